@@ -12,8 +12,24 @@
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable.hpp>
 #include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/string_name.hpp>
 #include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include "agent_memory.h"
+#include "json_reader.h"
+#include "observation_builder.h"
+#include "perf_stats.h"
+#include "random_stream.h"
+#include "replay_log.h"
+#include "ring_buffer.h"
+#include "stream_transport.h"
+#include "tool_future.h"
+#include "world_snapshot.h"
+
+#include <vector>
 
 namespace agent_arena {
 
@@ -30,12 +46,65 @@ class IPCClient;
 class SimulationManager : public godot::Node {
     GDCLASS(SimulationManager, godot::Node)
 
+public:
+    /**
+     * How the tick loop is driven.
+     *
+     * MANUAL:   ticks only advance via step_simulation() (legacy behaviour)
+     * REALTIME: fixed-timestep accumulator, tick_rate ticks per wall-clock second
+     * FAST:     as many ticks per frame as frame_budget_ms allows (headless evals)
+     * LOCKSTEP: one tick, then wait for notify_backend_ready() before the next
+     */
+    enum TickMode {
+        TICK_MODE_MANUAL,
+        TICK_MODE_REALTIME,
+        TICK_MODE_FAST,
+        TICK_MODE_LOCKSTEP,
+    };
+
 private:
     uint64_t current_tick;
     double tick_rate;
     bool is_running;
     EventBus* event_bus;
 
+    // Tick driver state
+    TickMode tick_mode;
+    double tick_accumulator;      // Unconsumed wall-clock time (REALTIME)
+    int max_ticks_per_frame;      // Catch-up cap per frame (REALTIME)
+    int max_fast_ticks_per_frame; // Optional tick cap per frame (FAST, 0 = budget only)
+    double frame_budget_ms;       // Time budget per frame (FAST)
+    bool awaiting_backend;        // LOCKSTEP: tick issued, backend not done yet
+    double lockstep_timeout;      // Seconds before a stalled backend is skipped (0 = wait forever)
+    double lockstep_wait_time;    // Time spent waiting on the current tick
+
+    // Adaptive tick rate: REALTIME/FAST slow down as backend pressure rises
+    bool adaptive_tick_rate;
+    double min_tick_rate_scale;   // Scale applied at full pressure
+    double backend_pressure;      // 0..1, fed from IPCClient's backpressure_changed
+
+    // Deterministic RNG: one stream per name, all derived from the master seed
+    uint64_t seed;
+    godot::HashMap<godot::String, godot::Ref<RandomStream>> rng_streams;
+
+    // Snapshots: state outside SimulationManager comes from named sources,
+    // captured and restored in registration order
+    struct SnapshotSource {
+        godot::String name;
+        godot::Callable capture;   // () -> Variant
+        godot::Callable restore;   // (Variant) -> void
+    };
+    std::vector<SnapshotSource> snapshot_sources;
+    godot::HashMap<int64_t, WorldSnapshot> snapshots;  // Insertion order = oldest first
+    int64_t next_snapshot_handle;
+    int max_snapshots;  // 0 = unlimited
+
+    void _run_tick_loop(double delta);
+    void _reseed_streams();
+    void _capture_sources(WorldSnapshot& r_snapshot) const;
+    void _apply_snapshot(const WorldSnapshot& snapshot);
+    int64_t _store_snapshot(WorldSnapshot&& snapshot);
+
 protected:
     static void _bind_methods();
 
@@ -61,10 +130,74 @@ public:
     // Setters
     void set_tick_rate(double rate);
     void set_seed(uint64_t seed);
+    uint64_t get_seed() const { return seed; }
+
+    // Named RNG stream (e.g. "world", "agent:<id>"); the same name always
+    // returns the same stream, which restarts whenever the seed is set or
+    // the simulation is reset
+    godot::Ref<RandomStream> get_stream(const godot::String& name);
+
+    // Tick driver configuration
+    void set_tick_mode(TickMode mode);
+    TickMode get_tick_mode() const { return tick_mode; }
+    void set_max_ticks_per_frame(int count);
+    int get_max_ticks_per_frame() const { return max_ticks_per_frame; }
+    void set_max_fast_ticks_per_frame(int count);
+    int get_max_fast_ticks_per_frame() const { return max_fast_ticks_per_frame; }
+    void set_frame_budget_ms(double budget);
+    double get_frame_budget_ms() const { return frame_budget_ms; }
+    void set_lockstep_timeout(double seconds);
+    double get_lockstep_timeout() const { return lockstep_timeout; }
+
+    // Backpressure: with adaptive_tick_rate, ticks run at tick_rate scaled
+    // linearly from 1 (no pressure) down to min_tick_rate_scale (pressure 1)
+    void set_adaptive_tick_rate(bool enabled) { adaptive_tick_rate = enabled; }
+    bool get_adaptive_tick_rate() const { return adaptive_tick_rate; }
+    void set_min_tick_rate_scale(double scale);
+    double get_min_tick_rate_scale() const { return min_tick_rate_scale; }
+    void set_backend_pressure(double pressure);
+    double get_backend_pressure() const { return backend_pressure; }
+    double get_tick_rate_scale() const;
+    double get_effective_tick_rate() const { return tick_rate * get_tick_rate_scale(); }
+
+    // Lockstep handshake: called once the backend has answered the current tick
+    void notify_backend_ready();
+    bool is_awaiting_backend() const { return awaiting_backend; }
+
+    // World-state snapshots. snapshot() captures the tick, seed, RNG streams,
+    // EventBus position and every source, and returns a handle; restore()
+    // rewinds all of them (without touching is_running) and emits
+    // snapshot_restored. Unchanged source blobs are shared between snapshots.
+    void add_snapshot_source(const godot::String& name, const godot::Callable& capture, const godot::Callable& restore);
+    void remove_snapshot_source(const godot::String& name);
+    int64_t snapshot();
+    bool restore(int64_t handle);
+    bool has_snapshot(int64_t handle) const { return snapshots.has(handle); }
+    int64_t get_snapshot_tick(int64_t handle) const;
+    void release_snapshot(int64_t handle) { snapshots.erase(handle); }
+    void clear_snapshots() { snapshots.clear(); }
+    int get_snapshot_count() const { return (int)snapshots.size(); }
+    void set_max_snapshots(int count);
+    int get_max_snapshots() const { return max_snapshots; }
+    godot::Dictionary get_snapshot_stats() const;
+
+    // Self-contained binary form, e.g. to branch evaluations in another process
+    godot::PackedByteArray get_snapshot_data(int64_t handle) const;
+    int64_t load_snapshot_data(const godot::PackedByteArray& data);  // -1 if malformed
 };
 
 /**
  * Event bus for deterministic event ordering and replay
+ *
+ * Events are stamped with the simulation tick (set by SimulationManager each
+ * step) and stored natively in one bucket per tick. Buckets live in dense
+ * segments of consecutive ticks, so get_events_for_tick() is an index into
+ * (almost always) the last segment; a gap of more than MAX_TICK_GAP ticks
+ * starts a new segment instead of allocating empty buckets, which keeps
+ * sparse or unordered recordings from growing with the tick span. Event
+ * type strings are interned to small integer IDs.
+ * When recording to a file, events are also streamed to a chunked replay log
+ * and in-memory buckets are dropped as each chunk is written.
  */
 class EventBus : public godot::Node {
     GDCLASS(EventBus, godot::Node)
@@ -72,26 +205,72 @@ class EventBus : public godot::Node {
 private:
     struct Event {
         uint64_t tick;
-        godot::String event_type;
+        uint32_t type_id;
         godot::Dictionary data;
     };
 
-    godot::Array event_queue;
+    // Bucket i holds the events of tick (base_tick + i), in emission order
+    struct TickSegment {
+        uint64_t base_tick;
+        std::vector<std::vector<Event>> buckets;
+    };
+
+    std::vector<TickSegment> segments;  // Sorted by base_tick, never overlapping
+    std::vector<std::vector<Event>> spare_buckets;  // Dropped buckets, emptied but keeping their capacity
+    int64_t event_count;
+
+    // Interned event types
+    godot::HashMap<godot::String, uint32_t> event_type_ids;
+    std::vector<godot::String> event_type_names;
+
+    uint64_t current_tick;
     bool recording;
+    ReplayWriter replay_writer;
+
+    uint32_t _intern_event_type(const godot::String& event_type);
+    void _drop_buckets_before(uint64_t tick);
+    void _recycle_bucket(std::vector<Event>& bucket);
+    void _recycle_segment(TickSegment& segment);
+    void _store_event(uint64_t tick, uint32_t type_id, const godot::Dictionary& data);
+    const std::vector<Event>* _get_bucket(uint64_t tick) const;
+    godot::Dictionary _event_to_dict(const Event& event) const;
 
 protected:
     static void _bind_methods();
 
 public:
+    static constexpr size_t INITIAL_TICK_CAPACITY = 4096;
+    static constexpr uint64_t MAX_TICK_GAP = 64;  // Empty ticks bridged inside one segment
+    static constexpr size_t MAX_SPARE_BUCKETS = 64;
+
     EventBus();
     ~EventBus();
 
     void emit_event(const godot::String& event_type, const godot::Dictionary& data);
     godot::Array get_events_for_tick(uint64_t tick);
+    int get_event_count_for_tick(uint64_t tick) const;
+    int64_t get_event_count() const { return event_count; }
     void clear_events();
 
+    // Drop every event after the first events_in_tick of tick (used by
+    // SimulationManager::restore); also makes tick current
+    void rewind_events(uint64_t tick, int events_in_tick);
+
+    // Tick that newly emitted events are stamped with
+    void set_current_tick(uint64_t tick) { current_tick = tick; }
+    uint64_t get_current_tick() const { return current_tick; }
+
+    // Interned ID for an event type (-1 if the type has never been seen)
+    int get_event_type_id(const godot::String& event_type) const;
+    godot::String get_event_type_name(int type_id) const;
+
     void start_recording();
     void stop_recording();
+    bool is_recording() const { return recording; }
+    godot::Error start_recording_to_file(const godot::String& path, bool compress = true);
+    bool is_recording_to_file() const { return replay_writer.is_open(); }
+    void set_replay_chunk_event_limit(int limit) { replay_writer.set_chunk_event_limit(limit); }
+    int get_replay_chunk_event_limit() const { return replay_writer.get_chunk_event_limit(); }
     godot::Array export_recording();
     void load_recording(const godot::Array& events);
 };
@@ -104,10 +283,13 @@ class Agent : public godot::Node3D {
 
 private:
     godot::String agent_id;
-    godot::Dictionary short_term_memory;
-    godot::Array action_history;
+    AgentMemory memory;
+    godot::Variant last_observation;  // Kept out of memory so snapshots don't resend it
     bool is_active;
     ToolRegistry* tool_registry;  // Optional manual override (for testing)
+    bool tool_registry_resolved;  // Sibling ToolRegistry looked up (on the first tool call)
+
+    ToolRegistry* _resolve_tool_registry();
 
 protected:
     static void _bind_methods();
@@ -116,8 +298,9 @@ public:
     Agent();
     ~Agent();
 
-    void _ready() override;
-    void _process(double delta) override;
+    // No _ready or _process override: per-tick work is driven by the scene
+    // controller (see AgentWorld), so idle agents cost nothing per frame, and
+    // the ToolRegistry lookup waits for the first tool call
 
     // Agent lifecycle
     void perceive(const godot::Dictionary& observations);
@@ -125,17 +308,36 @@ public:
     void execute_action(const godot::Dictionary& action);
 
     // Memory operations
-    void store_memory(const godot::String& key, const godot::Variant& value);
-    godot::Variant retrieve_memory(const godot::String& key);
+    void store_memory(const godot::StringName& key, const godot::Variant& value);
+    godot::Variant retrieve_memory(const godot::StringName& key) const;
+    bool has_memory(const godot::StringName& key) const { return memory.has(key); }
+    void erase_memory(const godot::StringName& key) { memory.erase(key); }
     void clear_short_term_memory();
 
+    // Bounded action history (newest action_history_capacity actions)
+    godot::Array get_action_history(int limit = -1) const { return memory.get_recent_actions(limit); }
+    int get_action_history_size() const { return memory.get_action_count(); }
+    int64_t get_total_action_count() const { return (int64_t)memory.get_total_actions(); }
+    void clear_action_history() { memory.clear_actions(); }
+    void set_action_history_capacity(int capacity) { memory.set_history_capacity(capacity); }
+    int get_action_history_capacity() const { return memory.get_history_capacity(); }
+
+    // Whole memory in one call; C++ callers can encode it directly via get_memory()
+    godot::Dictionary get_memory_snapshot(int action_limit = -1) const { return memory.snapshot(action_limit); }
+    void restore_memory_snapshot(const godot::Dictionary& snapshot);  // Inverse of get_memory_snapshot(-1)
+    const AgentMemory& get_memory() const { return memory; }
+
     // Tool interface
     godot::Dictionary call_tool(const godot::String& tool_name, const godot::Dictionary& params);
+    godot::Ref<ToolFuture> call_tool_async(const godot::String& tool_name, const godot::Dictionary& params);
 
     // Tool registry management
     void set_tool_registry(ToolRegistry* registry);
     ToolRegistry* get_tool_registry() const { return tool_registry; }
 
+    // Latest observation handed to perceive(), gathered by IPCClient for batched ticks
+    godot::Variant get_last_observation() const { return last_observation; }
+
     // Getters/Setters
     godot::String get_agent_id() const { return agent_id; }
     void set_agent_id(const godot::String& id) { agent_id = id; }
@@ -148,8 +350,26 @@ class ToolRegistry : public godot::Node {
     GDCLASS(ToolRegistry, godot::Node)
 
 private:
-    godot::Dictionary registered_tools;
+    struct ToolEntry {
+        godot::StringName name;
+        godot::Dictionary schema;
+        godot::Callable local_handler;  // Invalid = forwarded to the agent runtime
+        bool active = false;            // Cleared by unregister_tool(); the ID stays reserved
+    };
+
+    // Dispatch table indexed by tool ID; a re-registered name gets its old ID back
+    std::vector<ToolEntry> tools;
+    godot::HashMap<godot::StringName, int> tool_ids;
+    int active_tool_count;
+    uint64_t local_call_count;
+    uint64_t remote_call_count;
     IPCClient* ipc_client;
+    bool ipc_client_resolved;  // Sibling IPCClient looked up (on the first remote call)
+
+    IPCClient* _resolve_ipc_client();
+    ToolEntry* _get_entry(int tool_id);
+    int _ensure_entry(const godot::StringName& name);
+    godot::Dictionary _run_local_handler(ToolEntry& entry, const godot::Dictionary& params, godot::Object* agent);
 
 protected:
     static void _bind_methods();
@@ -158,17 +378,49 @@ public:
     ToolRegistry();
     ~ToolRegistry();
 
-    void _ready() override;
-
-    void register_tool(const godot::String& name, const godot::Dictionary& schema);
+    /**
+     * Tools are compiled into a flat table on registration. Tools with a local
+     * handler run in-engine as handler(agent, params) -> Dictionary, without
+     * IPC; C++ code can pass callable_mp() handlers. Everything else goes to
+     * the agent runtime through IPCClient.
+     */
+    int register_tool(const godot::String& name, const godot::Dictionary& schema);
+    int register_local_tool(const godot::String& name, const godot::Dictionary& schema, const godot::Callable& handler);
+    void set_local_handler(const godot::String& name, const godot::Callable& handler);  // Invalid Callable = remote
     void unregister_tool(const godot::String& name);
+
+    // Bulk registration from a manifest: an Array of schemas (each with a
+    // "name"), a Dictionary {"tools": [...]}, or a Dictionary name -> schema.
+    // Returns the number of tools registered.
+    int register_tools(const godot::Variant& manifest);
+    // Same, from a JSON manifest file decoded natively; -1 if it can't be read
+    int load_tool_manifest(const godot::String& path);
+
+    bool has_tool(const godot::String& name) const;
+    bool is_local_tool(const godot::String& name) const;
+    int get_tool_id(const godot::String& name) const;  // -1 if not registered
+    godot::String get_tool_name(int tool_id) const;
     godot::Dictionary get_tool_schema(const godot::String& name);
     godot::Array get_all_tool_names();
-    godot::Dictionary execute_tool(const godot::String& name, const godot::Dictionary& params);
+    int get_tool_count() const { return active_tool_count; }
+
+    godot::Dictionary execute_tool(const godot::String& name, const godot::Dictionary& params,
+                                   const godot::String& agent_id = "", godot::Object* agent = nullptr);
+    godot::Dictionary execute_tool_by_id(int tool_id, const godot::Dictionary& params,
+                                         const godot::String& agent_id = "", godot::Object* agent = nullptr);
+
+    // Same dispatch, returning a future: already resolved for local tools
+    godot::Ref<ToolFuture> call_tool(const godot::String& name, const godot::Dictionary& params,
+                                     const godot::String& agent_id = "", godot::Object* agent = nullptr);
+    godot::Ref<ToolFuture> call_tool_by_id(int tool_id, const godot::Dictionary& params,
+                                           const godot::String& agent_id = "", godot::Object* agent = nullptr);
+
+    uint64_t get_local_call_count() const { return local_call_count; }
+    uint64_t get_remote_call_count() const { return remote_call_count; }
 
     // IPC Client management
     void set_ipc_client(IPCClient* client);
-    IPCClient* get_ipc_client() const { return ipc_client; }
+    IPCClient* get_ipc_client() { return _resolve_ipc_client(); }
 };
 
 /**
@@ -177,23 +429,280 @@ public:
 class IPCClient : public godot::Node {
     GDCLASS(IPCClient, godot::Node)
 
+public:
+    /**
+     * Wire transport used for tick requests.
+     *
+     * HTTP:   JSON over HTTPRequest (default, works with any backend)
+     * STREAM: persistent TCP connection with length-prefixed MessagePack frames;
+     *         falls back to HTTP while the stream is not connected
+     */
+    enum Transport {
+        TRANSPORT_HTTP,
+        TRANSPORT_STREAM,
+    };
+
+    /**
+     * When the actions of a pipelined tick request are applied.
+     *
+     * ON_ARRIVAL: as soon as the response arrives (lowest latency, timing-dependent)
+     * FIXED:      at tick + pipeline_depth, via advance_to_tick() (deterministic
+     *             latency; a response that arrives later is applied on arrival)
+     */
+    enum ActionLatency {
+        ACTION_LATENCY_ON_ARRIVAL,
+        ACTION_LATENCY_FIXED,
+    };
+
+    /**
+     * What to do for an agent whose observation fingerprint (see
+     * ObservationBuilder::get_fingerprint) matches the one its last decision
+     * was made for, within decision_cache_ttl ticks of that decision.
+     *
+     * OFF:    always ask the backend
+     * REPLAY: leave the agent out of the request and re-apply the cached action
+     * SKIP:   leave the agent out of the request; it keeps its current action
+     */
+    enum DecisionCache {
+        DECISION_CACHE_OFF,
+        DECISION_CACHE_REPLAY,
+        DECISION_CACHE_SKIP,
+    };
+
+    /**
+     * Backend connection state, driven by /health probes and request outcomes.
+     *
+     * DISCONNECTED: not connected and not trying to (before connect_to_server,
+     *               after disconnect_from_server, or with auto_reconnect off)
+     * CONNECTING:   a probe is in flight and no response has arrived yet
+     * CONNECTED:    the backend answered; idle periods are covered by keep-alive probes
+     * BACKOFF:      the backend is unreachable; the next probe waits out an
+     *               exponentially growing delay
+     */
+    enum ConnectionState {
+        CONNECTION_DISCONNECTED,
+        CONNECTION_CONNECTING,
+        CONNECTION_CONNECTED,
+        CONNECTION_BACKOFF,
+    };
+
 private:
+    // A tool call waiting for (or occupying) a pool slot
+    struct ToolRequest {
+        uint64_t request_id = 0;
+        godot::String tool_name;
+        godot::Dictionary params;
+        godot::String agent_id;
+        uint64_t tick = 0;
+        uint64_t queued_usec = 0;  // PerfStats clock, for PHASE_TOOL_LATENCY
+        double priority = 1.0;     // The calling agent's decision priority
+        int bypassed = 0;          // Times passed over for a higher-priority request
+    };
+
+    // One in-flight tool request and the HTTPRequest node carrying it
+    struct ToolSlot {
+        godot::HTTPRequest* http = nullptr;
+        bool busy = false;
+        ToolRequest request;
+    };
+
+    // One HTTP tick request in flight
+    struct TickSlot {
+        godot::HTTPRequest* http = nullptr;
+        bool busy = false;
+        uint64_t tick = 0;
+    };
+
+    struct InFlightTick {
+        uint64_t tick;
+        bool via_stream;
+        uint64_t sent_usec;  // PerfStats clock, for PHASE_BACKEND_WAIT
+    };
+
+    // A response held back until its apply tick (ACTION_LATENCY_FIXED)
+    struct DeferredResponse {
+        uint64_t apply_tick;
+        godot::Dictionary response;
+        bool replayed;  // Decision-cache replay: route the actions only
+    };
+
+    // An agent's last backend decision and the fingerprint it was made for
+    struct CachedDecision {
+        bool valid = false;
+        uint64_t fingerprint = 0;
+        uint64_t decided_tick = 0;
+        godot::Dictionary action;
+        // Newest request that included this agent, committed when answered
+        bool pending = false;
+        uint64_t pending_fingerprint = 0;
+        uint64_t pending_tick = 0;
+    };
+
+    // Per-agent decision scheduling state, by agent_id
+    struct AgentSchedule {
+        double priority = 1.0;
+        int interval = 1;            // Ask at most every Nth tick
+        bool idle = false;           // Last decision was idle/wait (see idle_decision_interval)
+        bool requested = false;
+        uint64_t last_request_tick = 0;
+    };
+
+    // A registered agent due for a decision this tick
+    struct DecisionCandidate {
+        godot::String agent_id;
+        uint64_t instance_id = 0;
+        bool packed = false;         // Observation is in the ObservationBuilder
+        bool starving = false;       // Waited max_decision_wait ticks or more
+        double score = 0.0;          // priority * ticks since last asked
+        bool has_fingerprint = false;
+        uint64_t fingerprint = 0;
+    };
+
+    // An agent whose observation comes pre-encoded from the ObservationBuilder
+    struct PackedObservation {
+        godot::String agent_id;
+        const std::vector<uint8_t>* buffer = nullptr;
+    };
+
     godot::String server_url;
-    godot::HTTPRequest* http_request;
-    godot::HTTPRequest* http_request_tool;  // Separate request node for tool execution
+    godot::HTTPRequest* http_request;  // Health checks; created by the first connect_to_server()
+
+    // Built once per server_url instead of per request
+    godot::String health_url;
+    godot::String tick_url;
+    godot::String tool_url;
+    godot::PackedStringArray json_headers;
+
+    // Request Dictionaries refilled in place each time (same keys every send)
+    godot::Dictionary tick_request;
+    godot::Dictionary tool_request;
+    std::vector<godot::String> stale_agent_ids;  // Reused per batch
     bool is_connected;
     uint64_t current_tick;
     godot::Dictionary pending_response;
     bool response_received;
-
-    // Request queue for tool execution
-    godot::Array tool_request_queue;  // Queue of pending tool requests
-    bool tool_request_in_progress;    // Is a tool request currently being processed
-    godot::Dictionary current_tool_request;  // The request currently being processed
+    JsonReader json_reader;  // Decodes HTTP response bodies in place; reused across responses
+
+    // Connection health: http_request carries /health probes (keep-alive
+    // while idle, reconnect attempts while in backoff)
+    ConnectionState connection_state;
+    bool wants_connection;          // Between connect_to_server() and disconnect_from_server()
+    bool auto_reconnect;
+    double health_check_interval;   // Idle seconds before a keep-alive probe (0 = none)
+    double reconnect_base_delay;    // Backoff after the first failure; doubles per failed attempt
+    double reconnect_max_delay;
+    bool health_probe_pending;
+    uint64_t health_probe_sent_usec;
+    uint64_t last_contact_msec;     // Last successful response of any kind
+    uint64_t next_reconnect_msec;
+    int reconnect_attempts;         // Consecutive failures since the last contact
+    uint64_t next_stream_open_msec; // Stream transport: when to reopen a dropped stream
+    int stream_open_attempts;
+    double backend_rtt_ms;          // Smoothed request round-trip time
+
+    // Backpressure: how far backend latency is over latency_budget_ms, 0..1
+    double latency_budget_ms;       // 0 = never report pressure
+    double backpressure;
+    int max_queued_tool_requests;   // Tool calls waiting for a slot (0 = unbounded)
+    int max_response_lag;           // Ticks past its apply tick before a response's actions are dropped (0 = never)
+
+    // Binary stream transport
+    Transport transport;
+    int stream_port;
+    StreamTransport stream_transport;
+
+    // Agents participating in batched ticks (agent_id -> Agent instance ID)
+    godot::HashMap<godot::String, uint64_t> registered_agents;
+
+    // Optional native observation source; agents with a buffer for the
+    // current tick skip the Dictionary path entirely
+    godot::Ref<ObservationBuilder> observation_builder;
+    std::vector<PackedObservation> packed_observations;  // Reused per batch
+    bool observation_deltas;  // Send builder deltas over the stream transport
+
+    // Decision cache (opt-in), by agent_id
+    DecisionCache decision_cache;
+    int decision_cache_ttl;  // Ticks a decision stays reusable
+    godot::HashMap<godot::String, CachedDecision> cached_decisions;
+    godot::Array replayed_actions;  // Reused per batch
+
+    // Decision scheduling: which due agents a batched tick asks about when
+    // max_agents_per_tick (or backpressure) limits the request
+    godot::HashMap<godot::String, AgentSchedule> agent_schedules;
+    std::vector<DecisionCandidate> decision_candidates;  // Reused per batch
+    int max_agents_per_tick;     // 0 = every due agent
+    int max_decision_wait;       // Ticks before a waiting agent goes ahead of priority (0 = never)
+    int idle_decision_interval;  // Minimum interval for agents whose last action was idle
+    bool backpressure_shedding;  // Shrink the per-tick budget as backpressure rises
+
+    // Batch window (see begin_batch): ticks requested while open are merged
+    bool batch_open;
+    bool batch_pending;
+    uint64_t batch_tick;
+
+    // Decision pipeline: up to pipeline_depth tick requests in flight,
+    // matched to responses by tick
+    int pipeline_depth;
+    ActionLatency action_latency;
+    std::vector<TickSlot> tick_slots;             // Grown lazily up to pipeline_depth
+    std::vector<InFlightTick> in_flight_ticks;    // Oldest first
+    std::vector<DeferredResponse> deferred_responses;  // Sorted by apply_tick
+    uint64_t simulation_tick;                     // Last tick passed to advance_to_tick()
+    double tick_timeout;                          // Seconds before an unanswered tick fails (0 = none)
+    bool stream_was_open;
+
+    // Tool execution pipeline: FIFO of pending calls dispatched onto a pool
+    // of HTTPRequest slots, correlated by request ID
+    RingBuffer<ToolRequest> tool_request_queue;
+    std::vector<ToolSlot> tool_slots;  // Grown lazily up to max_concurrent_tool_requests
+    int max_concurrent_tool_requests;
+    int active_tool_requests;
+    uint64_t next_tool_request_id;
+    godot::HashMap<uint64_t, godot::Ref<ToolFuture>> tool_futures;  // Unresolved, by request ID
+    double tool_timeout;  // Default seconds from queueing to response (0 = none)
 
     void _on_request_completed(int result, int response_code, const godot::PackedStringArray& headers, const godot::PackedByteArray& body);
-    void _on_tool_request_completed(int result, int response_code, const godot::PackedStringArray& headers, const godot::PackedByteArray& body);
-    void _process_next_tool_request();  // Process next request in queue
+    void _on_tool_request_completed(int result, int response_code, const godot::PackedStringArray& headers, const godot::PackedByteArray& body, int slot_index);
+    void _process_next_tool_request();  // Dispatch queued requests onto idle slots
+    int _acquire_tool_slot();           // Index of an idle slot, or -1 if the pool is saturated
+    bool _send_tool_request(int slot_index);
+    void _resolve_tool_future(uint64_t request_id, const godot::Dictionary& response);
+    bool _drop_tool_request(uint64_t request_id, ToolFuture::Status status, const godot::String& error);
+    void _check_tool_timeouts();
+    void _on_tick_request_completed(int result, int response_code, const godot::PackedStringArray& headers, const godot::PackedByteArray& body, int slot_index);
+    int _acquire_tick_slot();
+    void _push_in_flight(uint64_t tick, bool via_stream);
+    bool _finish_in_flight(uint64_t tick);
+    bool _is_in_flight(uint64_t tick) const;
+    void _fail_tick_request(uint64_t tick, const godot::String& error);
+    void _expire_in_flight_ticks();
+    void _drop_stream_in_flight();
+    void _defer_response(uint64_t apply_tick, const godot::Dictionary& response, bool replayed);
+    void _apply_tick_response(const godot::Dictionary& response);
+    void _send_tick_payload(uint64_t tick, const godot::Array& agents);
+    godot::Error _send_packed_tick_frame(uint64_t tick, const godot::Array& agents);
+    void _route_tick_actions(const godot::Array& actions);
+    bool _serve_cached_decision(const godot::String& agent_id, uint64_t fingerprint, uint64_t tick);
+    void _mark_decision_pending(const godot::String& agent_id, uint64_t fingerprint, uint64_t tick);
+    void _record_decisions(uint64_t tick, const godot::Array& actions);
+    bool _is_decision_due(const AgentSchedule& schedule, uint64_t tick, DecisionCandidate& r_candidate) const;
+    int _get_decision_budget(int candidate_count) const;
+    void _schedule_decisions(uint64_t tick);  // Orders and trims decision_candidates
+    ToolRequest _pop_next_tool_request();
+    void _send_gathered_tick(uint64_t tick);  // send_batch_tick_request after the batch window
+    ToolRequest _take_queued_tool_request(size_t index);  // Removes it, keeping queue order
+    void _handle_tick_response(const godot::Dictionary& response);
+    godot::String _get_server_host() const;
+    void _update_endpoint_urls();
+    godot::HTTPRequest* _ensure_main_request();
+
+    void _set_connection_state(ConnectionState state);
+    void _send_health_probe();
+    void _mark_backend_alive();
+    void _on_backend_unreachable(const godot::String& reason, bool emit_failed);
+    void _record_rtt(uint64_t sent_usec);
+    void _update_connection();
+    void _update_backpressure();
 
 protected:
     static void _bind_methods();
@@ -202,7 +711,7 @@ public:
     IPCClient();
     ~IPCClient();
 
-    void _ready() override;
+    // No _ready override: every HTTPRequest child is created on first use
     void _process(double delta) override;
 
     // Connection management
@@ -210,19 +719,130 @@ public:
     void disconnect_from_server();
     bool is_server_connected() const { return is_connected; }
 
+    // Connection health
+    ConnectionState get_connection_state() const { return connection_state; }
+    void set_auto_reconnect(bool enabled) { auto_reconnect = enabled; }
+    bool get_auto_reconnect() const { return auto_reconnect; }
+    void set_health_check_interval(double seconds);
+    double get_health_check_interval() const { return health_check_interval; }
+    void set_reconnect_base_delay(double seconds);
+    double get_reconnect_base_delay() const { return reconnect_base_delay; }
+    void set_reconnect_max_delay(double seconds);
+    double get_reconnect_max_delay() const { return reconnect_max_delay; }
+    int get_reconnect_attempts() const { return reconnect_attempts; }
+    double get_backend_rtt_ms() const { return backend_rtt_ms; }
+    godot::Dictionary get_connection_stats() const;
+
+    // Backpressure: backpressure_changed(level) fires when the level moves by
+    // a tenth; slow SimulationManager down with set_backend_pressure(level)
+    void set_latency_budget_ms(double ms);
+    double get_latency_budget_ms() const { return latency_budget_ms; }
+    double get_backpressure() const { return backpressure; }
+    void set_max_queued_tool_requests(int count);
+    int get_max_queued_tool_requests() const { return max_queued_tool_requests; }
+    void set_max_response_lag(int ticks);
+    int get_max_response_lag() const { return max_response_lag; }
+
     // Communication
     void send_tick_request(uint64_t tick, const godot::Array& perceptions);
+    void send_batch_tick_request(uint64_t tick);
+
+    // Merge every send_batch_tick_request() until end_batch() into one request,
+    // e.g. one per WorldHost step across all worlds. end_batch() returns true
+    // if a request was sent.
+    void begin_batch();
+    bool end_batch();
+    bool is_batch_open() const { return batch_open; }
+
+    // Decision pipeline
+    bool can_send_tick() const { return (int)in_flight_ticks.size() < pipeline_depth; }
+    int get_in_flight_tick_count() const { return (int)in_flight_ticks.size(); }
+    int get_deferred_response_count() const { return (int)deferred_responses.size(); }
+    void advance_to_tick(uint64_t tick);  // Apply deferred actions that are due
+    void set_pipeline_depth(int depth);
+    int get_pipeline_depth() const { return pipeline_depth; }
+    void set_tick_timeout(double seconds);
+    double get_tick_timeout() const { return tick_timeout; }
+    void set_action_latency(ActionLatency policy) { action_latency = policy; }
+    ActionLatency get_action_latency() const { return action_latency; }
     godot::Dictionary get_tick_response();
     bool has_response() const { return response_received; }
 
-    // Tool execution
+    // Agent registration for batched ticks
+    void register_agent(Agent* agent);
+    void unregister_agent(const godot::String& agent_id);
+    int get_registered_agent_count() const { return registered_agents.size(); }
+    void set_observation_builder(const godot::Ref<ObservationBuilder>& builder) { observation_builder = builder; }
+    godot::Ref<ObservationBuilder> get_observation_builder() const { return observation_builder; }
+    void set_observation_deltas(bool enabled);
+    bool get_observation_deltas() const { return observation_deltas; }
+
+    // Decision cache
+    void set_decision_cache(DecisionCache mode);
+    DecisionCache get_decision_cache() const { return decision_cache; }
+    void set_decision_cache_ttl(int ticks);
+    int get_decision_cache_ttl() const { return decision_cache_ttl; }
+    int get_decision_cache_size() const { return cached_decisions.size(); }
+    void clear_decision_cache() { cached_decisions.clear(); }
+
+    // Decision scheduling. A batched tick asks about every registered agent
+    // due by its decision interval, up to max_agents_per_tick; when capped,
+    // agents waiting max_decision_wait ticks go first, then the highest
+    // priority * ticks-since-last-asked. Tool calls are dispatched by the
+    // caller's priority too (each passed over at most MAX_TOOL_BYPASS times).
+    void set_agent_priority(const godot::String& agent_id, double priority);
+    double get_agent_priority(const godot::String& agent_id) const;
+    void set_agent_decision_interval(const godot::String& agent_id, int ticks);
+    int get_agent_decision_interval(const godot::String& agent_id) const;
+    void set_max_agents_per_tick(int count);
+    int get_max_agents_per_tick() const { return max_agents_per_tick; }
+    void set_max_decision_wait(int ticks);
+    int get_max_decision_wait() const { return max_decision_wait; }
+    void set_idle_decision_interval(int ticks);
+    int get_idle_decision_interval() const { return idle_decision_interval; }
+    void set_backpressure_shedding(bool enabled) { backpressure_shedding = enabled; }
+    bool get_backpressure_shedding() const { return backpressure_shedding; }
+
+    // Tool execution. The future resolves when the response for its request
+    // ID arrives; timeout < 0 uses tool_timeout.
+    godot::Ref<ToolFuture> execute_tool_async(const godot::String& tool_name, const godot::Dictionary& params,
+                                              const godot::String& agent_id = "", uint64_t tick = 0,
+                                              double timeout = -1.0);
+    bool cancel_tool_request(int64_t request_id);
+    int get_unresolved_tool_count() const { return tool_futures.size(); }
+    void set_tool_timeout(double seconds);
+    double get_tool_timeout() const { return tool_timeout; }
+
+    // Legacy fire-and-forget form: a remote call returns
+    // {success: false, pending: true, request_id} at once, not its result
     godot::Dictionary execute_tool_sync(const godot::String& tool_name, const godot::Dictionary& params, const godot::String& agent_id = "", uint64_t tick = 0);
+    int get_pending_tool_request_count() const { return (int)tool_request_queue.size(); }
+    int get_active_tool_request_count() const { return active_tool_requests; }
+    void set_max_concurrent_tool_requests(int count);
+    int get_max_concurrent_tool_requests() const { return max_concurrent_tool_requests; }
+    static constexpr size_t TOOL_SCHEDULE_WINDOW = 32;  // Queued tool calls considered per dispatch
+    static constexpr int MAX_TOOL_BYPASS = 8;
 
     // Getters/Setters
     godot::String get_server_url() const { return server_url; }
     void set_server_url(const godot::String& url);
+
+    void set_transport(Transport mode);
+    Transport get_transport() const { return transport; }
+    void set_stream_port(int port) { stream_port = port; }
+    int get_stream_port() const { return stream_port; }
+    // Run the stream socket and frame decoding on a worker thread (next connect)
+    void set_network_thread(bool enabled) { stream_transport.set_threaded(enabled); }
+    bool get_network_thread() const { return stream_transport.is_threaded(); }
+    bool is_stream_connected() const { return stream_transport.is_open(); }
 };
 
 } // namespace agent_arena
 
+VARIANT_ENUM_CAST(agent_arena::SimulationManager::TickMode);
+VARIANT_ENUM_CAST(agent_arena::IPCClient::Transport);
+VARIANT_ENUM_CAST(agent_arena::IPCClient::ActionLatency);
+VARIANT_ENUM_CAST(agent_arena::IPCClient::DecisionCache);
+VARIANT_ENUM_CAST(agent_arena::IPCClient::ConnectionState);
+
 #endif // AGENT_ARENA_H
@@ -0,0 +1,68 @@
+#ifndef AGENT_ARENA_AGENT_MEMORY_H
+#define AGENT_ARENA_AGENT_MEMORY_H
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include "ring_buffer.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Native per-agent memory: interned-key entries plus a bounded action history.
+ *
+ * Keys are StringNames, so lookups hash an interned pointer instead of the
+ * string contents. The action history keeps the newest history_capacity
+ * actions and evicts the oldest, so long episodes use constant memory.
+ * encode_snapshot() writes the whole memory as one MessagePack map, for
+ * splicing into an ObservationBuilder buffer without a Dictionary copy.
+ */
+class AgentMemory {
+public:
+    static constexpr int DEFAULT_HISTORY_CAPACITY = 64;
+
+    AgentMemory();
+
+    // Key/value entries (insertion-ordered)
+    void store(const godot::StringName& key, const godot::Variant& value);
+    const godot::Variant* get(const godot::StringName& key) const { return entries.getptr(key); }
+    bool has(const godot::StringName& key) const { return entries.has(key); }
+    bool erase(const godot::StringName& key) { return entries.erase(key); }
+    void clear_entries() { entries.clear(); }
+    int get_entry_count() const { return entries.size(); }
+
+    // Action history (oldest first)
+    void push_action(const godot::Dictionary& action);
+    int get_action_count() const { return (int)action_history.size(); }
+    const godot::Dictionary& get_action(int index) const { return action_history[index]; }
+    godot::Array get_recent_actions(int limit) const;  // limit < 0 = all retained
+    void clear_actions() { action_history.clear(); }
+    uint64_t get_total_actions() const { return total_actions; }  // Including evicted ones
+
+    void set_history_capacity(int capacity);
+    int get_history_capacity() const { return history_capacity; }
+
+    // {entries: {...}, recent_actions: [...], total_actions: n}
+    godot::Dictionary snapshot(int action_limit) const;
+    // Replaces entries, history and total_actions with a snapshot(-1) result
+    void restore(const godot::Dictionary& snapshot);
+    void encode_snapshot(std::vector<uint8_t>& out, int action_limit) const;
+
+private:
+    godot::HashMap<godot::StringName, godot::Variant> entries;
+    RingBuffer<godot::Dictionary> action_history;
+    int history_capacity;
+    uint64_t total_actions;
+
+    size_t _first_recent(int limit) const;
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_AGENT_MEMORY_H
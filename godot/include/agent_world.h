@@ -0,0 +1,115 @@
+#ifndef AGENT_ARENA_AGENT_WORLD_H
+#define AGENT_ARENA_AGENT_WORLD_H
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+class SpatialIndex;
+
+/**
+ * Hot per-agent state of a scene, kept as structure-of-arrays.
+ *
+ * Slot i of every array belongs to the same agent, in registration order.
+ * The nodes stay the source of truth for movement and health:
+ * sync_from_nodes() reads every agent's global position (and
+ * `current_health`, when the node has it) in one pass, pushes moved positions
+ * into a SpatialIndex, and marks agents whose node has been freed or left
+ * the tree inactive. Perception then reads positions from here instead of
+ * going back through the scene tree, and actions routed during a frame are
+ * parked as pending and drained in slot order.
+ * Removal swaps the last slot into the freed one.
+ *
+ * capture_state()/restore_state() serve the "agents" SimulationManager
+ * snapshot source: position, health and active flag of every slot as one
+ * flat binary blob, written back to the nodes on restore.
+ */
+class AgentWorld : public godot::RefCounted {
+    GDCLASS(AgentWorld, godot::RefCounted)
+
+private:
+    std::vector<godot::String> ids;
+    std::vector<godot::String> teams;
+    std::vector<godot::Vector3> positions;
+    std::vector<float> health;
+    std::vector<uint8_t> active;
+    std::vector<uint8_t> has_pending;
+    std::vector<godot::Dictionary> pending_actions;
+    std::vector<uint64_t> node_ids;     // ObjectID of each agent's Node3D
+    std::vector<int64_t> spatial_ids;   // -1 = not in the spatial index
+    godot::HashMap<godot::String, int> index_by_id;
+    int pending_count;
+
+    bool _valid(int index) const { return index >= 0 && index < (int)ids.size(); }
+
+protected:
+    static void _bind_methods();
+
+public:
+    AgentWorld();
+    ~AgentWorld();
+
+    // Returns the new slot, or the existing one if agent_id is already registered
+    int add_agent(godot::Node3D* node, const godot::String& agent_id, const godot::String& team);
+    bool remove_agent(const godot::String& agent_id);
+    void clear();
+    int find_agent(const godot::String& agent_id) const;
+    int get_agent_count() const { return (int)ids.size(); }
+    int get_active_count() const;
+
+    // One pass over every slot; returns the number of active agents
+    int sync_from_nodes(SpatialIndex* spatial_index = nullptr);
+
+    // Blob: [u32 count][count x f32 xyz][count x f32 health][count x u8 active]
+    // [count x (u32 length, UTF-8 id)], native byte order. Restore matches
+    // slots by agent ID, moves the nodes, drops pending actions and returns
+    // the number of agents restored (-1 if the blob is malformed).
+    godot::PackedByteArray capture_state() const;
+    int restore_state(const godot::PackedByteArray& state, SpatialIndex* spatial_index = nullptr);
+
+    godot::String get_agent_id(int index) const;
+    godot::String get_team(int index) const;
+    godot::Node3D* get_agent_node(int index) const;
+    godot::Vector3 get_position(int index) const;
+    void set_position(int index, const godot::Vector3& position);
+    float get_health(int index) const;
+    void set_health(int index, float value);
+    bool is_agent_active(int index) const;
+    void set_agent_active(int index, bool value);
+    int64_t get_spatial_id(int index) const;
+    void set_spatial_id(int index, int64_t spatial_id);
+
+    // Whole columns, slot order
+    godot::PackedStringArray get_ids() const;
+    godot::PackedVector3Array get_positions() const;
+    godot::PackedFloat32Array get_health_values() const;
+    godot::PackedInt32Array get_team_slots(const godot::String& team) const;
+
+    // Pending actions: the latest action per agent wins until taken
+    void set_pending_action(int index, const godot::Dictionary& action);
+    bool has_pending_action(int index) const;
+    godot::Dictionary take_pending_action(int index);
+    int get_pending_action_count() const { return pending_count; }
+    godot::PackedInt32Array get_pending_slots() const;
+
+    // C++ access to the columns
+    const std::vector<godot::Vector3>& get_native_positions() const { return positions; }
+    const std::vector<uint8_t>& get_native_active() const { return active; }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_AGENT_WORLD_H
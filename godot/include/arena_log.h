@@ -0,0 +1,120 @@
+#ifndef AGENT_ARENA_ARENA_LOG_H
+#define AGENT_ARENA_ARENA_LOG_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstdint>
+
+// Compile-time floor: ARENA_LOG_* calls below it expand to nothing. CMake sets
+// it from AGENT_ARENA_LOG_LEVEL; TRACE with AGENT_ARENA_DEBUG, INFO otherwise.
+#define AGENT_ARENA_LOG_LEVEL_TRACE 0
+#define AGENT_ARENA_LOG_LEVEL_DEBUG 1
+#define AGENT_ARENA_LOG_LEVEL_INFO 2
+#define AGENT_ARENA_LOG_LEVEL_WARN 3
+#define AGENT_ARENA_LOG_LEVEL_ERROR 4
+#define AGENT_ARENA_LOG_LEVEL_NONE 5
+
+#ifndef AGENT_ARENA_LOG_LEVEL
+#ifdef AGENT_ARENA_DEBUG
+#define AGENT_ARENA_LOG_LEVEL AGENT_ARENA_LOG_LEVEL_TRACE
+#else
+#define AGENT_ARENA_LOG_LEVEL AGENT_ARENA_LOG_LEVEL_INFO
+#endif
+#endif
+
+namespace agent_arena {
+
+/**
+ * Leveled log for the extension, reached through the ARENA_LOG_* macros.
+ *
+ * Arguments are only stringified once a message passes both the compiled
+ * floor and the runtime level, so a disabled call costs one comparison.
+ * Accepted messages go to the console (unless disabled) and into a bounded
+ * history ring; at most rate_limit messages per second are accepted, and the
+ * rest are counted and summarised once the second rolls over.
+ */
+class ArenaLog : public godot::RefCounted {
+    GDCLASS(ArenaLog, godot::RefCounted)
+
+public:
+    enum Level {
+        LEVEL_TRACE = AGENT_ARENA_LOG_LEVEL_TRACE,
+        LEVEL_DEBUG = AGENT_ARENA_LOG_LEVEL_DEBUG,
+        LEVEL_INFO = AGENT_ARENA_LOG_LEVEL_INFO,
+        LEVEL_WARN = AGENT_ARENA_LOG_LEVEL_WARN,
+        LEVEL_ERROR = AGENT_ARENA_LOG_LEVEL_ERROR,
+        LEVEL_NONE = AGENT_ARENA_LOG_LEVEL_NONE,
+    };
+
+private:
+    static inline Level runtime_level = LEVEL_INFO;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static bool is_enabled(Level level) { return level >= runtime_level; }
+    static void write(Level level, const godot::String& message);
+
+    static void set_level(Level level) { runtime_level = level; }
+    static Level get_level() { return runtime_level; }
+    static int get_compiled_level() { return AGENT_ARENA_LOG_LEVEL; }
+
+    static void set_console_output(bool enabled);
+    static bool get_console_output();
+    static void set_rate_limit(int messages_per_second);  // 0 = unlimited
+    static int get_rate_limit();
+    static void set_history_capacity(int capacity);
+    static int get_history_capacity();
+
+    // Oldest first: [{time_msec, level, message}]; limit < 0 = all retained
+    static godot::Array get_recent(int limit = -1);
+    static int64_t get_suppressed_count();
+    static void clear_history();
+};
+
+} // namespace agent_arena
+
+VARIANT_ENUM_CAST(agent_arena::ArenaLog::Level);
+
+#define ARENA_LOG(level, ...)                                                                 \
+    do {                                                                                      \
+        if (::agent_arena::ArenaLog::is_enabled(level)) {                                     \
+            ::agent_arena::ArenaLog::write(level, ::godot::UtilityFunctions::str(__VA_ARGS__)); \
+        }                                                                                     \
+    } while (0)
+
+#if AGENT_ARENA_LOG_LEVEL <= AGENT_ARENA_LOG_LEVEL_TRACE
+#define ARENA_LOG_TRACE(...) ARENA_LOG(::agent_arena::ArenaLog::LEVEL_TRACE, __VA_ARGS__)
+#else
+#define ARENA_LOG_TRACE(...) ((void)0)
+#endif
+
+#if AGENT_ARENA_LOG_LEVEL <= AGENT_ARENA_LOG_LEVEL_DEBUG
+#define ARENA_LOG_DEBUG(...) ARENA_LOG(::agent_arena::ArenaLog::LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define ARENA_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if AGENT_ARENA_LOG_LEVEL <= AGENT_ARENA_LOG_LEVEL_INFO
+#define ARENA_LOG_INFO(...) ARENA_LOG(::agent_arena::ArenaLog::LEVEL_INFO, __VA_ARGS__)
+#else
+#define ARENA_LOG_INFO(...) ((void)0)
+#endif
+
+#if AGENT_ARENA_LOG_LEVEL <= AGENT_ARENA_LOG_LEVEL_WARN
+#define ARENA_LOG_WARN(...) ARENA_LOG(::agent_arena::ArenaLog::LEVEL_WARN, __VA_ARGS__)
+#else
+#define ARENA_LOG_WARN(...) ((void)0)
+#endif
+
+#if AGENT_ARENA_LOG_LEVEL <= AGENT_ARENA_LOG_LEVEL_ERROR
+#define ARENA_LOG_ERROR(...) ARENA_LOG(::agent_arena::ArenaLog::LEVEL_ERROR, __VA_ARGS__)
+#else
+#define ARENA_LOG_ERROR(...) ((void)0)
+#endif
+
+#endif // AGENT_ARENA_ARENA_LOG_H
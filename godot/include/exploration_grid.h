@@ -0,0 +1,164 @@
+#ifndef AGENT_ARENA_EXPLORATION_GRID_H
+#define AGENT_ARENA_EXPLORATION_GRID_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Seen/unseen cells over the XZ plane, one packed bitset per layer.
+ *
+ * A layer is a caller-chosen integer (0 = shared, or one per team/agent).
+ * Rows are 64-cell words, so marking a perception disk is a few masked ORs
+ * per row and newly seen cells are counted with popcount. reveal() also
+ * remembers each viewer's previous disk and only touches the part it has
+ * newly entered. Frontier cells (seen, with an unseen 4-neighbour) are
+ * rebuilt word-parallel only after something new was seen, and queried in
+ * place. Cell (x, z) covers [x * cell_size, (x + 1) * cell_size) and is in
+ * bounds when its corner lies inside the world bounds, as in
+ * VisibilityTracker.
+ */
+class ExplorationGrid : public godot::RefCounted {
+    GDCLASS(ExplorationGrid, godot::RefCounted)
+
+public:
+    enum Direction {
+        DIRECTION_EAST,
+        DIRECTION_NORTHEAST,
+        DIRECTION_NORTH,
+        DIRECTION_NORTHWEST,
+        DIRECTION_WEST,
+        DIRECTION_SOUTHWEST,
+        DIRECTION_SOUTH,
+        DIRECTION_SOUTHEAST,
+        DIRECTION_COUNT,
+    };
+
+private:
+    struct Layer {
+        std::vector<uint64_t> seen;
+        std::vector<uint64_t> frontier;
+        int64_t seen_count = 0;
+        int64_t frontier_count = 0;
+        bool frontier_dirty = true;
+    };
+
+    // Last disk a viewer revealed; every cell in it is already seen
+    struct Viewer {
+        int layer;
+        godot::Vector3 position;
+        double radius;
+    };
+
+    double cell_size;
+    godot::Vector2 world_min;
+    godot::Vector2 world_max;
+
+    int32_t min_cell_x;
+    int32_t min_cell_z;
+    int32_t width;   // Cells per row
+    int32_t height;  // Rows
+    int32_t words_per_row;
+
+    mutable godot::HashMap<int, Layer> layers;  // Frontiers are rebuilt lazily by const queries
+    godot::HashMap<int64_t, Viewer> viewers;
+
+    void _rebuild();
+    Layer& _layer(int layer);
+    const Layer* _find_layer(int layer) const { return layers.getptr(layer); }
+    bool _row_span(const godot::Vector3& position, double radius, int32_t row, int32_t& r_first, int32_t& r_last) const;
+    int64_t _mark_span(Layer& layer, int32_t row, int32_t first, int32_t last);
+    void _update_frontier(Layer& layer) const;
+    const Layer* _frontier_layer(int layer) const;
+
+    godot::Vector3 _cell_center(int32_t x, int32_t z) const;
+    int32_t _world_to_cell(double v) const;
+
+    template <typename F>
+    void _for_each_frontier(const Layer& layer, F&& visit) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    ExplorationGrid();
+    ~ExplorationGrid();
+
+    void set_world_bounds(const godot::Vector2& min_pos, const godot::Vector2& max_pos);
+    godot::Vector2 get_world_min() const { return world_min; }
+    godot::Vector2 get_world_max() const { return world_max; }
+    void set_cell_size(double size);
+    double get_cell_size() const { return cell_size; }
+
+    godot::Vector2i get_min_cell() const { return godot::Vector2i(min_cell_x, min_cell_z); }
+    godot::Vector2i get_grid_size() const { return godot::Vector2i(width, height); }
+    int64_t get_total_cells() const { return (int64_t)width * (int64_t)height; }
+    bool is_cell_in_bounds(int x, int z) const {
+        return x >= min_cell_x && x < min_cell_x + width && z >= min_cell_z && z < min_cell_z + height;
+    }
+
+    // Marks every in-bounds cell whose centre is within radius of position;
+    // returns how many were newly seen. viewer_id < 0 disables the
+    // incremental path (nothing is remembered).
+    int64_t reveal(int layer, int64_t viewer_id, const godot::Vector3& position, double radius);
+
+    // For callers that filter by line of sight first: the unseen cells in the
+    // disk as interleaved (x, z) pairs, and marking an (x, z) list as seen
+    godot::PackedInt32Array collect_unseen(int layer, const godot::Vector3& position, double radius) const;
+    int64_t mark_cells(int layer, const godot::PackedInt32Array& cells);
+
+    bool is_cell_seen(int layer, int x, int z) const;
+    bool is_position_seen(int layer, const godot::Vector3& position) const;
+    int64_t get_seen_count(int layer) const;
+    double get_exploration_percentage(int layer) const;
+
+    // Frontier queries
+    bool is_frontier_cell(int layer, int x, int z) const;
+    int64_t get_frontier_count(int layer) const;
+    godot::PackedInt32Array get_frontier_cells(int layer) const;  // Interleaved (x, z)
+
+    // C++ access to the frontier bitset: height rows of words_per_row words,
+    // bit (x - min_cell.x) of row (z - min_cell.z); nullptr for an unknown layer
+    const std::vector<uint64_t>* get_frontier_bits(int layer) const;
+    int get_words_per_row() const { return words_per_row; }
+
+    // {success, has_unexplored, position: [x, y, z], distance} for the
+    // nearest frontier cell in one of the eight compass directions
+    godot::Dictionary find_frontier(int layer, const godot::Vector3& from, const godot::String& direction) const;
+
+    // {exploration_percentage, total_cells, seen_cells,
+    //  frontiers_by_direction: {direction: distance},
+    //  explore_targets: [{direction, distance, position}] nearest first}
+    godot::Dictionary get_summary(int layer, const godot::Vector3& from, int max_targets = 5) const;
+
+    static Direction direction_between(const godot::Vector3& from, const godot::Vector3& to);
+    static godot::String direction_name(Direction direction);
+
+    // Seen bits of every layer plus each viewer's last disk as one raw blob,
+    // for SimulationManager snapshots. restore_state() returns false and
+    // leaves the grid untouched if the blob was taken with other bounds.
+    godot::PackedByteArray capture_state() const;
+    bool restore_state(const godot::PackedByteArray& state);
+
+    void clear_layer(int layer);
+    void forget_viewer(int64_t viewer_id) { viewers.erase(viewer_id); }
+    void clear();
+    int get_layer_count() const { return layers.size(); }
+};
+
+} // namespace agent_arena
+
+VARIANT_ENUM_CAST(agent_arena::ExplorationGrid::Direction);
+
+#endif // AGENT_ARENA_EXPLORATION_GRID_H
@@ -0,0 +1,64 @@
+#ifndef AGENT_ARENA_JSON_READER_H
+#define AGENT_ARENA_JSON_READER_H
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace agent_arena {
+
+/**
+ * JSON decoder for HTTP response bodies that reads the raw bytes in place.
+ *
+ * Godot's JSON class wants a String, so every response was first copied
+ * into one (a UTF-8 decode of the whole body) and then parsed by a freshly
+ * allocated parser. JsonReader walks the PackedByteArray directly, building
+ * the Variant tree in the same pass; only individual string values are
+ * decoded. One reader is kept per IPCClient and reused: escaped strings are
+ * unescaped into a scratch buffer, and object keys (the same few dozen in
+ * every tick response) are interned so each is decoded once.
+ *
+ * Integer literals become INT (as from MessagePack), others FLOAT.
+ */
+class JsonReader {
+public:
+    JsonReader();
+
+    // Decode one JSON document (surrounding whitespace allowed); returns
+    // false on malformed input, with get_error() saying where
+    bool parse(const uint8_t* data, size_t size, godot::Variant& r_value);
+    bool parse(const godot::PackedByteArray& bytes, godot::Variant& r_value);
+
+    const godot::String& get_error() const { return error; }
+    size_t get_cached_key_count() const { return keys.size(); }
+    void clear_cache() { keys.clear(); }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    godot::String error;
+
+    std::string scratch;     // Unescaped string bytes
+    std::string key_buffer;  // Lookup key for the intern table
+    std::unordered_map<std::string, godot::String> keys;
+
+    bool _fail(const char* message);
+    void _skip_whitespace();
+    bool _read_value(godot::Variant& r_value, int depth);
+    bool _read_object(godot::Variant& r_value, int depth);
+    bool _read_array(godot::Variant& r_value, int depth);
+    bool _read_string_bytes(const char*& r_start, size_t& r_length);
+    bool _read_string(godot::String& r_value);
+    bool _read_key(godot::String& r_value);
+    bool _read_number(godot::Variant& r_value);
+    bool _read_literal(const char* literal, size_t length);
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_JSON_READER_H
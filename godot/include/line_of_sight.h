@@ -0,0 +1,134 @@
+#ifndef AGENT_ARENA_LINE_OF_SIGHT_H
+#define AGENT_ARENA_LINE_OF_SIGHT_H
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/physics_direct_space_state3d.hpp>
+#include <godot_cpp/classes/physics_ray_query_parameters3d.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+
+namespace agent_arena {
+
+/**
+ * Batched line-of-sight raycasts against the 3D physics space.
+ *
+ * Callers pass a tick's (viewer, target) pairs in one or more calls between
+ * begin_tick() calls. Results are cached per entity pair and reused while
+ * neither endpoint has moved more than move_tolerance, so static pairs cost
+ * no raycast after the first tick. begin_tick() drops pairs that no call
+ * used during the previous tick, once the cache has outgrown the working set.
+ * With symmetric_pairs enabled, A->B and B->A share one cache entry, but
+ * only where the two rays really are the same: eye_height equals
+ * target_height and the pair has no target collider. Other pairs keep
+ * directional entries.
+ * Obstacles are assumed static; call invalidate() after moving them.
+ */
+class LineOfSight : public godot::Node3D {
+    GDCLASS(LineOfSight, godot::Node3D)
+
+private:
+    // Full entity ids; shared marks an order-normalized symmetric entry
+    struct PairKey {
+        int64_t from_id;
+        int64_t to_id;
+        bool shared;
+
+        bool operator==(const PairKey& other) const {
+            return from_id == other.from_id && to_id == other.to_id && shared == other.shared;
+        }
+    };
+
+    struct PairKeyHasher {
+        static uint32_t hash(const PairKey& key) {
+            uint32_t h = godot::hash_murmur3_one_64((uint64_t)key.from_id);
+            h = godot::hash_murmur3_one_64((uint64_t)key.to_id, h);
+            h = godot::hash_murmur3_one_32(key.shared ? 1 : 0, h);
+            return godot::hash_fmix32(h);
+        }
+    };
+
+    struct CacheEntry {
+        godot::Vector3 from;
+        godot::Vector3 to;
+        bool visible;
+        uint64_t generation;  // Last tick that used this entry
+    };
+
+    uint32_t collision_mask;
+    double eye_height;        // Added to the viewer position
+    double target_height;     // Added to the target position
+    double move_tolerance;
+    bool symmetric_pairs;
+    bool cache_enabled;
+
+    godot::HashMap<PairKey, CacheEntry, PairKeyHasher> cache;
+    uint64_t generation;  // Advanced by begin_tick()
+    godot::Ref<godot::PhysicsRayQueryParameters3D> query;
+
+    int64_t pairs_this_tick;
+    int64_t raycasts_last_batch;   // Since the last begin_tick()
+    int64_t cache_hits_last_batch;
+
+    PairKey _pair_key(int64_t from_id, int64_t to_id, bool shared) const;
+    bool _cast(godot::PhysicsDirectSpaceState3D* space_state, const godot::Vector3& from,
+               const godot::Vector3& to, int64_t target_instance_id);
+    void _prune_cache(int64_t working_set);
+
+protected:
+    static void _bind_methods();
+
+public:
+    LineOfSight();
+    ~LineOfSight();
+
+    // Call once per simulation tick, before that tick's queries
+    void begin_tick();
+
+    // One result byte (1 = visible) per pair; all arrays are pair-parallel.
+    // exclude_rids may be empty; target_instance_ids may be empty or use 0
+    // for "no target collider" (hitting the target itself counts as visible).
+    godot::PackedByteArray check_pairs(const godot::PackedInt64Array& from_ids,
+                                       const godot::PackedVector3Array& from_positions,
+                                       const godot::PackedInt64Array& to_ids,
+                                       const godot::PackedVector3Array& to_positions,
+                                       const godot::Array& exclude_rids,
+                                       const godot::PackedInt64Array& target_instance_ids);
+
+    // One viewer against many targets
+    godot::PackedByteArray check_targets(int64_t from_id, const godot::Vector3& from_position,
+                                         const godot::RID& exclude_rid,
+                                         const godot::PackedInt64Array& to_ids,
+                                         const godot::PackedVector3Array& to_positions,
+                                         const godot::PackedInt64Array& target_instance_ids);
+
+    void invalidate();
+    int get_cache_size() const { return cache.size(); }
+    int64_t get_raycasts_last_batch() const { return raycasts_last_batch; }
+    int64_t get_cache_hits_last_batch() const { return cache_hits_last_batch; }
+
+    void set_collision_mask(int mask) { collision_mask = (uint32_t)mask; }
+    int get_collision_mask() const { return (int)collision_mask; }
+    void set_eye_height(double height) { eye_height = height; }
+    double get_eye_height() const { return eye_height; }
+    void set_target_height(double height) { target_height = height; }
+    double get_target_height() const { return target_height; }
+    void set_move_tolerance(double tolerance);
+    double get_move_tolerance() const { return move_tolerance; }
+    void set_symmetric_pairs(bool enabled);
+    bool get_symmetric_pairs() const { return symmetric_pairs; }
+    void set_cache_enabled(bool enabled);
+    bool get_cache_enabled() const { return cache_enabled; }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_LINE_OF_SIGHT_H
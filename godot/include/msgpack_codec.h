@@ -0,0 +1,46 @@
+#ifndef AGENT_ARENA_MSGPACK_CODEC_H
+#define AGENT_ARENA_MSGPACK_CODEC_H
+
+#include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Compact MessagePack encoder/decoder for the binary IPC transport.
+ *
+ * Covers the subset of Variant used in observations and actions:
+ * nil, bool, int, float, String/StringName, Array, Dictionary and
+ * PackedByteArray (as bin). Vector2/Vector3 and packed numeric arrays are
+ * written as plain arrays so the Python side sees the same shape it gets
+ * from JSON today. Anything else is written as its string form.
+ */
+class MsgPackCodec {
+public:
+    // Append the encoding of value to out (out is not cleared)
+    static void encode(const godot::Variant& value, std::vector<uint8_t>& out);
+    static godot::PackedByteArray encode(const godot::Variant& value);
+
+    // Decode a single value; returns false on malformed or truncated input
+    static bool decode(const uint8_t* data, size_t size, godot::Variant& r_value, size_t* r_consumed = nullptr);
+    static bool decode(const godot::PackedByteArray& bytes, godot::Variant& r_value);
+
+    // Low-level writers for callers that stream a fixed layout directly
+    // (ObservationBuilder, IPCClient tick frames) instead of building Variants
+    static void write_map_header(std::vector<uint8_t>& out, uint32_t count);
+    static void write_array_header(std::vector<uint8_t>& out, uint32_t count);
+    static void write_str(std::vector<uint8_t>& out, const godot::String& value);
+    static void write_int(std::vector<uint8_t>& out, int64_t value);
+    static void write_double(std::vector<uint8_t>& out, double value);
+    static void write_vector3(std::vector<uint8_t>& out, const godot::Vector3& value);
+    static void write_nil(std::vector<uint8_t>& out);
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_MSGPACK_CODEC_H
@@ -0,0 +1,193 @@
+#ifndef AGENT_ARENA_OBSERVATION_BUILDER_H
+#define AGENT_ARENA_OBSERVATION_BUILDER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+class Agent;
+
+/**
+ * Writes per-agent observations straight into packed MessagePack buffers.
+ *
+ * Each agent owns a slot whose byte buffers are cleared, not freed, at the
+ * start of every tick, so steady-state building allocates nothing. The
+ * assembled buffer is a MessagePack map carrying "schema_version" plus the
+ * same keys the backend's Observation.from_dict reads, which lets
+ * IPCClient splice it into a stream frame without re-encoding.
+ *
+ * For the stream transport the builder can also encode each observation as
+ * a delta against what it last sent for that agent: only changed self
+ * fields, a quantised position step, added/changed/removed entities (by
+ * name) and changed extra fields. A delta names the tick it builds on
+ * ("base_tick"); a full observation is sent as a keyframe when there is no
+ * base, every keyframe_interval ticks, or after request_keyframe().
+ *
+ * get_fingerprint() hashes a quantised, order-independent view of the
+ * observation (position cell, health in 5% steps, each entity's kind, name,
+ * type and cell, and the extra fields not listed in
+ * fingerprint_ignored_fields), so IPCClient can tell when an agent's
+ * situation hasn't meaningfully changed.
+ */
+class ObservationBuilder : public godot::RefCounted {
+    GDCLASS(ObservationBuilder, godot::RefCounted)
+
+public:
+    static constexpr int SCHEMA_VERSION = 1;
+    static constexpr int64_t POSITION_STEPS_PER_UNIT = 1024;  // Delta position quantum (~1 mm)
+
+    enum EntityKind {
+        KIND_RESOURCE,
+        KIND_HAZARD,
+        KIND_STATION,
+        KIND_AGENT,
+        KIND_COUNT,
+    };
+
+private:
+    struct EntityState {
+        godot::String name;
+        godot::String type;
+        godot::Vector3 position;
+        double distance;
+    };
+
+    // An extra field's encoded value within AgentSlot::extras
+    struct ExtraRange {
+        godot::String key;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    // What the backend holds for an agent after the last delta/keyframe
+    struct SentState {
+        bool valid = false;
+        int64_t tick = -1;
+        int64_t keyframe_tick = -1;
+        int64_t position_steps[3] = {};
+        double health = 0.0;
+        double max_health = 0.0;
+        double perception_radius = 0.0;
+        std::vector<EntityState> entities[KIND_COUNT];  // In sent order
+        godot::HashMap<godot::String, std::vector<uint8_t>> extras;
+    };
+
+    struct AgentSlot {
+        int64_t tick = -1;  // Tick being built, -1 before the first begin_agent()
+        godot::Vector3 position;
+        double health = 100.0;
+        double max_health = 100.0;
+        double perception_radius = 0.0;
+
+        // Encoded entity maps per kind, and encoded key/value pairs for extras
+        std::vector<uint8_t> entities[KIND_COUNT];
+        uint32_t entity_counts[KIND_COUNT] = {};
+        std::vector<uint8_t> extras;
+        uint32_t extra_count = 0;
+
+        // The same entities and extras, structured for delta encoding
+        std::vector<EntityState> entity_states[KIND_COUNT];
+        std::vector<ExtraRange> extra_ranges;
+
+        std::vector<uint8_t> buffer;  // Assembled observation
+        bool dirty = true;            // buffer is out of date
+
+        uint64_t fingerprint = 0;
+        bool fingerprint_dirty = true;
+
+        SentState sent;
+        std::vector<uint8_t> delta_buffer;
+        int64_t delta_tick = -1;  // Tick delta_buffer was encoded for
+        bool delta_is_keyframe = false;
+    };
+
+    godot::HashMap<godot::String, AgentSlot> slots;
+    godot::String current_agent;
+    AgentSlot* current;  // Slot nodes are stable across HashMap inserts
+
+    int keyframe_interval;
+    double fingerprint_cell_size;
+    godot::PackedStringArray fingerprint_ignored_fields;
+
+    // Delta encoding scratch, reused across agents
+    std::vector<uint8_t> delta_body;
+    std::vector<uint8_t> delta_entities;
+    godot::HashMap<godot::String, int> sent_index;
+    std::vector<uint8_t> sent_matched;
+    std::vector<int32_t> upserts;
+    std::vector<EntityState> next_entities;
+
+    void _assemble(AgentSlot& slot, const godot::String& agent_id);
+    void _add_extra(const godot::String& key, uint32_t value_begin);
+    void _commit_keyframe(AgentSlot& slot);
+    bool _encode_delta(AgentSlot& slot, const godot::String& agent_id);
+    uint64_t _compute_fingerprint(const AgentSlot& slot) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    ObservationBuilder();
+    ~ObservationBuilder();
+
+    // Start (or restart) an agent's observation for tick; later calls write to it
+    void begin_agent(const godot::String& agent_id, int64_t tick);
+    void set_self(const godot::Vector3& position, double health, double max_health, double perception_radius);
+    void add_entity(EntityKind kind, const godot::String& name, const godot::String& type,
+                    const godot::Vector3& position, double distance);
+
+    // Extra top-level key (exploration, tool_result, custom, ...), encoded once
+    void set_field(const godot::String& key, const godot::Variant& value);
+
+    // "memory" field encoded straight from the agent's native memory store
+    void set_memory(Agent* agent, int action_limit = -1);
+
+    // C++ access for the transport: nullptr unless built for exactly this tick
+    const std::vector<uint8_t>* get_native_buffer(const godot::String& agent_id, int64_t tick);
+
+    // Keyframe or delta against the last sent state, which it then replaces;
+    // only for ordered transports. Repeated calls for the same tick return
+    // the same bytes.
+    const std::vector<uint8_t>* get_native_delta_buffer(const godot::String& agent_id, int64_t tick);
+
+    // Next delta buffer for the agent (or every agent) is a keyframe
+    void request_keyframe(const godot::String& agent_id);
+    void reset_deltas();
+
+    void set_keyframe_interval(int ticks);  // 0 = only on request
+    int get_keyframe_interval() const { return keyframe_interval; }
+
+    // Fingerprint of the agent's observation for tick; false if none was built
+    bool get_native_fingerprint(const godot::String& agent_id, int64_t tick, uint64_t& r_fingerprint);
+    int64_t get_fingerprint(const godot::String& agent_id);  // Latest tick, 0 if none
+
+    void set_fingerprint_cell_size(double size);
+    double get_fingerprint_cell_size() const { return fingerprint_cell_size; }
+    void set_fingerprint_ignored_fields(const godot::PackedStringArray& fields);
+    godot::PackedStringArray get_fingerprint_ignored_fields() const { return fingerprint_ignored_fields; }
+
+    bool has_observation(const godot::String& agent_id, int64_t tick) const;
+    godot::PackedByteArray get_buffer(const godot::String& agent_id);
+    godot::Dictionary get_observation(const godot::String& agent_id);  // Decoded, for debugging/HTTP
+    int get_schema_version() const { return SCHEMA_VERSION; }
+    int get_agent_count() const { return slots.size(); }
+
+    void remove_agent(const godot::String& agent_id);
+    void clear();
+};
+
+} // namespace agent_arena
+
+VARIANT_ENUM_CAST(agent_arena::ObservationBuilder::EntityKind);
+
+#endif // AGENT_ARENA_OBSERVATION_BUILDER_H
@@ -0,0 +1,157 @@
+#ifndef AGENT_ARENA_PATH_PLANNER_H
+#define AGENT_ARENA_PATH_PLANNER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * A* over the world-bounds grid on the XZ plane, with a shared path cache.
+ *
+ * Cells are blocked by static obstacles (set once, e.g. rasterised from
+ * physics) and, for hazard-avoiding queries, by circular hazards. Moves are
+ * 8-connected without cutting blocked corners. Found paths are cached under
+ * (start cell, goal cell, avoid_hazards) and tagged with the epoch they were
+ * planned in; any obstacle or hazard change bumps the epoch, so stale
+ * entries are simply replanned (paths that ignore hazards only go stale
+ * when obstacles change). Agents heading for the same resource from
+ * the same cell share one search. Search scratch is reused between queries.
+ */
+class PathPlanner : public godot::RefCounted {
+    GDCLASS(PathPlanner, godot::RefCounted)
+
+public:
+    struct Result {
+        bool success = false;
+        bool cached = false;
+        double distance = 0.0;
+        std::vector<godot::Vector3> waypoints;  // Start and target included
+    };
+
+private:
+    struct Hazard {
+        godot::Vector3 position;
+        double radius;
+    };
+
+    struct CachedPath {
+        uint64_t epoch;
+        uint64_t last_used;     // Query counter, for pruning
+        bool found;
+        std::vector<int32_t> cells;  // Turn points only, start to goal
+    };
+
+    struct OpenNode {
+        float f;
+        int32_t cell;
+    };
+
+    double cell_size;
+    godot::Vector2 world_min;
+    godot::Vector2 world_max;
+    int32_t min_cell_x;
+    int32_t min_cell_z;
+    int32_t width;
+    int32_t height;
+
+    std::vector<uint8_t> obstacles;       // 1 = blocked
+    std::vector<uint16_t> hazard_cover;   // Hazards covering each cell
+    godot::HashMap<int64_t, Hazard> hazards;
+    uint64_t epoch;           // Bumped by every obstacle or hazard change
+    uint64_t obstacle_epoch;  // epoch at the last obstacle change
+
+    godot::HashMap<uint64_t, CachedPath> cache;
+    int max_cached_paths;
+    bool cache_enabled;
+    uint64_t query_counter;
+
+    // Search scratch; a cell's g/parent are valid when its stamp matches
+    std::vector<float> g_cost;
+    std::vector<int32_t> parent;
+    std::vector<uint32_t> visit_stamp;
+    std::vector<uint32_t> closed_stamp;
+    std::vector<OpenNode> open_heap;
+    std::vector<int32_t> trace;
+    uint32_t search_stamp;
+
+    int64_t cache_hits;
+    int64_t cache_misses;
+    int64_t nodes_expanded;
+
+    void _rebuild();
+    void _cover_hazard(const Hazard& hazard, int delta);
+    bool _to_cell(const godot::Vector3& position, int32_t& r_x, int32_t& r_z) const;
+    int32_t _index(int32_t x, int32_t z) const { return (z - min_cell_z) * width + (x - min_cell_x); }
+    godot::Vector3 _index_center(int32_t index, double y) const;
+    bool _passable(int32_t index, bool avoid_hazards) const;
+    bool _search(int32_t start, int32_t goal, bool avoid_hazards, std::vector<int32_t>& r_cells);
+    void _prune_cache();
+
+protected:
+    static void _bind_methods();
+
+public:
+    PathPlanner();
+    ~PathPlanner();
+
+    void set_world_bounds(const godot::Vector2& min_pos, const godot::Vector2& max_pos);
+    godot::Vector2 get_world_min() const { return world_min; }
+    godot::Vector2 get_world_max() const { return world_max; }
+    void set_cell_size(double size);
+    double get_cell_size() const { return cell_size; }
+    godot::Vector2i get_min_cell() const { return godot::Vector2i(min_cell_x, min_cell_z); }
+    godot::Vector2i get_grid_size() const { return godot::Vector2i(width, height); }
+
+    // Static obstacles
+    void set_cell_blocked(int x, int z, bool blocked);
+    bool is_cell_blocked(int x, int z) const;
+    void set_blocked_cells(const godot::PackedByteArray& blocked);  // Row-major, width * height
+    void clear_obstacles();
+
+    // Hazards (caller-chosen ids); each change bumps the epoch
+    void set_hazard(int64_t id, const godot::Vector3& position, double radius);
+    void remove_hazard(int64_t id);
+    void clear_hazards();
+    int get_hazard_count() const { return hazards.size(); }
+    int64_t get_epoch() const { return (int64_t)epoch; }
+
+    // C++ query
+    void plan_native(const godot::Vector3& from, const godot::Vector3& to, bool avoid_hazards, Result& r_result);
+
+    // {success, blocked, waypoints: [[x, y, z], ...], distance, avoid_hazards, cached, reason}
+    godot::Dictionary plan_path(const godot::Vector3& from, const godot::Vector3& to, bool avoid_hazards = true);
+
+    // One query per (from, to) pair, packed CSR-style:
+    // {offsets: PackedInt32Array (pairs + 1), waypoints: PackedVector3Array,
+    //  distances: PackedFloat32Array, success: PackedByteArray};
+    // pair i's path is waypoints[offsets[i] .. offsets[i + 1])
+    godot::Dictionary plan_paths(const godot::PackedVector3Array& from, const godot::PackedVector3Array& to,
+                                 bool avoid_hazards = true);
+
+    void set_cache_enabled(bool enabled);
+    bool get_cache_enabled() const { return cache_enabled; }
+    void set_max_cached_paths(int count);
+    int get_max_cached_paths() const { return max_cached_paths; }
+    int get_cache_size() const { return cache.size(); }
+    void clear_cache() { cache.clear(); }
+
+    // {cache_hits, cache_misses, nodes_expanded} since the last reset
+    godot::Dictionary get_stats() const;
+    void reset_stats();
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_PATH_PLANNER_H
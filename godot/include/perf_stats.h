@@ -0,0 +1,190 @@
+#ifndef AGENT_ARENA_PERF_STATS_H
+#define AGENT_ARENA_PERF_STATS_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Process-wide timings and counters for each phase of a tick.
+ *
+ * Durations land in fixed log2 microsecond histograms, so recording is a
+ * handful of integer ops and never allocates. While a trace is running,
+ * every span is also kept (up to a cap) for export as Chrome trace JSON,
+ * which chrome://tracing and Perfetto both open. Everything runs on the
+ * main thread, like the rest of the extension.
+ */
+class PerfStats {
+public:
+    enum Phase {
+        PHASE_TICK,               // step_simulation(), including every tick_advanced handler
+        PHASE_OBSERVATION_BUILD,  // ObservationBuilder buffer assembly
+        PHASE_SERIALIZE,          // Encoding a tick request (JSON or MessagePack)
+        PHASE_IPC_SEND,           // Handing a request to HTTPRequest or the stream
+        PHASE_BACKEND_WAIT,       // Tick request sent -> response arrived
+        PHASE_RESPONSE_PARSE,     // Decoding a tick response
+        PHASE_ACTION_EXECUTE,     // Routing a response's actions to agents
+        PHASE_TOOL_LATENCY,       // Tool call queued -> resolved
+        PHASE_COUNT,
+    };
+
+    enum Counter {
+        COUNTER_TICK_REQUESTS,
+        COUNTER_TICK_RESPONSES,
+        COUNTER_TICKS_SKIPPED,   // Pipeline full or no slot
+        COUNTER_TOOL_REQUESTS,
+        COUNTER_TOOL_TIMEOUTS,
+        COUNTER_LOCAL_TOOL_CALLS,
+        COUNTER_BYTES_SENT,      // Tick request payloads
+        COUNTER_OBSERVATION_KEYFRAMES,  // Full observations sent on a delta-capable transport
+        COUNTER_OBSERVATION_DELTAS,
+        COUNTER_DECISION_CACHE_HITS,  // Agents left out of a tick request by the decision cache
+        COUNTER_RECONNECT_ATTEMPTS,
+        COUNTER_STALE_RESPONSES,      // Tick responses whose actions arrived too late to apply
+        COUNTER_TOOL_REQUESTS_REJECTED,  // Tool calls refused because the queue was full
+        COUNTER_DECISIONS_DEFERRED,   // Due agents left out of a tick request by the per-tick budget
+        COUNTER_DECISIONS_THROTTLED,  // Agents not yet due by their decision interval
+        COUNTER_COUNT,
+    };
+
+    static constexpr int BUCKET_COUNT = 32;  // Bucket i counts durations in [2^i, 2^(i+1)) us
+
+    struct Histogram {
+        uint64_t count = 0;
+        uint64_t total_usec = 0;
+        uint64_t min_usec = 0;
+        uint64_t max_usec = 0;
+        uint64_t last_usec = 0;
+        uint64_t buckets[BUCKET_COUNT] = {};
+
+        void record(uint64_t usec);
+        uint64_t percentile(double fraction) const;  // Upper bound of the bucket holding it
+        double mean_usec() const { return count ? (double)total_usec / (double)count : 0.0; }
+    };
+
+    static PerfStats& get();
+
+    static uint64_t now_usec() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void set_enabled(bool p_enabled) { enabled = p_enabled; }
+    bool is_enabled() const { return enabled; }
+
+    void record_span(Phase phase, uint64_t start_usec, uint64_t end_usec);
+    void add(Counter counter, uint64_t amount = 1) {
+        if (enabled) counters[counter] += amount;
+    }
+    void set_tool_queue_depth(int depth);
+
+    const Histogram& get_histogram(Phase phase) const { return histograms[phase]; }
+    uint64_t get_counter(Counter counter) const { return counters[counter]; }
+    int get_tool_queue_depth() const { return tool_queue_depth; }
+    void reset();
+
+    // {phases: {name: {count, mean_ms, min_ms, max_ms, p50_ms, p95_ms, p99_ms}},
+    //  counters: {name: n}, tool_queue_depth, peak_tool_queue_depth}
+    godot::Dictionary to_dictionary() const;
+
+    void start_trace(int max_events);
+    void stop_trace() { tracing = false; }
+    bool is_tracing() const { return tracing; }
+    int get_trace_event_count() const { return (int)trace_events.size(); }
+    godot::String export_trace_json() const;
+
+    static const char* phase_name(Phase phase);
+    static const char* counter_name(Counter counter);
+
+private:
+    struct TraceEvent {
+        uint64_t start_usec;
+        uint64_t duration_usec;
+        Phase phase;
+    };
+
+    PerfStats();
+
+    bool enabled;
+    Histogram histograms[PHASE_COUNT];
+    uint64_t counters[COUNTER_COUNT];
+    int tool_queue_depth;
+    int peak_tool_queue_depth;
+
+    bool tracing;
+    size_t trace_capacity;
+    uint64_t trace_origin_usec;
+    std::vector<TraceEvent> trace_events;
+};
+
+/**
+ * Records the enclosing scope's duration against a phase.
+ */
+class ScopedPerfTimer {
+public:
+    explicit ScopedPerfTimer(PerfStats::Phase p_phase) : phase(p_phase), start_usec(PerfStats::now_usec()) {}
+    ~ScopedPerfTimer() { PerfStats::get().record_span(phase, start_usec, PerfStats::now_usec()); }
+
+    ScopedPerfTimer(const ScopedPerfTimer&) = delete;
+    ScopedPerfTimer& operator=(const ScopedPerfTimer&) = delete;
+
+private:
+    PerfStats::Phase phase;
+    uint64_t start_usec;
+};
+
+/**
+ * Scene-side view of PerfStats.
+ *
+ * Registers "agent_arena/*" custom monitors in the editor's Debugger >
+ * Monitors tab while in the tree (last duration per phase in ms, plus the
+ * tool queue depth), and exposes the aggregated stats and trace export.
+ */
+class PerfMonitor : public godot::Node {
+    GDCLASS(PerfMonitor, godot::Node)
+
+private:
+    bool register_monitors;
+    bool monitors_registered;
+
+    void _add_monitors();
+    void _remove_monitors();
+
+protected:
+    static void _bind_methods();
+
+public:
+    PerfMonitor();
+    ~PerfMonitor();
+
+    void _enter_tree() override;
+    void _exit_tree() override;
+
+    godot::Dictionary get_perf_stats() const { return PerfStats::get().to_dictionary(); }
+    void reset_perf_stats() { PerfStats::get().reset(); }
+    void set_stats_enabled(bool enabled) { PerfStats::get().set_enabled(enabled); }
+    bool get_stats_enabled() const { return PerfStats::get().is_enabled(); }
+
+    void start_trace(int max_events = 200000) { PerfStats::get().start_trace(max_events); }
+    void stop_trace() { PerfStats::get().stop_trace(); }
+    bool is_tracing() const { return PerfStats::get().is_tracing(); }
+    int get_trace_event_count() const { return PerfStats::get().get_trace_event_count(); }
+    godot::Error export_trace(const godot::String& path) const;
+
+    void set_register_monitors(bool enabled);
+    bool get_register_monitors() const { return register_monitors; }
+
+    double _monitor_phase(int phase) const;
+    int _monitor_tool_queue_depth() const { return PerfStats::get().get_tool_queue_depth(); }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_PERF_STATS_H
@@ -0,0 +1,91 @@
+#ifndef AGENT_ARENA_RANDOM_STREAM_H
+#define AGENT_ARENA_RANDOM_STREAM_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+
+namespace agent_arena {
+
+/**
+ * Deterministic, splittable PRNG stream (xoshiro256**, seeded via SplitMix64).
+ *
+ * SimulationManager owns the master seed and hands out one named stream per
+ * subsystem or agent via get_stream(); each stream's sequence depends only
+ * on (master seed, name), so adding a consumer never perturbs the others.
+ * The next_* methods are inline for use from C++ hot paths.
+ */
+class RandomStream : public godot::RefCounted {
+    GDCLASS(RandomStream, godot::RefCounted)
+
+private:
+    uint64_t state[4];
+    uint64_t stream_seed;
+
+    static uint64_t _rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+protected:
+    static void _bind_methods();
+
+public:
+    RandomStream();
+
+    // SplitMix64 step, also used to derive stream seeds
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Stable 64-bit FNV-1a of the UTF-8 name (independent of String::hash)
+    static uint64_t hash_name(const godot::String& name);
+    static uint64_t derive_seed(uint64_t master_seed, const godot::String& name);
+
+    void set_seed(uint64_t seed);
+    uint64_t get_seed() const { return stream_seed; }
+
+    // Raw generator state, for SimulationManager snapshots
+    void get_state(uint64_t r_state[4]) const {
+        for (int i = 0; i < 4; i++) {
+            r_state[i] = state[i];
+        }
+    }
+    void set_state(uint64_t seed, const uint64_t p_state[4]) {
+        stream_seed = seed;
+        for (int i = 0; i < 4; i++) {
+            state[i] = p_state[i];
+        }
+    }
+
+    uint64_t next_u64() {
+        const uint64_t result = _rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = _rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1) with 53 bits of precision
+    double next_double() { return (double)(next_u64() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Uniform integer in [0, bound) without modulo bias (rejection sampling)
+    uint64_t next_bounded(uint64_t bound);
+
+    // GDScript-facing API (mirrors RandomNumberGenerator naming)
+    int64_t randi();
+    double randf() { return next_double(); }
+    int64_t randi_range(int64_t from, int64_t to);
+    double randf_range(double from, double to) { return from + (to - from) * next_double(); }
+    double randfn(double mean = 0.0, double deviation = 1.0);
+    godot::Ref<RandomStream> fork(const godot::String& name) const;
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_RANDOM_STREAM_H
@@ -0,0 +1,144 @@
+#ifndef AGENT_ARENA_REPLAY_LOG_H
+#define AGENT_ARENA_REPLAY_LOG_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * On-disk replay log layout shared by ReplayWriter and ReplayReader.
+ *
+ * File:  [u32 FILE_MAGIC][u32 VERSION] followed by chunks, append-only.
+ * Chunk: [u32 CHUNK_MAGIC][u64 first_tick][u64 last_tick][u32 event_count]
+ *        [u32 compression][u32 raw_size][u32 stored_size][payload]
+ *
+ * The payload is event_count MessagePack values, each [tick, type, data],
+ * optionally zstd-compressed. Within a chunk ticks never decrease, and a
+ * tick never spans two chunks except at a rewind: EventBus::rewind_events
+ * closes the current chunk, and the next one starts again at the rewind
+ * tick, so later chunks may cover ticks already written (the abandoned
+ * branch stays in the file). All integers are little-endian.
+ */
+namespace replay_format {
+    constexpr uint32_t FILE_MAGIC = 0x50524141;   // "AARP"
+    constexpr uint32_t CHUNK_MAGIC = 0x4B4E4843;  // "CHNK"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t COMPRESSION_NONE = 0;
+    constexpr uint32_t COMPRESSION_ZSTD = 1;
+    constexpr uint32_t CHUNK_HEADER_SIZE = 4 + 8 + 8 + 4 + 4 + 4 + 4;
+}
+
+/**
+ * Incremental chunked writer used by EventBus while recording to disk.
+ *
+ * Events are encoded as they arrive and written out as one chunk once
+ * chunk_event_limit events have accumulated and the tick changes, so memory
+ * use is bounded by a single chunk regardless of recording length.
+ */
+class ReplayWriter {
+public:
+    ReplayWriter();
+    ~ReplayWriter();
+
+    godot::Error open(const godot::String& path, bool compress);
+    void close();
+    bool is_open() const { return file.is_valid(); }
+
+    // Returns true if a chunk was flushed before this event was buffered
+    bool append(uint64_t tick, const godot::String& event_type, const godot::Dictionary& data);
+    void flush_chunk();
+    // Called on rewind: the next event may be older than the last one written
+    void begin_segment() { flush_chunk(); }
+
+    void set_chunk_event_limit(int limit) { chunk_event_limit = limit < 1 ? 1 : limit; }
+    int get_chunk_event_limit() const { return chunk_event_limit; }
+    int64_t get_chunk_count() const { return chunk_count; }
+    uint64_t get_bytes_written() const { return bytes_written; }
+
+private:
+    godot::Ref<godot::FileAccess> file;
+    bool compress;
+    int chunk_event_limit;
+
+    std::vector<uint8_t> pending;
+    uint32_t pending_count;
+    uint64_t pending_first_tick;
+    uint64_t pending_last_tick;
+
+    int64_t chunk_count;
+    uint64_t bytes_written;
+};
+
+/**
+ * Seekable reader for replay logs written by EventBus::start_recording_to_file.
+ *
+ * open() scans only the chunk headers to build a tick index; chunk payloads
+ * are read and decoded on demand, and the most recently used chunk is cached
+ * so sequential playback decodes each chunk once. Range queries binary
+ * search the index while chunk ticks increase through the file; a log
+ * recorded across a rewind instead scans every chunk whose tick span
+ * overlaps the range, returning events in file order.
+ */
+class ReplayReader : public godot::RefCounted {
+    GDCLASS(ReplayReader, godot::RefCounted)
+
+private:
+    struct ChunkInfo {
+        uint64_t payload_offset;
+        uint64_t first_tick;
+        uint64_t last_tick;
+        uint32_t event_count;
+        uint32_t compression;
+        uint32_t raw_size;
+        uint32_t stored_size;
+    };
+
+    struct DecodedEvent {
+        uint64_t tick;
+        godot::Dictionary event;  // {tick, type, data}
+    };
+
+    godot::Ref<godot::FileAccess> file;
+    std::vector<ChunkInfo> chunks;
+    int64_t event_count;
+    bool monotonic;  // Every chunk starts after the previous one ends
+    uint64_t min_tick;
+    uint64_t max_tick;
+
+    int cached_chunk;
+    std::vector<DecodedEvent> cached_events;
+
+    bool _load_chunk(int index);
+
+protected:
+    static void _bind_methods();
+
+public:
+    ReplayReader();
+    ~ReplayReader();
+
+    godot::Error open(const godot::String& path);
+    void close();
+    bool is_open() const { return file.is_valid(); }
+
+    godot::Array get_events_for_tick(uint64_t tick);
+    godot::Array get_events_in_range(uint64_t from_tick, uint64_t to_tick);
+
+    int get_chunk_count() const { return (int)chunks.size(); }
+    int64_t get_event_count() const { return event_count; }
+    uint64_t get_first_tick() const { return min_tick; }
+    uint64_t get_last_tick() const { return max_tick; }
+    bool is_monotonic() const { return monotonic; }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_REPLAY_LOG_H
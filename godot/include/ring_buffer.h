@@ -0,0 +1,79 @@
+#ifndef AGENT_ARENA_RING_BUFFER_H
+#define AGENT_ARENA_RING_BUFFER_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Growable FIFO ring buffer with O(1) push_back/pop_front.
+ *
+ * Capacity is kept at a power of two so indices wrap with a mask. The buffer
+ * doubles when full and never shrinks, so steady-state use does not allocate.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t initial_capacity = 16) : head(0), count(0) {
+        size_t capacity = 1;
+        while (capacity < initial_capacity) {
+            capacity <<= 1;
+        }
+        slots.resize(capacity);
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+
+    void push_back(T value) {
+        if (count == slots.size()) {
+            _grow();
+        }
+        slots[(head + count) & (slots.size() - 1)] = std::move(value);
+        count++;
+    }
+
+    T pop_front() {
+        T value = std::move(slots[head]);
+        slots[head] = T();
+        head = (head + 1) & (slots.size() - 1);
+        count--;
+        return value;
+    }
+
+    T& front() { return slots[head]; }
+    const T& front() const { return slots[head]; }
+
+    // Element i counted from the oldest entry
+    T& operator[](size_t i) { return slots[(head + i) & (slots.size() - 1)]; }
+    const T& operator[](size_t i) const { return slots[(head + i) & (slots.size() - 1)]; }
+
+    void clear() {
+        for (size_t i = 0; i < count; i++) {
+            (*this)[i] = T();
+        }
+        head = 0;
+        count = 0;
+    }
+
+private:
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+
+    void _grow() {
+        std::vector<T> grown(slots.size() * 2);
+        for (size_t i = 0; i < count; i++) {
+            grown[i] = std::move((*this)[i]);
+        }
+        slots.swap(grown);
+        head = 0;
+    }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_RING_BUFFER_H
@@ -0,0 +1,87 @@
+#ifndef AGENT_ARENA_SPATIAL_INDEX_H
+#define AGENT_ARENA_SPATIAL_INDEX_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Uniform grid over the XZ plane for perception and proximity queries.
+ *
+ * Entities are caller-chosen integer IDs with a category bitmask (e.g.
+ * resource, hazard, agent) so one index can serve every query type. Moving
+ * an entity only touches the grid when it crosses a cell boundary. Query
+ * results are sorted by distance, then ID, so they are deterministic.
+ */
+class SpatialIndex : public godot::Node {
+    GDCLASS(SpatialIndex, godot::Node)
+
+public:
+    struct Hit {
+        int64_t id;
+        float distance;
+    };
+
+private:
+    struct Entry {
+        godot::Vector3 position;
+        uint32_t category_mask;
+        int64_t cell_key;
+        uint32_t slot;  // Index within the cell's id list
+    };
+
+    double cell_size;
+    godot::HashMap<int64_t, Entry> entities;
+    godot::HashMap<int64_t, std::vector<int64_t>> cells;
+
+    int64_t _cell_key_for(const godot::Vector3& position) const;
+    void _cell_insert(int64_t id, Entry& entry);
+    void _cell_remove(const Entry& entry);
+    void _rebuild();
+
+protected:
+    static void _bind_methods();
+
+public:
+    SpatialIndex();
+    ~SpatialIndex();
+
+    // Entity management
+    void insert(int64_t id, const godot::Vector3& position, int category_mask);
+    void update(int64_t id, const godot::Vector3& position);
+    void remove(int64_t id);
+    void clear();
+    bool has(int64_t id) const { return entities.has(id); }
+    int get_count() const { return entities.size(); }
+    godot::Vector3 get_position(int64_t id) const;
+
+    // C++ query: appends matches within radius (sorted by distance, then id)
+    void query_radius_native(const godot::Vector3& center, double radius, uint32_t category_mask,
+                             std::vector<Hit>& r_hits, int64_t exclude_id = -1) const;
+
+    // GDScript queries
+    godot::PackedInt64Array query_radius(const godot::Vector3& center, double radius, int category_mask) const;
+    godot::Dictionary query_radius_with_distance(const godot::Vector3& center, double radius, int category_mask) const;
+
+    // One query per center, packed CSR-style:
+    // {offsets: PackedInt32Array (centers + 1), ids: PackedInt64Array, distances: PackedFloat32Array};
+    // the hits for center i are ids[offsets[i] .. offsets[i + 1])
+    godot::Dictionary query_radius_batch(const godot::PackedVector3Array& centers, double radius, int category_mask) const;
+
+    void set_cell_size(double size);
+    double get_cell_size() const { return cell_size; }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_SPATIAL_INDEX_H
@@ -0,0 +1,77 @@
+#ifndef AGENT_ARENA_SPSC_QUEUE_H
+#define AGENT_ARENA_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * Capacity is rounded up to a power of two and fixed at construction, so
+ * neither side ever allocates or blocks: try_push() fails when full and
+ * try_pop() when empty. The producer only writes tail and the consumer only
+ * writes head; each sits on its own cache line.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t min_capacity = 64) : head(0), tail(0) {
+        size_t capacity = 2;
+        while (capacity < min_capacity) {
+            capacity <<= 1;
+        }
+        slots.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool try_push(T&& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[t & mask] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& r_value) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        r_value = std::move(slots[h & mask]);
+        slots[h & mask] = T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate unless called from one of the two threads with the other idle
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    size_t capacity() const { return slots.size(); }
+
+    // Only safe while neither thread is using the queue
+    void clear() {
+        T discard;
+        while (try_pop(discard)) {
+        }
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_SPSC_QUEUE_H
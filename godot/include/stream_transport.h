@@ -0,0 +1,109 @@
+#ifndef AGENT_ARENA_STREAM_TRANSPORT_H
+#define AGENT_ARENA_STREAM_TRANSPORT_H
+
+#include <godot_cpp/classes/stream_peer_tcp.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Persistent length-prefixed binary transport to the Python runtime.
+ *
+ * Keeps one TCP connection open for the whole session instead of paying
+ * HTTP request setup per tick. Each frame is a little-endian uint32 payload
+ * length followed by a MessagePack-encoded Dictionary (see MsgPackCodec).
+ * Owned and polled by IPCClient; not exposed to GDScript directly.
+ *
+ * When threaded (the default), a worker thread owns the socket: it connects,
+ * writes queued frames, reads and MessagePack-decodes incoming ones, and
+ * hands messages back through lock-free SPSC queues. The main thread then
+ * only moves an encoded frame into the outbound queue and drains decoded
+ * messages in poll(), so large responses never stall a frame. Sent frame
+ * buffers come back on a recycle queue and are reused by begin_frame().
+ */
+class StreamTransport {
+public:
+    static constexpr uint32_t MAX_FRAME_SIZE = 64u * 1024u * 1024u;
+
+    StreamTransport();
+    ~StreamTransport();
+
+    StreamTransport(const StreamTransport&) = delete;
+    StreamTransport& operator=(const StreamTransport&) = delete;
+
+    bool open(const godot::String& host, int port);
+    void close();
+
+    // True once the TCP handshake has completed
+    bool is_open() const { return connected.load(std::memory_order_acquire); }
+    bool is_connecting() const;
+
+    // Takes effect on the next open()
+    void set_threaded(bool enabled) { threaded = enabled; }
+    bool is_threaded() const { return threaded; }
+
+    // Append every complete decoded frame to r_messages (advancing the
+    // socket first when not threaded)
+    void poll(godot::Array& r_messages);
+    godot::Error send_message(const godot::Dictionary& message);
+
+    // Callers that already hold MessagePack bytes append one encoded value to
+    // the buffer returned by begin_frame(), then call send_frame()
+    std::vector<uint8_t>& begin_frame();
+    godot::Error send_frame();
+
+    uint64_t get_bytes_sent() const { return bytes_sent.load(std::memory_order_relaxed); }
+    uint64_t get_bytes_received() const { return bytes_received.load(std::memory_order_relaxed); }
+
+private:
+    // Socket state; owned by the worker thread while one is running
+    godot::Ref<godot::StreamPeerTCP> peer;
+    std::atomic<bool> connected;
+    std::vector<uint8_t> rx_buffer;
+    size_t rx_offset;  // Start of unconsumed data in rx_buffer
+
+    std::vector<uint8_t> tx_buffer;  // Frame being built on the main thread
+
+    std::atomic<uint64_t> bytes_sent;
+    std::atomic<uint64_t> bytes_received;
+
+    // Worker thread mode
+    bool threaded;
+    bool use_worker;  // The current connection runs on the worker
+    std::thread worker;
+    std::atomic<bool> worker_running;
+    std::atomic<bool> worker_connecting;
+    std::atomic<bool> stop_requested;
+    std::mutex wake_lock;  // Only guards the worker's idle wait
+    std::condition_variable wake;
+    godot::String worker_host;
+    int worker_port;
+    SpscQueue<std::vector<uint8_t>> outbound;  // Main -> worker: encoded frames
+    SpscQueue<std::vector<uint8_t>> recycled;  // Worker -> main: sent frame buffers
+    SpscQueue<godot::Variant> inbound;         // Worker -> main: decoded messages
+
+    bool _connect(const godot::String& host, int port);
+    bool _pump(godot::Array& r_messages);
+    bool _write(const std::vector<uint8_t>& frame);
+    void _close_socket();
+    bool _extract_frames(godot::Array& r_messages);
+    void _run_worker();
+    void _stop_worker();
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_STREAM_TRANSPORT_H
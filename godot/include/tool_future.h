@@ -0,0 +1,78 @@
+#ifndef AGENT_ARENA_TOOL_FUTURE_H
+#define AGENT_ARENA_TOOL_FUTURE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+
+namespace agent_arena {
+
+class IPCClient;
+
+/**
+ * Handle for one tool call, resolved exactly once.
+ *
+ * Remote calls are resolved by IPCClient when the response for their
+ * request ID arrives, or when they time out or are cancelled; local tools
+ * return an already-resolved future. "completed" is only emitted on a
+ * later resolution, so GDScript awaits with
+ *   if not future.is_done(): await future.completed
+ * and C++ polls is_done()/get_result().
+ */
+class ToolFuture : public godot::RefCounted {
+    GDCLASS(ToolFuture, godot::RefCounted)
+
+public:
+    enum Status {
+        STATUS_PENDING,
+        STATUS_COMPLETED,  // Response arrived with success = true
+        STATUS_FAILED,     // Response arrived with success = false, or the send failed
+        STATUS_CANCELLED,
+        STATUS_TIMED_OUT,
+    };
+
+private:
+    int64_t request_id;  // -1 for local tools
+    godot::String tool_name;
+    godot::String agent_id;
+    Status status;
+    godot::Dictionary result;
+    uint64_t deadline_msec;  // 0 = no timeout
+    uint64_t client_id;  // IPCClient instance ID, 0 for local tools
+
+protected:
+    static void _bind_methods();
+
+public:
+    ToolFuture();
+    ~ToolFuture();
+
+    static godot::Ref<ToolFuture> make_resolved(const godot::String& tool_name, const godot::String& agent_id,
+                                                const godot::Dictionary& result);
+
+    // Called by IPCClient
+    void setup(IPCClient* client, int64_t request_id, const godot::String& tool_name,
+               const godot::String& agent_id, uint64_t deadline_msec);
+    void resolve(const godot::Dictionary& response);
+    void abandon(Status final_status, const godot::String& error);
+
+    // Ask the owning IPCClient to drop the request; false if already resolved
+    bool cancel();
+
+    bool is_done() const { return status != STATUS_PENDING; }
+    bool is_success() const { return status == STATUS_COMPLETED; }
+    Status get_status() const { return status; }
+    godot::Dictionary get_result() const { return result; }
+    int64_t get_request_id() const { return request_id; }
+    godot::String get_tool_name() const { return tool_name; }
+    godot::String get_agent_id() const { return agent_id; }
+    uint64_t get_deadline_msec() const { return deadline_msec; }
+};
+
+} // namespace agent_arena
+
+VARIANT_ENUM_CAST(agent_arena::ToolFuture::Status);
+
+#endif // AGENT_ARENA_TOOL_FUTURE_H
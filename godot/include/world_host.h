@@ -0,0 +1,106 @@
+#ifndef AGENT_ARENA_WORLD_HOST_H
+#define AGENT_ARENA_WORLD_HOST_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/sub_viewport.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+class IPCClient;
+class SimulationManager;
+
+/**
+ * Hosts N isolated copies of a scene in one process (vectorized-env style).
+ *
+ * Each world is an instance of world_scene inside its own SubViewport with
+ * its own World3D, so physics spaces, agents, SimulationManager and EventBus
+ * never interact. The host steps every world's SimulationManager in
+ * lockstep and wraps the step in an IPCClient batch window, so all worlds
+ * share a single /tick request; stepping pauses only while the IPCClient
+ * decision pipeline is full. Agent IDs are namespaced by world ID
+ * ("w0/forager_001"); see BaseAgent.
+ */
+class WorldHost : public godot::Node {
+    GDCLASS(WorldHost, godot::Node)
+
+private:
+    struct World {
+        godot::SubViewport* viewport = nullptr;
+        godot::Node* root = nullptr;
+        SimulationManager* simulation = nullptr;
+    };
+
+    godot::Ref<godot::PackedScene> world_scene;
+    int world_count;
+    uint64_t master_seed;
+    double tick_rate;         // Batched steps per second (0 = one per frame)
+    double backend_timeout;   // Seconds before a stalled backend is skipped (0 = wait forever)
+    bool render_worlds;
+
+    std::vector<World> worlds;
+    uint64_t ipc_client_id;   // Instance ID, so a freed client is detected
+
+    bool is_running;
+    bool awaiting_backend;
+    double tick_accumulator;
+    double wait_time;
+    uint64_t current_tick;
+
+    IPCClient* _get_ipc_client() const;
+    void _on_tick_request_completed(int tick);
+    void _on_connection_failed(const godot::String& error);
+
+protected:
+    static void _bind_methods();
+
+public:
+    WorldHost();
+    ~WorldHost();
+
+    void _process(double delta) override;
+
+    // World lifecycle
+    void spawn_worlds();
+    void clear_worlds();
+    void start();
+    void stop();
+    void reset();
+    void step();  // One tick in every world, one backend request
+
+    int get_spawned_world_count() const { return (int)worlds.size(); }
+    godot::Node* get_world_root(int index) const;
+    SimulationManager* get_world_simulation(int index) const;
+    static godot::String world_id_for(int index);
+    godot::String get_world_id(int index) const { return world_id_for(index); }
+
+    void set_ipc_client(IPCClient* client);
+    IPCClient* get_ipc_client() const { return _get_ipc_client(); }
+
+    bool get_is_running() const { return is_running; }
+    bool is_awaiting_backend() const { return awaiting_backend; }
+    uint64_t get_current_tick() const { return current_tick; }
+
+    // Configuration
+    void set_world_scene(const godot::Ref<godot::PackedScene>& scene) { world_scene = scene; }
+    godot::Ref<godot::PackedScene> get_world_scene() const { return world_scene; }
+    void set_world_count(int count);
+    int get_world_count() const { return world_count; }
+    void set_master_seed(uint64_t seed) { master_seed = seed; }
+    uint64_t get_master_seed() const { return master_seed; }
+    void set_tick_rate(double rate);
+    double get_tick_rate() const { return tick_rate; }
+    void set_backend_timeout(double seconds);
+    double get_backend_timeout() const { return backend_timeout; }
+    void set_render_worlds(bool enabled);
+    bool get_render_worlds() const { return render_worlds; }
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_WORLD_HOST_H
@@ -0,0 +1,69 @@
+#ifndef AGENT_ARENA_WORLD_SNAPSHOT_H
+#define AGENT_ARENA_WORLD_SNAPSHOT_H
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace agent_arena {
+
+/**
+ * Serialized layout of a WorldSnapshot (SimulationManager::get_snapshot_data).
+ *
+ * One MessagePack array:
+ *   [MAGIC, VERSION, tick, seed, event_tick, event_offset,
+ *    [[stream_name, stream_seed, s0, s1, s2, s3], ...],
+ *    [[source_name, bin], ...]]
+ * 64-bit values are stored as their int64 bit pattern. Source payloads are
+ * opaque to the snapshot (var_to_bytes of whatever the source captured).
+ */
+namespace snapshot_format {
+    constexpr int64_t MAGIC = 0x534E5741;  // "AWNS"
+    constexpr int64_t VERSION = 1;
+}
+
+/**
+ * Everything SimulationManager needs to put the simulation back where it was:
+ * the tick, the master seed and every RNG stream's state, the EventBus
+ * position, and one opaque blob per registered snapshot source (agents,
+ * scene resources and hazards, ...).
+ *
+ * Source blobs are PackedByteArrays and therefore copy-on-write: when a
+ * source captures the same bytes as in the previous snapshot, the new
+ * snapshot shares that buffer instead of holding a copy, so frequent
+ * checkpoints only pay for the sources that actually changed.
+ */
+struct WorldSnapshot {
+    struct StreamState {
+        godot::String name;
+        uint64_t seed;
+        uint64_t state[4];
+    };
+
+    struct SourceState {
+        godot::String name;
+        godot::PackedByteArray data;
+        bool shared;  // Buffer reused from the previous snapshot
+    };
+
+    uint64_t tick = 0;
+    uint64_t seed = 0;
+    uint64_t event_tick = 0;   // EventBus tick and how many of its events
+    int event_offset = 0;      // had been emitted when the snapshot was taken
+    std::vector<StreamState> streams;
+    std::vector<SourceState> sources;
+
+    // Bytes held by this snapshot's own (unshared) source buffers
+    int64_t get_owned_bytes() const;
+    int64_t get_shared_bytes() const;
+
+    godot::PackedByteArray encode() const;
+    // Returns false (leaving r_snapshot unspecified) on malformed input
+    static bool decode(const godot::PackedByteArray& bytes, WorldSnapshot& r_snapshot);
+};
+
+} // namespace agent_arena
+
+#endif // AGENT_ARENA_WORLD_SNAPSHOT_H
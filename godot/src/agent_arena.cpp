@@ -1,15 +1,80 @@
 #include "agent_arena.h"
+#include "arena_log.h"
+#include "msgpack_codec.h"
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace godot;
 using namespace agent_arena;
 
+namespace {
+
+// Whole numbers arrive as INT or FLOAT (Python may send 5.0); Variant casts don't coerce
+int64_t variant_to_int(const Variant& value, int64_t fallback = 0) {
+    switch (value.get_type()) {
+        case Variant::INT:
+            return (int64_t)value;
+        case Variant::FLOAT:
+            return (int64_t)(double)value;
+        case Variant::BOOL:
+            return (bool)value ? 1 : 0;
+        default:
+            return fallback;
+    }
+}
+
+// Dictionary keys used on every tick. A string literal key builds (and
+// UTF-8 decodes) a new String at each use; these are built once, on first use.
+struct IpcKeys {
+    const String tick = "tick";
+    const String agents = "agents";
+    const String agent_id = "agent_id";
+    const String observations = "observations";
+    const String simulation_state = "simulation_state";
+    const String type = "type";
+    const String actions = "actions";
+    const String action = "action";
+    const String resync = "resync";
+    const String tool = "tool";
+    const String params = "params";
+    const String request_id = "request_id";
+    const String tool_name = "tool_name";
+    const String success = "success";
+    const String error = "error";
+    const String idle = "idle";
+    const String wait = "wait";
+};
+
+const IpcKeys& ipc_keys() {
+    static const IpcKeys keys;
+    return keys;
+}
+
+} // namespace
+
 // ============================================================================
 // SimulationManager Implementation
 // ============================================================================
 
 SimulationManager::SimulationManager()
-    : current_tick(0), tick_rate(60.0), is_running(false), event_bus(nullptr) {
+    : current_tick(0), tick_rate(60.0), is_running(false), event_bus(nullptr),
+      tick_mode(TICK_MODE_MANUAL),
+      tick_accumulator(0.0),
+      max_ticks_per_frame(8),
+      max_fast_ticks_per_frame(0),
+      frame_budget_ms(12.0),
+      awaiting_backend(false),
+      lockstep_timeout(0.0),
+      lockstep_wait_time(0.0),
+      adaptive_tick_rate(false),
+      min_tick_rate_scale(0.25),
+      backend_pressure(0.0),
+      seed(0),
+      next_snapshot_handle(1),
+      max_snapshots(0) {
 }
 
 SimulationManager::~SimulationManager() {}
@@ -26,14 +91,69 @@ void SimulationManager::_bind_methods() {
 
     ClassDB::bind_method(D_METHOD("set_tick_rate", "rate"), &SimulationManager::set_tick_rate);
     ClassDB::bind_method(D_METHOD("set_seed", "seed"), &SimulationManager::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &SimulationManager::get_seed);
+    ClassDB::bind_method(D_METHOD("get_stream", "name"), &SimulationManager::get_stream);
+
+    ClassDB::bind_method(D_METHOD("set_tick_mode", "mode"), &SimulationManager::set_tick_mode);
+    ClassDB::bind_method(D_METHOD("get_tick_mode"), &SimulationManager::get_tick_mode);
+    ClassDB::bind_method(D_METHOD("set_max_ticks_per_frame", "count"), &SimulationManager::set_max_ticks_per_frame);
+    ClassDB::bind_method(D_METHOD("get_max_ticks_per_frame"), &SimulationManager::get_max_ticks_per_frame);
+    ClassDB::bind_method(D_METHOD("set_max_fast_ticks_per_frame", "count"), &SimulationManager::set_max_fast_ticks_per_frame);
+    ClassDB::bind_method(D_METHOD("get_max_fast_ticks_per_frame"), &SimulationManager::get_max_fast_ticks_per_frame);
+    ClassDB::bind_method(D_METHOD("set_frame_budget_ms", "budget"), &SimulationManager::set_frame_budget_ms);
+    ClassDB::bind_method(D_METHOD("get_frame_budget_ms"), &SimulationManager::get_frame_budget_ms);
+    ClassDB::bind_method(D_METHOD("set_lockstep_timeout", "seconds"), &SimulationManager::set_lockstep_timeout);
+    ClassDB::bind_method(D_METHOD("get_lockstep_timeout"), &SimulationManager::get_lockstep_timeout);
+    ClassDB::bind_method(D_METHOD("set_adaptive_tick_rate", "enabled"), &SimulationManager::set_adaptive_tick_rate);
+    ClassDB::bind_method(D_METHOD("get_adaptive_tick_rate"), &SimulationManager::get_adaptive_tick_rate);
+    ClassDB::bind_method(D_METHOD("set_min_tick_rate_scale", "scale"), &SimulationManager::set_min_tick_rate_scale);
+    ClassDB::bind_method(D_METHOD("get_min_tick_rate_scale"), &SimulationManager::get_min_tick_rate_scale);
+    ClassDB::bind_method(D_METHOD("set_backend_pressure", "pressure"), &SimulationManager::set_backend_pressure);
+    ClassDB::bind_method(D_METHOD("get_backend_pressure"), &SimulationManager::get_backend_pressure);
+    ClassDB::bind_method(D_METHOD("get_tick_rate_scale"), &SimulationManager::get_tick_rate_scale);
+    ClassDB::bind_method(D_METHOD("get_effective_tick_rate"), &SimulationManager::get_effective_tick_rate);
+    ClassDB::bind_method(D_METHOD("notify_backend_ready"), &SimulationManager::notify_backend_ready);
+    ClassDB::bind_method(D_METHOD("is_awaiting_backend"), &SimulationManager::is_awaiting_backend);
+    ClassDB::bind_method(D_METHOD("add_snapshot_source", "name", "capture", "restore"), &SimulationManager::add_snapshot_source);
+    ClassDB::bind_method(D_METHOD("remove_snapshot_source", "name"), &SimulationManager::remove_snapshot_source);
+    ClassDB::bind_method(D_METHOD("snapshot"), &SimulationManager::snapshot);
+    ClassDB::bind_method(D_METHOD("restore", "handle"), &SimulationManager::restore);
+    ClassDB::bind_method(D_METHOD("has_snapshot", "handle"), &SimulationManager::has_snapshot);
+    ClassDB::bind_method(D_METHOD("get_snapshot_tick", "handle"), &SimulationManager::get_snapshot_tick);
+    ClassDB::bind_method(D_METHOD("release_snapshot", "handle"), &SimulationManager::release_snapshot);
+    ClassDB::bind_method(D_METHOD("clear_snapshots"), &SimulationManager::clear_snapshots);
+    ClassDB::bind_method(D_METHOD("get_snapshot_count"), &SimulationManager::get_snapshot_count);
+    ClassDB::bind_method(D_METHOD("set_max_snapshots", "count"), &SimulationManager::set_max_snapshots);
+    ClassDB::bind_method(D_METHOD("get_max_snapshots"), &SimulationManager::get_max_snapshots);
+    ClassDB::bind_method(D_METHOD("get_snapshot_stats"), &SimulationManager::get_snapshot_stats);
+    ClassDB::bind_method(D_METHOD("get_snapshot_data", "handle"), &SimulationManager::get_snapshot_data);
+    ClassDB::bind_method(D_METHOD("load_snapshot_data", "data"), &SimulationManager::load_snapshot_data);
 
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tick_rate"), "set_tick_rate", "get_tick_rate");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "current_tick"), "", "get_current_tick");
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "is_running"), "", "get_is_running");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "tick_mode", PROPERTY_HINT_ENUM, "Manual,Realtime,Fast,Lockstep"),
+                 "set_tick_mode", "get_tick_mode");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_ticks_per_frame"), "set_max_ticks_per_frame", "get_max_ticks_per_frame");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_fast_ticks_per_frame"), "set_max_fast_ticks_per_frame", "get_max_fast_ticks_per_frame");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "frame_budget_ms"), "set_frame_budget_ms", "get_frame_budget_ms");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lockstep_timeout"), "set_lockstep_timeout", "get_lockstep_timeout");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "adaptive_tick_rate"), "set_adaptive_tick_rate", "get_adaptive_tick_rate");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_tick_rate_scale", PROPERTY_HINT_RANGE, "0.01,1,0.01"),
+                 "set_min_tick_rate_scale", "get_min_tick_rate_scale");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_snapshots", PROPERTY_HINT_RANGE, "0,4096,1"), "set_max_snapshots", "get_max_snapshots");
+
+    BIND_ENUM_CONSTANT(TICK_MODE_MANUAL);
+    BIND_ENUM_CONSTANT(TICK_MODE_REALTIME);
+    BIND_ENUM_CONSTANT(TICK_MODE_FAST);
+    BIND_ENUM_CONSTANT(TICK_MODE_LOCKSTEP);
 
     ADD_SIGNAL(MethodInfo("tick_advanced", PropertyInfo(Variant::INT, "tick")));
     ADD_SIGNAL(MethodInfo("simulation_started"));
     ADD_SIGNAL(MethodInfo("simulation_stopped"));
+    ADD_SIGNAL(MethodInfo("lockstep_timed_out", PropertyInfo(Variant::INT, "tick")));
+    ADD_SIGNAL(MethodInfo("snapshot_restored", PropertyInfo(Variant::INT, "tick")));
 }
 
 void SimulationManager::_ready() {
@@ -42,7 +162,7 @@ void SimulationManager::_ready() {
     if (parent) {
         event_bus = Object::cast_to<EventBus>(parent->get_node_or_null("EventBus"));
         if (event_bus) {
-            UtilityFunctions::print("c++ SimulationManager: EventBus connected");
+            ARENA_LOG_DEBUG("SimulationManager: EventBus connected");
         }
         // Note: EventBus is optional - scenes without it will simply not record events
     }
@@ -51,21 +171,87 @@ void SimulationManager::_ready() {
 void SimulationManager::_process(double delta) {
     if (!is_running) return;
 
-    // Process simulation tick
-    // In a real implementation, this would handle timing and call step_simulation
+    _run_tick_loop(delta);
 }
 
 void SimulationManager::_physics_process(double delta) {
     // Physics-based simulation tick (for deterministic physics)
 }
 
+void SimulationManager::_run_tick_loop(double delta) {
+    switch (tick_mode) {
+        case TICK_MODE_MANUAL:
+            // Ticks are driven externally via step_simulation()
+            break;
+
+        case TICK_MODE_REALTIME: {
+            // Fixed-timestep accumulator: consume wall-clock time in 1/tick_rate slices
+            const double tick_interval = 1.0 / get_effective_tick_rate();
+            tick_accumulator += delta;
+
+            int ticks_this_frame = 0;
+            while (tick_accumulator >= tick_interval && ticks_this_frame < max_ticks_per_frame && is_running) {
+                tick_accumulator -= tick_interval;
+                step_simulation();
+                ticks_this_frame++;
+            }
+
+            // Drop the backlog after a long stall instead of spiralling into catch-up
+            if (tick_accumulator > tick_interval * max_ticks_per_frame) {
+                tick_accumulator = 0.0;
+            }
+            break;
+        }
+
+        case TICK_MODE_FAST: {
+            // Run as many ticks as the frame budget allows, ignoring wall-clock
+            // time; backpressure shrinks the budget (and the optional cap)
+            const double scale = get_tick_rate_scale();
+            const uint64_t budget_usec = static_cast<uint64_t>(frame_budget_ms * scale * 1000.0);
+            const uint64_t frame_start = Time::get_singleton()->get_ticks_usec();
+            int tick_cap = 0;
+            if (max_fast_ticks_per_frame > 0) {
+                const double scaled_cap = Math::round(max_fast_ticks_per_frame * scale);
+                tick_cap = scaled_cap < 1.0 ? 1 : (int)scaled_cap;
+            }
+
+            int ticks_this_frame = 0;
+            while ((tick_cap == 0 || ticks_this_frame < tick_cap) && is_running) {
+                step_simulation();
+                ticks_this_frame++;
+                if (Time::get_singleton()->get_ticks_usec() - frame_start >= budget_usec) {
+                    break;
+                }
+            }
+            break;
+        }
+
+        case TICK_MODE_LOCKSTEP:
+            if (awaiting_backend) {
+                lockstep_wait_time += delta;
+                if (lockstep_timeout <= 0.0 || lockstep_wait_time < lockstep_timeout) {
+                    break;
+                }
+                // Backend stalled past the timeout - advance without it
+                emit_signal("lockstep_timed_out", current_tick);
+            }
+            awaiting_backend = true;
+            lockstep_wait_time = 0.0;
+            step_simulation();
+            break;
+    }
+}
+
 void SimulationManager::start_simulation() {
     is_running = true;
+    tick_accumulator = 0.0;
+    awaiting_backend = false;
+    lockstep_wait_time = 0.0;
     if (event_bus) {
         event_bus->start_recording();
     }
     emit_signal("simulation_started");
-    UtilityFunctions::print("c++ Simulation started at tick ", current_tick);
+    ARENA_LOG_INFO("Simulation started at tick ", current_tick);
 }
 
 void SimulationManager::stop_simulation() {
@@ -74,96 +260,580 @@ void SimulationManager::stop_simulation() {
         event_bus->stop_recording();
     }
     emit_signal("simulation_stopped");
-    UtilityFunctions::print("c++ Simulation stopped at tick ", current_tick);
+    ARENA_LOG_INFO("Simulation stopped at tick ", current_tick);
 }
 
 void SimulationManager::step_simulation() {
+    ScopedPerfTimer timer(PerfStats::PHASE_TICK);
     current_tick++;
-    emit_signal("tick_advanced", current_tick);
 
-    // Process all pending events for this tick
+    // Events emitted by tick_advanced handlers belong to this tick
     if (event_bus) {
-        Array events = event_bus->get_events_for_tick(current_tick);
-        for (int i = 0; i < events.size(); i++) {
-            // Process each event
-        }
+        event_bus->set_current_tick(current_tick);
     }
+
+    emit_signal("tick_advanced", current_tick);
 }
 
 void SimulationManager::reset_simulation() {
     current_tick = 0;
     is_running = false;
+    tick_accumulator = 0.0;
+    awaiting_backend = false;
+    lockstep_wait_time = 0.0;
     if (event_bus) {
         event_bus->clear_events();
+        event_bus->set_current_tick(0);
     }
-    UtilityFunctions::print("c++ Simulation reset");
+    _reseed_streams();
+    ARENA_LOG_INFO("Simulation reset");
 }
 
 void SimulationManager::set_tick_rate(double rate) {
     tick_rate = Math::max(1.0, rate);
 }
 
-void SimulationManager::set_seed(uint64_t seed) {
-    // Set RNG seed for deterministic simulation
-    UtilityFunctions::print("c++ Simulation seed set to ", seed);
+void SimulationManager::set_seed(uint64_t p_seed) {
+    seed = p_seed;
+    _reseed_streams();
+    ARENA_LOG_INFO("Simulation seed set to ", seed);
+}
+
+Ref<RandomStream> SimulationManager::get_stream(const String& name) {
+    Ref<RandomStream>* existing = rng_streams.getptr(name);
+    if (existing) {
+        return *existing;
+    }
+
+    Ref<RandomStream> stream;
+    stream.instantiate();
+    stream->set_seed(RandomStream::derive_seed(seed, name));
+    rng_streams.insert(name, stream);
+    return stream;
+}
+
+void SimulationManager::_reseed_streams() {
+    // Reseed in place so references already handed out stay valid
+    for (KeyValue<String, Ref<RandomStream>>& entry : rng_streams) {
+        entry.value->set_seed(RandomStream::derive_seed(seed, entry.key));
+    }
+}
+
+void SimulationManager::set_tick_mode(TickMode mode) {
+    tick_mode = mode;
+    tick_accumulator = 0.0;
+    awaiting_backend = false;
+    lockstep_wait_time = 0.0;
+}
+
+void SimulationManager::set_max_ticks_per_frame(int count) {
+    max_ticks_per_frame = count < 1 ? 1 : count;
+}
+
+void SimulationManager::set_max_fast_ticks_per_frame(int count) {
+    max_fast_ticks_per_frame = count < 0 ? 0 : count;
+}
+
+void SimulationManager::set_frame_budget_ms(double budget) {
+    frame_budget_ms = Math::max(0.1, budget);
+}
+
+void SimulationManager::set_lockstep_timeout(double seconds) {
+    lockstep_timeout = Math::max(0.0, seconds);
+}
+
+void SimulationManager::set_min_tick_rate_scale(double scale) {
+    min_tick_rate_scale = scale < 0.01 ? 0.01 : (scale > 1.0 ? 1.0 : scale);
+}
+
+void SimulationManager::set_backend_pressure(double pressure) {
+    backend_pressure = pressure < 0.0 ? 0.0 : (pressure > 1.0 ? 1.0 : pressure);
+}
+
+double SimulationManager::get_tick_rate_scale() const {
+    if (!adaptive_tick_rate) {
+        return 1.0;
+    }
+    return 1.0 - backend_pressure * (1.0 - min_tick_rate_scale);
+}
+
+void SimulationManager::notify_backend_ready() {
+    awaiting_backend = false;
+    lockstep_wait_time = 0.0;
+}
+
+void SimulationManager::add_snapshot_source(const String& name, const Callable& capture, const Callable& restore) {
+    for (SnapshotSource& source : snapshot_sources) {
+        if (source.name == name) {
+            source.capture = capture;
+            source.restore = restore;
+            return;
+        }
+    }
+    snapshot_sources.push_back(SnapshotSource{name, capture, restore});
+}
+
+void SimulationManager::remove_snapshot_source(const String& name) {
+    for (size_t i = 0; i < snapshot_sources.size(); i++) {
+        if (snapshot_sources[i].name == name) {
+            snapshot_sources.erase(snapshot_sources.begin() + i);
+            return;
+        }
+    }
+}
+
+int64_t SimulationManager::snapshot() {
+    WorldSnapshot snap;
+    snap.tick = current_tick;
+    snap.seed = seed;
+    if (event_bus) {
+        snap.event_tick = event_bus->get_current_tick();
+        snap.event_offset = event_bus->get_event_count_for_tick(snap.event_tick);
+    }
+
+    snap.streams.reserve(rng_streams.size());
+    for (const KeyValue<String, Ref<RandomStream>>& entry : rng_streams) {
+        WorldSnapshot::StreamState stream;
+        stream.name = entry.key;
+        stream.seed = entry.value->get_seed();
+        entry.value->get_state(stream.state);
+        snap.streams.push_back(stream);
+    }
+
+    _capture_sources(snap);
+    return _store_snapshot(std::move(snap));
+}
+
+void SimulationManager::_capture_sources(WorldSnapshot& r_snapshot) const {
+    // The most recent snapshot is the one most likely to hold identical blobs
+    const WorldSnapshot* previous = snapshots.getptr(next_snapshot_handle - 1);
+
+    r_snapshot.sources.reserve(snapshot_sources.size());
+    for (const SnapshotSource& source : snapshot_sources) {
+        if (!source.capture.is_valid()) {
+            continue;
+        }
+        PackedByteArray data = UtilityFunctions::var_to_bytes(source.capture.call());
+
+        bool shared = false;
+        if (previous) {
+            for (const WorldSnapshot::SourceState& old : previous->sources) {
+                if (old.name == source.name && old.data.size() == data.size() &&
+                    std::memcmp(old.data.ptr(), data.ptr(), (size_t)data.size()) == 0) {
+                    data = old.data;  // Share the buffer (copy-on-write) instead of keeping a duplicate
+                    shared = true;
+                    break;
+                }
+            }
+        }
+        r_snapshot.sources.push_back(WorldSnapshot::SourceState{source.name, data, shared});
+    }
+}
+
+int64_t SimulationManager::_store_snapshot(WorldSnapshot&& snap) {
+    while (max_snapshots > 0 && (int)snapshots.size() >= max_snapshots) {
+        const int64_t oldest = snapshots.begin()->key;
+        snapshots.erase(oldest);
+    }
+
+    const int64_t handle = next_snapshot_handle++;
+    snapshots.insert(handle, std::move(snap));
+    return handle;
+}
+
+bool SimulationManager::restore(int64_t handle) {
+    const WorldSnapshot* snap = snapshots.getptr(handle);
+    if (!snap) {
+        ARENA_LOG_WARN("SimulationManager: unknown snapshot handle ", handle);
+        return false;
+    }
+    _apply_snapshot(*snap);
+    return true;
+}
+
+void SimulationManager::_apply_snapshot(const WorldSnapshot& snap) {
+    current_tick = snap.tick;
+    tick_accumulator = 0.0;
+    awaiting_backend = false;
+    lockstep_wait_time = 0.0;
+
+    // Streams first handed out after the snapshot go back to their initial state
+    seed = snap.seed;
+    _reseed_streams();
+    for (const WorldSnapshot::StreamState& stream : snap.streams) {
+        get_stream(stream.name)->set_state(stream.seed, stream.state);
+    }
+
+    if (event_bus) {
+        event_bus->rewind_events(snap.event_tick, snap.event_offset);
+        event_bus->set_current_tick(current_tick);
+    }
+
+    for (const WorldSnapshot::SourceState& saved : snap.sources) {
+        const SnapshotSource* source = nullptr;
+        for (const SnapshotSource& candidate : snapshot_sources) {
+            if (candidate.name == saved.name) {
+                source = &candidate;
+                break;
+            }
+        }
+        if (!source || !source->restore.is_valid()) {
+            ARENA_LOG_WARN("SimulationManager: no restore handler for snapshot source '", saved.name, "'");
+            continue;
+        }
+        source->restore.call(UtilityFunctions::bytes_to_var(saved.data));
+    }
+
+    emit_signal("snapshot_restored", current_tick);
+    ARENA_LOG_DEBUG("Simulation restored to tick ", current_tick);
+}
+
+int64_t SimulationManager::get_snapshot_tick(int64_t handle) const {
+    const WorldSnapshot* snap = snapshots.getptr(handle);
+    return snap ? (int64_t)snap->tick : -1;
+}
+
+void SimulationManager::set_max_snapshots(int count) {
+    max_snapshots = count < 0 ? 0 : count;
+    while (max_snapshots > 0 && (int)snapshots.size() > max_snapshots) {
+        const int64_t oldest = snapshots.begin()->key;
+        snapshots.erase(oldest);
+    }
+}
+
+Dictionary SimulationManager::get_snapshot_stats() const {
+    int64_t owned_bytes = 0;
+    int64_t shared_bytes = 0;
+    for (const KeyValue<int64_t, WorldSnapshot>& entry : snapshots) {
+        owned_bytes += entry.value.get_owned_bytes();
+        shared_bytes += entry.value.get_shared_bytes();
+    }
+
+    Dictionary stats;
+    stats["count"] = (int64_t)snapshots.size();
+    stats["source_count"] = (int64_t)snapshot_sources.size();
+    stats["owned_bytes"] = owned_bytes;
+    stats["shared_bytes"] = shared_bytes;
+    return stats;
+}
+
+PackedByteArray SimulationManager::get_snapshot_data(int64_t handle) const {
+    const WorldSnapshot* snap = snapshots.getptr(handle);
+    return snap ? snap->encode() : PackedByteArray();
+}
+
+int64_t SimulationManager::load_snapshot_data(const PackedByteArray& data) {
+    WorldSnapshot snap;
+    if (!WorldSnapshot::decode(data, snap)) {
+        ARENA_LOG_WARN("SimulationManager: malformed snapshot data (", data.size(), " bytes)");
+        return -1;
+    }
+    return _store_snapshot(std::move(snap));
 }
 
 // ============================================================================
 // EventBus Implementation
 // ============================================================================
 
-EventBus::EventBus() : recording(false) {}
+EventBus::EventBus()
+    : event_count(0),
+      current_tick(0),
+      recording(false) {}
 
 EventBus::~EventBus() {}
 
 void EventBus::_bind_methods() {
     ClassDB::bind_method(D_METHOD("emit_event", "event_type", "data"), &EventBus::emit_event);
     ClassDB::bind_method(D_METHOD("get_events_for_tick", "tick"), &EventBus::get_events_for_tick);
+    ClassDB::bind_method(D_METHOD("get_event_count_for_tick", "tick"), &EventBus::get_event_count_for_tick);
+    ClassDB::bind_method(D_METHOD("get_event_count"), &EventBus::get_event_count);
     ClassDB::bind_method(D_METHOD("clear_events"), &EventBus::clear_events);
+    ClassDB::bind_method(D_METHOD("rewind_events", "tick", "events_in_tick"), &EventBus::rewind_events);
+    ClassDB::bind_method(D_METHOD("set_current_tick", "tick"), &EventBus::set_current_tick);
+    ClassDB::bind_method(D_METHOD("get_current_tick"), &EventBus::get_current_tick);
+    ClassDB::bind_method(D_METHOD("get_event_type_id", "event_type"), &EventBus::get_event_type_id);
+    ClassDB::bind_method(D_METHOD("get_event_type_name", "type_id"), &EventBus::get_event_type_name);
     ClassDB::bind_method(D_METHOD("start_recording"), &EventBus::start_recording);
     ClassDB::bind_method(D_METHOD("stop_recording"), &EventBus::stop_recording);
+    ClassDB::bind_method(D_METHOD("is_recording"), &EventBus::is_recording);
+    ClassDB::bind_method(D_METHOD("start_recording_to_file", "path", "compress"), &EventBus::start_recording_to_file, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("is_recording_to_file"), &EventBus::is_recording_to_file);
+    ClassDB::bind_method(D_METHOD("set_replay_chunk_event_limit", "limit"), &EventBus::set_replay_chunk_event_limit);
+    ClassDB::bind_method(D_METHOD("get_replay_chunk_event_limit"), &EventBus::get_replay_chunk_event_limit);
     ClassDB::bind_method(D_METHOD("export_recording"), &EventBus::export_recording);
     ClassDB::bind_method(D_METHOD("load_recording", "events"), &EventBus::load_recording);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "replay_chunk_event_limit", PROPERTY_HINT_RANGE, "1,1000000,1"),
+                 "set_replay_chunk_event_limit", "get_replay_chunk_event_limit");
+}
+
+uint32_t EventBus::_intern_event_type(const String& event_type) {
+    const uint32_t* existing = event_type_ids.getptr(event_type);
+    if (existing) {
+        return *existing;
+    }
+
+    uint32_t type_id = (uint32_t)event_type_names.size();
+    event_type_names.push_back(event_type);
+    event_type_ids.insert(event_type, type_id);
+    return type_id;
+}
+
+void EventBus::_store_event(uint64_t tick, uint32_t type_id, const Dictionary& data) {
+    // Segment that starts at or before tick; live recording only ever hits the last one
+    std::vector<TickSegment>::iterator next = segments.end();
+    if (!segments.empty() && tick < segments.back().base_tick) {
+        next = std::upper_bound(segments.begin(), segments.end(), tick,
+                                [](uint64_t t, const TickSegment& segment) { return t < segment.base_tick; });
+    }
+
+    TickSegment* segment = nullptr;
+    if (next != segments.begin()) {
+        TickSegment& prev = *(next - 1);
+        // upper_bound guarantees tick < next->base_tick, so extending can't overlap it
+        if (tick - prev.base_tick < prev.buckets.size() + MAX_TICK_GAP) {
+            segment = &prev;
+        }
+    }
+    if (!segment) {
+        // Past a long gap (or before every segment): start a new run of ticks
+        TickSegment created;
+        created.base_tick = tick;
+        if (segments.empty()) {
+            created.buckets.reserve(INITIAL_TICK_CAPACITY);
+        }
+        segment = &*segments.insert(next, std::move(created));
+    }
+
+    const size_t index = (size_t)(tick - segment->base_tick);
+    while (index >= segment->buckets.size()) {
+        if (spare_buckets.empty()) {
+            segment->buckets.emplace_back();
+        } else {
+            segment->buckets.push_back(std::move(spare_buckets.back()));
+            spare_buckets.pop_back();
+        }
+    }
+
+    segment->buckets[index].push_back(Event{tick, type_id, data});
+    event_count++;
+}
+
+void EventBus::_drop_buckets_before(uint64_t tick) {
+    size_t drop_segments = 0;
+    while (drop_segments < segments.size()) {
+        TickSegment& segment = segments[drop_segments];
+        if (segment.base_tick >= tick) {
+            break;
+        }
+        if (tick - segment.base_tick < segment.buckets.size()) {
+            // Straddles tick: keep its tail
+            const size_t drop = (size_t)(tick - segment.base_tick);
+            for (size_t i = 0; i < drop; i++) {
+                event_count -= (int64_t)segment.buckets[i].size();
+                _recycle_bucket(segment.buckets[i]);
+            }
+            segment.buckets.erase(segment.buckets.begin(), segment.buckets.begin() + drop);
+            segment.base_tick = tick;
+            break;
+        }
+        _recycle_segment(segment);
+        drop_segments++;
+    }
+    segments.erase(segments.begin(), segments.begin() + drop_segments);
+}
+
+void EventBus::_recycle_bucket(std::vector<Event>& bucket) {
+    if (bucket.capacity() == 0 || spare_buckets.size() >= MAX_SPARE_BUCKETS) {
+        return;
+    }
+    bucket.clear();  // Releases the event Dictionaries, keeps the storage
+    spare_buckets.push_back(std::move(bucket));
+}
+
+void EventBus::_recycle_segment(TickSegment& segment) {
+    for (std::vector<Event>& bucket : segment.buckets) {
+        event_count -= (int64_t)bucket.size();
+        _recycle_bucket(bucket);
+    }
+    segment.buckets.clear();
+}
+
+const std::vector<EventBus::Event>* EventBus::_get_bucket(uint64_t tick) const {
+    std::vector<TickSegment>::const_iterator next =
+        std::upper_bound(segments.begin(), segments.end(), tick,
+                         [](uint64_t t, const TickSegment& segment) { return t < segment.base_tick; });
+    if (next == segments.begin()) {
+        return nullptr;
+    }
+    const TickSegment& segment = *(next - 1);
+    if (tick - segment.base_tick >= segment.buckets.size()) {
+        return nullptr;
+    }
+    return &segment.buckets[(size_t)(tick - segment.base_tick)];
+}
+
+Dictionary EventBus::_event_to_dict(const Event& event) const {
+    Dictionary dict;
+    dict["tick"] = (int64_t)event.tick;
+    dict["type"] = event_type_names[event.type_id];
+    dict["data"] = event.data;
+    return dict;
 }
 
 void EventBus::emit_event(const String& event_type, const Dictionary& data) {
-    Dictionary event;
-    event["type"] = event_type;
-    event["data"] = data;
-    event["timestamp"] = Time::get_singleton()->get_ticks_msec();
+    if (!recording) {
+        return;
+    }
 
-    if (recording) {
-        event_queue.append(event);
+    _store_event(current_tick, _intern_event_type(event_type), data);
+
+    // Older ticks now live on disk; keep only what hasn't been flushed
+    if (replay_writer.is_open() && replay_writer.append(current_tick, event_type, data)) {
+        _drop_buckets_before(current_tick);
     }
 }
 
 Array EventBus::get_events_for_tick(uint64_t tick) {
     Array tick_events;
-    // Filter events for the specified tick
+
+    const std::vector<Event>* bucket = _get_bucket(tick);
+    if (bucket) {
+        for (const Event& event : *bucket) {
+            tick_events.append(_event_to_dict(event));
+        }
+    }
+
     return tick_events;
 }
 
+int EventBus::get_event_count_for_tick(uint64_t tick) const {
+    const std::vector<Event>* bucket = _get_bucket(tick);
+    return bucket ? (int)bucket->size() : 0;
+}
+
 void EventBus::clear_events() {
-    event_queue.clear();
+    for (TickSegment& segment : segments) {
+        _recycle_segment(segment);
+    }
+    segments.clear();
+    event_count = 0;
+}
+
+void EventBus::rewind_events(uint64_t tick, int events_in_tick) {
+    // Segments that start after tick are entirely newer
+    while (!segments.empty() && segments.back().base_tick > tick) {
+        _recycle_segment(segments.back());
+        segments.pop_back();
+    }
+
+    if (!segments.empty() && tick - segments.back().base_tick < segments.back().buckets.size()) {
+        TickSegment& segment = segments.back();
+        const size_t index = (size_t)(tick - segment.base_tick);
+        for (size_t i = index + 1; i < segment.buckets.size(); i++) {
+            event_count -= (int64_t)segment.buckets[i].size();
+            _recycle_bucket(segment.buckets[i]);
+        }
+        segment.buckets.erase(segment.buckets.begin() + index + 1, segment.buckets.end());
+
+        std::vector<Event>& bucket = segment.buckets[index];
+        const size_t keep = events_in_tick < 0 ? 0 : (size_t)events_in_tick;
+        if (bucket.size() > keep) {
+            event_count -= (int64_t)(bucket.size() - keep);
+            bucket.erase(bucket.begin() + keep, bucket.end());
+        }
+    }
+    current_tick = tick;
+
+    if (replay_writer.is_open()) {
+        // Events already handed to the writer can't be taken back; close the
+        // chunk so the next one can start again at this tick
+        replay_writer.begin_segment();
+        ARENA_LOG_WARN("EventBus: rewound to tick ", (int64_t)tick, " while recording to file; the log keeps the abandoned branch");
+    }
+}
+
+int EventBus::get_event_type_id(const String& event_type) const {
+    const uint32_t* type_id = event_type_ids.getptr(event_type);
+    return type_id ? (int)*type_id : -1;
+}
+
+String EventBus::get_event_type_name(int type_id) const {
+    if (type_id < 0 || type_id >= (int)event_type_names.size()) {
+        return String();
+    }
+    return event_type_names[type_id];
 }
 
 void EventBus::start_recording() {
     recording = true;
-    UtilityFunctions::print("c++ Event recording started");
+    ARENA_LOG_INFO("Event recording started");
+}
+
+Error EventBus::start_recording_to_file(const String& path, bool compress) {
+    Error err = replay_writer.open(path, compress);
+    if (err != OK) {
+        return err;
+    }
+
+    // In-memory buckets only need to cover the chunk being written
+    clear_events();
+    start_recording();
+    return OK;
 }
 
 void EventBus::stop_recording() {
     recording = false;
-    UtilityFunctions::print("c++ Event recording stopped");
+    if (replay_writer.is_open()) {
+        ARENA_LOG_INFO("Replay log closed: ", replay_writer.get_chunk_count(), " chunks, ",
+                       (int64_t)replay_writer.get_bytes_written(), " bytes");
+        replay_writer.close();
+    }
+    ARENA_LOG_INFO("Event recording stopped");
 }
 
 Array EventBus::export_recording() {
-    return event_queue.duplicate();
+    Array events;
+    for (const TickSegment& segment : segments) {
+        for (const std::vector<Event>& bucket : segment.buckets) {
+            for (const Event& event : bucket) {
+                events.append(_event_to_dict(event));
+            }
+        }
+    }
+    return events;
 }
 
 void EventBus::load_recording(const Array& events) {
-    event_queue = events.duplicate();
-    UtilityFunctions::print("c++ Loaded ", events.size(), " events");
+    clear_events();
+
+    // Store in tick order (stable, so same-tick events keep their order):
+    // every event then appends to the last segment
+    struct LoadedEvent {
+        uint64_t tick;
+        int index;
+    };
+    std::vector<LoadedEvent> order;
+    order.reserve((size_t)events.size());
+    for (int i = 0; i < events.size(); i++) {
+        if (events[i].get_type() != Variant::DICTIONARY) {
+            continue;
+        }
+        const int64_t tick = variant_to_int(((Dictionary)events[i]).get("tick", 0));
+        order.push_back(LoadedEvent{tick < 0 ? 0 : (uint64_t)tick, i});
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const LoadedEvent& a, const LoadedEvent& b) { return a.tick < b.tick; });
+
+    for (const LoadedEvent& loaded : order) {
+        Dictionary event = events[loaded.index];
+        Variant data = event.get("data", Dictionary());
+        _store_event(loaded.tick,
+                     _intern_event_type(event.get("type", "").stringify()),
+                     data.get_type() == Variant::DICTIONARY ? (Dictionary)data : Dictionary());
+    }
+
+    ARENA_LOG_INFO("Loaded ", events.size(), " events");
 }
 
 // ============================================================================
@@ -172,7 +842,8 @@ void EventBus::load_recording(const Array& events) {
 
 Agent::Agent()
     : is_active(true),
-      tool_registry(nullptr) {
+      tool_registry(nullptr),
+      tool_registry_resolved(false) {
     agent_id = "agent_" + String::num_int64(Time::get_singleton()->get_ticks_msec());
 }
 
@@ -185,9 +856,21 @@ void Agent::_bind_methods() {
 
     ClassDB::bind_method(D_METHOD("store_memory", "key", "value"), &Agent::store_memory);
     ClassDB::bind_method(D_METHOD("retrieve_memory", "key"), &Agent::retrieve_memory);
+    ClassDB::bind_method(D_METHOD("has_memory", "key"), &Agent::has_memory);
+    ClassDB::bind_method(D_METHOD("erase_memory", "key"), &Agent::erase_memory);
     ClassDB::bind_method(D_METHOD("clear_short_term_memory"), &Agent::clear_short_term_memory);
 
+    ClassDB::bind_method(D_METHOD("get_action_history", "limit"), &Agent::get_action_history, DEFVAL(-1));
+    ClassDB::bind_method(D_METHOD("get_action_history_size"), &Agent::get_action_history_size);
+    ClassDB::bind_method(D_METHOD("get_total_action_count"), &Agent::get_total_action_count);
+    ClassDB::bind_method(D_METHOD("clear_action_history"), &Agent::clear_action_history);
+    ClassDB::bind_method(D_METHOD("set_action_history_capacity", "capacity"), &Agent::set_action_history_capacity);
+    ClassDB::bind_method(D_METHOD("get_action_history_capacity"), &Agent::get_action_history_capacity);
+    ClassDB::bind_method(D_METHOD("get_memory_snapshot", "action_limit"), &Agent::get_memory_snapshot, DEFVAL(-1));
+    ClassDB::bind_method(D_METHOD("restore_memory_snapshot", "snapshot"), &Agent::restore_memory_snapshot);
+
     ClassDB::bind_method(D_METHOD("call_tool", "tool_name", "params"), &Agent::call_tool);
+    ClassDB::bind_method(D_METHOD("call_tool_async", "tool_name", "params"), &Agent::call_tool_async);
     ClassDB::bind_method(D_METHOD("set_tool_registry", "registry"), &Agent::set_tool_registry);
     ClassDB::bind_method(D_METHOD("get_tool_registry"), &Agent::get_tool_registry);
 
@@ -195,32 +878,31 @@ void Agent::_bind_methods() {
     ClassDB::bind_method(D_METHOD("set_agent_id", "id"), &Agent::set_agent_id);
 
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "agent_id"), "set_agent_id", "get_agent_id");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "action_history_capacity", PROPERTY_HINT_RANGE, "1,4096,1"),
+                 "set_action_history_capacity", "get_action_history_capacity");
+
+    ClassDB::bind_method(D_METHOD("get_last_observation"), &Agent::get_last_observation);
 
     ADD_SIGNAL(MethodInfo("action_decided", PropertyInfo(Variant::DICTIONARY, "action")));
+    ADD_SIGNAL(MethodInfo("action_received", PropertyInfo(Variant::DICTIONARY, "action")));
     ADD_SIGNAL(MethodInfo("perception_received", PropertyInfo(Variant::DICTIONARY, "observations")));
 }
 
-void Agent::_ready() {
-    // Try to find ToolRegistry in the scene tree
-    Node* parent = get_parent();
-    if (parent) {
-        tool_registry = Object::cast_to<ToolRegistry>(parent->get_node_or_null("ToolRegistry"));
-        if (tool_registry) {
-            UtilityFunctions::print("c++ Agent ", agent_id, " connected to ToolRegistry");
+ToolRegistry* Agent::_resolve_tool_registry() {
+    // Looked up once, on the first tool call, rather than by every agent at startup
+    if (!tool_registry && !tool_registry_resolved) {
+        tool_registry_resolved = true;
+        Node* parent = get_parent();
+        if (parent) {
+            tool_registry = Object::cast_to<ToolRegistry>(parent->get_node_or_null("ToolRegistry"));
         }
     }
-    UtilityFunctions::print("c++ Agent ", agent_id, " ready");
-}
-
-void Agent::_process(double delta) {
-    if (!is_active) return;
-
-    // Agent processing loop (perception -> decision -> action)
+    return tool_registry;
 }
 
 void Agent::perceive(const Dictionary& observations) {
     emit_signal("perception_received", observations);
-    store_memory("last_observation", observations);
+    last_observation = observations;
 }
 
 Dictionary Agent::decide_action() {
@@ -233,47 +915,63 @@ Dictionary Agent::decide_action() {
 }
 
 void Agent::execute_action(const Dictionary& action) {
-    action_history.append(action);
-    UtilityFunctions::print("c++ Agent ", agent_id, " executing action: ", action["type"]);
+    memory.push_action(action);
+    ARENA_LOG_TRACE("Agent ", agent_id, " executing action: ", action.get("tool", action.get("type", "")));
+
+    // Let the owning wrapper (e.g. SimpleAgent) carry the action out in the world
+    emit_signal("action_received", action);
 }
 
-void Agent::store_memory(const String& key, const Variant& value) {
-    short_term_memory[key] = value;
+void Agent::store_memory(const StringName& key, const Variant& value) {
+    memory.store(key, value);
 }
 
-Variant Agent::retrieve_memory(const String& key) {
-    if (short_term_memory.has(key)) {
-        return short_term_memory[key];
-    }
-    return Variant();
+Variant Agent::retrieve_memory(const StringName& key) const {
+    const Variant* value = memory.get(key);
+    return value ? *value : Variant();
 }
 
 void Agent::clear_short_term_memory() {
-    short_term_memory.clear();
+    memory.clear_entries();
+    last_observation = Variant();
 }
 
-Dictionary Agent::call_tool(const String& tool_name, const Dictionary& params) {
-    Dictionary result;
+void Agent::restore_memory_snapshot(const Dictionary& snapshot) {
+    memory.restore(snapshot);
+    last_observation = Variant();
+}
 
+Dictionary Agent::call_tool(const String& tool_name, const Dictionary& params) {
     // Use manually set tool_registry (for testing only - production code should use SimpleAgent)
-    if (tool_registry) {
-        result = tool_registry->execute_tool(tool_name, params);
-        UtilityFunctions::print("c++ Agent ", agent_id, " called tool '", tool_name, "' via manual ToolRegistry");
-        return result;
+    if (_resolve_tool_registry()) {
+        ARENA_LOG_TRACE("Agent ", agent_id, " called tool '", tool_name, "' via manual ToolRegistry");
+        return tool_registry->execute_tool(tool_name, params, agent_id, this);
     }
 
     // No tool registry available - agent should be wrapped in SimpleAgent for production use
+    Dictionary result;
     result["success"] = false;
     result["error"] = "No ToolRegistry set. Use SimpleAgent wrapper for production code.";
-    UtilityFunctions::print("c++ Agent ", agent_id, " error: No ToolRegistry set for '", tool_name, "'. Consider using SimpleAgent wrapper.");
+    ARENA_LOG_WARN("Agent ", agent_id, " error: No ToolRegistry set for '", tool_name, "'. Consider using SimpleAgent wrapper.");
 
     return result;
 }
 
+Ref<ToolFuture> Agent::call_tool_async(const String& tool_name, const Dictionary& params) {
+    if (_resolve_tool_registry()) {
+        return tool_registry->call_tool(tool_name, params, agent_id, this);
+    }
+
+    Dictionary result;
+    result["success"] = false;
+    result["error"] = "No ToolRegistry set. Use SimpleAgent wrapper for production code.";
+    return ToolFuture::make_resolved(tool_name, agent_id, result);
+}
+
 void Agent::set_tool_registry(ToolRegistry* registry) {
     tool_registry = registry;
     if (registry) {
-        UtilityFunctions::print("c++ Agent ", agent_id, ": ToolRegistry set");
+        ARENA_LOG_DEBUG("Agent ", agent_id, ": ToolRegistry set");
     }
 }
 
@@ -281,262 +979,1195 @@ void Agent::set_tool_registry(ToolRegistry* registry) {
 // ToolRegistry Implementation
 // ============================================================================
 
-ToolRegistry::ToolRegistry() : ipc_client(nullptr) {}
+ToolRegistry::ToolRegistry()
+    : active_tool_count(0),
+      local_call_count(0),
+      remote_call_count(0),
+      ipc_client(nullptr),
+      ipc_client_resolved(false) {}
 
 ToolRegistry::~ToolRegistry() {}
 
 void ToolRegistry::_bind_methods() {
     ClassDB::bind_method(D_METHOD("register_tool", "name", "schema"), &ToolRegistry::register_tool);
+    ClassDB::bind_method(D_METHOD("register_local_tool", "name", "schema", "handler"), &ToolRegistry::register_local_tool);
+    ClassDB::bind_method(D_METHOD("set_local_handler", "name", "handler"), &ToolRegistry::set_local_handler);
     ClassDB::bind_method(D_METHOD("unregister_tool", "name"), &ToolRegistry::unregister_tool);
+    ClassDB::bind_method(D_METHOD("register_tools", "manifest"), &ToolRegistry::register_tools);
+    ClassDB::bind_method(D_METHOD("load_tool_manifest", "path"), &ToolRegistry::load_tool_manifest);
+    ClassDB::bind_method(D_METHOD("has_tool", "name"), &ToolRegistry::has_tool);
+    ClassDB::bind_method(D_METHOD("is_local_tool", "name"), &ToolRegistry::is_local_tool);
+    ClassDB::bind_method(D_METHOD("get_tool_id", "name"), &ToolRegistry::get_tool_id);
+    ClassDB::bind_method(D_METHOD("get_tool_name", "tool_id"), &ToolRegistry::get_tool_name);
     ClassDB::bind_method(D_METHOD("get_tool_schema", "name"), &ToolRegistry::get_tool_schema);
     ClassDB::bind_method(D_METHOD("get_all_tool_names"), &ToolRegistry::get_all_tool_names);
-    ClassDB::bind_method(D_METHOD("execute_tool", "name", "params"), &ToolRegistry::execute_tool);
+    ClassDB::bind_method(D_METHOD("get_tool_count"), &ToolRegistry::get_tool_count);
+    ClassDB::bind_method(D_METHOD("execute_tool", "name", "params", "agent_id", "agent"), &ToolRegistry::execute_tool,
+                         DEFVAL(""), DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("execute_tool_by_id", "tool_id", "params", "agent_id", "agent"),
+                         &ToolRegistry::execute_tool_by_id, DEFVAL(""), DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("call_tool", "name", "params", "agent_id", "agent"), &ToolRegistry::call_tool,
+                         DEFVAL(""), DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("call_tool_by_id", "tool_id", "params", "agent_id", "agent"),
+                         &ToolRegistry::call_tool_by_id, DEFVAL(""), DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("get_local_call_count"), &ToolRegistry::get_local_call_count);
+    ClassDB::bind_method(D_METHOD("get_remote_call_count"), &ToolRegistry::get_remote_call_count);
     ClassDB::bind_method(D_METHOD("set_ipc_client", "client"), &ToolRegistry::set_ipc_client);
     ClassDB::bind_method(D_METHOD("get_ipc_client"), &ToolRegistry::get_ipc_client);
 }
 
-void ToolRegistry::_ready() {
-    // Try to find IPCClient in the scene tree
-    Node* parent = get_parent();
-    if (parent) {
-        ipc_client = Object::cast_to<IPCClient>(parent->get_node_or_null("IPCClient"));
-        if (ipc_client) {
-            UtilityFunctions::print("c++ ToolRegistry: IPCClient connected");
-        } else {
-            UtilityFunctions::print("c++ ToolRegistry: Warning - No IPCClient found. Tools will not execute.");
+IPCClient* ToolRegistry::_resolve_ipc_client() {
+    // Looked up once, on the first remote call; set_ipc_client() skips it
+    if (!ipc_client && !ipc_client_resolved) {
+        ipc_client_resolved = true;
+        Node* parent = get_parent();
+        if (parent) {
+            ipc_client = Object::cast_to<IPCClient>(parent->get_node_or_null("IPCClient"));
+        }
+        if (!ipc_client) {
+            ARENA_LOG_WARN("ToolRegistry: No IPCClient found. Remote tools will not execute.");
         }
     }
+    return ipc_client;
 }
 
-void ToolRegistry::register_tool(const String& name, const Dictionary& schema) {
-    registered_tools[name] = schema;
-    UtilityFunctions::print("c++ Registered tool: ", name);
+ToolRegistry::ToolEntry* ToolRegistry::_get_entry(int tool_id) {
+    if (tool_id < 0 || tool_id >= (int)tools.size() || !tools[tool_id].active) {
+        return nullptr;
+    }
+    return &tools[tool_id];
 }
 
-void ToolRegistry::unregister_tool(const String& name) {
-    if (registered_tools.has(name)) {
-        registered_tools.erase(name);
-        UtilityFunctions::print("c++ Unregistered tool: ", name);
+int ToolRegistry::_ensure_entry(const StringName& name) {
+    const int* existing = tool_ids.getptr(name);
+    int tool_id;
+    if (existing) {
+        tool_id = *existing;
+    } else {
+        tool_id = (int)tools.size();
+        tools.push_back(ToolEntry());
+        tools[tool_id].name = name;
+        tool_ids.insert(name, tool_id);
     }
-}
 
-Dictionary ToolRegistry::get_tool_schema(const String& name) {
-    if (registered_tools.has(name)) {
-        return registered_tools[name];
+    if (!tools[tool_id].active) {
+        tools[tool_id].active = true;
+        active_tool_count++;
     }
-    return Dictionary();
+    return tool_id;
 }
 
-Array ToolRegistry::get_all_tool_names() {
-    return registered_tools.keys();
+int ToolRegistry::register_tool(const String& name, const Dictionary& schema) {
+    // Re-registering refreshes the schema but keeps any local handler
+    const int tool_id = _ensure_entry(name);
+    tools[tool_id].schema = schema;
+    ARENA_LOG_DEBUG("Registered tool: ", name, " (id ", tool_id, ")");
+    return tool_id;
 }
 
-Dictionary ToolRegistry::execute_tool(const String& name, const Dictionary& params) {
-    Dictionary result;
+int ToolRegistry::register_local_tool(const String& name, const Dictionary& schema, const Callable& handler) {
+    const int tool_id = _ensure_entry(name);
+    tools[tool_id].schema = schema;
+    tools[tool_id].local_handler = handler;
+    ARENA_LOG_DEBUG("Registered local tool: ", name, " (id ", tool_id, ")");
+    return tool_id;
+}
 
-    if (!registered_tools.has(name)) {
-        result["success"] = false;
-        result["error"] = "Tool not found: " + name;
-        return result;
+int ToolRegistry::register_tools(const Variant& manifest) {
+    static const String tools_key("tools");
+    static const String name_key("name");
+
+    Variant list = manifest;
+    if (manifest.get_type() == Variant::DICTIONARY) {
+        const Dictionary dict = manifest;
+        const Variant tools_value = dict.get(tools_key, Variant());
+        if (tools_value.get_type() != Variant::ARRAY) {
+            // name -> schema
+            tools.reserve(tools.size() + (size_t)dict.size());
+            const Array names = dict.keys();
+            int registered = 0;
+            for (int64_t i = 0; i < names.size(); i++) {
+                const Variant schema = dict[names[i]];
+                if (schema.get_type() == Variant::DICTIONARY) {
+                    const int tool_id = _ensure_entry(names[i].stringify());
+                    tools[tool_id].schema = schema;
+                    registered++;
+                }
+            }
+            ARENA_LOG_DEBUG("Registered ", registered, " tools from manifest");
+            return registered;
+        }
+        list = tools_value;
+    }
+    if (list.get_type() != Variant::ARRAY) {
+        ARENA_LOG_WARN("ToolRegistry: tool manifest must be an Array or Dictionary");
+        return 0;
     }
 
-    // Execute tool via IPC if available
-    if (ipc_client) {
-        result = ipc_client->execute_tool_sync(name, params);
-        UtilityFunctions::print("c++ Executed tool '", name, "' via IPC");
-    } else {
-        result["success"] = false;
-        result["error"] = "No IPC client available for tool execution";
-        UtilityFunctions::print("c++ Error: Cannot execute tool '", name, "' - no IPC client");
+    const Array schemas = list;
+    tools.reserve(tools.size() + (size_t)schemas.size());
+    int registered = 0;
+    for (int64_t i = 0; i < schemas.size(); i++) {
+        if (schemas[i].get_type() != Variant::DICTIONARY) {
+            continue;
+        }
+        const Dictionary schema = schemas[i];
+        const Variant name = schema.get(name_key, Variant());
+        if (name.get_type() != Variant::STRING && name.get_type() != Variant::STRING_NAME) {
+            continue;
+        }
+        const int tool_id = _ensure_entry(name.stringify());
+        tools[tool_id].schema = schema;
+        registered++;
     }
+    ARENA_LOG_DEBUG("Registered ", registered, " tools from manifest");
+    return registered;
+}
 
-    return result;
+int ToolRegistry::load_tool_manifest(const String& path) {
+    const PackedByteArray bytes = FileAccess::get_file_as_bytes(path);
+    if (bytes.is_empty()) {
+        ARENA_LOG_ERROR("ToolRegistry: cannot read tool manifest ", path);
+        return -1;
+    }
+
+    JsonReader reader;
+    Variant manifest;
+    if (!reader.parse(bytes, manifest)) {
+        ARENA_LOG_ERROR("ToolRegistry: malformed tool manifest ", path, ": ", reader.get_error());
+        return -1;
+    }
+    return register_tools(manifest);
 }
 
-void ToolRegistry::set_ipc_client(IPCClient* client) {
-    ipc_client = client;
-    if (client) {
-        UtilityFunctions::print("c++ ToolRegistry: IPC client set");
+void ToolRegistry::set_local_handler(const String& name, const Callable& handler) {
+    ToolEntry* entry = _get_entry(get_tool_id(name));
+    if (!entry) {
+        ARENA_LOG_WARN("ToolRegistry: cannot set handler, tool not found: ", name);
+        return;
     }
+    entry->local_handler = handler;
 }
 
-// ============================================================================
-// IPCClient Implementation
-// ============================================================================
+void ToolRegistry::unregister_tool(const String& name) {
+    ToolEntry* entry = _get_entry(get_tool_id(name));
+    if (entry) {
+        entry->active = false;
+        entry->schema = Dictionary();
+        entry->local_handler = Callable();
+        active_tool_count--;
+        ARENA_LOG_DEBUG("Unregistered tool: ", name);
+    }
+}
 
-IPCClient::IPCClient()
-    : server_url("http://127.0.0.1:5000"),
-      http_request(nullptr),
-      http_request_tool(nullptr),
-      is_connected(false),
-      current_tick(0),
-      response_received(false),
-      tool_request_in_progress(false) {
+bool ToolRegistry::has_tool(const String& name) const {
+    return get_tool_id(name) >= 0;
 }
 
-IPCClient::~IPCClient() {
+bool ToolRegistry::is_local_tool(const String& name) const {
+    const int tool_id = get_tool_id(name);
+    return tool_id >= 0 && tools[tool_id].local_handler.is_valid();
+}
 
+int ToolRegistry::get_tool_id(const String& name) const {
+    const int* tool_id = tool_ids.getptr(name);
+    if (!tool_id || !tools[*tool_id].active) {
+        return -1;
+    }
+    return *tool_id;
 }
 
-void IPCClient::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("connect_to_server", "url"), &IPCClient::connect_to_server);
+String ToolRegistry::get_tool_name(int tool_id) const {
+    if (tool_id < 0 || tool_id >= (int)tools.size() || !tools[tool_id].active) {
+        return String();
+    }
+    return tools[tool_id].name;
+}
+
+Dictionary ToolRegistry::get_tool_schema(const String& name) {
+    ToolEntry* entry = _get_entry(get_tool_id(name));
+    return entry ? entry->schema : Dictionary();
+}
+
+Array ToolRegistry::get_all_tool_names() {
+    Array names;
+    for (const ToolEntry& entry : tools) {
+        if (entry.active) {
+            names.append(String(entry.name));
+        }
+    }
+    return names;
+}
+
+Dictionary ToolRegistry::execute_tool(const String& name, const Dictionary& params,
+                                      const String& agent_id, Object* agent) {
+    const int tool_id = get_tool_id(name);
+    if (tool_id < 0) {
+        Dictionary result;
+        result["success"] = false;
+        result["error"] = "Tool not found: " + name;
+        return result;
+    }
+    return execute_tool_by_id(tool_id, params, agent_id, agent);
+}
+
+Dictionary ToolRegistry::execute_tool_by_id(int tool_id, const Dictionary& params,
+                                            const String& agent_id, Object* agent) {
+    ToolEntry* entry = _get_entry(tool_id);
+    if (!entry) {
+        Dictionary result;
+        result["success"] = false;
+        result["error"] = vformat("Tool not found: id %d", tool_id);
+        return result;
+    }
+
+    // Engine-side tool: answer in this frame, no round-trip
+    if (entry->local_handler.is_valid()) {
+        return _run_local_handler(*entry, params, agent);
+    }
+
+    // Execute tool via IPC if available
+    if (_resolve_ipc_client()) {
+        remote_call_count++;
+        ARENA_LOG_TRACE("Executing tool '", entry->name, "' via IPC");
+        return ipc_client->execute_tool_sync(entry->name, params, agent_id);
+    }
+
+    Dictionary result;
+    result["success"] = false;
+    result["error"] = "No IPC client available for tool execution";
+    ARENA_LOG_ERROR("Cannot execute tool '", entry->name, "' - no IPC client");
+    return result;
+}
+
+Dictionary ToolRegistry::_run_local_handler(ToolEntry& entry, const Dictionary& params, Object* agent) {
+    local_call_count++;
+    PerfStats::get().add(PerfStats::COUNTER_LOCAL_TOOL_CALLS);
+    Variant ret = entry.local_handler.call(agent, params);
+    if (ret.get_type() == Variant::DICTIONARY) {
+        return ret;
+    }
+    Dictionary result;
+    result["success"] = false;
+    result["error"] = "Local tool '" + String(entry.name) + "' did not return a Dictionary";
+    return result;
+}
+
+Ref<ToolFuture> ToolRegistry::call_tool(const String& name, const Dictionary& params,
+                                        const String& agent_id, Object* agent) {
+    const int tool_id = get_tool_id(name);
+    if (tool_id < 0) {
+        Dictionary result;
+        result["success"] = false;
+        result["error"] = "Tool not found: " + name;
+        return ToolFuture::make_resolved(name, agent_id, result);
+    }
+    return call_tool_by_id(tool_id, params, agent_id, agent);
+}
+
+Ref<ToolFuture> ToolRegistry::call_tool_by_id(int tool_id, const Dictionary& params,
+                                              const String& agent_id, Object* agent) {
+    ToolEntry* entry = _get_entry(tool_id);
+    if (!entry) {
+        Dictionary result;
+        result["success"] = false;
+        result["error"] = vformat("Tool not found: id %d", tool_id);
+        return ToolFuture::make_resolved(String(), agent_id, result);
+    }
+
+    if (entry->local_handler.is_valid()) {
+        return ToolFuture::make_resolved(entry->name, agent_id, _run_local_handler(*entry, params, agent));
+    }
+
+    if (!_resolve_ipc_client()) {
+        Dictionary result;
+        result["success"] = false;
+        result["error"] = "No IPC client available for tool execution";
+        return ToolFuture::make_resolved(entry->name, agent_id, result);
+    }
+
+    remote_call_count++;
+    return ipc_client->execute_tool_async(entry->name, params, agent_id);
+}
+
+void ToolRegistry::set_ipc_client(IPCClient* client) {
+    ipc_client = client;
+    if (client) {
+        ARENA_LOG_DEBUG("ToolRegistry: IPC client set");
+    }
+}
+
+// ============================================================================
+// IPCClient Implementation
+// ============================================================================
+
+IPCClient::IPCClient()
+    : server_url("http://127.0.0.1:5000"),
+      http_request(nullptr),
+      is_connected(false),
+      current_tick(0),
+      response_received(false),
+      connection_state(CONNECTION_DISCONNECTED),
+      wants_connection(false),
+      auto_reconnect(true),
+      health_check_interval(5.0),
+      reconnect_base_delay(0.5),
+      reconnect_max_delay(30.0),
+      health_probe_pending(false),
+      health_probe_sent_usec(0),
+      last_contact_msec(0),
+      next_reconnect_msec(0),
+      reconnect_attempts(0),
+      next_stream_open_msec(0),
+      stream_open_attempts(0),
+      backend_rtt_ms(0.0),
+      latency_budget_ms(250.0),
+      backpressure(0.0),
+      max_queued_tool_requests(256),
+      max_response_lag(0),
+      transport(TRANSPORT_HTTP),
+      stream_port(5001),
+      observation_deltas(true),
+      decision_cache(DECISION_CACHE_OFF),
+      decision_cache_ttl(30),
+      max_agents_per_tick(0),
+      max_decision_wait(30),
+      idle_decision_interval(1),
+      backpressure_shedding(false),
+      batch_open(false),
+      batch_pending(false),
+      batch_tick(0),
+      pipeline_depth(1),
+      action_latency(ACTION_LATENCY_ON_ARRIVAL),
+      simulation_tick(0),
+      tick_timeout(30.0),
+      stream_was_open(false),
+      max_concurrent_tool_requests(4),
+      active_tool_requests(0),
+      next_tool_request_id(1),
+      tool_timeout(30.0) {
+    json_headers.append("Content-Type: application/json");
+    _update_endpoint_urls();
+}
+
+IPCClient::~IPCClient() {
+
+}
+
+void IPCClient::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("connect_to_server", "url"), &IPCClient::connect_to_server);
     ClassDB::bind_method(D_METHOD("disconnect_from_server"), &IPCClient::disconnect_from_server);
     ClassDB::bind_method(D_METHOD("is_server_connected"), &IPCClient::is_server_connected);
+    ClassDB::bind_method(D_METHOD("get_connection_state"), &IPCClient::get_connection_state);
+    ClassDB::bind_method(D_METHOD("set_auto_reconnect", "enabled"), &IPCClient::set_auto_reconnect);
+    ClassDB::bind_method(D_METHOD("get_auto_reconnect"), &IPCClient::get_auto_reconnect);
+    ClassDB::bind_method(D_METHOD("set_health_check_interval", "seconds"), &IPCClient::set_health_check_interval);
+    ClassDB::bind_method(D_METHOD("get_health_check_interval"), &IPCClient::get_health_check_interval);
+    ClassDB::bind_method(D_METHOD("set_reconnect_base_delay", "seconds"), &IPCClient::set_reconnect_base_delay);
+    ClassDB::bind_method(D_METHOD("get_reconnect_base_delay"), &IPCClient::get_reconnect_base_delay);
+    ClassDB::bind_method(D_METHOD("set_reconnect_max_delay", "seconds"), &IPCClient::set_reconnect_max_delay);
+    ClassDB::bind_method(D_METHOD("get_reconnect_max_delay"), &IPCClient::get_reconnect_max_delay);
+    ClassDB::bind_method(D_METHOD("get_reconnect_attempts"), &IPCClient::get_reconnect_attempts);
+    ClassDB::bind_method(D_METHOD("get_backend_rtt_ms"), &IPCClient::get_backend_rtt_ms);
+    ClassDB::bind_method(D_METHOD("get_connection_stats"), &IPCClient::get_connection_stats);
+    ClassDB::bind_method(D_METHOD("set_latency_budget_ms", "ms"), &IPCClient::set_latency_budget_ms);
+    ClassDB::bind_method(D_METHOD("get_latency_budget_ms"), &IPCClient::get_latency_budget_ms);
+    ClassDB::bind_method(D_METHOD("get_backpressure"), &IPCClient::get_backpressure);
+    ClassDB::bind_method(D_METHOD("set_max_queued_tool_requests", "count"), &IPCClient::set_max_queued_tool_requests);
+    ClassDB::bind_method(D_METHOD("get_max_queued_tool_requests"), &IPCClient::get_max_queued_tool_requests);
+    ClassDB::bind_method(D_METHOD("set_max_response_lag", "ticks"), &IPCClient::set_max_response_lag);
+    ClassDB::bind_method(D_METHOD("get_max_response_lag"), &IPCClient::get_max_response_lag);
 
     ClassDB::bind_method(D_METHOD("send_tick_request", "tick", "perceptions"), &IPCClient::send_tick_request);
+    ClassDB::bind_method(D_METHOD("send_batch_tick_request", "tick"), &IPCClient::send_batch_tick_request);
+    ClassDB::bind_method(D_METHOD("begin_batch"), &IPCClient::begin_batch);
+    ClassDB::bind_method(D_METHOD("end_batch"), &IPCClient::end_batch);
+    ClassDB::bind_method(D_METHOD("is_batch_open"), &IPCClient::is_batch_open);
+    ClassDB::bind_method(D_METHOD("can_send_tick"), &IPCClient::can_send_tick);
+    ClassDB::bind_method(D_METHOD("get_in_flight_tick_count"), &IPCClient::get_in_flight_tick_count);
+    ClassDB::bind_method(D_METHOD("get_deferred_response_count"), &IPCClient::get_deferred_response_count);
+    ClassDB::bind_method(D_METHOD("advance_to_tick", "tick"), &IPCClient::advance_to_tick);
+    ClassDB::bind_method(D_METHOD("set_pipeline_depth", "depth"), &IPCClient::set_pipeline_depth);
+    ClassDB::bind_method(D_METHOD("get_pipeline_depth"), &IPCClient::get_pipeline_depth);
+    ClassDB::bind_method(D_METHOD("set_tick_timeout", "seconds"), &IPCClient::set_tick_timeout);
+    ClassDB::bind_method(D_METHOD("get_tick_timeout"), &IPCClient::get_tick_timeout);
+    ClassDB::bind_method(D_METHOD("set_action_latency", "policy"), &IPCClient::set_action_latency);
+    ClassDB::bind_method(D_METHOD("get_action_latency"), &IPCClient::get_action_latency);
+    ClassDB::bind_method(D_METHOD("register_agent", "agent"), &IPCClient::register_agent);
+    ClassDB::bind_method(D_METHOD("unregister_agent", "agent_id"), &IPCClient::unregister_agent);
+    ClassDB::bind_method(D_METHOD("get_registered_agent_count"), &IPCClient::get_registered_agent_count);
+    ClassDB::bind_method(D_METHOD("set_observation_builder", "builder"), &IPCClient::set_observation_builder);
+    ClassDB::bind_method(D_METHOD("get_observation_builder"), &IPCClient::get_observation_builder);
+    ClassDB::bind_method(D_METHOD("set_observation_deltas", "enabled"), &IPCClient::set_observation_deltas);
+    ClassDB::bind_method(D_METHOD("get_observation_deltas"), &IPCClient::get_observation_deltas);
+    ClassDB::bind_method(D_METHOD("set_decision_cache", "mode"), &IPCClient::set_decision_cache);
+    ClassDB::bind_method(D_METHOD("get_decision_cache"), &IPCClient::get_decision_cache);
+    ClassDB::bind_method(D_METHOD("set_decision_cache_ttl", "ticks"), &IPCClient::set_decision_cache_ttl);
+    ClassDB::bind_method(D_METHOD("get_decision_cache_ttl"), &IPCClient::get_decision_cache_ttl);
+    ClassDB::bind_method(D_METHOD("get_decision_cache_size"), &IPCClient::get_decision_cache_size);
+    ClassDB::bind_method(D_METHOD("clear_decision_cache"), &IPCClient::clear_decision_cache);
+    ClassDB::bind_method(D_METHOD("set_agent_priority", "agent_id", "priority"), &IPCClient::set_agent_priority);
+    ClassDB::bind_method(D_METHOD("get_agent_priority", "agent_id"), &IPCClient::get_agent_priority);
+    ClassDB::bind_method(D_METHOD("set_agent_decision_interval", "agent_id", "ticks"), &IPCClient::set_agent_decision_interval);
+    ClassDB::bind_method(D_METHOD("get_agent_decision_interval", "agent_id"), &IPCClient::get_agent_decision_interval);
+    ClassDB::bind_method(D_METHOD("set_max_agents_per_tick", "count"), &IPCClient::set_max_agents_per_tick);
+    ClassDB::bind_method(D_METHOD("get_max_agents_per_tick"), &IPCClient::get_max_agents_per_tick);
+    ClassDB::bind_method(D_METHOD("set_max_decision_wait", "ticks"), &IPCClient::set_max_decision_wait);
+    ClassDB::bind_method(D_METHOD("get_max_decision_wait"), &IPCClient::get_max_decision_wait);
+    ClassDB::bind_method(D_METHOD("set_idle_decision_interval", "ticks"), &IPCClient::set_idle_decision_interval);
+    ClassDB::bind_method(D_METHOD("get_idle_decision_interval"), &IPCClient::get_idle_decision_interval);
+    ClassDB::bind_method(D_METHOD("set_backpressure_shedding", "enabled"), &IPCClient::set_backpressure_shedding);
+    ClassDB::bind_method(D_METHOD("get_backpressure_shedding"), &IPCClient::get_backpressure_shedding);
     ClassDB::bind_method(D_METHOD("get_tick_response"), &IPCClient::get_tick_response);
     ClassDB::bind_method(D_METHOD("has_response"), &IPCClient::has_response);
 
+    ClassDB::bind_method(D_METHOD("execute_tool_async", "tool_name", "params", "agent_id", "tick", "timeout"),
+                         &IPCClient::execute_tool_async, DEFVAL(""), DEFVAL(0), DEFVAL(-1.0));
+    ClassDB::bind_method(D_METHOD("cancel_tool_request", "request_id"), &IPCClient::cancel_tool_request);
+    ClassDB::bind_method(D_METHOD("get_unresolved_tool_count"), &IPCClient::get_unresolved_tool_count);
+    ClassDB::bind_method(D_METHOD("set_tool_timeout", "seconds"), &IPCClient::set_tool_timeout);
+    ClassDB::bind_method(D_METHOD("get_tool_timeout"), &IPCClient::get_tool_timeout);
     ClassDB::bind_method(D_METHOD("execute_tool_sync", "tool_name", "params", "agent_id", "tick"),
                          &IPCClient::execute_tool_sync);
+    ClassDB::bind_method(D_METHOD("get_pending_tool_request_count"), &IPCClient::get_pending_tool_request_count);
+    ClassDB::bind_method(D_METHOD("get_active_tool_request_count"), &IPCClient::get_active_tool_request_count);
+    ClassDB::bind_method(D_METHOD("set_max_concurrent_tool_requests", "count"), &IPCClient::set_max_concurrent_tool_requests);
+    ClassDB::bind_method(D_METHOD("get_max_concurrent_tool_requests"), &IPCClient::get_max_concurrent_tool_requests);
 
     ClassDB::bind_method(D_METHOD("get_server_url"), &IPCClient::get_server_url);
     ClassDB::bind_method(D_METHOD("set_server_url", "url"), &IPCClient::set_server_url);
 
     ClassDB::bind_method(D_METHOD("_on_request_completed", "result", "response_code", "headers", "body"),
                          &IPCClient::_on_request_completed);
-    ClassDB::bind_method(D_METHOD("_on_tool_request_completed", "result", "response_code", "headers", "body"),
+    ClassDB::bind_method(D_METHOD("_on_tick_request_completed", "result", "response_code", "headers", "body", "slot_index"),
+                         &IPCClient::_on_tick_request_completed);
+    ClassDB::bind_method(D_METHOD("_on_tool_request_completed", "result", "response_code", "headers", "body", "slot_index"),
                          &IPCClient::_on_tool_request_completed);
 
+    ClassDB::bind_method(D_METHOD("set_transport", "mode"), &IPCClient::set_transport);
+    ClassDB::bind_method(D_METHOD("get_transport"), &IPCClient::get_transport);
+    ClassDB::bind_method(D_METHOD("set_stream_port", "port"), &IPCClient::set_stream_port);
+    ClassDB::bind_method(D_METHOD("get_stream_port"), &IPCClient::get_stream_port);
+    ClassDB::bind_method(D_METHOD("is_stream_connected"), &IPCClient::is_stream_connected);
+    ClassDB::bind_method(D_METHOD("set_network_thread", "enabled"), &IPCClient::set_network_thread);
+    ClassDB::bind_method(D_METHOD("get_network_thread"), &IPCClient::get_network_thread);
+
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "server_url"), "set_server_url", "get_server_url");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_reconnect"), "set_auto_reconnect", "get_auto_reconnect");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "health_check_interval"), "set_health_check_interval", "get_health_check_interval");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "reconnect_base_delay"), "set_reconnect_base_delay", "get_reconnect_base_delay");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "reconnect_max_delay"), "set_reconnect_max_delay", "get_reconnect_max_delay");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "latency_budget_ms"), "set_latency_budget_ms", "get_latency_budget_ms");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_queued_tool_requests"), "set_max_queued_tool_requests", "get_max_queued_tool_requests");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_response_lag"), "set_max_response_lag", "get_max_response_lag");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "transport", PROPERTY_HINT_ENUM, "HTTP,Stream"), "set_transport", "get_transport");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "stream_port"), "set_stream_port", "get_stream_port");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "network_thread"), "set_network_thread", "get_network_thread");
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "observation_builder", PROPERTY_HINT_RESOURCE_TYPE, "ObservationBuilder"),
+                 "set_observation_builder", "get_observation_builder");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "observation_deltas"), "set_observation_deltas", "get_observation_deltas");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "decision_cache", PROPERTY_HINT_ENUM, "Off,Replay,Skip"),
+                 "set_decision_cache", "get_decision_cache");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "decision_cache_ttl", PROPERTY_HINT_RANGE, "1,10000,1"),
+                 "set_decision_cache_ttl", "get_decision_cache_ttl");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_agents_per_tick"), "set_max_agents_per_tick", "get_max_agents_per_tick");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_decision_wait"), "set_max_decision_wait", "get_max_decision_wait");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "idle_decision_interval", PROPERTY_HINT_RANGE, "1,1000,1"),
+                 "set_idle_decision_interval", "get_idle_decision_interval");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "backpressure_shedding"), "set_backpressure_shedding", "get_backpressure_shedding");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_concurrent_tool_requests", PROPERTY_HINT_RANGE, "1,64,1"),
+                 "set_max_concurrent_tool_requests", "get_max_concurrent_tool_requests");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tool_timeout"), "set_tool_timeout", "get_tool_timeout");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "pipeline_depth", PROPERTY_HINT_RANGE, "1,16,1"),
+                 "set_pipeline_depth", "get_pipeline_depth");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tick_timeout"), "set_tick_timeout", "get_tick_timeout");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "action_latency", PROPERTY_HINT_ENUM, "On Arrival,Fixed"),
+                 "set_action_latency", "get_action_latency");
+
+    BIND_ENUM_CONSTANT(TRANSPORT_HTTP);
+    BIND_ENUM_CONSTANT(TRANSPORT_STREAM);
+    BIND_ENUM_CONSTANT(ACTION_LATENCY_ON_ARRIVAL);
+    BIND_ENUM_CONSTANT(ACTION_LATENCY_FIXED);
+    BIND_ENUM_CONSTANT(DECISION_CACHE_OFF);
+    BIND_ENUM_CONSTANT(DECISION_CACHE_REPLAY);
+    BIND_ENUM_CONSTANT(DECISION_CACHE_SKIP);
+    BIND_ENUM_CONSTANT(CONNECTION_DISCONNECTED);
+    BIND_ENUM_CONSTANT(CONNECTION_CONNECTING);
+    BIND_ENUM_CONSTANT(CONNECTION_CONNECTED);
+    BIND_ENUM_CONSTANT(CONNECTION_BACKOFF);
 
     ADD_SIGNAL(MethodInfo("response_received", PropertyInfo(Variant::DICTIONARY, "response")));
+    ADD_SIGNAL(MethodInfo("tool_response_received", PropertyInfo(Variant::INT, "request_id"), PropertyInfo(Variant::DICTIONARY, "response")));
+    ADD_SIGNAL(MethodInfo("tick_request_completed", PropertyInfo(Variant::INT, "tick")));
+    ADD_SIGNAL(MethodInfo("tick_request_failed", PropertyInfo(Variant::INT, "tick"), PropertyInfo(Variant::STRING, "error")));
+    ADD_SIGNAL(MethodInfo("tick_actions_routed", PropertyInfo(Variant::INT, "tick"), PropertyInfo(Variant::INT, "action_count")));
     ADD_SIGNAL(MethodInfo("connection_failed", PropertyInfo(Variant::STRING, "error")));
+    ADD_SIGNAL(MethodInfo("connection_state_changed", PropertyInfo(Variant::INT, "state")));
+    ADD_SIGNAL(MethodInfo("backpressure_changed", PropertyInfo(Variant::FLOAT, "level")));
 }
 
-void IPCClient::_ready() {
-    // Create HTTPRequest node for general requests (health check, tick)
-    http_request = memnew(HTTPRequest);
-    http_request->set_timeout(30.0);  // 30 second timeout
-    http_request->set_use_threads(true);  // Enable threading for async requests
+HTTPRequest* IPCClient::_ensure_main_request() {
+    // Created on the first connect, not at _ready, so nodes that never talk to
+    // the backend (and every eval episode's boot) skip it
+    if (http_request != nullptr || !is_inside_tree()) {
+        return http_request;
+    }
 
-    // IMPORTANT: Set the HTTPRequest's name before adding as child
+    http_request = memnew(HTTPRequest);
+    http_request->set_timeout(10.0);  // A probe that takes longer counts as a failure
+    http_request->set_use_threads(true);  // Resolve and connect off the main thread
     http_request->set_name("HTTPRequestMain");
-
     add_child(http_request, false, Node::INTERNAL_MODE_DISABLED);
-
-    // Force the node to be owned by the scene tree
     http_request->set_owner(this);
+    http_request->connect("request_completed", Callable(this, "_on_request_completed"));
+    return http_request;
+}
 
-    UtilityFunctions::print("c++ HTTPRequest created - timeout: ", http_request->get_timeout());
-
-    // Connect signal
-    http_request->connect("request_completed",
-                         Callable(this, "_on_request_completed"));
-
-    // Create separate HTTPRequest node for tool execution
-    http_request_tool = memnew(HTTPRequest);
-    http_request_tool->set_timeout(30.0);  // 30 second timeout
-    http_request_tool->set_use_threads(true);  // Enable threading for async requests
-
-    // Set name for debugging
-    http_request_tool->set_name("HTTPRequestTool");
-
-    add_child(http_request_tool, false, Node::INTERNAL_MODE_DISABLED);
-
-    // Force the node to be owned by the scene tree
-    http_request_tool->set_owner(this);
+void IPCClient::_process(double delta) {
+    const IpcKeys& keys = ipc_keys();
+    if (!tool_futures.is_empty()) {
+        _check_tool_timeouts();
+    }
+    _update_connection();
+    _update_backpressure();
 
-    // Connect signal for tool requests
-    http_request_tool->connect("request_completed",
-                               Callable(this, "_on_tool_request_completed"));
+    if (transport != TRANSPORT_STREAM) {
+        return;
+    }
 
-    UtilityFunctions::print("c++ IPCClient initialized with server URL: ", server_url);
-    UtilityFunctions::print("c++ HTTPRequest nodes created: 2");
-    UtilityFunctions::print("c++ HTTPRequest main path: ", http_request->get_path());
-    UtilityFunctions::print("c++ HTTPRequest tool path: ", http_request_tool->get_path());
-}
+    Array messages;
+    const uint64_t poll_start = PerfStats::now_usec();
+    stream_transport.poll(messages);
+    if (!messages.is_empty()) {
+        // Only polls that delivered something count as response parsing (with
+        // network_thread, decoding already happened on the worker)
+        PerfStats::get().record_span(PerfStats::PHASE_RESPONSE_PARSE, poll_start, PerfStats::now_usec());
+    }
+    for (int i = 0; i < messages.size(); i++) {
+        Dictionary message = messages[i];
+        String type = message.get(keys.type, "");
+        if (type == "tick_response") {
+            _handle_tick_response(message);
+        } else if (type == "error") {
+            // The backend answered, it just couldn't handle the tick; free
+            // its slot now rather than at the tick timeout
+            _mark_backend_alive();
+            String error = message.get(keys.error, "Backend error");
+            if (!message.has(keys.tick)) {
+                ARENA_LOG_WARN("IPCClient: Backend stream error: ", error);
+                continue;
+            }
+            const uint64_t tick = (uint64_t)variant_to_int(message[keys.tick]);
+            ARENA_LOG_WARN("IPCClient: Backend failed tick ", tick, ": ", error);
+            if (_is_in_flight(tick)) {
+                _fail_tick_request(tick, error);
+            }
+        } else {
+            ARENA_LOG_WARN("IPCClient: Unknown stream message type: ", type);
+        }
+    }
 
-void IPCClient::_process(double delta) {
-    // Process method for any per-frame updates
+    // Requests sent on a stream that has since dropped will never be answered
+    const bool stream_open = stream_transport.is_open();
+    if (stream_was_open && !stream_open) {
+        _drop_stream_in_flight();
+        if (observation_builder.is_valid()) {
+            observation_builder->reset_deltas();  // A new connection starts from keyframes
+        }
+    }
+    stream_was_open = stream_open;
 }
 
 void IPCClient::connect_to_server(const String& url) {
     server_url = url;
+    _update_endpoint_urls();
 
-    // Verify http_request exists
-    if (http_request == nullptr) {
-        UtilityFunctions::print("c++ ERROR: http_request is null! IPCClient not properly initialized.");
-        emit_signal("connection_failed", "HTTPRequest not initialized");
-        is_connected = false;
-        return;
-    }
-
-    // Verify http_request is in the scene tree and ready
-    if (!http_request->is_inside_tree()) {
-        UtilityFunctions::print("c++ ERROR: http_request is not in scene tree yet! Waiting for node to be ready.");
+    // The health-check request node needs the client to be in the scene tree
+    if (_ensure_main_request() == nullptr) {
+        ARENA_LOG_ERROR("IPCClient is not in the scene tree yet; cannot connect.");
         emit_signal("connection_failed", "HTTPRequest not ready");
         is_connected = false;
+        _set_connection_state(CONNECTION_DISCONNECTED);
         return;
     }
 
     // Check if http_request is already processing a request
     HTTPClient::Status status = http_request->get_http_client_status();
-    UtilityFunctions::print("c++ HTTPRequest status before request: ", (int)status);
+    ARENA_LOG_DEBUG("HTTPRequest status before request: ", (int)status);
 
     if (status != HTTPClient::STATUS_DISCONNECTED) {
-        UtilityFunctions::print("c++ Warning: HTTPRequest is busy (status=", (int)status, "), cancelling previous request");
+        ARENA_LOG_WARN("HTTPRequest is busy (status=", (int)status, "), cancelling previous request");
         http_request->cancel_request();
-        // Give it a moment to cancel
-        // Note: In a real scenario, we might want to retry this call after a delay
+        health_probe_pending = false;
     }
 
-    // Test connection with health check
-    String health_url = server_url + "/health";
-    UtilityFunctions::print("c++ Attempting HTTP request to: ", health_url);
-    Error err = http_request->request(health_url);
-
-    if (err != OK) {
-        UtilityFunctions::print("c++ Failed to connect to server: ", server_url, " Error code: ", err);
-        emit_signal("connection_failed", "HTTP request failed");
-        is_connected = false;
-    } else {
-        UtilityFunctions::print("c++ Connecting to IPC server: ", server_url);
+    // Test connection with health check; failures from here on are retried
+    // with backoff (see _update_connection)
+    wants_connection = true;
+    reconnect_attempts = 0;
+    _set_connection_state(CONNECTION_CONNECTING);
+    ARENA_LOG_INFO("Connecting to IPC server: ", server_url);
+    _send_health_probe();
+
+    // Open the persistent binary stream alongside the HTTP health check
+    if (transport == TRANSPORT_STREAM) {
+        stream_open_attempts = 0;
+        next_stream_open_msec = 0;
+        stream_transport.open(_get_server_host(), stream_port);
     }
 }
 
 void IPCClient::disconnect_from_server() {
     is_connected = false;
-    http_request->cancel_request();
-    UtilityFunctions::print("c++ Disconnected from IPC server");
+    wants_connection = false;
+    health_probe_pending = false;
+    _set_connection_state(CONNECTION_DISCONNECTED);
+    if (http_request != nullptr) {
+        http_request->cancel_request();
+    }
+    stream_transport.close();
+    if (observation_builder.is_valid()) {
+        observation_builder->reset_deltas();
+    }
+    ARENA_LOG_INFO("Disconnected from IPC server");
 }
 
 void IPCClient::set_server_url(const String& url) {
     server_url = url;
+    _update_endpoint_urls();
+}
+
+void IPCClient::_update_endpoint_urls() {
+    health_url = server_url + "/health";
+    tick_url = server_url + "/tick";
+    tool_url = server_url + "/tools/execute";
+}
+
+void IPCClient::set_transport(Transport mode) {
+    transport = mode;
+    if (transport != TRANSPORT_STREAM) {
+        stream_transport.close();
+        if (observation_builder.is_valid()) {
+            observation_builder->reset_deltas();
+        }
+    }
+}
+
+void IPCClient::set_observation_deltas(bool enabled) {
+    if (enabled && !observation_deltas && observation_builder.is_valid()) {
+        observation_builder->reset_deltas();  // Its sent state is from before deltas were off
+    }
+    observation_deltas = enabled;
+}
+
+String IPCClient::_get_server_host() const {
+    // "http://127.0.0.1:5000/..." -> "127.0.0.1"
+    String host = server_url.trim_prefix("http://").trim_prefix("https://");
+    return host.get_slice("/", 0).get_slice(":", 0);
 }
 
 void IPCClient::send_tick_request(uint64_t tick, const Array& perceptions) {
+    const IpcKeys& keys = ipc_keys();
+    advance_to_tick(tick);
+
+    // Accept either {agent_id, observations} entries or flat per-agent perception dicts
+    Array agents;
+    for (int i = 0; i < perceptions.size(); i++) {
+        Dictionary perception = perceptions[i];
+        if (perception.has(keys.observations)) {
+            agents.append(perception);
+        } else {
+            Dictionary agent_entry;
+            agent_entry[keys.agent_id] = perception.get(keys.agent_id, "");
+            agent_entry[keys.observations] = perception;
+            agents.append(agent_entry);
+        }
+    }
+
+    _send_tick_payload(tick, agents);
+}
+
+void IPCClient::begin_batch() {
+    batch_open = true;
+    batch_pending = false;
+}
+
+bool IPCClient::end_batch() {
+    batch_open = false;
+    if (!batch_pending) {
+        return false;
+    }
+    batch_pending = false;
+    // The window already advanced simulation_tick, possibly past batch_tick
+    _send_gathered_tick(batch_tick);
+    return true;
+}
+
+void IPCClient::send_batch_tick_request(uint64_t tick) {
+    if (!batch_open) {
+        advance_to_tick(tick);
+        _send_gathered_tick(tick);
+        return;
+    }
+
+    // Registered agents are gathered once, when the window closes. Worlds
+    // stepped together should agree on the tick; if one lags, ask for the
+    // oldest so no world's decisions arrive stamped for its future
+    if (!batch_pending) {
+        batch_tick = tick;
+        advance_to_tick(tick);
+    } else if (tick != batch_tick) {
+        ARENA_LOG_WARN("Batched worlds disagree on the tick (", (int64_t)batch_tick, " vs ", (int64_t)tick, "), using the lowest");
+        batch_tick = Math::min(batch_tick, tick);
+        if (tick > simulation_tick) {
+            advance_to_tick(tick);  // Never backwards: that reads as a reset
+        }
+    }
+    batch_pending = true;
+}
+
+void IPCClient::_send_gathered_tick(uint64_t tick) {
+    const IpcKeys& keys = ipc_keys();
+    if (!can_send_tick()) {
+        PerfStats::get().add(PerfStats::COUNTER_TICKS_SKIPPED);
+        ARENA_LOG_DEBUG("Decision pipeline full (", (int64_t)in_flight_ticks.size(), " in flight), skipping tick ", tick);
+        return;
+    }
+
+    // Gather every registered Agent due for a decision (by its interval, and
+    // not served from the decision cache), then keep the most urgent ones
+    Array agents;
+    stale_agent_ids.clear();
+    packed_observations.clear();
+    decision_candidates.clear();
+    replayed_actions.clear();
+    const bool use_cache = decision_cache != DECISION_CACHE_OFF && observation_builder.is_valid();
+    bool any_skipped = false;
+    for (const KeyValue<String, uint64_t>& entry : registered_agents) {
+        Agent* agent = Object::cast_to<Agent>(ObjectDB::get_instance(entry.value));
+        if (agent == nullptr) {
+            stale_agent_ids.push_back(entry.key);
+            continue;
+        }
+
+        DecisionCandidate candidate;
+        candidate.agent_id = entry.key;
+        candidate.instance_id = entry.value;
+        // Buffers are fetched once the transport is known (delta or full)
+        candidate.packed = observation_builder.is_valid() && observation_builder->has_observation(entry.key, (int64_t)tick);
+        if (!candidate.packed && agent->get_last_observation().get_type() != Variant::DICTIONARY) {
+            continue;  // Agent hasn't perceived anything yet
+        }
+
+        if (!_is_decision_due(agent_schedules[entry.key], tick, candidate)) {
+            PerfStats::get().add(PerfStats::COUNTER_DECISIONS_THROTTLED);
+            any_skipped = true;
+            continue;
+        }
+
+        if (candidate.packed && use_cache &&
+            observation_builder->get_native_fingerprint(entry.key, (int64_t)tick, candidate.fingerprint)) {
+            candidate.has_fingerprint = true;
+            if (_serve_cached_decision(entry.key, candidate.fingerprint, tick)) {
+                any_skipped = true;
+                continue;
+            }
+        }
+        decision_candidates.push_back(candidate);
+    }
+
+    for (const String& stale_id : stale_agent_ids) {
+        registered_agents.erase(stale_id);
+        agent_schedules.erase(stale_id);
+    }
+
+    if (!replayed_actions.is_empty()) {
+        // Replayed decisions keep the same latency as backend ones, or a
+        // cache hit would act pipeline_depth ticks early
+        const uint64_t apply_tick = tick + (action_latency == ACTION_LATENCY_FIXED ? (uint64_t)pipeline_depth : 0);
+        if (apply_tick > simulation_tick) {
+            Dictionary replay;
+            replay[keys.tick] = (int64_t)tick;
+            replay[keys.actions] = replayed_actions.duplicate();  // The member is reused next tick
+            _defer_response(apply_tick, replay, true);
+        } else {
+            _route_tick_actions(replayed_actions);
+        }
+    }
+
+    _schedule_decisions(tick);
+    if (decision_candidates.empty() && any_skipped) {
+        return;  // Every agent was throttled or served from the cache
+    }
+
+    for (const DecisionCandidate& candidate : decision_candidates) {
+        if (candidate.has_fingerprint) {
+            _mark_decision_pending(candidate.agent_id, candidate.fingerprint, tick);
+        }
+        if (candidate.packed) {
+            packed_observations.push_back(PackedObservation{candidate.agent_id, nullptr});
+            continue;
+        }
+
+        Agent* agent = Object::cast_to<Agent>(ObjectDB::get_instance(candidate.instance_id));
+        if (agent == nullptr) {
+            continue;  // Freed by a replayed action
+        }
+        Dictionary agent_entry;
+        agent_entry[keys.agent_id] = candidate.agent_id;
+        agent_entry[keys.observations] = agent->get_last_observation();
+        agents.append(agent_entry);
+    }
+
+    if (!packed_observations.empty()) {
+        // Packed buffers go out verbatim inside a stream frame
+        if (transport == TRANSPORT_STREAM && stream_transport.is_open()) {
+            // The stream is ordered, so the backend can rebuild deltas
+            for (PackedObservation& packed : packed_observations) {
+                packed.buffer = observation_deltas
+                                    ? observation_builder->get_native_delta_buffer(packed.agent_id, (int64_t)tick)
+                                    : observation_builder->get_native_buffer(packed.agent_id, (int64_t)tick);
+            }
+            current_tick = tick;
+            response_received = false;
+            Error stream_err = _send_packed_tick_frame(tick, agents);
+            if (stream_err == OK) {
+                _push_in_flight(tick, true);
+                return;
+            }
+            ARENA_LOG_WARN("Stream tick send failed (", stream_err, "), falling back to HTTP");
+            if (observation_deltas) {
+                observation_builder->reset_deltas();  // Those deltas never arrived
+            }
+        }
+
+        // JSON needs Variants: decode the packed observations
+        for (PackedObservation& packed : packed_observations) {
+            packed.buffer = observation_builder->get_native_buffer(packed.agent_id, (int64_t)tick);
+            Variant observation;
+            if (!MsgPackCodec::decode(packed.buffer->data(), packed.buffer->size(), observation)) {
+                ARENA_LOG_WARN("Failed to decode packed observation for ", packed.agent_id);
+                continue;
+            }
+            Dictionary agent_entry;
+            agent_entry[keys.agent_id] = packed.agent_id;
+            agent_entry[keys.observations] = observation;
+            agents.append(agent_entry);
+        }
+    }
+
+    _send_tick_payload(tick, agents);
+}
+
+Error IPCClient::_send_packed_tick_frame(uint64_t tick, const Array& agents) {
+    // Same shape as _send_tick_payload's request, written field by field so
+    // the packed observations can be spliced in without a decode/encode pass
+    const uint64_t serialize_start = PerfStats::now_usec();
+    std::vector<uint8_t>& out = stream_transport.begin_frame();
+    MsgPackCodec::write_map_header(out, 4);
+    MsgPackCodec::write_str(out, "type");
+    MsgPackCodec::write_str(out, "tick");
+    MsgPackCodec::write_str(out, "tick");
+    MsgPackCodec::write_int(out, (int64_t)tick);
+    MsgPackCodec::write_str(out, "agents");
+    MsgPackCodec::write_array_header(out, (uint32_t)(agents.size() + packed_observations.size()));
+    for (int i = 0; i < agents.size(); i++) {
+        MsgPackCodec::encode(agents[i], out);
+    }
+    for (const PackedObservation& packed : packed_observations) {
+        MsgPackCodec::write_map_header(out, 2);
+        MsgPackCodec::write_str(out, "agent_id");
+        MsgPackCodec::write_str(out, packed.agent_id);
+        MsgPackCodec::write_str(out, "observations");
+        out.insert(out.end(), packed.buffer->begin(), packed.buffer->end());
+    }
+    MsgPackCodec::write_str(out, "simulation_state");
+    MsgPackCodec::write_map_header(out, 0);
+
+    const uint64_t send_start = PerfStats::now_usec();
+    PerfStats& perf = PerfStats::get();
+    perf.record_span(PerfStats::PHASE_SERIALIZE, serialize_start, send_start);
+    perf.add(PerfStats::COUNTER_BYTES_SENT, out.size());
+    Error err = stream_transport.send_frame();
+    perf.record_span(PerfStats::PHASE_IPC_SEND, send_start, PerfStats::now_usec());
+    return err;
+}
+
+void IPCClient::_send_tick_payload(uint64_t tick, const Array& agents) {
+    const IpcKeys& keys = ipc_keys();
     if (!is_connected) {
-        UtilityFunctions::print("c++ Warning: Sending request while not connected");
+        ARENA_LOG_DEBUG("Sending request while not connected");
+    }
+
+    if (!can_send_tick()) {
+        PerfStats::get().add(PerfStats::COUNTER_TICKS_SKIPPED);
+        ARENA_LOG_DEBUG("Decision pipeline full (", (int64_t)in_flight_ticks.size(), " in flight), skipping tick ", tick);
+        return;
     }
 
     current_tick = tick;
     response_received = false;
 
     // Build request JSON
-    Dictionary request_dict;
-    request_dict["tick"] = tick;
-    request_dict["perceptions"] = perceptions;
-    request_dict["simulation_state"] = Dictionary();
+    Dictionary& request_dict = tick_request;
+    if (request_dict.is_empty()) {
+        request_dict[keys.simulation_state] = Dictionary();
+    }
+    request_dict[keys.tick] = tick;
+    request_dict[keys.agents] = agents;
+
+    // Prefer the persistent binary stream when it's up
+    if (transport == TRANSPORT_STREAM && stream_transport.is_open()) {
+        request_dict[keys.type] = "tick";
+        const uint64_t serialize_start = PerfStats::now_usec();
+        std::vector<uint8_t>& out = stream_transport.begin_frame();
+        MsgPackCodec::encode(request_dict, out);
+        request_dict.erase(keys.type);
+
+        const uint64_t send_start = PerfStats::now_usec();
+        PerfStats& perf = PerfStats::get();
+        perf.record_span(PerfStats::PHASE_SERIALIZE, serialize_start, send_start);
+        perf.add(PerfStats::COUNTER_BYTES_SENT, out.size());
+        Error stream_err = stream_transport.send_frame();
+        perf.record_span(PerfStats::PHASE_IPC_SEND, send_start, PerfStats::now_usec());
+        if (stream_err == OK) {
+            request_dict[keys.agents] = Variant();  // Don't keep the observations alive
+            _push_in_flight(tick, true);
+            return;
+        }
+        ARENA_LOG_WARN("Stream tick send failed (", stream_err, "), falling back to HTTP");
+    }
 
+    // Each in-flight HTTP tick needs its own HTTPRequest node
+    int slot_index = _acquire_tick_slot();
+    if (slot_index < 0) {
+        PerfStats::get().add(PerfStats::COUNTER_TICKS_SKIPPED);
+        ARENA_LOG_DEBUG("No HTTP tick slot available, skipping tick ", tick);
+        return;
+    }
+
+    const uint64_t serialize_start = PerfStats::now_usec();
     String json = JSON::stringify(request_dict);
+    request_dict[keys.agents] = Variant();
 
-    // Send POST request
-    String url = server_url + "/tick";
-    PackedStringArray headers;
-    headers.append("Content-Type: application/json");
+    const uint64_t send_start = PerfStats::now_usec();
+    PerfStats& perf = PerfStats::get();
+    perf.record_span(PerfStats::PHASE_SERIALIZE, serialize_start, send_start);
+    perf.add(PerfStats::COUNTER_BYTES_SENT, json.length());  // Payloads are ASCII JSON
 
-    Error err = http_request->request(url, headers, HTTPClient::METHOD_POST, json);
+    TickSlot& slot = tick_slots[slot_index];
+    Error err = slot.http->request(tick_url, json_headers, HTTPClient::METHOD_POST, json);
+    perf.record_span(PerfStats::PHASE_IPC_SEND, send_start, PerfStats::now_usec());
 
     if (err != OK) {
-        UtilityFunctions::print("c++ Error sending tick request: ", err);
+        ARENA_LOG_ERROR("Error sending tick request: ", err);
+        return;
+    }
+
+    slot.busy = true;
+    slot.tick = tick;
+    _push_in_flight(tick, false);
+}
+
+void IPCClient::register_agent(Agent* agent) {
+    if (agent == nullptr) {
+        return;
+    }
+    registered_agents[agent->get_agent_id()] = agent->get_instance_id();
+    if (!agent_schedules.has(agent->get_agent_id())) {
+        agent_schedules.insert(agent->get_agent_id(), AgentSchedule());
+    }
+    ARENA_LOG_DEBUG("IPCClient: Registered agent ", agent->get_agent_id(), " for batched ticks");
+}
+
+void IPCClient::unregister_agent(const String& agent_id) {
+    registered_agents.erase(agent_id);
+    cached_decisions.erase(agent_id);
+    agent_schedules.erase(agent_id);
+}
+
+void IPCClient::set_agent_priority(const String& agent_id, double priority) {
+    agent_schedules[agent_id].priority = Math::max(0.0, priority);
+}
+
+double IPCClient::get_agent_priority(const String& agent_id) const {
+    const AgentSchedule* schedule = agent_schedules.getptr(agent_id);
+    return schedule ? schedule->priority : 1.0;
+}
+
+void IPCClient::set_agent_decision_interval(const String& agent_id, int ticks) {
+    agent_schedules[agent_id].interval = ticks < 1 ? 1 : ticks;
+}
+
+int IPCClient::get_agent_decision_interval(const String& agent_id) const {
+    const AgentSchedule* schedule = agent_schedules.getptr(agent_id);
+    return schedule ? schedule->interval : 1;
+}
+
+void IPCClient::set_max_agents_per_tick(int count) {
+    max_agents_per_tick = count < 0 ? 0 : count;
+}
+
+void IPCClient::set_max_decision_wait(int ticks) {
+    max_decision_wait = ticks < 0 ? 0 : ticks;
+}
+
+void IPCClient::set_idle_decision_interval(int ticks) {
+    idle_decision_interval = ticks < 1 ? 1 : ticks;
+}
+
+bool IPCClient::_is_decision_due(const AgentSchedule& schedule, uint64_t tick, DecisionCandidate& r_candidate) const {
+    // Never asked (or the simulation was reset): due, and first in line
+    if (!schedule.requested || tick < schedule.last_request_tick) {
+        r_candidate.starving = true;
+        r_candidate.score = schedule.priority * (double)Math::max(max_decision_wait, 1);
+        return true;
+    }
+
+    const uint64_t waited = tick - schedule.last_request_tick;
+    const int interval = schedule.idle ? Math::max(schedule.interval, idle_decision_interval) : schedule.interval;
+    if (waited < (uint64_t)interval) {
+        return false;
+    }
+    r_candidate.starving = max_decision_wait > 0 && waited >= (uint64_t)max_decision_wait;
+    r_candidate.score = schedule.priority * (double)waited;
+    return true;
+}
+
+int IPCClient::_get_decision_budget(int candidate_count) const {
+    int budget = max_agents_per_tick > 0 ? Math::min(max_agents_per_tick, candidate_count) : candidate_count;
+    if (backpressure_shedding && backpressure > 0.0 && budget > 1) {
+        budget = Math::max(1, (int)Math::ceil(budget * (1.0 - backpressure)));
+    }
+    return budget;
+}
+
+void IPCClient::_schedule_decisions(uint64_t tick) {
+    const int budget = _get_decision_budget((int)decision_candidates.size());
+    if (budget < (int)decision_candidates.size()) {
+        // Starving agents first, then by score; stable, so ties keep registration order
+        std::stable_sort(decision_candidates.begin(), decision_candidates.end(),
+                         [](const DecisionCandidate& a, const DecisionCandidate& b) {
+                             if (a.starving != b.starving) {
+                                 return a.starving;
+                             }
+                             return a.score > b.score;
+                         });
+        PerfStats::get().add(PerfStats::COUNTER_DECISIONS_DEFERRED, decision_candidates.size() - (size_t)budget);
+        decision_candidates.erase(decision_candidates.begin() + budget, decision_candidates.end());
+    }
+
+    for (const DecisionCandidate& candidate : decision_candidates) {
+        AgentSchedule& schedule = agent_schedules[candidate.agent_id];
+        schedule.requested = true;
+        schedule.last_request_tick = tick;
+    }
+}
+
+void IPCClient::set_decision_cache(DecisionCache mode) {
+    decision_cache = mode;
+    if (decision_cache == DECISION_CACHE_OFF) {
+        cached_decisions.clear();
+    }
+}
+
+void IPCClient::set_decision_cache_ttl(int ticks) {
+    decision_cache_ttl = ticks < 1 ? 1 : ticks;
+}
+
+bool IPCClient::_serve_cached_decision(const String& agent_id, uint64_t fingerprint, uint64_t tick) {
+    const CachedDecision* cached = cached_decisions.getptr(agent_id);
+    if (!cached || !cached->valid || cached->fingerprint != fingerprint || tick < cached->decided_tick ||
+        tick - cached->decided_tick > (uint64_t)decision_cache_ttl) {
+        return false;
+    }
+
+    PerfStats::get().add(PerfStats::COUNTER_DECISION_CACHE_HITS);
+    if (decision_cache == DECISION_CACHE_REPLAY) {
+        const IpcKeys& keys = ipc_keys();
+        Dictionary entry;
+        entry[keys.agent_id] = agent_id;
+        entry[keys.action] = cached->action.duplicate();  // Handlers may annotate it
+        replayed_actions.append(entry);
+    }
+
+    // A served decision counts as asked, so the agent doesn't look starved
+    AgentSchedule& schedule = agent_schedules[agent_id];
+    schedule.requested = true;
+    schedule.last_request_tick = tick;
+    return true;
+}
+
+void IPCClient::_mark_decision_pending(const String& agent_id, uint64_t fingerprint, uint64_t tick) {
+    // With several ticks in flight, keep waiting on the oldest request
+    // for this fingerprint (unless it looks lost) so one gets recorded
+    CachedDecision& cached = cached_decisions[agent_id];
+    if (!cached.pending || cached.pending_fingerprint != fingerprint || tick < cached.pending_tick ||
+        tick - cached.pending_tick > (uint64_t)decision_cache_ttl) {
+        cached.pending = true;
+        cached.pending_fingerprint = fingerprint;
+        cached.pending_tick = tick;
+    }
+}
+
+void IPCClient::_record_decisions(uint64_t tick, const Array& actions) {
+    const IpcKeys& keys = ipc_keys();
+    for (int i = 0; i < actions.size(); i++) {
+        if (actions[i].get_type() != Variant::DICTIONARY) {
+            continue;
+        }
+        Dictionary entry = actions[i];
+        CachedDecision* cached = cached_decisions.getptr(entry.get(keys.agent_id, ""));
+        if (!cached || !cached->pending || cached->pending_tick != tick) {
+            continue;  // Superseded by a newer request, or never cached
+        }
+        cached->valid = true;
+        cached->fingerprint = cached->pending_fingerprint;
+        cached->decided_tick = tick;
+        cached->action = entry.get(keys.action, Variant());
+        cached->pending = false;
+    }
+}
+
+void IPCClient::_route_tick_actions(const Array& actions) {
+    const IpcKeys& keys = ipc_keys();
+    ScopedPerfTimer timer(PerfStats::PHASE_ACTION_EXECUTE);
+    for (int i = 0; i < actions.size(); i++) {
+        if (actions[i].get_type() != Variant::DICTIONARY) {
+            continue;
+        }
+        Dictionary entry = actions[i];
+        String agent_id = entry.get(keys.agent_id, "");
+
+        HashMap<String, uint64_t>::Iterator it = registered_agents.find(agent_id);
+        if (it == registered_agents.end()) {
+            ARENA_LOG_WARN("IPCClient: Action for unknown agent ", agent_id);
+            continue;
+        }
+
+        Agent* agent = Object::cast_to<Agent>(ObjectDB::get_instance(it->value));
+        if (agent == nullptr) {
+            registered_agents.remove(it);
+            continue;
+        }
+
+        Dictionary action = entry.get(keys.action, Variant());  // Nil default: no empty Dictionary built per agent
+        if (AgentSchedule* schedule = agent_schedules.getptr(agent_id)) {
+            const String tool = action.get(keys.tool, String());
+            schedule->idle = tool.is_empty() || tool == keys.idle || tool == keys.wait;
+        }
+        agent->execute_action(action);
     }
 }
 
 Dictionary IPCClient::get_tick_response() {
     if (response_received) {
+        // Hand the response over rather than keeping a second reference alive
         response_received = false;
-        return pending_response;
+        Dictionary response = pending_response;
+        pending_response = Dictionary();
+        return response;
     }
     return Dictionary();
 }
@@ -544,177 +2175,837 @@ Dictionary IPCClient::get_tick_response() {
 void IPCClient::_on_request_completed(int result, int response_code,
                                       const PackedStringArray& headers,
                                       const PackedByteArray& body) {
-    UtilityFunctions::print("c++ [C++] _on_request_completed called! result=", result, " response_code=", response_code);
+    ARENA_LOG_TRACE("_on_request_completed called! result=", result, " response_code=", response_code);
+    const bool was_probe = health_probe_pending;
+    health_probe_pending = false;
+    if (!wants_connection) {
+        return;  // Disconnected while the probe was in flight
+    }
 
+    // Only the first failure in a row is reported; retries stay quiet
     if (result != HTTPRequest::RESULT_SUCCESS) {
-        UtilityFunctions::print("c++ HTTP Request failed with result: ", result);
-        emit_signal("connection_failed", "Request failed");
-        is_connected = false;
+        ARENA_LOG_ERROR("HTTP Request failed with result: ", result);
+        _on_backend_unreachable("Request failed", reconnect_attempts == 0);
         return;
     }
 
-    if (response_code == 200) {
-        // Parse JSON response
-        String body_string = body.get_string_from_utf8();
+    // A probe that found the request node busy borrowed this response; its
+    // send time is unknown, so it gives no RTT sample
+    if (was_probe && health_probe_sent_usec != 0) {
+        _record_rtt(health_probe_sent_usec);
+    }
+    health_probe_sent_usec = 0;
 
-        // Parse JSON using Ref<JSON> (required in Godot 4)
-        Ref<JSON> json;
-        json.instantiate();
-        Error err = json->parse(body_string);
+    if (response_code == 200) {
+        if (is_connected) {
+            _mark_backend_alive();  // Keep-alive answered
+            return;
+        }
 
-        if (err == OK) {
-            Variant data = json->get_data();
+        // First contact (or a reconnect): surface the health response
+        // Parse JSON straight from the body bytes
+        Variant data;
+        if (json_reader.parse(body, data)) {
             if (data.get_type() == Variant::DICTIONARY) {
-                pending_response = data;
-                response_received = true;
-                is_connected = true;
-
-                emit_signal("response_received", pending_response);
-
-                UtilityFunctions::print("c++ Received tick response for tick ", current_tick);
+                _mark_backend_alive();
+                _handle_tick_response(data);
             } else {
-                UtilityFunctions::print("c++ Invalid JSON response format");
+                ARENA_LOG_WARN("Invalid JSON response format");
             }
         } else {
-            UtilityFunctions::print("c++ Failed to parse JSON response");
+            ARENA_LOG_WARN("Failed to parse JSON response: ", json_reader.get_error());
         }
     } else {
-        UtilityFunctions::print("c++ HTTP request returned error code: ", response_code);
-        is_connected = false;
+        // The backend answered, so it is reachable; only this request failed
+        ARENA_LOG_WARN("HTTP request returned error code: ", response_code);
+        _mark_backend_alive();
     }
 }
 
-void IPCClient::_on_tool_request_completed(int result, int response_code,
-                                           const PackedStringArray& headers,
-                                           const PackedByteArray& body) {
-    UtilityFunctions::print("c++ [C++] Tool request callback triggered - result: ", result, ", code: ", response_code);
+void IPCClient::_set_connection_state(ConnectionState state) {
+    if (state == connection_state) {
+        return;
+    }
+    connection_state = state;
+    emit_signal("connection_state_changed", (int64_t)state);
+}
 
-    // Mark request as no longer in progress
-    tool_request_in_progress = false;
+void IPCClient::_send_health_probe() {
+    const Error err = http_request->request(health_url);
+    if (err == OK) {
+        health_probe_pending = true;
+        health_probe_sent_usec = PerfStats::now_usec();
+    } else if (err == ERR_BUSY) {
+        // The request already in flight answers for it, but isn't timed as a probe
+        health_probe_pending = true;
+        health_probe_sent_usec = 0;
+    } else {
+        ARENA_LOG_ERROR("Failed to connect to server: ", server_url, " Error code: ", err);
+        _on_backend_unreachable("HTTP request failed", reconnect_attempts == 0);
+    }
+}
 
-    if (result != HTTPRequest::RESULT_SUCCESS) {
-        UtilityFunctions::print("c++ Tool HTTP Request failed with result: ", result);
-        // Process next request even on failure
-        _process_next_tool_request();
+void IPCClient::_mark_backend_alive() {
+    is_connected = true;
+    last_contact_msec = Time::get_singleton()->get_ticks_msec();
+    if (reconnect_attempts > 0) {
+        ARENA_LOG_INFO("Reconnected to IPC server after ", reconnect_attempts, " failed attempt(s)");
+        reconnect_attempts = 0;
+    }
+    if (wants_connection) {
+        _set_connection_state(CONNECTION_CONNECTED);
+    }
+}
+
+void IPCClient::_on_backend_unreachable(const String& reason, bool emit_failed) {
+    is_connected = false;
+
+    if (!wants_connection || !auto_reconnect) {
+        _set_connection_state(CONNECTION_DISCONNECTED);
+    } else if (connection_state != CONNECTION_BACKOFF) {
+        // Failures while already backing off keep the current schedule
+        const double delay = Math::min(reconnect_max_delay,
+                                       reconnect_base_delay * Math::pow(2.0, (double)Math::min(reconnect_attempts, 16)));
+        reconnect_attempts++;
+        next_reconnect_msec = Time::get_singleton()->get_ticks_msec() + (uint64_t)(delay * 1000.0);
+        ARENA_LOG_WARN("IPC backend unreachable (", reason, "), retrying in ", delay, "s");
+        _set_connection_state(CONNECTION_BACKOFF);
+    }
+
+    if (emit_failed) {
+        emit_signal("connection_failed", reason);
+    }
+}
+
+void IPCClient::_record_rtt(uint64_t sent_usec) {
+    const double rtt_ms = (double)(PerfStats::now_usec() - sent_usec) / 1000.0;
+    // Exponentially weighted, so one slow response doesn't swing backpressure
+    backend_rtt_ms = backend_rtt_ms <= 0.0 ? rtt_ms : backend_rtt_ms + 0.2 * (rtt_ms - backend_rtt_ms);
+}
+
+void IPCClient::_update_connection() {
+    if (!wants_connection || http_request == nullptr || !http_request->is_inside_tree()) {
         return;
     }
 
-    if (response_code == 200) {
-        // Parse JSON response
-        String body_string = body.get_string_from_utf8();
+    const uint64_t now = Time::get_singleton()->get_ticks_msec();
+    if (connection_state == CONNECTION_BACKOFF) {
+        if (auto_reconnect && !health_probe_pending && now >= next_reconnect_msec) {
+            PerfStats::get().add(PerfStats::COUNTER_RECONNECT_ATTEMPTS);
+            ARENA_LOG_DEBUG("Reconnect attempt ", reconnect_attempts, " to ", server_url);
+            _set_connection_state(CONNECTION_CONNECTING);
+            _send_health_probe();
+        }
+        return;
+    }
+    if (connection_state != CONNECTION_CONNECTED) {
+        return;
+    }
+
+    // Keep-alive: only probe when nothing else has been heard for a while
+    if (health_check_interval > 0.0 && !health_probe_pending &&
+        now - last_contact_msec >= (uint64_t)(health_check_interval * 1000.0)) {
+        _send_health_probe();
+    }
 
-        // Parse JSON using Ref<JSON> (required in Godot 4)
-        Ref<JSON> json;
-        json.instantiate();
-        Error err = json->parse(body_string);
+    // Reopen a dropped stream while HTTP still reaches the backend
+    if (transport == TRANSPORT_STREAM && !stream_transport.is_open() && !stream_transport.is_connecting() &&
+        now >= next_stream_open_msec) {
+        const double delay = Math::min(reconnect_max_delay,
+                                       reconnect_base_delay * Math::pow(2.0, (double)Math::min(stream_open_attempts, 16)));
+        stream_open_attempts++;
+        next_stream_open_msec = now + (uint64_t)(delay * 1000.0);
+        PerfStats::get().add(PerfStats::COUNTER_RECONNECT_ATTEMPTS);
+        stream_transport.open(_get_server_host(), stream_port);
+    } else if (stream_transport.is_open()) {
+        stream_open_attempts = 0;
+    }
+}
 
-        if (err == OK) {
-            Variant data = json->get_data();
-            if (data.get_type() == Variant::DICTIONARY) {
-                Dictionary tool_response = data;
-                UtilityFunctions::print("c++ Tool execution response received: ", tool_response);
+void IPCClient::_update_backpressure() {
+    // Stale entries go first, or one lost response would pin the level at 1.0
+    _expire_in_flight_ticks();
+
+    double level = 0.0;
+    if (latency_budget_ms > 0.0) {
+        // A stalled request counts from the moment it was sent, not when it
+        // answers. Entries are in send order, so the first one that hasn't
+        // outlived tick_timeout is the oldest live request (an HTTP tick past
+        // it is about to fail in its HTTPRequest).
+        const uint64_t now = PerfStats::now_usec();
+        const uint64_t limit_usec = (uint64_t)(tick_timeout * 1000000.0);
+        double latency = backend_rtt_ms;
+        for (const InFlightTick& entry : in_flight_ticks) {
+            const uint64_t age_usec = now - entry.sent_usec;
+            if (limit_usec == 0 || age_usec < limit_usec) {
+                latency = Math::max(latency, (double)age_usec / 1000.0);
+                break;
+            }
+        }
+        level = (latency - latency_budget_ms) / latency_budget_ms;
+        level = level < 0.0 ? 0.0 : (level > 1.0 ? 1.0 : level);
+        level = Math::floor(level * 10.0) / 10.0;  // Tenths, so the signal doesn't fire every frame
+    }
+
+    if (level != backpressure) {
+        backpressure = level;
+        emit_signal("backpressure_changed", backpressure);
+    }
+}
 
-                // Add request context to response for routing
-                tool_response["agent_id"] = current_tool_request.get("agent_id", "");
-                tool_response["tool_name"] = current_tool_request.get("tool_name", "");
-                tool_response["tick"] = current_tool_request.get("tick", 0);
+Dictionary IPCClient::get_connection_stats() const {
+    Dictionary stats;
+    stats["state"] = (int64_t)connection_state;
+    stats["connected"] = is_connected;
+    stats["reconnect_attempts"] = reconnect_attempts;
+    stats["backend_rtt_ms"] = backend_rtt_ms;
+    stats["backpressure"] = backpressure;
+    stats["last_contact_msec"] = (int64_t)last_contact_msec;
+    stats["in_flight_ticks"] = (int64_t)in_flight_ticks.size();
+    stats["queued_tool_requests"] = (int64_t)tool_request_queue.size();
+    stats["active_tool_requests"] = active_tool_requests;
+    return stats;
+}
 
-                // Emit signal for async handling
-                emit_signal("response_received", tool_response);
-            } else {
-                UtilityFunctions::print("c++ Invalid tool response JSON format");
+void IPCClient::set_health_check_interval(double seconds) {
+    health_check_interval = Math::max(0.0, seconds);
+}
+
+void IPCClient::set_reconnect_base_delay(double seconds) {
+    reconnect_base_delay = Math::max(0.01, seconds);
+}
+
+void IPCClient::set_reconnect_max_delay(double seconds) {
+    reconnect_max_delay = Math::max(0.01, seconds);
+}
+
+void IPCClient::set_latency_budget_ms(double ms) {
+    latency_budget_ms = Math::max(0.0, ms);
+}
+
+void IPCClient::set_max_queued_tool_requests(int count) {
+    max_queued_tool_requests = count < 0 ? 0 : count;
+}
+
+void IPCClient::set_max_response_lag(int ticks) {
+    max_response_lag = ticks < 0 ? 0 : ticks;
+}
+
+void IPCClient::_handle_tick_response(const Dictionary& response) {
+    const IpcKeys& keys = ipc_keys();
+    _mark_backend_alive();
+
+    // Agents whose delta the backend couldn't apply get a keyframe next tick
+    if (response.has(keys.resync) && observation_builder.is_valid()) {
+        Array resync = response[keys.resync];
+        for (int i = 0; i < resync.size(); i++) {
+            observation_builder->request_keyframe(resync[i]);
+        }
+        ARENA_LOG_DEBUG("Backend requested keyframes for ", resync.size(), " agent(s)");
+    }
+
+    // Tick responses free their pipeline slot on arrival, even if their
+    // actions are held back until the apply tick
+    if (response.has(keys.tick)) {
+        const uint64_t tick = (uint64_t)variant_to_int(response[keys.tick]);
+        if (_finish_in_flight(tick)) {
+            emit_signal("tick_request_completed", (int64_t)tick);
+        }
+
+        // Decisions for a tick long gone only fight the newer ones
+        const uint64_t due_tick = tick + (action_latency == ACTION_LATENCY_FIXED ? (uint64_t)pipeline_depth : 0);
+        if (max_response_lag > 0 && response.has(keys.actions) && simulation_tick > due_tick + (uint64_t)max_response_lag) {
+            PerfStats::get().add(PerfStats::COUNTER_STALE_RESPONSES);
+            ARENA_LOG_DEBUG("Dropped stale actions for tick ", tick, " at tick ", simulation_tick);
+            return;
+        }
+
+        if (action_latency == ACTION_LATENCY_FIXED && response.has(keys.actions)) {
+            const uint64_t apply_tick = tick + (uint64_t)pipeline_depth;
+            if (apply_tick > simulation_tick) {
+                _defer_response(apply_tick, response, false);
+                return;
             }
+            // Too late for its slot: applying now beats dropping the decision
+        }
+    }
+
+    _apply_tick_response(response);
+}
+
+void IPCClient::_defer_response(uint64_t apply_tick, const Dictionary& response, bool replayed) {
+    // After any entry for the same tick, so arrival order is kept
+    std::vector<DeferredResponse>::iterator it = deferred_responses.begin();
+    while (it != deferred_responses.end() && it->apply_tick <= apply_tick) {
+        ++it;
+    }
+    deferred_responses.insert(it, DeferredResponse{apply_tick, response, replayed});
+}
+
+void IPCClient::_apply_tick_response(const Dictionary& response) {
+    const IpcKeys& keys = ipc_keys();
+    pending_response = response;
+    response_received = true;
+
+    // Batched tick responses carry one action per agent
+    if (pending_response.has(keys.actions)) {
+        Array actions = pending_response[keys.actions];
+        if (decision_cache != DECISION_CACHE_OFF && pending_response.has(keys.tick)) {
+            _record_decisions((uint64_t)variant_to_int(pending_response[keys.tick]), actions);
+        }
+        _route_tick_actions(actions);
+        emit_signal("tick_actions_routed", variant_to_int(pending_response.get(keys.tick, 0)), actions.size());
+    }
+
+    emit_signal("response_received", pending_response);
+
+    ARENA_LOG_TRACE("Received tick response for tick ", variant_to_int(pending_response.get(keys.tick, (int64_t)current_tick)));
+}
+
+void IPCClient::advance_to_tick(uint64_t tick) {
+    if (tick < simulation_tick) {
+        // Simulation was reset; held-back actions belong to the old episode
+        deferred_responses.clear();
+    }
+    simulation_tick = tick;
+
+    while (!deferred_responses.empty() && deferred_responses.front().apply_tick <= simulation_tick) {
+        const DeferredResponse deferred = deferred_responses.front();
+        deferred_responses.erase(deferred_responses.begin());
+        if (deferred.replayed) {
+            _route_tick_actions(deferred.response[ipc_keys().actions]);
         } else {
-            UtilityFunctions::print("c++ Failed to parse tool response JSON");
+            _apply_tick_response(deferred.response);
         }
+    }
+}
+
+void IPCClient::_push_in_flight(uint64_t tick, bool via_stream) {
+    in_flight_ticks.push_back(InFlightTick{tick, via_stream, PerfStats::now_usec()});
+    PerfStats::get().add(PerfStats::COUNTER_TICK_REQUESTS);
+}
+
+bool IPCClient::_finish_in_flight(uint64_t tick) {
+    for (std::vector<InFlightTick>::iterator it = in_flight_ticks.begin(); it != in_flight_ticks.end(); ++it) {
+        if (it->tick == tick) {
+            PerfStats& perf = PerfStats::get();
+            perf.record_span(PerfStats::PHASE_BACKEND_WAIT, it->sent_usec, PerfStats::now_usec());
+            perf.add(PerfStats::COUNTER_TICK_RESPONSES);
+            _record_rtt(it->sent_usec);
+            in_flight_ticks.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IPCClient::_is_in_flight(uint64_t tick) const {
+    for (const InFlightTick& in_flight : in_flight_ticks) {
+        if (in_flight.tick == tick) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void IPCClient::_fail_tick_request(uint64_t tick, const String& error) {
+    _finish_in_flight(tick);
+    emit_signal("tick_request_failed", (int64_t)tick, error);
+    emit_signal("tick_request_completed", (int64_t)tick);
+}
+
+void IPCClient::_expire_in_flight_ticks() {
+    // HTTP ticks time out in their HTTPRequest; a stream tick whose response
+    // was lost (malformed frame, unexpected message) would hold its pipeline
+    // slot forever
+    if (tick_timeout <= 0.0 || in_flight_ticks.empty()) {
+        return;
+    }
+
+    const uint64_t now = PerfStats::now_usec();
+    const uint64_t limit_usec = (uint64_t)(tick_timeout * 1000000.0);
+    std::vector<uint64_t> expired;
+    for (size_t i = 0; i < in_flight_ticks.size();) {
+        if (in_flight_ticks[i].via_stream && now - in_flight_ticks[i].sent_usec >= limit_usec) {
+            expired.push_back(in_flight_ticks[i].tick);
+            in_flight_ticks.erase(in_flight_ticks.begin() + i);  // No RTT sample: nothing answered
+        } else {
+            i++;
+        }
+    }
+
+    for (uint64_t tick : expired) {
+        ARENA_LOG_WARN("Tick ", (int64_t)tick, " got no stream response within ", tick_timeout, "s");
+        _fail_tick_request(tick, "Tick response timed out");
+    }
+}
+
+void IPCClient::_drop_stream_in_flight() {
+    int dropped = 0;
+    for (size_t i = 0; i < in_flight_ticks.size();) {
+        if (in_flight_ticks[i].via_stream) {
+            in_flight_ticks.erase(in_flight_ticks.begin() + i);
+            dropped++;
+        } else {
+            i++;
+        }
+    }
+
+    if (dropped > 0) {
+        ARENA_LOG_WARN("Stream lost with ", dropped, " tick request(s) in flight");
+        emit_signal("connection_failed", "Stream connection lost");
+    }
+}
+
+int IPCClient::_acquire_tick_slot() {
+    for (int i = 0; i < (int)tick_slots.size() && i < pipeline_depth; i++) {
+        if (!tick_slots[i].busy) {
+            return i;
+        }
+    }
+
+    if ((int)tick_slots.size() >= pipeline_depth || !is_inside_tree()) {
+        return -1;
+    }
+
+    int slot_index = (int)tick_slots.size();
+
+    HTTPRequest* http = memnew(HTTPRequest);
+    http->set_timeout(tick_timeout);  // Expiry of HTTP ticks comes back through the slot
+    http->set_use_threads(true);  // Enable threading for async requests
+    http->set_name("HTTPRequestTick" + String::num_int64(slot_index));
+    add_child(http, false, Node::INTERNAL_MODE_DISABLED);
+    http->set_owner(this);
+
+    http->connect("request_completed",
+                  Callable(this, "_on_tick_request_completed").bind(slot_index));
+
+    TickSlot slot;
+    slot.http = http;
+    tick_slots.push_back(slot);
+
+    ARENA_LOG_DEBUG("HTTPRequest tick slot created: ", http->get_path());
+    return slot_index;
+}
+
+void IPCClient::_on_tick_request_completed(int result, int response_code,
+                                           const PackedStringArray& headers,
+                                           const PackedByteArray& body,
+                                           int slot_index) {
+    const IpcKeys& keys = ipc_keys();
+    if (slot_index < 0 || slot_index >= (int)tick_slots.size() || !tick_slots[slot_index].busy) {
+        ARENA_LOG_WARN("Tick response for unknown slot ", slot_index, " ignored");
+        return;
+    }
+
+    TickSlot& slot = tick_slots[slot_index];
+    const uint64_t tick = slot.tick;
+    slot.busy = false;
+
+    // Every exit below frees the slot and emits tick_request_completed, so a
+    // lockstep scene waiting on this tick always gets released
+    if (result != HTTPRequest::RESULT_SUCCESS) {
+        ARENA_LOG_ERROR("Tick HTTP Request failed with result: ", result);
+        _on_backend_unreachable("Request failed", true);
+        _fail_tick_request(tick, "HTTP request failed with result " + String::num_int64(result));
+        return;
+    }
+
+    if (response_code != 200) {
+        // Reachable but the tick failed: don't back off a backend that answered
+        ARENA_LOG_WARN("Tick HTTP request returned error code: ", response_code);
+        _mark_backend_alive();
+        _fail_tick_request(tick, "HTTP " + String::num_int64(response_code));
+        return;
+    }
+
+    Variant data;
+    {
+        ScopedPerfTimer timer(PerfStats::PHASE_RESPONSE_PARSE);
+        if (!json_reader.parse(body, data)) {
+            ARENA_LOG_DEBUG("Tick response parse error: ", json_reader.get_error());
+        }
+    }
+
+    if (data.get_type() != Variant::DICTIONARY) {
+        ARENA_LOG_WARN("Invalid tick response JSON");
+        _mark_backend_alive();
+        _fail_tick_request(tick, "Invalid tick response JSON");
+        return;
+    }
+
+    Dictionary response = data;
+    if (!response.has(keys.tick)) {
+        response[keys.tick] = (int64_t)tick;  // Match by the tick this slot carried
+    }
+    const bool tracked = _is_in_flight(tick);
+    _handle_tick_response(response);
+
+    // The response named another tick, or this one was already dropped
+    // (reset, rewind): still report the slot's tick as done
+    if (_finish_in_flight(tick) || !tracked) {
+        emit_signal("tick_request_completed", (int64_t)tick);
+    }
+}
+
+void IPCClient::set_pipeline_depth(int depth) {
+    pipeline_depth = depth < 1 ? 1 : (depth > 16 ? 16 : depth);
+}
+
+void IPCClient::set_tick_timeout(double seconds) {
+    tick_timeout = seconds < 0.0 ? 0.0 : seconds;
+    for (TickSlot& slot : tick_slots) {
+        slot.http->set_timeout(tick_timeout);
+    }
+}
+
+void IPCClient::_on_tool_request_completed(int result, int response_code,
+                                           const PackedStringArray& headers,
+                                           const PackedByteArray& body,
+                                           int slot_index) {
+    const IpcKeys& keys = ipc_keys();
+    if (slot_index < 0 || slot_index >= (int)tool_slots.size() || !tool_slots[slot_index].busy) {
+        ARENA_LOG_WARN("Tool response for unknown slot ", slot_index, " ignored");
+        return;
+    }
+
+    // Release the slot before handling so re-entrant tool calls can reuse it
+    ToolSlot& slot = tool_slots[slot_index];
+    ToolRequest request = slot.request;
+    slot.busy = false;
+    slot.request = ToolRequest();
+    active_tool_requests--;
+
+    ARENA_LOG_TRACE("Tool request ", request.request_id, " callback triggered - result: ", result, ", code: ", response_code);
+
+    Dictionary tool_response;
+    if (result != HTTPRequest::RESULT_SUCCESS) {
+        ARENA_LOG_ERROR("Tool HTTP Request failed with result: ", result);
+        _on_backend_unreachable("Tool request failed", false);
+        tool_response[keys.success] = false;
+        tool_response[keys.error] = "HTTP request failed with result " + String::num_int64(result);
+    } else if (response_code != 200) {
+        ARENA_LOG_WARN("Tool HTTP request returned error code: ", response_code);
+        tool_response[keys.success] = false;
+        tool_response[keys.error] = "HTTP " + String::num_int64(response_code);
     } else {
-        UtilityFunctions::print("c++ Tool HTTP request returned error code: ", response_code);
+        _mark_backend_alive();
+        Variant data;
+        json_reader.parse(body, data);
+        if (data.get_type() == Variant::DICTIONARY) {
+            tool_response = data;
+            ARENA_LOG_TRACE("Tool execution response received: ", tool_response);
+        } else {
+            ARENA_LOG_WARN("Failed to parse tool response JSON: ", json_reader.get_error());
+            tool_response[keys.success] = false;
+            tool_response[keys.error] = "Invalid tool response JSON";
+        }
+    }
+
+    // Add request context to response for routing
+    tool_response[keys.request_id] = (int64_t)request.request_id;
+    tool_response[keys.agent_id] = request.agent_id;
+    tool_response[keys.tool_name] = request.tool_name;
+    tool_response[keys.tick] = (int64_t)request.tick;
+
+    PerfStats::get().record_span(PerfStats::PHASE_TOOL_LATENCY, request.queued_usec, PerfStats::now_usec());
+    _resolve_tool_future(request.request_id, tool_response);
+    emit_signal("tool_response_received", (int64_t)request.request_id, tool_response);
+
+    // Successful responses are also broadcast on the legacy signal
+    if (result == HTTPRequest::RESULT_SUCCESS && response_code == 200) {
+        emit_signal("response_received", tool_response);
     }
 
-    // Process next request in queue
     _process_next_tool_request();
 }
 
+Ref<ToolFuture> IPCClient::execute_tool_async(const String& tool_name, const Dictionary& params,
+                                              const String& agent_id, uint64_t tick, double timeout) {
+    if (!is_connected) {
+        ARENA_LOG_DEBUG("Tool execution while not connected to server");
+    }
+
+    ToolRequest request;
+    request.request_id = next_tool_request_id++;
+    request.tool_name = tool_name;
+    request.params = params;
+    request.agent_id = agent_id;
+    request.tick = tick;
+    request.queued_usec = PerfStats::now_usec();
+    if (const AgentSchedule* schedule = agent_schedules.getptr(agent_id)) {
+        request.priority = schedule->priority;
+    }
+
+    const double seconds = timeout < 0.0 ? tool_timeout : timeout;
+    const uint64_t deadline = seconds > 0.0 ? Time::get_singleton()->get_ticks_msec() + (uint64_t)(seconds * 1000.0) : 0;
+
+    Ref<ToolFuture> future;
+    future.instantiate();
+    future->setup(this, (int64_t)request.request_id, tool_name, agent_id, deadline);
+    tool_futures.insert(request.request_id, future);
+
+    PerfStats& perf = PerfStats::get();
+    perf.add(PerfStats::COUNTER_TOOL_REQUESTS);
+    if (max_queued_tool_requests > 0 && (int)tool_request_queue.size() >= max_queued_tool_requests) {
+        // Fail fast instead of growing a backlog the backend can't drain
+        perf.add(PerfStats::COUNTER_TOOL_REQUESTS_REJECTED);
+        _drop_tool_request(request.request_id, ToolFuture::STATUS_FAILED, "Tool queue full (backend overloaded)");
+        return future;
+    }
+
+    tool_request_queue.push_back(request);
+    perf.set_tool_queue_depth((int)tool_request_queue.size());
+    ARENA_LOG_TRACE("Tool execution request ", request.request_id, " queued for '", tool_name, "' (queue size: ", (int64_t)tool_request_queue.size(), ")");
+
+    _process_next_tool_request();
+    return future;
+}
+
 Dictionary IPCClient::execute_tool_sync(const String& tool_name, const Dictionary& params,
                                         const String& agent_id, uint64_t tick) {
+    Ref<ToolFuture> future = execute_tool_async(tool_name, params, agent_id, tick);
+
+    // Only a failed send resolves before returning. Otherwise nothing has
+    // succeeded yet: report pending, the result arrives with
+    // tool_response_received (or via the future from execute_tool_async)
+    if (future->is_done()) {
+        return future->get_result();
+    }
+
     Dictionary result;
+    result["success"] = false;
+    result["pending"] = true;
+    result["request_id"] = future->get_request_id();
+    return result;
+}
 
-    if (!is_connected) {
-        UtilityFunctions::print("c++ Warning: Tool execution while not connected to server");
+bool IPCClient::cancel_tool_request(int64_t request_id) {
+    if (request_id < 0) {
+        return false;
+    }
+    return _drop_tool_request((uint64_t)request_id, ToolFuture::STATUS_CANCELLED, "Tool request cancelled");
+}
+
+void IPCClient::set_tool_timeout(double seconds) {
+    tool_timeout = seconds < 0.0 ? 0.0 : seconds;
+}
+
+void IPCClient::_resolve_tool_future(uint64_t request_id, const Dictionary& response) {
+    Ref<ToolFuture>* entry = tool_futures.getptr(request_id);
+    if (!entry) {
+        return;
     }
+    // Erase first: completion handlers may issue new tool calls
+    Ref<ToolFuture> future = *entry;
+    tool_futures.erase(request_id);
+    future->resolve(response);
+}
 
-    // Build request dictionary
-    Dictionary request_dict;
-    request_dict["tool_name"] = tool_name;
-    request_dict["params"] = params;
-    request_dict["agent_id"] = agent_id;
-    request_dict["tick"] = tick;
+bool IPCClient::_drop_tool_request(uint64_t request_id, ToolFuture::Status status, const String& error) {
+    Ref<ToolFuture>* entry = tool_futures.getptr(request_id);
+    if (!entry) {
+        return false;
+    }
+    Ref<ToolFuture> future = *entry;
+    tool_futures.erase(request_id);
+
+    // An in-flight request frees its slot; a queued one leaves the queue so
+    // it no longer counts against max_queued_tool_requests
+    bool freed_slot = false;
+    for (ToolSlot& slot : tool_slots) {
+        if (slot.busy && slot.request.request_id == request_id) {
+            slot.http->cancel_request();
+            slot.busy = false;
+            slot.request = ToolRequest();
+            active_tool_requests--;
+            freed_slot = true;
+            break;
+        }
+    }
+    if (!freed_slot) {
+        for (size_t i = 0; i < tool_request_queue.size(); i++) {
+            if (tool_request_queue[i].request_id == request_id) {
+                _take_queued_tool_request(i);
+                PerfStats::get().set_tool_queue_depth((int)tool_request_queue.size());
+                break;
+            }
+        }
+    }
 
-    // Add request to queue
-    tool_request_queue.append(request_dict);
-    UtilityFunctions::print("c++ Tool execution request queued for '", tool_name, "' (queue size: ", tool_request_queue.size(), ")");
+    ARENA_LOG_DEBUG("Tool request ", (int64_t)request_id, " dropped: ", error);
+    future->abandon(status, error);
+    emit_signal("tool_response_received", (int64_t)request_id, future->get_result());
 
-    // If no request is in progress, start processing
-    if (!tool_request_in_progress) {
+    if (freed_slot) {
         _process_next_tool_request();
     }
+    return true;
+}
+
+void IPCClient::_check_tool_timeouts() {
+    const uint64_t now = Time::get_singleton()->get_ticks_msec();
+    std::vector<uint64_t> expired;
+    for (const KeyValue<uint64_t, Ref<ToolFuture>>& kv : tool_futures) {
+        const uint64_t deadline = kv.value->get_deadline_msec();
+        if (deadline > 0 && now >= deadline) {
+            expired.push_back(kv.key);
+        }
+    }
+    for (uint64_t request_id : expired) {
+        if (_drop_tool_request(request_id, ToolFuture::STATUS_TIMED_OUT, "Tool request timed out")) {
+            PerfStats::get().add(PerfStats::COUNTER_TOOL_TIMEOUTS);
+        }
+    }
+}
 
-    // Return a pending status - the actual response will come through the signal
-    result["success"] = true;
-    result["result"] = Dictionary();
-    result["note"] = "Tool execution initiated - check response signal";
+void IPCClient::set_max_concurrent_tool_requests(int count) {
+    max_concurrent_tool_requests = count < 1 ? 1 : count;
 
-    return result;
+    // A larger pool may be able to take queued requests right away
+    if (is_inside_tree()) {
+        _process_next_tool_request();
+    }
 }
 
-void IPCClient::_process_next_tool_request() {
-    // If there's already a request in progress, don't start another
-    if (tool_request_in_progress) {
-        return;
+int IPCClient::_acquire_tool_slot() {
+    for (int i = 0; i < (int)tool_slots.size() && i < max_concurrent_tool_requests; i++) {
+        if (!tool_slots[i].busy) {
+            return i;
+        }
     }
 
-    // If queue is empty, nothing to do
-    if (tool_request_queue.size() == 0) {
-        return;
+    if ((int)tool_slots.size() >= max_concurrent_tool_requests || !is_inside_tree()) {
+        return -1;
     }
 
-    // Get the next request from the queue
-    current_tool_request = tool_request_queue[0];
-    tool_request_queue.remove_at(0);
-    tool_request_in_progress = true;
+    int slot_index = (int)tool_slots.size();
+
+    HTTPRequest* http = memnew(HTTPRequest);
+    http->set_timeout(30.0);  // 30 second timeout
+    http->set_use_threads(true);  // Enable threading for async requests
+    http->set_name("HTTPRequestTool" + String::num_int64(slot_index));
+    add_child(http, false, Node::INTERNAL_MODE_DISABLED);
+    http->set_owner(this);
+
+    // The slot index rides along with the signal so responses find their request
+    http->connect("request_completed",
+                  Callable(this, "_on_tool_request_completed").bind(slot_index));
+
+    ToolSlot slot;
+    slot.http = http;
+    tool_slots.push_back(slot);
 
-    // Extract request data
-    String tool_name = current_tool_request["tool_name"];
-    Dictionary params = current_tool_request["params"];
-    String agent_id = current_tool_request.get("agent_id", "");
-    uint64_t tick = current_tool_request.get("tick", 0);
+    ARENA_LOG_DEBUG("HTTPRequest tool slot created: ", http->get_path());
+    return slot_index;
+}
+
+bool IPCClient::_send_tool_request(int slot_index) {
+    const IpcKeys& keys = ipc_keys();
+    ToolSlot& slot = tool_slots[slot_index];
+    const ToolRequest& request = slot.request;
 
     // Build JSON request
-    Dictionary request_dict;
-    request_dict["tool"] = tool_name;
-    request_dict["params"] = params;
-    if (!agent_id.is_empty()) {
-        request_dict["agent_id"] = agent_id;
+    Dictionary& request_dict = tool_request;
+    request_dict[keys.tool] = request.tool_name;
+    request_dict[keys.params] = request.params;
+    request_dict[keys.request_id] = (int64_t)request.request_id;
+    if (!request.agent_id.is_empty()) {
+        request_dict[keys.agent_id] = request.agent_id;
+    } else {
+        request_dict.erase(keys.agent_id);
     }
-    if (tick > 0) {
-        request_dict["tick"] = tick;
+    if (request.tick > 0) {
+        request_dict[keys.tick] = (int64_t)request.tick;
+    } else {
+        request_dict.erase(keys.tick);
     }
 
     String json = JSON::stringify(request_dict);
+    request_dict[keys.params] = Variant();  // Don't keep the caller's params alive
 
     // Send POST request to /tools/execute endpoint
-    String url = server_url + "/tools/execute";
-    PackedStringArray headers;
-    headers.append("Content-Type: application/json");
+    Error err = slot.http->request(tool_url, json_headers, HTTPClient::METHOD_POST, json);
+    if (err != OK) {
+        ARENA_LOG_ERROR("Error sending tool request ", request.request_id, ": ", err);
+        return false;
+    }
 
-    Error err = http_request_tool->request(url, headers, HTTPClient::METHOD_POST, json);
+    ARENA_LOG_TRACE("Sending tool request ", request.request_id, " for '", request.tool_name, "' on slot ", slot_index);
+    return true;
+}
 
-    if (err != OK) {
-        UtilityFunctions::print("c++ Error sending tool request: ", err);
-        tool_request_in_progress = false;
-        // Try to process next request
-        _process_next_tool_request();
-    } else {
-        UtilityFunctions::print("c++ Sending tool request for '", tool_name, "'");
+IPCClient::ToolRequest IPCClient::_pop_next_tool_request() {
+    // Highest priority among the first TOOL_SCHEDULE_WINDOW requests (oldest
+    // on ties), unless one of them has already been passed over too often:
+    // then the oldest such request goes first
+    const size_t window = Math::min(tool_request_queue.size(), TOOL_SCHEDULE_WINDOW);
+    size_t best = 0;
+    for (size_t i = 0; i < window; i++) {
+        if (tool_request_queue[i].bypassed >= MAX_TOOL_BYPASS) {
+            best = i;
+            break;
+        }
+        if (tool_request_queue[i].priority > tool_request_queue[best].priority) {
+            best = i;
+        }
+    }
+    if (best == 0) {
+        return tool_request_queue.pop_front();
+    }
+
+    // Every older request was passed over, not just the front one
+    for (size_t i = 0; i < best; i++) {
+        tool_request_queue[i].bypassed++;
+    }
+    return _take_queued_tool_request(best);
+}
+
+IPCClient::ToolRequest IPCClient::_take_queued_tool_request(size_t index) {
+    ToolRequest taken = std::move(tool_request_queue[index]);
+    for (size_t i = index; i > 0; i--) {
+        tool_request_queue[i] = std::move(tool_request_queue[i - 1]);
+    }
+    tool_request_queue.pop_front();  // The slot vacated by the shift
+    return taken;
+}
+
+void IPCClient::_process_next_tool_request() {
+    const IpcKeys& keys = ipc_keys();
+    // Fill every idle slot from the front of the queue
+    while (!tool_request_queue.empty()) {
+        int slot_index = _acquire_tool_slot();
+        if (slot_index < 0) {
+            return;
+        }
+
+        ToolRequest request = _pop_next_tool_request();
+        PerfStats::get().set_tool_queue_depth((int)tool_request_queue.size());
+        if (!tool_futures.has(request.request_id)) {
+            continue;  // Cancelled or timed out while queued
+        }
+
+        ToolSlot& slot = tool_slots[slot_index];
+        slot.request = request;
+        slot.busy = true;
+        active_tool_requests++;
+
+        if (!_send_tool_request(slot_index)) {
+            ToolRequest failed = slot.request;
+            slot.busy = false;
+            slot.request = ToolRequest();
+            active_tool_requests--;
+
+            Dictionary tool_response;
+            tool_response[keys.success] = false;
+            tool_response[keys.error] = "Failed to send tool request";
+            tool_response[keys.request_id] = (int64_t)failed.request_id;
+            tool_response[keys.agent_id] = failed.agent_id;
+            tool_response[keys.tool_name] = failed.tool_name;
+            tool_response[keys.tick] = (int64_t)failed.tick;
+            PerfStats::get().record_span(PerfStats::PHASE_TOOL_LATENCY, failed.queued_usec, PerfStats::now_usec());
+            _resolve_tool_future(failed.request_id, tool_response);
+            emit_signal("tool_response_received", (int64_t)failed.request_id, tool_response);
+        }
     }
 }
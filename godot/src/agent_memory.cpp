@@ -0,0 +1,107 @@
+#include "agent_memory.h"
+
+#include "msgpack_codec.h"
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// AgentMemory Implementation
+// ============================================================================
+
+AgentMemory::AgentMemory()
+    : action_history(DEFAULT_HISTORY_CAPACITY),
+      history_capacity(DEFAULT_HISTORY_CAPACITY),
+      total_actions(0) {}
+
+void AgentMemory::store(const StringName& key, const Variant& value) {
+    Variant* slot = entries.getptr(key);
+    if (slot) {
+        *slot = value;
+    } else {
+        entries.insert(key, value);
+    }
+}
+
+void AgentMemory::push_action(const Dictionary& action) {
+    if ((int)action_history.size() >= history_capacity) {
+        action_history.pop_front();
+    }
+    action_history.push_back(action);
+    total_actions++;
+}
+
+size_t AgentMemory::_first_recent(int limit) const {
+    const size_t count = action_history.size();
+    if (limit < 0 || (size_t)limit >= count) {
+        return 0;
+    }
+    return count - (size_t)limit;
+}
+
+Array AgentMemory::get_recent_actions(int limit) const {
+    Array actions;
+    for (size_t i = _first_recent(limit); i < action_history.size(); i++) {
+        actions.append(action_history[i]);
+    }
+    return actions;
+}
+
+void AgentMemory::set_history_capacity(int capacity) {
+    history_capacity = capacity < 1 ? 1 : capacity;
+    while ((int)action_history.size() > history_capacity) {
+        action_history.pop_front();
+    }
+}
+
+Dictionary AgentMemory::snapshot(int action_limit) const {
+    Dictionary memory_entries;
+    for (const KeyValue<StringName, Variant>& kv : entries) {
+        memory_entries[kv.key] = kv.value;
+    }
+
+    Dictionary result;
+    result["entries"] = memory_entries;
+    result["recent_actions"] = get_recent_actions(action_limit);
+    result["total_actions"] = (int64_t)total_actions;
+    return result;
+}
+
+void AgentMemory::restore(const Dictionary& snapshot) {
+    entries.clear();
+    const Dictionary memory_entries = snapshot.get("entries", Dictionary());
+    const Array keys = memory_entries.keys();
+    for (int64_t i = 0; i < keys.size(); i++) {
+        entries.insert(StringName(keys[i]), memory_entries[keys[i]]);
+    }
+
+    action_history.clear();
+    const Array actions = snapshot.get("recent_actions", Array());
+    const int64_t first = actions.size() > history_capacity ? actions.size() - history_capacity : 0;
+    for (int64_t i = first; i < actions.size(); i++) {
+        action_history.push_back(actions[i]);
+    }
+    total_actions = (uint64_t)(int64_t)snapshot.get("total_actions", actions.size());
+}
+
+void AgentMemory::encode_snapshot(std::vector<uint8_t>& out, int action_limit) const {
+    // Same shape as snapshot(), written straight from native storage
+    MsgPackCodec::write_map_header(out, 3);
+
+    MsgPackCodec::write_str(out, "entries");
+    MsgPackCodec::write_map_header(out, (uint32_t)entries.size());
+    for (const KeyValue<StringName, Variant>& kv : entries) {
+        MsgPackCodec::write_str(out, kv.key);
+        MsgPackCodec::encode(kv.value, out);
+    }
+
+    const size_t first = _first_recent(action_limit);
+    MsgPackCodec::write_str(out, "recent_actions");
+    MsgPackCodec::write_array_header(out, (uint32_t)(action_history.size() - first));
+    for (size_t i = first; i < action_history.size(); i++) {
+        MsgPackCodec::encode(action_history[i], out);
+    }
+
+    MsgPackCodec::write_str(out, "total_actions");
+    MsgPackCodec::write_int(out, (int64_t)total_actions);
+}
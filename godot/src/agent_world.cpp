@@ -0,0 +1,416 @@
+#include "agent_world.h"
+
+#include "spatial_index.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/char_string.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// AgentWorld Implementation
+// ============================================================================
+
+namespace {
+
+const float DEFAULT_HEALTH = 100.0f;
+
+template <typename T>
+void put_raw(std::vector<uint8_t>& out, const T& value) {
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool get_raw(const uint8_t* data, size_t size, size_t& pos, T& r_value) {
+    if (size - pos < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&r_value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+AgentWorld::AgentWorld()
+    : pending_count(0) {}
+
+AgentWorld::~AgentWorld() {}
+
+void AgentWorld::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_agent", "node", "agent_id", "team"), &AgentWorld::add_agent);
+    ClassDB::bind_method(D_METHOD("remove_agent", "agent_id"), &AgentWorld::remove_agent);
+    ClassDB::bind_method(D_METHOD("clear"), &AgentWorld::clear);
+    ClassDB::bind_method(D_METHOD("find_agent", "agent_id"), &AgentWorld::find_agent);
+    ClassDB::bind_method(D_METHOD("get_agent_count"), &AgentWorld::get_agent_count);
+    ClassDB::bind_method(D_METHOD("get_active_count"), &AgentWorld::get_active_count);
+    ClassDB::bind_method(D_METHOD("sync_from_nodes", "spatial_index"), &AgentWorld::sync_from_nodes, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("capture_state"), &AgentWorld::capture_state);
+    ClassDB::bind_method(D_METHOD("restore_state", "state", "spatial_index"), &AgentWorld::restore_state, DEFVAL(Variant()));
+
+    ClassDB::bind_method(D_METHOD("get_agent_id", "index"), &AgentWorld::get_agent_id);
+    ClassDB::bind_method(D_METHOD("get_team", "index"), &AgentWorld::get_team);
+    ClassDB::bind_method(D_METHOD("get_agent_node", "index"), &AgentWorld::get_agent_node);
+    ClassDB::bind_method(D_METHOD("get_position", "index"), &AgentWorld::get_position);
+    ClassDB::bind_method(D_METHOD("set_position", "index", "position"), &AgentWorld::set_position);
+    ClassDB::bind_method(D_METHOD("get_health", "index"), &AgentWorld::get_health);
+    ClassDB::bind_method(D_METHOD("set_health", "index", "value"), &AgentWorld::set_health);
+    ClassDB::bind_method(D_METHOD("is_agent_active", "index"), &AgentWorld::is_agent_active);
+    ClassDB::bind_method(D_METHOD("set_agent_active", "index", "value"), &AgentWorld::set_agent_active);
+    ClassDB::bind_method(D_METHOD("get_spatial_id", "index"), &AgentWorld::get_spatial_id);
+    ClassDB::bind_method(D_METHOD("set_spatial_id", "index", "spatial_id"), &AgentWorld::set_spatial_id);
+
+    ClassDB::bind_method(D_METHOD("get_ids"), &AgentWorld::get_ids);
+    ClassDB::bind_method(D_METHOD("get_positions"), &AgentWorld::get_positions);
+    ClassDB::bind_method(D_METHOD("get_health_values"), &AgentWorld::get_health_values);
+    ClassDB::bind_method(D_METHOD("get_team_slots", "team"), &AgentWorld::get_team_slots);
+
+    ClassDB::bind_method(D_METHOD("set_pending_action", "index", "action"), &AgentWorld::set_pending_action);
+    ClassDB::bind_method(D_METHOD("has_pending_action", "index"), &AgentWorld::has_pending_action);
+    ClassDB::bind_method(D_METHOD("take_pending_action", "index"), &AgentWorld::take_pending_action);
+    ClassDB::bind_method(D_METHOD("get_pending_action_count"), &AgentWorld::get_pending_action_count);
+    ClassDB::bind_method(D_METHOD("get_pending_slots"), &AgentWorld::get_pending_slots);
+}
+
+int AgentWorld::add_agent(Node3D* node, const String& agent_id, const String& team) {
+    if (const int* existing = index_by_id.getptr(agent_id)) {
+        return *existing;
+    }
+
+    const int index = (int)ids.size();
+    ids.push_back(agent_id);
+    teams.push_back(team);
+    positions.push_back(node ? node->get_global_position() : Vector3());
+    health.push_back(DEFAULT_HEALTH);
+    active.push_back(node ? 1 : 0);
+    has_pending.push_back(0);
+    pending_actions.push_back(Dictionary());
+    node_ids.push_back(node ? node->get_instance_id() : 0);
+    spatial_ids.push_back(-1);
+    index_by_id.insert(agent_id, index);
+    return index;
+}
+
+bool AgentWorld::remove_agent(const String& agent_id) {
+    const int* found = index_by_id.getptr(agent_id);
+    if (!found) {
+        return false;
+    }
+    const int index = *found;
+    const int last = (int)ids.size() - 1;
+    if (has_pending[index]) {
+        pending_count--;
+    }
+
+    if (index != last) {
+        ids[index] = ids[last];
+        teams[index] = teams[last];
+        positions[index] = positions[last];
+        health[index] = health[last];
+        active[index] = active[last];
+        has_pending[index] = has_pending[last];
+        pending_actions[index] = pending_actions[last];
+        node_ids[index] = node_ids[last];
+        spatial_ids[index] = spatial_ids[last];
+        index_by_id[ids[index]] = index;
+    }
+
+    ids.pop_back();
+    teams.pop_back();
+    positions.pop_back();
+    health.pop_back();
+    active.pop_back();
+    has_pending.pop_back();
+    pending_actions.pop_back();
+    node_ids.pop_back();
+    spatial_ids.pop_back();
+    index_by_id.erase(agent_id);
+    return true;
+}
+
+void AgentWorld::clear() {
+    ids.clear();
+    teams.clear();
+    positions.clear();
+    health.clear();
+    active.clear();
+    has_pending.clear();
+    pending_actions.clear();
+    node_ids.clear();
+    spatial_ids.clear();
+    index_by_id.clear();
+    pending_count = 0;
+}
+
+int AgentWorld::find_agent(const String& agent_id) const {
+    const int* found = index_by_id.getptr(agent_id);
+    return found ? *found : -1;
+}
+
+int AgentWorld::get_active_count() const {
+    int count = 0;
+    for (uint8_t flag : active) {
+        count += flag;
+    }
+    return count;
+}
+
+int AgentWorld::sync_from_nodes(SpatialIndex* spatial_index) {
+    static const StringName current_health_name("current_health");
+
+    int active_count = 0;
+    const int count = (int)ids.size();
+    for (int i = 0; i < count; i++) {
+        Node3D* node = node_ids[i] ? Object::cast_to<Node3D>(ObjectDB::get_instance(node_ids[i])) : nullptr;
+        if (!node || !node->is_inside_tree()) {
+            active[i] = 0;
+            continue;
+        }
+        active[i] = 1;
+        active_count++;
+
+        const Vector3 position = node->get_global_position();
+        if (position != positions[i]) {
+            positions[i] = position;
+            if (spatial_index && spatial_ids[i] >= 0) {
+                spatial_index->update(spatial_ids[i], position);
+            }
+        }
+
+        const Variant value = node->get(current_health_name);
+        if (value.get_type() == Variant::FLOAT || value.get_type() == Variant::INT) {
+            health[i] = (float)(double)value;
+        }
+    }
+    return active_count;
+}
+
+PackedByteArray AgentWorld::capture_state() const {
+    const uint32_t count = (uint32_t)ids.size();
+    std::vector<uint8_t> buffer;
+    buffer.reserve(4 + count * (12 + 4 + 1 + 4 + 16));
+
+    put_raw(buffer, count);
+    for (const Vector3& position : positions) {
+        put_raw(buffer, (float)position.x);
+        put_raw(buffer, (float)position.y);
+        put_raw(buffer, (float)position.z);
+    }
+    for (float value : health) {
+        put_raw(buffer, value);
+    }
+    buffer.insert(buffer.end(), active.begin(), active.end());
+    for (const String& id : ids) {
+        const CharString utf8 = id.utf8();
+        put_raw(buffer, (uint32_t)utf8.length());
+        buffer.insert(buffer.end(), utf8.get_data(), utf8.get_data() + utf8.length());
+    }
+
+    PackedByteArray bytes;
+    bytes.resize((int64_t)buffer.size());
+    std::memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    return bytes;
+}
+
+int AgentWorld::restore_state(const PackedByteArray& state, SpatialIndex* spatial_index) {
+    static const StringName current_health_name("current_health");
+
+    const uint8_t* data = state.ptr();
+    const size_t size = (size_t)state.size();
+    size_t pos = 0;
+    uint32_t count = 0;
+    if (!get_raw(data, size, pos, count) || (size - pos) / (12 + 4 + 1 + 4) < count) {
+        return -1;
+    }
+
+    // Columns first, IDs last: read the IDs, then walk the columns by offset
+    const size_t positions_at = pos;
+    const size_t health_at = positions_at + (size_t)count * 12;
+    const size_t active_at = health_at + (size_t)count * 4;
+    pos = active_at + count;
+
+    std::vector<int> slots(count, -1);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t length = 0;
+        if (!get_raw(data, size, pos, length) || size - pos < length) {
+            return -1;
+        }
+        const String id = String::utf8((const char*)data + pos, (int)length);
+        pos += length;
+        // Fast path: same agents in the same order as when captured
+        slots[i] = (i < ids.size() && ids[i] == id) ? (int)i : find_agent(id);
+    }
+
+    int restored = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const int slot = slots[i];
+        if (slot < 0) {
+            continue;
+        }
+        float xyz[3];
+        std::memcpy(xyz, data + positions_at + (size_t)i * 12, sizeof(xyz));
+        std::memcpy(&health[slot], data + health_at + (size_t)i * 4, sizeof(float));
+        positions[slot] = Vector3(xyz[0], xyz[1], xyz[2]);
+        active[slot] = data[active_at + i] ? 1 : 0;
+        if (has_pending[slot]) {
+            has_pending[slot] = 0;
+            pending_actions[slot] = Dictionary();
+            pending_count--;
+        }
+
+        Node3D* node = node_ids[slot] ? Object::cast_to<Node3D>(ObjectDB::get_instance(node_ids[slot])) : nullptr;
+        if (node && node->is_inside_tree()) {
+            node->set_global_position(positions[slot]);
+            const Variant value = node->get(current_health_name);
+            if (value.get_type() == Variant::FLOAT || value.get_type() == Variant::INT) {
+                node->set(current_health_name, health[slot]);
+            }
+        }
+        if (spatial_index && spatial_ids[slot] >= 0) {
+            spatial_index->update(spatial_ids[slot], positions[slot]);
+        }
+        restored++;
+    }
+    return restored;
+}
+
+String AgentWorld::get_agent_id(int index) const {
+    if (!_valid(index)) return String();
+    return ids[index];
+}
+
+String AgentWorld::get_team(int index) const {
+    if (!_valid(index)) return String();
+    return teams[index];
+}
+
+Node3D* AgentWorld::get_agent_node(int index) const {
+    if (!_valid(index)) return nullptr;
+    return node_ids[index] ? Object::cast_to<Node3D>(ObjectDB::get_instance(node_ids[index])) : nullptr;
+}
+
+Vector3 AgentWorld::get_position(int index) const {
+    if (!_valid(index)) return Vector3();
+    return positions[index];
+}
+
+void AgentWorld::set_position(int index, const Vector3& position) {
+    if (!_valid(index)) return;
+    positions[index] = position;
+}
+
+float AgentWorld::get_health(int index) const {
+    if (!_valid(index)) return 0.0f;
+    return health[index];
+}
+
+void AgentWorld::set_health(int index, float value) {
+    if (!_valid(index)) return;
+    health[index] = value;
+}
+
+bool AgentWorld::is_agent_active(int index) const {
+    if (!_valid(index)) return false;
+    return active[index] != 0;
+}
+
+void AgentWorld::set_agent_active(int index, bool value) {
+    if (!_valid(index)) return;
+    active[index] = value ? 1 : 0;
+}
+
+int64_t AgentWorld::get_spatial_id(int index) const {
+    if (!_valid(index)) return -1;
+    return spatial_ids[index];
+}
+
+void AgentWorld::set_spatial_id(int index, int64_t spatial_id) {
+    if (!_valid(index)) return;
+    spatial_ids[index] = spatial_id;
+}
+
+PackedStringArray AgentWorld::get_ids() const {
+    PackedStringArray result;
+    result.resize((int64_t)ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        result.set((int64_t)i, ids[i]);
+    }
+    return result;
+}
+
+PackedVector3Array AgentWorld::get_positions() const {
+    PackedVector3Array result;
+    result.resize((int64_t)positions.size());
+    Vector3* out = result.ptrw();
+    for (size_t i = 0; i < positions.size(); i++) {
+        out[i] = positions[i];
+    }
+    return result;
+}
+
+PackedFloat32Array AgentWorld::get_health_values() const {
+    PackedFloat32Array result;
+    result.resize((int64_t)health.size());
+    float* out = result.ptrw();
+    for (size_t i = 0; i < health.size(); i++) {
+        out[i] = health[i];
+    }
+    return result;
+}
+
+PackedInt32Array AgentWorld::get_team_slots(const String& team) const {
+    PackedInt32Array result;
+    for (size_t i = 0; i < teams.size(); i++) {
+        if (teams[i] == team) {
+            result.push_back((int32_t)i);
+        }
+    }
+    return result;
+}
+
+void AgentWorld::set_pending_action(int index, const Dictionary& action) {
+    if (!_valid(index)) return;
+    if (!has_pending[index]) {
+        has_pending[index] = 1;
+        pending_count++;
+    }
+    pending_actions[index] = action;
+}
+
+bool AgentWorld::has_pending_action(int index) const {
+    if (!_valid(index)) return false;
+    return has_pending[index] != 0;
+}
+
+Dictionary AgentWorld::take_pending_action(int index) {
+    if (!_valid(index)) return Dictionary();
+    if (!has_pending[index]) {
+        return Dictionary();
+    }
+    has_pending[index] = 0;
+    pending_count--;
+    Dictionary action = pending_actions[index];
+    pending_actions[index] = Dictionary();
+    return action;
+}
+
+PackedInt32Array AgentWorld::get_pending_slots() const {
+    PackedInt32Array result;
+    if (pending_count == 0) {
+        return result;
+    }
+    for (size_t i = 0; i < has_pending.size(); i++) {
+        if (has_pending[i]) {
+            result.push_back((int32_t)i);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,175 @@
+#include "arena_log.h"
+
+#include "ring_buffer.h"
+
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <mutex>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// ArenaLog Implementation
+// ============================================================================
+
+namespace {
+
+struct LogEntry {
+    uint64_t time_msec = 0;
+    ArenaLog::Level level = ArenaLog::LEVEL_INFO;
+    String message;
+};
+
+const char* const LEVEL_TAGS[] = {"[trace] ", "[debug] ", "", "[warn] ", "[error] "};
+
+// All sink state; the lock lets future worker threads log too
+struct LogSink {
+    std::mutex lock;
+    bool console_output = true;
+    int rate_limit = 200;
+    int history_capacity = 256;
+    RingBuffer<LogEntry> history{256};
+
+    uint64_t window_start_msec = 0;
+    int window_count = 0;
+    int64_t window_suppressed = 0;
+    int64_t total_suppressed = 0;
+};
+
+LogSink& sink() {
+    static LogSink instance;
+    return instance;
+}
+
+void emit_line(ArenaLog::Level level, const String& message, bool console) {
+    LogSink& s = sink();
+    if ((int)s.history.size() >= s.history_capacity) {
+        s.history.pop_front();
+    }
+    s.history.push_back(LogEntry{Time::get_singleton()->get_ticks_msec(), level, message});
+
+    if (!console) {
+        return;
+    }
+    const String line = String("c++ ") + LEVEL_TAGS[level] + message;
+    if (level >= ArenaLog::LEVEL_ERROR) {
+        UtilityFunctions::printerr(line);
+    } else {
+        UtilityFunctions::print(line);
+    }
+}
+
+} // namespace
+
+void ArenaLog::_bind_methods() {
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("set_level", "level"), &ArenaLog::set_level);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_level"), &ArenaLog::get_level);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_compiled_level"), &ArenaLog::get_compiled_level);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("set_console_output", "enabled"), &ArenaLog::set_console_output);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_console_output"), &ArenaLog::get_console_output);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("set_rate_limit", "messages_per_second"), &ArenaLog::set_rate_limit);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_rate_limit"), &ArenaLog::get_rate_limit);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("set_history_capacity", "capacity"), &ArenaLog::set_history_capacity);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_history_capacity"), &ArenaLog::get_history_capacity);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_recent", "limit"), &ArenaLog::get_recent, DEFVAL(-1));
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("get_suppressed_count"), &ArenaLog::get_suppressed_count);
+    ClassDB::bind_static_method("ArenaLog", D_METHOD("clear_history"), &ArenaLog::clear_history);
+
+    BIND_ENUM_CONSTANT(LEVEL_TRACE);
+    BIND_ENUM_CONSTANT(LEVEL_DEBUG);
+    BIND_ENUM_CONSTANT(LEVEL_INFO);
+    BIND_ENUM_CONSTANT(LEVEL_WARN);
+    BIND_ENUM_CONSTANT(LEVEL_ERROR);
+    BIND_ENUM_CONSTANT(LEVEL_NONE);
+}
+
+void ArenaLog::write(Level level, const String& message) {
+    if (level < LEVEL_TRACE || level >= LEVEL_NONE) {
+        return;
+    }
+
+    LogSink& s = sink();
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    // Fixed one-second windows: cheap, and bursts stay bounded per second
+    const uint64_t now = Time::get_singleton()->get_ticks_msec();
+    if (now - s.window_start_msec >= 1000) {
+        if (s.window_suppressed > 0) {
+            emit_line(LEVEL_WARN, vformat("%d log messages suppressed (rate limit %d/s)", s.window_suppressed, s.rate_limit),
+                      s.console_output);
+        }
+        s.window_start_msec = now;
+        s.window_count = 0;
+        s.window_suppressed = 0;
+    }
+
+    // Errors always get through
+    if (s.rate_limit > 0 && s.window_count >= s.rate_limit && level < LEVEL_ERROR) {
+        s.window_suppressed++;
+        s.total_suppressed++;
+        return;
+    }
+    s.window_count++;
+    emit_line(level, message, s.console_output);
+}
+
+void ArenaLog::set_console_output(bool enabled) {
+    std::lock_guard<std::mutex> guard(sink().lock);
+    sink().console_output = enabled;
+}
+
+bool ArenaLog::get_console_output() {
+    return sink().console_output;
+}
+
+void ArenaLog::set_rate_limit(int messages_per_second) {
+    std::lock_guard<std::mutex> guard(sink().lock);
+    sink().rate_limit = messages_per_second < 0 ? 0 : messages_per_second;
+}
+
+int ArenaLog::get_rate_limit() {
+    return sink().rate_limit;
+}
+
+void ArenaLog::set_history_capacity(int capacity) {
+    LogSink& s = sink();
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.history_capacity = capacity < 1 ? 1 : capacity;
+    while ((int)s.history.size() > s.history_capacity) {
+        s.history.pop_front();
+    }
+}
+
+int ArenaLog::get_history_capacity() {
+    return sink().history_capacity;
+}
+
+Array ArenaLog::get_recent(int limit) {
+    LogSink& s = sink();
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    const size_t count = s.history.size();
+    const size_t first = (limit < 0 || (size_t)limit >= count) ? 0 : count - (size_t)limit;
+    Array entries;
+    for (size_t i = first; i < count; i++) {
+        const LogEntry& entry = s.history[i];
+        Dictionary item;
+        item["time_msec"] = (int64_t)entry.time_msec;
+        item["level"] = (int)entry.level;
+        item["message"] = entry.message;
+        entries.append(item);
+    }
+    return entries;
+}
+
+int64_t ArenaLog::get_suppressed_count() {
+    return sink().total_suppressed;
+}
+
+void ArenaLog::clear_history() {
+    std::lock_guard<std::mutex> guard(sink().lock);
+    sink().history.clear();
+}
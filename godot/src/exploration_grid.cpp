@@ -0,0 +1,643 @@
+#include "exploration_grid.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/array.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// ExplorationGrid Implementation
+// ============================================================================
+
+namespace {
+
+const char* const DIRECTION_NAMES[ExplorationGrid::DIRECTION_COUNT] = {
+    "east", "northeast", "north", "northwest", "west", "southwest", "south", "southeast",
+};
+
+const uint64_t ALL_BITS = ~(uint64_t)0;
+
+inline int popcount64(uint64_t v) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(v);
+#else
+    return __builtin_popcountll(v);
+#endif
+}
+
+inline int lowest_bit(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+Array position_array(const Vector3& position) {
+    Array result;
+    result.append(position.x);
+    result.append(position.y);
+    result.append(position.z);
+    return result;
+}
+
+template <typename T>
+void put_raw(std::vector<uint8_t>& out, const T& value) {
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool get_raw(const uint8_t* data, size_t size, size_t& pos, T& r_value) {
+    if (size - pos < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&r_value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+struct FrontierTarget {
+    double distance;
+    Vector3 position;
+    bool found = false;
+};
+
+} // namespace
+
+ExplorationGrid::ExplorationGrid()
+    : cell_size(2.0),
+      world_min(-25, -25),
+      world_max(25, 25),
+      min_cell_x(0),
+      min_cell_z(0),
+      width(0),
+      height(0),
+      words_per_row(0) {
+    _rebuild();
+}
+
+ExplorationGrid::~ExplorationGrid() {}
+
+void ExplorationGrid::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_world_bounds", "min_pos", "max_pos"), &ExplorationGrid::set_world_bounds);
+    ClassDB::bind_method(D_METHOD("get_world_min"), &ExplorationGrid::get_world_min);
+    ClassDB::bind_method(D_METHOD("get_world_max"), &ExplorationGrid::get_world_max);
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &ExplorationGrid::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &ExplorationGrid::get_cell_size);
+    ClassDB::bind_method(D_METHOD("get_min_cell"), &ExplorationGrid::get_min_cell);
+    ClassDB::bind_method(D_METHOD("get_grid_size"), &ExplorationGrid::get_grid_size);
+    ClassDB::bind_method(D_METHOD("get_total_cells"), &ExplorationGrid::get_total_cells);
+    ClassDB::bind_method(D_METHOD("is_cell_in_bounds", "x", "z"), &ExplorationGrid::is_cell_in_bounds);
+
+    ClassDB::bind_method(D_METHOD("reveal", "layer", "viewer_id", "position", "radius"), &ExplorationGrid::reveal);
+    ClassDB::bind_method(D_METHOD("collect_unseen", "layer", "position", "radius"), &ExplorationGrid::collect_unseen);
+    ClassDB::bind_method(D_METHOD("mark_cells", "layer", "cells"), &ExplorationGrid::mark_cells);
+
+    ClassDB::bind_method(D_METHOD("is_cell_seen", "layer", "x", "z"), &ExplorationGrid::is_cell_seen);
+    ClassDB::bind_method(D_METHOD("is_position_seen", "layer", "position"), &ExplorationGrid::is_position_seen);
+    ClassDB::bind_method(D_METHOD("get_seen_count", "layer"), &ExplorationGrid::get_seen_count);
+    ClassDB::bind_method(D_METHOD("get_exploration_percentage", "layer"), &ExplorationGrid::get_exploration_percentage);
+
+    ClassDB::bind_method(D_METHOD("is_frontier_cell", "layer", "x", "z"), &ExplorationGrid::is_frontier_cell);
+    ClassDB::bind_method(D_METHOD("get_frontier_count", "layer"), &ExplorationGrid::get_frontier_count);
+    ClassDB::bind_method(D_METHOD("get_frontier_cells", "layer"), &ExplorationGrid::get_frontier_cells);
+    ClassDB::bind_method(D_METHOD("find_frontier", "layer", "from", "direction"), &ExplorationGrid::find_frontier);
+    ClassDB::bind_method(D_METHOD("get_summary", "layer", "from", "max_targets"), &ExplorationGrid::get_summary, DEFVAL(5));
+
+    ClassDB::bind_static_method("ExplorationGrid", D_METHOD("direction_between", "from", "to"),
+                                &ExplorationGrid::direction_between);
+    ClassDB::bind_static_method("ExplorationGrid", D_METHOD("direction_name", "direction"),
+                                &ExplorationGrid::direction_name);
+
+    ClassDB::bind_method(D_METHOD("capture_state"), &ExplorationGrid::capture_state);
+    ClassDB::bind_method(D_METHOD("restore_state", "state"), &ExplorationGrid::restore_state);
+    ClassDB::bind_method(D_METHOD("clear_layer", "layer"), &ExplorationGrid::clear_layer);
+    ClassDB::bind_method(D_METHOD("forget_viewer", "viewer_id"), &ExplorationGrid::forget_viewer);
+    ClassDB::bind_method(D_METHOD("clear"), &ExplorationGrid::clear);
+    ClassDB::bind_method(D_METHOD("get_layer_count"), &ExplorationGrid::get_layer_count);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+
+    BIND_ENUM_CONSTANT(DIRECTION_EAST);
+    BIND_ENUM_CONSTANT(DIRECTION_NORTHEAST);
+    BIND_ENUM_CONSTANT(DIRECTION_NORTH);
+    BIND_ENUM_CONSTANT(DIRECTION_NORTHWEST);
+    BIND_ENUM_CONSTANT(DIRECTION_WEST);
+    BIND_ENUM_CONSTANT(DIRECTION_SOUTHWEST);
+    BIND_ENUM_CONSTANT(DIRECTION_SOUTH);
+    BIND_ENUM_CONSTANT(DIRECTION_SOUTHEAST);
+}
+
+void ExplorationGrid::set_world_bounds(const Vector2& min_pos, const Vector2& max_pos) {
+    world_min = min_pos;
+    world_max = max_pos;
+    _rebuild();
+}
+
+void ExplorationGrid::set_cell_size(double size) {
+    cell_size = Math::max(0.1, size);
+    _rebuild();
+}
+
+void ExplorationGrid::_rebuild() {
+    // In bounds: the cell's corner (x * cell_size) lies within [min, max]
+    min_cell_x = (int32_t)std::ceil(world_min.x / cell_size);
+    min_cell_z = (int32_t)std::ceil(world_min.y / cell_size);
+    const int32_t max_cell_x = (int32_t)std::floor(world_max.x / cell_size);
+    const int32_t max_cell_z = (int32_t)std::floor(world_max.y / cell_size);
+    width = max_cell_x >= min_cell_x ? max_cell_x - min_cell_x + 1 : 0;
+    height = max_cell_z >= min_cell_z ? max_cell_z - min_cell_z + 1 : 0;
+    words_per_row = (width + 63) / 64;
+
+    layers.clear();
+    viewers.clear();
+}
+
+ExplorationGrid::Layer& ExplorationGrid::_layer(int layer) {
+    Layer* existing = layers.getptr(layer);
+    if (existing) {
+        return *existing;
+    }
+    Layer& created = layers.insert(layer, Layer())->value;
+    created.seen.assign((size_t)words_per_row * (size_t)height, 0);
+    created.frontier.assign(created.seen.size(), 0);
+    return created;
+}
+
+int32_t ExplorationGrid::_world_to_cell(double v) const {
+    return (int32_t)std::floor(v / cell_size);
+}
+
+Vector3 ExplorationGrid::_cell_center(int32_t x, int32_t z) const {
+    return Vector3((x + 0.5) * cell_size, 0.0, (z + 0.5) * cell_size);
+}
+
+bool ExplorationGrid::_row_span(const Vector3& position, double radius, int32_t row,
+                                int32_t& r_first, int32_t& r_last) const {
+    // Cell centres sit on the ground, so the viewer's height eats into the radius
+    const double dz = (row + 0.5) * cell_size - position.z;
+    const double remaining = radius * radius - dz * dz - position.y * position.y;
+    if (remaining < 0.0) {
+        return false;
+    }
+    const double half = std::sqrt(remaining);
+    const int32_t first = (int32_t)std::ceil((position.x - half) / cell_size - 0.5);
+    const int32_t last = (int32_t)std::floor((position.x + half) / cell_size - 0.5);
+    r_first = first > min_cell_x ? first : min_cell_x;
+    r_last = last < min_cell_x + width - 1 ? last : min_cell_x + width - 1;
+    return r_first <= r_last;
+}
+
+int64_t ExplorationGrid::_mark_span(Layer& layer, int32_t row, int32_t first, int32_t last) {
+    const int32_t c0 = first - min_cell_x;
+    const int32_t c1 = last - min_cell_x;
+    uint64_t* words = layer.seen.data() + (size_t)(row - min_cell_z) * (size_t)words_per_row;
+
+    int64_t added = 0;
+    for (int32_t w = c0 >> 6; w <= c1 >> 6; w++) {
+        uint64_t mask = ALL_BITS;
+        if (w == c0 >> 6) mask &= ALL_BITS << (c0 & 63);
+        if (w == c1 >> 6) mask &= ALL_BITS >> (63 - (c1 & 63));
+        const uint64_t fresh = mask & ~words[w];
+        if (fresh) {
+            added += popcount64(fresh);
+            words[w] |= fresh;
+        }
+    }
+    if (added > 0) {
+        layer.seen_count += added;
+        layer.frontier_dirty = true;
+    }
+    return added;
+}
+
+int64_t ExplorationGrid::reveal(int layer, int64_t viewer_id, const Vector3& position, double radius) {
+    if (width == 0 || height == 0) {
+        return 0;
+    }
+    Layer& target = _layer(layer);
+
+    const Viewer* previous = viewer_id >= 0 ? viewers.getptr(viewer_id) : nullptr;
+    if (previous && previous->layer != layer) {
+        previous = nullptr;
+    }
+    if (previous && previous->position == position && previous->radius == radius) {
+        return 0;
+    }
+
+    int32_t z_first = (int32_t)std::ceil((position.z - radius) / cell_size - 0.5);
+    int32_t z_last = (int32_t)std::floor((position.z + radius) / cell_size - 0.5);
+    z_first = z_first > min_cell_z ? z_first : min_cell_z;
+    z_last = z_last < min_cell_z + height - 1 ? z_last : min_cell_z + height - 1;
+
+    int64_t added = 0;
+    for (int32_t z = z_first; z <= z_last; z++) {
+        int32_t a, b;
+        if (!_row_span(position, radius, z, a, b)) {
+            continue;
+        }
+
+        // Only the part of the row outside the previous disk can be new
+        int32_t c, d;
+        if (!previous || !_row_span(previous->position, previous->radius, z, c, d) || d < a || c > b) {
+            added += _mark_span(target, z, a, b);
+            continue;
+        }
+        if (a < c) {
+            added += _mark_span(target, z, a, c - 1);
+        }
+        if (b > d) {
+            added += _mark_span(target, z, d + 1, b);
+        }
+    }
+
+    if (viewer_id >= 0) {
+        viewers[viewer_id] = Viewer{layer, position, radius};
+    }
+    return added;
+}
+
+PackedInt32Array ExplorationGrid::collect_unseen(int layer, const Vector3& position, double radius) const {
+    PackedInt32Array cells;
+    if (width == 0 || height == 0) {
+        return cells;
+    }
+    const Layer* source = _find_layer(layer);
+
+    for (int32_t z = min_cell_z; z < min_cell_z + height; z++) {
+        int32_t a, b;
+        if (!_row_span(position, radius, z, a, b)) {
+            continue;
+        }
+        const int32_t c0 = a - min_cell_x;
+        const int32_t c1 = b - min_cell_x;
+        const uint64_t* words = source ? source->seen.data() + (size_t)(z - min_cell_z) * (size_t)words_per_row : nullptr;
+        for (int32_t w = c0 >> 6; w <= c1 >> 6; w++) {
+            uint64_t mask = ALL_BITS;
+            if (w == c0 >> 6) mask &= ALL_BITS << (c0 & 63);
+            if (w == c1 >> 6) mask &= ALL_BITS >> (63 - (c1 & 63));
+            uint64_t unseen = words ? mask & ~words[w] : mask;
+            while (unseen) {
+                const int bit = lowest_bit(unseen);
+                unseen &= unseen - 1;
+                cells.append(min_cell_x + w * 64 + bit);
+                cells.append(z);
+            }
+        }
+    }
+    return cells;
+}
+
+int64_t ExplorationGrid::mark_cells(int layer, const PackedInt32Array& cells) {
+    Layer& target = _layer(layer);
+    int64_t added = 0;
+    for (int64_t i = 0; i + 1 < cells.size(); i += 2) {
+        const int32_t x = cells[i];
+        const int32_t z = cells[i + 1];
+        if (is_cell_in_bounds(x, z)) {
+            added += _mark_span(target, z, x, x);
+        }
+    }
+    return added;
+}
+
+bool ExplorationGrid::is_cell_seen(int layer, int x, int z) const {
+    const Layer* source = _find_layer(layer);
+    if (!source || !is_cell_in_bounds(x, z)) {
+        return false;
+    }
+    const int32_t column = x - min_cell_x;
+    const uint64_t word = source->seen[(size_t)(z - min_cell_z) * (size_t)words_per_row + (size_t)(column >> 6)];
+    return (word >> (column & 63)) & 1;
+}
+
+bool ExplorationGrid::is_position_seen(int layer, const Vector3& position) const {
+    return is_cell_seen(layer, _world_to_cell(position.x), _world_to_cell(position.z));
+}
+
+int64_t ExplorationGrid::get_seen_count(int layer) const {
+    const Layer* source = _find_layer(layer);
+    return source ? source->seen_count : 0;
+}
+
+double ExplorationGrid::get_exploration_percentage(int layer) const {
+    const int64_t total = get_total_cells();
+    return total > 0 ? (double)get_seen_count(layer) / (double)total * 100.0 : 0.0;
+}
+
+void ExplorationGrid::_update_frontier(Layer& layer) const {
+    // Out-of-bounds neighbours count as seen, so padding bits and missing
+    // rows/words read as ones
+    const int tail_bits = width & 63;
+    const uint64_t last_word_valid = tail_bits ? (((uint64_t)1 << tail_bits) - 1) : ALL_BITS;
+    auto padded = [&](int32_t row, int32_t w) -> uint64_t {
+        if (row < 0 || row >= height || w < 0 || w >= words_per_row) {
+            return ALL_BITS;
+        }
+        const uint64_t word = layer.seen[(size_t)row * (size_t)words_per_row + (size_t)w];
+        return w == words_per_row - 1 ? word | ~last_word_valid : word;
+    };
+
+    int64_t count = 0;
+    for (int32_t row = 0; row < height; row++) {
+        for (int32_t w = 0; w < words_per_row; w++) {
+            const size_t index = (size_t)row * (size_t)words_per_row + (size_t)w;
+            const uint64_t seen = layer.seen[index];
+            const uint64_t mid = padded(row, w);
+            const uint64_t left = (mid << 1) | (padded(row, w - 1) >> 63);
+            const uint64_t right = (mid >> 1) | (padded(row, w + 1) << 63);
+            const uint64_t enclosed = left & right & padded(row - 1, w) & padded(row + 1, w);
+            const uint64_t frontier = seen & ~enclosed;
+            layer.frontier[index] = frontier;
+            count += popcount64(frontier);
+        }
+    }
+    layer.frontier_count = count;
+    layer.frontier_dirty = false;
+}
+
+const ExplorationGrid::Layer* ExplorationGrid::_frontier_layer(int layer) const {
+    Layer* source = layers.getptr(layer);
+    if (source && source->frontier_dirty) {
+        _update_frontier(*source);
+    }
+    return source;
+}
+
+template <typename F>
+void ExplorationGrid::_for_each_frontier(const Layer& layer, F&& visit) const {
+    for (int32_t row = 0; row < height; row++) {
+        for (int32_t w = 0; w < words_per_row; w++) {
+            uint64_t bits = layer.frontier[(size_t)row * (size_t)words_per_row + (size_t)w];
+            while (bits) {
+                const int bit = lowest_bit(bits);
+                bits &= bits - 1;
+                visit(min_cell_x + w * 64 + bit, min_cell_z + row);
+            }
+        }
+    }
+}
+
+bool ExplorationGrid::is_frontier_cell(int layer, int x, int z) const {
+    const Layer* source = _frontier_layer(layer);
+    if (!source || !is_cell_in_bounds(x, z)) {
+        return false;
+    }
+    const int32_t column = x - min_cell_x;
+    const uint64_t word = source->frontier[(size_t)(z - min_cell_z) * (size_t)words_per_row + (size_t)(column >> 6)];
+    return (word >> (column & 63)) & 1;
+}
+
+int64_t ExplorationGrid::get_frontier_count(int layer) const {
+    const Layer* source = _frontier_layer(layer);
+    return source ? source->frontier_count : 0;
+}
+
+PackedInt32Array ExplorationGrid::get_frontier_cells(int layer) const {
+    PackedInt32Array cells;
+    const Layer* source = _frontier_layer(layer);
+    if (!source) {
+        return cells;
+    }
+    cells.resize(source->frontier_count * 2);
+    int32_t* out = cells.ptrw();
+    _for_each_frontier(*source, [&](int32_t x, int32_t z) {
+        *out++ = x;
+        *out++ = z;
+    });
+    return cells;
+}
+
+const std::vector<uint64_t>* ExplorationGrid::get_frontier_bits(int layer) const {
+    const Layer* source = _frontier_layer(layer);
+    return source ? &source->frontier : nullptr;
+}
+
+ExplorationGrid::Direction ExplorationGrid::direction_between(const Vector3& from, const Vector3& to) {
+    // 0 = east, 90 = north; Godot's +Z points south
+    double angle = Math::rad_to_deg(std::atan2(-(to.z - from.z), to.x - from.x));
+    if (angle < 0.0) {
+        angle += 360.0;
+    }
+    return (Direction)((int)((angle + 22.5) / 45.0) % DIRECTION_COUNT);
+}
+
+String ExplorationGrid::direction_name(Direction direction) {
+    if (direction < 0 || direction >= DIRECTION_COUNT) {
+        return String();
+    }
+    return DIRECTION_NAMES[direction];
+}
+
+Dictionary ExplorationGrid::find_frontier(int layer, const Vector3& from, const String& direction) const {
+    int wanted = -1;
+    for (int i = 0; i < DIRECTION_COUNT; i++) {
+        if (direction == DIRECTION_NAMES[i]) {
+            wanted = i;
+            break;
+        }
+    }
+
+    FrontierTarget best;
+    const Layer* source = _frontier_layer(layer);
+    if (source && wanted >= 0) {
+        _for_each_frontier(*source, [&](int32_t x, int32_t z) {
+            const Vector3 center = _cell_center(x, z);
+            if (direction_between(from, center) != wanted) {
+                return;
+            }
+            const double distance = from.distance_to(center);
+            if (!best.found || distance < best.distance) {
+                best.distance = distance;
+                best.position = center;
+                best.found = true;
+            }
+        });
+    }
+
+    Dictionary result;
+    result["success"] = best.found;
+    result["has_unexplored"] = best.found;
+    if (best.found) {
+        result["position"] = position_array(best.position);
+        result["distance"] = best.distance;
+    } else {
+        result["reason"] = "No unexplored areas in direction: " + direction;
+    }
+    return result;
+}
+
+Dictionary ExplorationGrid::get_summary(int layer, const Vector3& from, int max_targets) const {
+    FrontierTarget best[DIRECTION_COUNT];
+    const Layer* source = _frontier_layer(layer);
+    if (source) {
+        _for_each_frontier(*source, [&](int32_t x, int32_t z) {
+            const Vector3 center = _cell_center(x, z);
+            FrontierTarget& slot = best[direction_between(from, center)];
+            const double distance = from.distance_to(center);
+            if (!slot.found || distance < slot.distance) {
+                slot.distance = distance;
+                slot.position = center;
+                slot.found = true;
+            }
+        });
+    }
+
+    int order[DIRECTION_COUNT];
+    int found_count = 0;
+    Dictionary frontiers_by_direction;
+    for (int i = 0; i < DIRECTION_COUNT; i++) {
+        if (best[i].found) {
+            frontiers_by_direction[DIRECTION_NAMES[i]] = best[i].distance;
+            order[found_count++] = i;
+        }
+    }
+    std::stable_sort(order, order + found_count, [&](int a, int b) { return best[a].distance < best[b].distance; });
+
+    Array explore_targets;
+    for (int i = 0; i < found_count && i < max_targets; i++) {
+        const FrontierTarget& target = best[order[i]];
+        Dictionary entry;
+        entry["direction"] = DIRECTION_NAMES[order[i]];
+        entry["distance"] = target.distance;
+        entry["position"] = position_array(target.position);
+        explore_targets.append(entry);
+    }
+
+    Dictionary result;
+    result["exploration_percentage"] = get_exploration_percentage(layer);
+    result["total_cells"] = get_total_cells();
+    result["seen_cells"] = get_seen_count(layer);
+    result["frontiers_by_direction"] = frontiers_by_direction;
+    result["explore_targets"] = explore_targets;
+    return result;
+}
+
+PackedByteArray ExplorationGrid::capture_state() const {
+    const size_t words = (size_t)height * (size_t)words_per_row;
+    std::vector<uint8_t> buffer;
+    buffer.reserve(24 + layers.size() * (12 + words * 8) + viewers.size() * 44);
+
+    put_raw(buffer, min_cell_x);
+    put_raw(buffer, min_cell_z);
+    put_raw(buffer, width);
+    put_raw(buffer, height);
+
+    put_raw(buffer, (uint32_t)layers.size());
+    for (const KeyValue<int, Layer>& kv : layers) {
+        put_raw(buffer, (int32_t)kv.key);
+        put_raw(buffer, kv.value.seen_count);
+        const uint8_t* bits = reinterpret_cast<const uint8_t*>(kv.value.seen.data());
+        buffer.insert(buffer.end(), bits, bits + words * sizeof(uint64_t));
+    }
+
+    put_raw(buffer, (uint32_t)viewers.size());
+    for (const KeyValue<int64_t, Viewer>& kv : viewers) {
+        put_raw(buffer, kv.key);
+        put_raw(buffer, (int32_t)kv.value.layer);
+        put_raw(buffer, (double)kv.value.position.x);
+        put_raw(buffer, (double)kv.value.position.y);
+        put_raw(buffer, (double)kv.value.position.z);
+        put_raw(buffer, kv.value.radius);
+    }
+
+    PackedByteArray bytes;
+    bytes.resize((int64_t)buffer.size());
+    std::memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    return bytes;
+}
+
+bool ExplorationGrid::restore_state(const PackedByteArray& state) {
+    const uint8_t* data = state.ptr();
+    const size_t size = (size_t)state.size();
+    size_t pos = 0;
+
+    int32_t saved_min_x = 0;
+    int32_t saved_min_z = 0;
+    int32_t saved_width = 0;
+    int32_t saved_height = 0;
+    if (!get_raw(data, size, pos, saved_min_x) || !get_raw(data, size, pos, saved_min_z) ||
+        !get_raw(data, size, pos, saved_width) || !get_raw(data, size, pos, saved_height) ||
+        saved_min_x != min_cell_x || saved_min_z != min_cell_z ||
+        saved_width != width || saved_height != height) {
+        return false;
+    }
+
+    // Parse into fresh maps so a truncated blob leaves the grid as it was
+    const size_t words = (size_t)height * (size_t)words_per_row;
+    HashMap<int, Layer> restored_layers;
+    uint32_t layer_count = 0;
+    if (!get_raw(data, size, pos, layer_count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < layer_count; i++) {
+        int32_t id = 0;
+        Layer layer;
+        if (!get_raw(data, size, pos, id) || !get_raw(data, size, pos, layer.seen_count) ||
+            (size - pos) / sizeof(uint64_t) < words) {
+            return false;
+        }
+        layer.seen.resize(words);
+        layer.frontier.assign(words, 0);
+        std::memcpy(layer.seen.data(), data + pos, words * sizeof(uint64_t));
+        pos += words * sizeof(uint64_t);
+        restored_layers.insert(id, layer);
+    }
+
+    HashMap<int64_t, Viewer> restored_viewers;
+    uint32_t viewer_count = 0;
+    if (!get_raw(data, size, pos, viewer_count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < viewer_count; i++) {
+        int64_t id = 0;
+        int32_t layer = 0;
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        double radius = 0.0;
+        if (!get_raw(data, size, pos, id) || !get_raw(data, size, pos, layer) ||
+            !get_raw(data, size, pos, x) || !get_raw(data, size, pos, y) ||
+            !get_raw(data, size, pos, z) || !get_raw(data, size, pos, radius)) {
+            return false;
+        }
+        restored_viewers.insert(id, Viewer{layer, Vector3(x, y, z), radius});
+    }
+
+    layers = restored_layers;
+    viewers = restored_viewers;
+    return true;
+}
+
+void ExplorationGrid::clear_layer(int layer) {
+    layers.erase(layer);
+
+    std::vector<int64_t> stale;
+    for (const KeyValue<int64_t, Viewer>& kv : viewers) {
+        if (kv.value.layer == layer) {
+            stale.push_back(kv.key);
+        }
+    }
+    for (int64_t viewer_id : stale) {
+        viewers.erase(viewer_id);
+    }
+}
+
+void ExplorationGrid::clear() {
+    layers.clear();
+    viewers.clear();
+}
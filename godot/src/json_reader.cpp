@@ -0,0 +1,430 @@
+#include "json_reader.h"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// JsonReader Implementation
+// ============================================================================
+
+namespace {
+
+const int MAX_DEPTH = 128;
+const size_t MAX_KEY_LENGTH = 64;     // Longer keys are decoded, not interned
+const size_t MAX_CACHED_KEYS = 1024;  // Bounds the table if a backend sends dynamic keys
+
+// Exactly representable powers of ten, for the fast float path
+const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool is_digit(uint8_t c) {
+    return c >= '0' && c <= '9';
+}
+
+int hex_value(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+} // namespace
+
+JsonReader::JsonReader()
+    : data(nullptr),
+      size(0),
+      pos(0) {}
+
+bool JsonReader::parse(const PackedByteArray& bytes, Variant& r_value) {
+    return parse(bytes.ptr(), (size_t)bytes.size(), r_value);
+}
+
+bool JsonReader::parse(const uint8_t* p_data, size_t p_size, Variant& r_value) {
+    data = p_data;
+    size = p_data ? p_size : 0;
+    pos = 0;
+    error = String();
+
+    Variant value;
+    bool ok = _read_value(value, 0);
+    if (ok) {
+        _skip_whitespace();
+        ok = pos == size || _fail("Unexpected data after the document");
+    }
+    if (ok) {
+        r_value = value;
+    }
+    data = nullptr;  // The body is only borrowed for the call
+    size = 0;
+    return ok;
+}
+
+bool JsonReader::_fail(const char* message) {
+    if (error.is_empty()) {
+        error = String(message) + " at byte " + String::num_uint64(pos);
+    }
+    return false;
+}
+
+void JsonReader::_skip_whitespace() {
+    while (pos < size) {
+        const uint8_t c = data[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return;
+        }
+        pos++;
+    }
+}
+
+bool JsonReader::_read_value(Variant& r_value, int depth) {
+    if (depth > MAX_DEPTH) {
+        return _fail("Nesting too deep");
+    }
+    _skip_whitespace();
+    if (pos >= size) {
+        return _fail("Unexpected end of input");
+    }
+
+    switch (data[pos]) {
+        case '{':
+            return _read_object(r_value, depth);
+        case '[':
+            return _read_array(r_value, depth);
+        case '"': {
+            String value;
+            if (!_read_string(value)) return false;
+            r_value = value;
+            return true;
+        }
+        case 't':
+            if (!_read_literal("true", 4)) return false;
+            r_value = true;
+            return true;
+        case 'f':
+            if (!_read_literal("false", 5)) return false;
+            r_value = false;
+            return true;
+        case 'n':
+            if (!_read_literal("null", 4)) return false;
+            r_value = Variant();
+            return true;
+        default:
+            if (data[pos] == '-' || is_digit(data[pos])) {
+                return _read_number(r_value);
+            }
+            return _fail("Unexpected character");
+    }
+}
+
+bool JsonReader::_read_object(Variant& r_value, int depth) {
+    pos++;  // '{'
+    Dictionary dict;
+    _skip_whitespace();
+    if (pos < size && data[pos] == '}') {
+        pos++;
+        r_value = dict;
+        return true;
+    }
+
+    while (true) {
+        _skip_whitespace();
+        if (pos >= size || data[pos] != '"') {
+            return _fail("Expected a string key");
+        }
+        String key;
+        if (!_read_key(key)) return false;
+
+        _skip_whitespace();
+        if (pos >= size || data[pos] != ':') {
+            return _fail("Expected ':'");
+        }
+        pos++;
+
+        Variant value;
+        if (!_read_value(value, depth + 1)) return false;
+        dict[key] = value;
+
+        _skip_whitespace();
+        if (pos >= size) {
+            return _fail("Unterminated object");
+        }
+        const uint8_t c = data[pos++];
+        if (c == '}') break;
+        if (c != ',') {
+            pos--;
+            return _fail("Expected ',' or '}'");
+        }
+    }
+    r_value = dict;
+    return true;
+}
+
+bool JsonReader::_read_array(Variant& r_value, int depth) {
+    pos++;  // '['
+    Array array;
+    _skip_whitespace();
+    if (pos < size && data[pos] == ']') {
+        pos++;
+        r_value = array;
+        return true;
+    }
+
+    while (true) {
+        Variant value;
+        if (!_read_value(value, depth + 1)) return false;
+        array.push_back(value);
+
+        _skip_whitespace();
+        if (pos >= size) {
+            return _fail("Unterminated array");
+        }
+        const uint8_t c = data[pos++];
+        if (c == ']') break;
+        if (c != ',') {
+            pos--;
+            return _fail("Expected ',' or ']'");
+        }
+    }
+    r_value = array;
+    return true;
+}
+
+bool JsonReader::_read_string_bytes(const char*& r_start, size_t& r_length) {
+    pos++;  // Opening quote
+    const size_t start = pos;
+
+    // Fast path: no escapes, the bytes are used in place
+    while (pos < size) {
+        const uint8_t c = data[pos];
+        if (c == '"') {
+            r_start = reinterpret_cast<const char*>(data + start);
+            r_length = pos - start;
+            pos++;
+            return true;
+        }
+        if (c == '\\') break;
+        if (c < 0x20) return _fail("Control character in string");
+        pos++;
+    }
+    if (pos >= size) {
+        return _fail("Unterminated string");
+    }
+
+    scratch.assign(reinterpret_cast<const char*>(data + start), pos - start);
+    while (pos < size) {
+        const uint8_t c = data[pos++];
+        if (c == '"') {
+            r_start = scratch.data();
+            r_length = scratch.size();
+            return true;
+        }
+        if (c < 0x20) {
+            pos--;
+            return _fail("Control character in string");
+        }
+        if (c != '\\') {
+            scratch.push_back(static_cast<char>(c));
+            continue;
+        }
+
+        if (pos >= size) break;
+        const uint8_t escape = data[pos++];
+        switch (escape) {
+            case '"': scratch.push_back('"'); break;
+            case '\\': scratch.push_back('\\'); break;
+            case '/': scratch.push_back('/'); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u': {
+                uint32_t cp = 0;
+                for (int i = 0; i < 4; i++) {
+                    const int digit = pos < size ? hex_value(data[pos]) : -1;
+                    if (digit < 0) return _fail("Invalid \\u escape");
+                    cp = (cp << 4) | (uint32_t)digit;
+                    pos++;
+                }
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    // High surrogate: combine with a following \uDC00-\uDFFF
+                    uint32_t low = 0;
+                    bool paired = pos + 6 <= size && data[pos] == '\\' && data[pos + 1] == 'u';
+                    for (int i = 0; paired && i < 4; i++) {
+                        const int digit = hex_value(data[pos + 2 + i]);
+                        paired = digit >= 0;
+                        low = (low << 4) | (uint32_t)(paired ? digit : 0);
+                    }
+                    if (paired && low >= 0xDC00 && low <= 0xDFFF) {
+                        pos += 6;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        cp = 0xFFFD;
+                    }
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    cp = 0xFFFD;  // Lone low surrogate
+                }
+                append_utf8(scratch, cp);
+                break;
+            }
+            default:
+                pos--;
+                return _fail("Invalid escape");
+        }
+    }
+    return _fail("Unterminated string");
+}
+
+bool JsonReader::_read_string(String& r_value) {
+    const char* start = nullptr;
+    size_t length = 0;
+    if (!_read_string_bytes(start, length)) return false;
+    r_value = String::utf8(start, (int64_t)length);
+    return true;
+}
+
+bool JsonReader::_read_key(String& r_value) {
+    const char* start = nullptr;
+    size_t length = 0;
+    if (!_read_string_bytes(start, length)) return false;
+    if (length > MAX_KEY_LENGTH) {
+        r_value = String::utf8(start, (int64_t)length);
+        return true;
+    }
+
+    key_buffer.assign(start, length);
+    std::unordered_map<std::string, String>::const_iterator found = keys.find(key_buffer);
+    if (found != keys.end()) {
+        r_value = found->second;
+        return true;
+    }
+    r_value = String::utf8(start, (int64_t)length);
+    if (keys.size() < MAX_CACHED_KEYS) {
+        keys.emplace(key_buffer, r_value);
+    }
+    return true;
+}
+
+bool JsonReader::_read_number(Variant& r_value) {
+    const size_t start = pos;
+    const bool negative = data[pos] == '-';
+    if (negative) pos++;
+    if (pos >= size || !is_digit(data[pos])) {
+        return _fail("Invalid number");
+    }
+
+    // Up to 19 significant digits in mantissa, scaled by 10^exponent
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool integer = true;
+
+    if (data[pos] == '0') {
+        pos++;
+    } else {
+        while (pos < size && is_digit(data[pos])) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (data[pos] - '0');
+                digits++;
+            } else {
+                truncated = true;
+                exponent++;
+            }
+            pos++;
+        }
+    }
+
+    if (pos < size && data[pos] == '.') {
+        integer = false;
+        pos++;
+        if (pos >= size || !is_digit(data[pos])) {
+            return _fail("Invalid number");
+        }
+        while (pos < size && is_digit(data[pos])) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (data[pos] - '0');
+                if (mantissa != 0) digits++;  // Leading fraction zeros aren't significant
+                exponent--;
+            } else {
+                truncated = true;
+            }
+            pos++;
+        }
+    }
+
+    if (pos < size && (data[pos] == 'e' || data[pos] == 'E')) {
+        integer = false;
+        pos++;
+        bool exponent_negative = false;
+        if (pos < size && (data[pos] == '+' || data[pos] == '-')) {
+            exponent_negative = data[pos] == '-';
+            pos++;
+        }
+        if (pos >= size || !is_digit(data[pos])) {
+            return _fail("Invalid number");
+        }
+        int value = 0;
+        while (pos < size && is_digit(data[pos])) {
+            if (value < 100000) {
+                value = value * 10 + (data[pos] - '0');
+            }
+            pos++;
+        }
+        exponent += exponent_negative ? -value : value;
+    }
+
+    if (integer && !truncated) {
+        if (!negative && mantissa <= (uint64_t)INT64_MAX) {
+            r_value = (int64_t)mantissa;
+            return true;
+        }
+        if (negative && mantissa <= (uint64_t)INT64_MAX + 1) {
+            r_value = mantissa == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)mantissa;
+            return true;
+        }
+    }
+
+    // Exact when both the mantissa and the power of ten are exact doubles
+    if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / POW10[-exponent] : value * POW10[exponent];
+        r_value = negative ? -value : value;
+        return true;
+    }
+
+    // Long mantissas and large exponents are rare in responses; let Godot round them
+    r_value = String::utf8(reinterpret_cast<const char*>(data + start), (int64_t)(pos - start)).to_float();
+    return true;
+}
+
+bool JsonReader::_read_literal(const char* literal, size_t length) {
+    if (size - pos < length || std::memcmp(data + pos, literal, length) != 0) {
+        return _fail("Invalid literal");
+    }
+    pos += length;
+    return true;
+}
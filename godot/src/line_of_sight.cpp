@@ -0,0 +1,247 @@
+#include "line_of_sight.h"
+
+#include "arena_log.h"
+
+#include <godot_cpp/classes/physics_direct_space_state3d.hpp>
+#include <godot_cpp/classes/world3d.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <vector>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// LineOfSight Implementation
+// ============================================================================
+
+LineOfSight::LineOfSight()
+    : collision_mask(2),
+      eye_height(1.0),
+      target_height(0.5),
+      move_tolerance(0.05),
+      symmetric_pairs(false),
+      cache_enabled(true),
+      generation(0),
+      pairs_this_tick(0),
+      raycasts_last_batch(0),
+      cache_hits_last_batch(0) {
+    query.instantiate();
+}
+
+LineOfSight::~LineOfSight() {}
+
+void LineOfSight::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("begin_tick"), &LineOfSight::begin_tick);
+    ClassDB::bind_method(D_METHOD("check_pairs", "from_ids", "from_positions", "to_ids", "to_positions", "exclude_rids", "target_instance_ids"),
+                         &LineOfSight::check_pairs);
+    ClassDB::bind_method(D_METHOD("check_targets", "from_id", "from_position", "exclude_rid", "to_ids", "to_positions", "target_instance_ids"),
+                         &LineOfSight::check_targets);
+    ClassDB::bind_method(D_METHOD("invalidate"), &LineOfSight::invalidate);
+    ClassDB::bind_method(D_METHOD("get_cache_size"), &LineOfSight::get_cache_size);
+    ClassDB::bind_method(D_METHOD("get_raycasts_last_batch"), &LineOfSight::get_raycasts_last_batch);
+    ClassDB::bind_method(D_METHOD("get_cache_hits_last_batch"), &LineOfSight::get_cache_hits_last_batch);
+
+    ClassDB::bind_method(D_METHOD("set_collision_mask", "mask"), &LineOfSight::set_collision_mask);
+    ClassDB::bind_method(D_METHOD("get_collision_mask"), &LineOfSight::get_collision_mask);
+    ClassDB::bind_method(D_METHOD("set_eye_height", "height"), &LineOfSight::set_eye_height);
+    ClassDB::bind_method(D_METHOD("get_eye_height"), &LineOfSight::get_eye_height);
+    ClassDB::bind_method(D_METHOD("set_target_height", "height"), &LineOfSight::set_target_height);
+    ClassDB::bind_method(D_METHOD("get_target_height"), &LineOfSight::get_target_height);
+    ClassDB::bind_method(D_METHOD("set_move_tolerance", "tolerance"), &LineOfSight::set_move_tolerance);
+    ClassDB::bind_method(D_METHOD("get_move_tolerance"), &LineOfSight::get_move_tolerance);
+    ClassDB::bind_method(D_METHOD("set_symmetric_pairs", "enabled"), &LineOfSight::set_symmetric_pairs);
+    ClassDB::bind_method(D_METHOD("get_symmetric_pairs"), &LineOfSight::get_symmetric_pairs);
+    ClassDB::bind_method(D_METHOD("set_cache_enabled", "enabled"), &LineOfSight::set_cache_enabled);
+    ClassDB::bind_method(D_METHOD("get_cache_enabled"), &LineOfSight::get_cache_enabled);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_mask", "get_collision_mask");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "eye_height"), "set_eye_height", "get_eye_height");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "target_height"), "set_target_height", "get_target_height");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "move_tolerance"), "set_move_tolerance", "get_move_tolerance");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "symmetric_pairs"), "set_symmetric_pairs", "get_symmetric_pairs");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cache_enabled"), "set_cache_enabled", "get_cache_enabled");
+}
+
+LineOfSight::PairKey LineOfSight::_pair_key(int64_t from_id, int64_t to_id, bool shared) const {
+    if (shared && to_id < from_id) {
+        return PairKey{to_id, from_id, true};
+    }
+    return PairKey{from_id, to_id, shared};
+}
+
+bool LineOfSight::_cast(PhysicsDirectSpaceState3D* space_state, const Vector3& from, const Vector3& to,
+                        int64_t target_instance_id) {
+    if (!space_state) {
+        return true;  // Fallback: assume visible if no physics
+    }
+
+    query->set_from(from + Vector3(0, eye_height, 0));
+    query->set_to(to + Vector3(0, target_height, 0));
+
+    raycasts_last_batch++;
+    Dictionary hit = space_state->intersect_ray(query);
+    if (hit.is_empty()) {
+        return true;
+    }
+
+    // Hitting the target itself still counts as visible
+    return target_instance_id != 0 && (int64_t)hit.get("collider_id", 0) == target_instance_id;
+}
+
+PackedByteArray LineOfSight::check_pairs(const PackedInt64Array& from_ids,
+                                         const PackedVector3Array& from_positions,
+                                         const PackedInt64Array& to_ids,
+                                         const PackedVector3Array& to_positions,
+                                         const Array& exclude_rids,
+                                         const PackedInt64Array& target_instance_ids) {
+    PackedByteArray results;
+    const int64_t count = from_ids.size();
+    if (from_positions.size() != count || to_ids.size() != count || to_positions.size() != count) {
+        ARENA_LOG_WARN("LineOfSight: check_pairs arrays must have the same length");
+        return results;
+    }
+
+    results.resize(count);
+    uint8_t* results_w = results.ptrw();
+
+    PhysicsDirectSpaceState3D* space_state = nullptr;
+    Ref<World3D> world = get_world_3d();
+    if (world.is_valid()) {
+        space_state = world->get_direct_space_state();
+    }
+
+    query->set_collision_mask(collision_mask);
+    const bool has_excludes = exclude_rids.size() == count;
+    const bool has_targets = target_instance_ids.size() == count;
+    RID current_exclude;
+    query->set_exclude(TypedArray<RID>());
+
+    const double tolerance_sq = move_tolerance * move_tolerance;
+
+    for (int64_t i = 0; i < count; i++) {
+        const int64_t from_id = from_ids[i];
+        const int64_t to_id = to_ids[i];
+        const Vector3 from = from_positions[i];
+        const Vector3 to = to_positions[i];
+        const int64_t target_instance_id = has_targets ? target_instance_ids[i] : 0;
+
+        // A->B and B->A only cast the same ray when both ends use the same
+        // height offset and neither ray may end on a target collider
+        const bool shared = symmetric_pairs && eye_height == target_height && target_instance_id == 0;
+
+        // Cache entries store endpoints in key order so reversed pairs line up
+        const bool reversed = shared && to_id < from_id;
+        const Vector3& key_from = reversed ? to : from;
+        const Vector3& key_to = reversed ? from : to;
+        const PairKey key = _pair_key(from_id, to_id, shared);
+
+        if (cache_enabled) {
+            CacheEntry* entry = cache.getptr(key);
+            if (entry && entry->from.distance_squared_to(key_from) <= tolerance_sq &&
+                entry->to.distance_squared_to(key_to) <= tolerance_sq) {
+                entry->generation = generation;
+                results_w[i] = entry->visible ? 1 : 0;
+                cache_hits_last_batch++;
+                continue;
+            }
+        }
+
+        // Pairs are usually grouped by viewer, so the exclude list rarely changes
+        if (has_excludes) {
+            const Variant& rid_value = exclude_rids[i];
+            RID rid = rid_value.get_type() == Variant::RID ? (RID)rid_value : RID();
+            if (rid != current_exclude) {
+                current_exclude = rid;
+                TypedArray<RID> exclude;
+                if (rid.is_valid()) {
+                    exclude.append(rid);
+                }
+                query->set_exclude(exclude);
+            }
+        }
+
+        const bool visible = _cast(space_state, from, to, target_instance_id);
+        results_w[i] = visible ? 1 : 0;
+
+        if (cache_enabled) {
+            cache.insert(key, CacheEntry{key_from, key_to, visible, generation});
+        }
+    }
+
+    pairs_this_tick += count;
+    return results;
+}
+
+PackedByteArray LineOfSight::check_targets(int64_t from_id, const Vector3& from_position,
+                                           const RID& exclude_rid,
+                                           const PackedInt64Array& to_ids,
+                                           const PackedVector3Array& to_positions,
+                                           const PackedInt64Array& target_instance_ids) {
+    const int64_t count = to_ids.size();
+
+    PackedInt64Array from_ids;
+    from_ids.resize(count);
+    from_ids.fill(from_id);
+
+    PackedVector3Array from_positions;
+    from_positions.resize(count);
+    from_positions.fill(from_position);
+
+    Array exclude_rids;
+    exclude_rids.resize(count);
+    exclude_rids.fill(exclude_rid);
+
+    return check_pairs(from_ids, from_positions, to_ids, to_positions, exclude_rids, target_instance_ids);
+}
+
+void LineOfSight::begin_tick() {
+    // Every viewer's pairs from the tick just finished are current; only
+    // pairs no viewer asked for in it are candidates for eviction
+    _prune_cache(pairs_this_tick);
+    generation++;
+    pairs_this_tick = 0;
+    raycasts_last_batch = 0;
+    cache_hits_last_batch = 0;
+}
+
+void LineOfSight::_prune_cache(int64_t working_set) {
+    // Drop pairs unused during the last tick once the cache outgrows the working set
+    const int64_t limit = working_set * 4 > 1024 ? working_set * 4 : 1024;
+    if ((int64_t)cache.size() <= limit) {
+        return;
+    }
+
+    std::vector<PairKey> stale;
+    for (const KeyValue<PairKey, CacheEntry>& kv : cache) {
+        if (kv.value.generation < generation) {
+            stale.push_back(kv.key);
+        }
+    }
+    for (const PairKey& key : stale) {
+        cache.erase(key);
+    }
+}
+
+void LineOfSight::invalidate() {
+    cache.clear();
+}
+
+void LineOfSight::set_move_tolerance(double tolerance) {
+    move_tolerance = Math::max(0.0, tolerance);
+}
+
+void LineOfSight::set_symmetric_pairs(bool enabled) {
+    symmetric_pairs = enabled;
+    cache.clear();  // Which pairs share entries changes
+}
+
+void LineOfSight::set_cache_enabled(bool enabled) {
+    cache_enabled = enabled;
+    if (!enabled) {
+        cache.clear();
+    }
+}
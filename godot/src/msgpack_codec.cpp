@@ -0,0 +1,424 @@
+#include "msgpack_codec.h"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Encoding helpers (MessagePack is big-endian on the wire)
+// ----------------------------------------------------------------------------
+
+void put_u8(std::vector<uint8_t>& out, uint8_t v) {
+    out.push_back(v);
+}
+
+void put_be16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void put_be32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(v >> shift));
+    }
+}
+
+void put_be64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(v >> shift));
+    }
+}
+
+void put_int(std::vector<uint8_t>& out, int64_t v) {
+    if (v >= 0) {
+        if (v < 128) {
+            put_u8(out, static_cast<uint8_t>(v));  // positive fixint
+        } else if (v <= 0xFF) {
+            put_u8(out, 0xcc);
+            put_u8(out, static_cast<uint8_t>(v));
+        } else if (v <= 0xFFFF) {
+            put_u8(out, 0xcd);
+            put_be16(out, static_cast<uint16_t>(v));
+        } else if (v <= 0xFFFFFFFFLL) {
+            put_u8(out, 0xce);
+            put_be32(out, static_cast<uint32_t>(v));
+        } else {
+            put_u8(out, 0xcf);
+            put_be64(out, static_cast<uint64_t>(v));
+        }
+    } else {
+        if (v >= -32) {
+            put_u8(out, static_cast<uint8_t>(static_cast<int8_t>(v)));  // negative fixint
+        } else if (v >= -128) {
+            put_u8(out, 0xd0);
+            put_u8(out, static_cast<uint8_t>(static_cast<int8_t>(v)));
+        } else if (v >= -32768) {
+            put_u8(out, 0xd1);
+            put_be16(out, static_cast<uint16_t>(static_cast<int16_t>(v)));
+        } else if (v >= -2147483648LL) {
+            put_u8(out, 0xd2);
+            put_be32(out, static_cast<uint32_t>(static_cast<int32_t>(v)));
+        } else {
+            put_u8(out, 0xd3);
+            put_be64(out, static_cast<uint64_t>(v));
+        }
+    }
+}
+
+void put_double(std::vector<uint8_t>& out, double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    put_u8(out, 0xcb);
+    put_be64(out, bits);
+}
+
+void put_str(std::vector<uint8_t>& out, const String& s) {
+    CharString utf8 = s.utf8();
+    const uint32_t len = static_cast<uint32_t>(utf8.length());
+    if (len < 32) {
+        put_u8(out, static_cast<uint8_t>(0xa0 | len));
+    } else if (len <= 0xFF) {
+        put_u8(out, 0xd9);
+        put_u8(out, static_cast<uint8_t>(len));
+    } else if (len <= 0xFFFF) {
+        put_u8(out, 0xda);
+        put_be16(out, static_cast<uint16_t>(len));
+    } else {
+        put_u8(out, 0xdb);
+        put_be32(out, len);
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(utf8.get_data());
+    out.insert(out.end(), bytes, bytes + len);
+}
+
+void put_array_header(std::vector<uint8_t>& out, uint32_t count) {
+    if (count < 16) {
+        put_u8(out, static_cast<uint8_t>(0x90 | count));
+    } else if (count <= 0xFFFF) {
+        put_u8(out, 0xdc);
+        put_be16(out, static_cast<uint16_t>(count));
+    } else {
+        put_u8(out, 0xdd);
+        put_be32(out, count);
+    }
+}
+
+void put_map_header(std::vector<uint8_t>& out, uint32_t count) {
+    if (count < 16) {
+        put_u8(out, static_cast<uint8_t>(0x80 | count));
+    } else if (count <= 0xFFFF) {
+        put_u8(out, 0xde);
+        put_be16(out, static_cast<uint16_t>(count));
+    } else {
+        put_u8(out, 0xdf);
+        put_be32(out, count);
+    }
+}
+
+void put_bin(std::vector<uint8_t>& out, const PackedByteArray& bytes) {
+    const uint32_t len = static_cast<uint32_t>(bytes.size());
+    if (len <= 0xFF) {
+        put_u8(out, 0xc4);
+        put_u8(out, static_cast<uint8_t>(len));
+    } else if (len <= 0xFFFF) {
+        put_u8(out, 0xc5);
+        put_be16(out, static_cast<uint16_t>(len));
+    } else {
+        put_u8(out, 0xc6);
+        put_be32(out, len);
+    }
+    out.insert(out.end(), bytes.ptr(), bytes.ptr() + len);
+}
+
+// ----------------------------------------------------------------------------
+// Decoding helpers
+// ----------------------------------------------------------------------------
+
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+
+    bool has(size_t n) const { return size - pos >= n; }
+
+    uint64_t be(size_t n) {
+        uint64_t v = 0;
+        for (size_t i = 0; i < n; i++) {
+            v = (v << 8) | data[pos + i];
+        }
+        pos += n;
+        return v;
+    }
+};
+
+bool read_value(Reader& r, Variant& out, int depth);
+
+bool read_str(Reader& r, size_t len, Variant& out) {
+    if (!r.has(len)) return false;
+    out = String::utf8(reinterpret_cast<const char*>(r.data + r.pos), static_cast<int64_t>(len));
+    r.pos += len;
+    return true;
+}
+
+bool read_bin(Reader& r, size_t len, Variant& out) {
+    if (!r.has(len)) return false;
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(len));
+    if (len > 0) {
+        std::memcpy(bytes.ptrw(), r.data + r.pos, len);
+    }
+    r.pos += len;
+    out = bytes;
+    return true;
+}
+
+bool read_array(Reader& r, size_t count, Variant& out, int depth) {
+    if (!r.has(count)) return false;  // Every element takes at least one byte
+    Array arr;
+    arr.resize(static_cast<int64_t>(count));
+    for (size_t i = 0; i < count; i++) {
+        Variant item;
+        if (!read_value(r, item, depth + 1)) return false;
+        arr[static_cast<int64_t>(i)] = item;
+    }
+    out = arr;
+    return true;
+}
+
+bool read_map(Reader& r, size_t count, Variant& out, int depth) {
+    if (!r.has(count)) return false;
+    Dictionary dict;
+    for (size_t i = 0; i < count; i++) {
+        Variant key;
+        Variant value;
+        if (!read_value(r, key, depth + 1)) return false;
+        if (!read_value(r, value, depth + 1)) return false;
+        dict[key] = value;
+    }
+    out = dict;
+    return true;
+}
+
+bool read_value(Reader& r, Variant& out, int depth) {
+    // Guard against hostile or corrupt input nesting the stack away
+    if (depth > 64 || !r.has(1)) return false;
+
+    const uint8_t tag = r.data[r.pos++];
+
+    if (tag <= 0x7f) { out = static_cast<int64_t>(tag); return true; }
+    if (tag >= 0xe0) { out = static_cast<int64_t>(static_cast<int8_t>(tag)); return true; }
+    if ((tag & 0xe0) == 0xa0) return read_str(r, tag & 0x1f, out);
+    if ((tag & 0xf0) == 0x90) return read_array(r, tag & 0x0f, out, depth);
+    if ((tag & 0xf0) == 0x80) return read_map(r, tag & 0x0f, out, depth);
+
+    switch (tag) {
+        case 0xc0: out = Variant(); return true;
+        case 0xc2: out = false; return true;
+        case 0xc3: out = true; return true;
+
+        case 0xc4: if (!r.has(1)) return false; return read_bin(r, r.be(1), out);
+        case 0xc5: if (!r.has(2)) return false; return read_bin(r, r.be(2), out);
+        case 0xc6: if (!r.has(4)) return false; return read_bin(r, r.be(4), out);
+
+        case 0xca: {
+            if (!r.has(4)) return false;
+            uint32_t bits = static_cast<uint32_t>(r.be(4));
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            out = static_cast<double>(f);
+            return true;
+        }
+        case 0xcb: {
+            if (!r.has(8)) return false;
+            uint64_t bits = r.be(8);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            out = d;
+            return true;
+        }
+
+        case 0xcc: if (!r.has(1)) return false; out = static_cast<int64_t>(r.be(1)); return true;
+        case 0xcd: if (!r.has(2)) return false; out = static_cast<int64_t>(r.be(2)); return true;
+        case 0xce: if (!r.has(4)) return false; out = static_cast<int64_t>(r.be(4)); return true;
+        case 0xcf: if (!r.has(8)) return false; out = static_cast<int64_t>(r.be(8)); return true;
+        case 0xd0: if (!r.has(1)) return false; out = static_cast<int64_t>(static_cast<int8_t>(r.be(1))); return true;
+        case 0xd1: if (!r.has(2)) return false; out = static_cast<int64_t>(static_cast<int16_t>(r.be(2))); return true;
+        case 0xd2: if (!r.has(4)) return false; out = static_cast<int64_t>(static_cast<int32_t>(r.be(4))); return true;
+        case 0xd3: if (!r.has(8)) return false; out = static_cast<int64_t>(r.be(8)); return true;
+
+        case 0xd9: if (!r.has(1)) return false; return read_str(r, r.be(1), out);
+        case 0xda: if (!r.has(2)) return false; return read_str(r, r.be(2), out);
+        case 0xdb: if (!r.has(4)) return false; return read_str(r, r.be(4), out);
+
+        case 0xdc: if (!r.has(2)) return false; return read_array(r, r.be(2), out, depth);
+        case 0xdd: if (!r.has(4)) return false; return read_array(r, r.be(4), out, depth);
+        case 0xde: if (!r.has(2)) return false; return read_map(r, r.be(2), out, depth);
+        case 0xdf: if (!r.has(4)) return false; return read_map(r, r.be(4), out, depth);
+
+        default:
+            // ext types and the reserved 0xc1 tag are not used by the protocol
+            return false;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// MsgPackCodec Implementation
+// ============================================================================
+
+void MsgPackCodec::encode(const Variant& value, std::vector<uint8_t>& out) {
+    switch (value.get_type()) {
+        case Variant::NIL:
+            put_u8(out, 0xc0);
+            break;
+        case Variant::BOOL:
+            put_u8(out, static_cast<bool>(value) ? 0xc3 : 0xc2);
+            break;
+        case Variant::INT:
+            put_int(out, static_cast<int64_t>(value));
+            break;
+        case Variant::FLOAT:
+            put_double(out, static_cast<double>(value));
+            break;
+        case Variant::STRING:
+            put_str(out, static_cast<String>(value));
+            break;
+        case Variant::STRING_NAME:
+            put_str(out, String(static_cast<StringName>(value)));
+            break;
+        case Variant::VECTOR2: {
+            Vector2 v = value;
+            put_array_header(out, 2);
+            put_double(out, v.x);
+            put_double(out, v.y);
+            break;
+        }
+        case Variant::VECTOR3: {
+            Vector3 v = value;
+            put_array_header(out, 3);
+            put_double(out, v.x);
+            put_double(out, v.y);
+            put_double(out, v.z);
+            break;
+        }
+        case Variant::ARRAY: {
+            Array arr = value;
+            put_array_header(out, static_cast<uint32_t>(arr.size()));
+            for (int64_t i = 0; i < arr.size(); i++) {
+                encode(arr[i], out);
+            }
+            break;
+        }
+        case Variant::DICTIONARY: {
+            Dictionary dict = value;
+            Array keys = dict.keys();
+            put_map_header(out, static_cast<uint32_t>(keys.size()));
+            for (int64_t i = 0; i < keys.size(); i++) {
+                encode(keys[i], out);
+                encode(dict[keys[i]], out);
+            }
+            break;
+        }
+        case Variant::PACKED_BYTE_ARRAY:
+            put_bin(out, value);
+            break;
+        // Packed arrays are routed through Array so element encoding stays in one place
+        case Variant::PACKED_INT32_ARRAY:
+            encode(Array(static_cast<PackedInt32Array>(value)), out);
+            break;
+        case Variant::PACKED_INT64_ARRAY:
+            encode(Array(static_cast<PackedInt64Array>(value)), out);
+            break;
+        case Variant::PACKED_FLOAT32_ARRAY:
+            encode(Array(static_cast<PackedFloat32Array>(value)), out);
+            break;
+        case Variant::PACKED_FLOAT64_ARRAY:
+            encode(Array(static_cast<PackedFloat64Array>(value)), out);
+            break;
+        case Variant::PACKED_STRING_ARRAY:
+            encode(Array(static_cast<PackedStringArray>(value)), out);
+            break;
+        case Variant::PACKED_VECTOR3_ARRAY:
+            encode(Array(static_cast<PackedVector3Array>(value)), out);
+            break;
+        default:
+            put_str(out, value.stringify());
+            break;
+    }
+}
+
+PackedByteArray MsgPackCodec::encode(const Variant& value) {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(256);
+    encode(value, buffer);
+
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(buffer.size()));
+    if (!buffer.empty()) {
+        std::memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    }
+    return bytes;
+}
+
+bool MsgPackCodec::decode(const uint8_t* data, size_t size, Variant& r_value, size_t* r_consumed) {
+    Reader reader{data, size, 0};
+    if (!read_value(reader, r_value, 0)) {
+        return false;
+    }
+    if (r_consumed) {
+        *r_consumed = reader.pos;
+    }
+    return true;
+}
+
+bool MsgPackCodec::decode(const PackedByteArray& bytes, Variant& r_value) {
+    return decode(bytes.ptr(), static_cast<size_t>(bytes.size()), r_value);
+}
+
+void MsgPackCodec::write_map_header(std::vector<uint8_t>& out, uint32_t count) {
+    put_map_header(out, count);
+}
+
+void MsgPackCodec::write_array_header(std::vector<uint8_t>& out, uint32_t count) {
+    put_array_header(out, count);
+}
+
+void MsgPackCodec::write_str(std::vector<uint8_t>& out, const String& value) {
+    put_str(out, value);
+}
+
+void MsgPackCodec::write_int(std::vector<uint8_t>& out, int64_t value) {
+    put_int(out, value);
+}
+
+void MsgPackCodec::write_double(std::vector<uint8_t>& out, double value) {
+    put_double(out, value);
+}
+
+void MsgPackCodec::write_vector3(std::vector<uint8_t>& out, const Vector3& value) {
+    put_array_header(out, 3);
+    put_double(out, value.x);
+    put_double(out, value.y);
+    put_double(out, value.z);
+}
+
+void MsgPackCodec::write_nil(std::vector<uint8_t>& out) {
+    put_u8(out, 0xc0);
+}
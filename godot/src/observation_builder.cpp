@@ -0,0 +1,709 @@
+#include "observation_builder.h"
+
+#include "agent_arena.h"
+#include "arena_log.h"
+#include "msgpack_codec.h"
+#include "perf_stats.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// ObservationBuilder Implementation
+// ============================================================================
+
+namespace {
+
+// Backend keys for each EntityKind, in enum order
+const char* const KIND_KEYS[ObservationBuilder::KIND_COUNT] = {
+    "nearby_resources",
+    "nearby_hazards",
+    "nearby_stations",
+    "nearby_agents",
+};
+
+// Resources and hazards are always present (Observation.from_dict defaults
+// the rest), so only these two are written when empty
+bool kind_always_written(int kind) {
+    return kind == ObservationBuilder::KIND_RESOURCE || kind == ObservationBuilder::KIND_HAZARD;
+}
+
+// Shared with the backend's decoder: floor(v * steps + 0.5), exact for the
+// float32 components Godot sends since steps is a power of two
+int64_t position_steps(double value) {
+    return (int64_t)Math::floor(value * (double)ObservationBuilder::POSITION_STEPS_PER_UNIT + 0.5);
+}
+
+// Distance changes smaller than one position step aren't resent
+bool distance_changed(double sent, double now) {
+    return Math::abs(now - sent) * (double)ObservationBuilder::POSITION_STEPS_PER_UNIT >= 1.0;
+}
+
+uint64_t mix64(uint64_t x) {
+    // splitmix64 finaliser
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t combine(uint64_t seed, uint64_t value) {
+    return mix64(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+uint64_t hash_bytes(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+int64_t fingerprint_cell(double value, double cell_size) {
+    return (int64_t)Math::floor(value / cell_size);
+}
+
+bool bytes_equal(const std::vector<uint8_t>& a, const uint8_t* b, size_t b_size) {
+    return a.size() == b_size && (b_size == 0 || std::memcmp(a.data(), b, b_size) == 0);
+}
+
+} // namespace
+
+ObservationBuilder::ObservationBuilder() : current(nullptr), keyframe_interval(300), fingerprint_cell_size(1.0) {
+    // Both change every tick without changing what an agent should do
+    fingerprint_ignored_fields.append("memory");
+    fingerprint_ignored_fields.append("exploration");
+}
+
+ObservationBuilder::~ObservationBuilder() {}
+
+void ObservationBuilder::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("begin_agent", "agent_id", "tick"), &ObservationBuilder::begin_agent);
+    ClassDB::bind_method(D_METHOD("set_self", "position", "health", "max_health", "perception_radius"),
+                         &ObservationBuilder::set_self);
+    ClassDB::bind_method(D_METHOD("add_entity", "kind", "name", "type", "position", "distance"),
+                         &ObservationBuilder::add_entity);
+    ClassDB::bind_method(D_METHOD("set_field", "key", "value"), &ObservationBuilder::set_field);
+    ClassDB::bind_method(D_METHOD("set_memory", "agent", "action_limit"), &ObservationBuilder::set_memory, DEFVAL(-1));
+
+    ClassDB::bind_method(D_METHOD("has_observation", "agent_id", "tick"), &ObservationBuilder::has_observation);
+    ClassDB::bind_method(D_METHOD("get_buffer", "agent_id"), &ObservationBuilder::get_buffer);
+    ClassDB::bind_method(D_METHOD("get_observation", "agent_id"), &ObservationBuilder::get_observation);
+    ClassDB::bind_method(D_METHOD("get_schema_version"), &ObservationBuilder::get_schema_version);
+    ClassDB::bind_method(D_METHOD("get_agent_count"), &ObservationBuilder::get_agent_count);
+    ClassDB::bind_method(D_METHOD("remove_agent", "agent_id"), &ObservationBuilder::remove_agent);
+    ClassDB::bind_method(D_METHOD("clear"), &ObservationBuilder::clear);
+
+    ClassDB::bind_method(D_METHOD("request_keyframe", "agent_id"), &ObservationBuilder::request_keyframe);
+    ClassDB::bind_method(D_METHOD("reset_deltas"), &ObservationBuilder::reset_deltas);
+    ClassDB::bind_method(D_METHOD("set_keyframe_interval", "ticks"), &ObservationBuilder::set_keyframe_interval);
+    ClassDB::bind_method(D_METHOD("get_keyframe_interval"), &ObservationBuilder::get_keyframe_interval);
+
+    ClassDB::bind_method(D_METHOD("get_fingerprint", "agent_id"), &ObservationBuilder::get_fingerprint);
+    ClassDB::bind_method(D_METHOD("set_fingerprint_cell_size", "size"), &ObservationBuilder::set_fingerprint_cell_size);
+    ClassDB::bind_method(D_METHOD("get_fingerprint_cell_size"), &ObservationBuilder::get_fingerprint_cell_size);
+    ClassDB::bind_method(D_METHOD("set_fingerprint_ignored_fields", "fields"), &ObservationBuilder::set_fingerprint_ignored_fields);
+    ClassDB::bind_method(D_METHOD("get_fingerprint_ignored_fields"), &ObservationBuilder::get_fingerprint_ignored_fields);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "keyframe_interval", PROPERTY_HINT_RANGE, "0,10000,1"),
+                 "set_keyframe_interval", "get_keyframe_interval");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "fingerprint_cell_size"), "set_fingerprint_cell_size", "get_fingerprint_cell_size");
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "fingerprint_ignored_fields"),
+                 "set_fingerprint_ignored_fields", "get_fingerprint_ignored_fields");
+
+    BIND_ENUM_CONSTANT(KIND_RESOURCE);
+    BIND_ENUM_CONSTANT(KIND_HAZARD);
+    BIND_ENUM_CONSTANT(KIND_STATION);
+    BIND_ENUM_CONSTANT(KIND_AGENT);
+}
+
+void ObservationBuilder::begin_agent(const String& agent_id, int64_t tick) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot) {
+        slot = &slots.insert(agent_id, AgentSlot())->value;
+    }
+
+    // clear() keeps capacity, so a warmed-up slot never reallocates
+    slot->tick = tick;
+    slot->position = Vector3();
+    slot->health = 100.0;
+    slot->max_health = 100.0;
+    slot->perception_radius = 0.0;
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        slot->entities[kind].clear();
+        slot->entity_counts[kind] = 0;
+        slot->entity_states[kind].clear();
+    }
+    slot->extras.clear();
+    slot->extra_count = 0;
+    slot->extra_ranges.clear();
+    slot->dirty = true;
+    slot->fingerprint_dirty = true;
+    slot->delta_tick = -1;
+
+    current_agent = agent_id;
+    current = slot;
+}
+
+void ObservationBuilder::set_self(const Vector3& position, double health, double max_health, double perception_radius) {
+    if (!current) {
+        ARENA_LOG_WARN("ObservationBuilder: set_self called before begin_agent");
+        return;
+    }
+    current->position = position;
+    current->health = health;
+    current->max_health = max_health;
+    current->perception_radius = perception_radius;
+    current->dirty = true;
+    current->fingerprint_dirty = true;
+}
+
+void ObservationBuilder::add_entity(EntityKind kind, const String& name, const String& type,
+                                    const Vector3& position, double distance) {
+    if (!current) {
+        ARENA_LOG_WARN("ObservationBuilder: add_entity called before begin_agent");
+        return;
+    }
+    if (kind < 0 || kind >= KIND_COUNT) {
+        ARENA_LOG_WARN("ObservationBuilder: invalid entity kind ", (int)kind);
+        return;
+    }
+
+    std::vector<uint8_t>& out = current->entities[kind];
+    MsgPackCodec::write_map_header(out, 4);
+    MsgPackCodec::write_str(out, "name");
+    MsgPackCodec::write_str(out, name);
+    MsgPackCodec::write_str(out, "type");
+    MsgPackCodec::write_str(out, type);
+    MsgPackCodec::write_str(out, "position");
+    MsgPackCodec::write_vector3(out, position);
+    MsgPackCodec::write_str(out, "distance");
+    MsgPackCodec::write_double(out, distance);
+    current->entity_counts[kind]++;
+    current->entity_states[kind].push_back(EntityState{name, type, position, distance});
+    current->dirty = true;
+    current->fingerprint_dirty = true;
+}
+
+void ObservationBuilder::set_field(const String& key, const Variant& value) {
+    if (!current) {
+        ARENA_LOG_WARN("ObservationBuilder: set_field called before begin_agent");
+        return;
+    }
+    MsgPackCodec::write_str(current->extras, key);
+    const uint32_t value_begin = (uint32_t)current->extras.size();
+    MsgPackCodec::encode(value, current->extras);
+    _add_extra(key, value_begin);
+}
+
+void ObservationBuilder::_add_extra(const String& key, uint32_t value_begin) {
+    current->extra_ranges.push_back(ExtraRange{key, value_begin, (uint32_t)current->extras.size()});
+    current->extra_count++;
+    current->dirty = true;
+    current->fingerprint_dirty = true;
+}
+
+void ObservationBuilder::_assemble(AgentSlot& slot, const String& agent_id) {
+    ScopedPerfTimer timer(PerfStats::PHASE_OBSERVATION_BUILD);
+    uint32_t field_count = 7 + slot.extra_count;
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        if (kind_always_written(kind) || slot.entity_counts[kind] > 0) {
+            field_count++;
+        }
+    }
+
+    std::vector<uint8_t>& out = slot.buffer;
+    out.clear();
+    MsgPackCodec::write_map_header(out, field_count);
+    MsgPackCodec::write_str(out, "schema_version");
+    MsgPackCodec::write_int(out, SCHEMA_VERSION);
+    MsgPackCodec::write_str(out, "agent_id");
+    MsgPackCodec::write_str(out, agent_id);
+    MsgPackCodec::write_str(out, "tick");
+    MsgPackCodec::write_int(out, slot.tick);
+    MsgPackCodec::write_str(out, "position");
+    MsgPackCodec::write_vector3(out, slot.position);
+    MsgPackCodec::write_str(out, "health");
+    MsgPackCodec::write_double(out, slot.health);
+    MsgPackCodec::write_str(out, "max_health");
+    MsgPackCodec::write_double(out, slot.max_health);
+    MsgPackCodec::write_str(out, "perception_radius");
+    MsgPackCodec::write_double(out, slot.perception_radius);
+
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        if (!kind_always_written(kind) && slot.entity_counts[kind] == 0) {
+            continue;
+        }
+        MsgPackCodec::write_str(out, KIND_KEYS[kind]);
+        MsgPackCodec::write_array_header(out, slot.entity_counts[kind]);
+        out.insert(out.end(), slot.entities[kind].begin(), slot.entities[kind].end());
+    }
+
+    out.insert(out.end(), slot.extras.begin(), slot.extras.end());
+    slot.dirty = false;
+}
+
+void ObservationBuilder::set_memory(Agent* agent, int action_limit) {
+    if (!current) {
+        ARENA_LOG_WARN("ObservationBuilder: set_memory called before begin_agent");
+        return;
+    }
+    if (!agent) {
+        return;
+    }
+    MsgPackCodec::write_str(current->extras, "memory");
+    const uint32_t value_begin = (uint32_t)current->extras.size();
+    agent->get_memory().encode_snapshot(current->extras, action_limit);
+    _add_extra("memory", value_begin);
+}
+
+const std::vector<uint8_t>* ObservationBuilder::get_native_buffer(const String& agent_id, int64_t tick) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot || slot->tick != tick) {
+        return nullptr;
+    }
+    if (slot->dirty) {
+        _assemble(*slot, agent_id);
+    }
+    return &slot->buffer;
+}
+
+const std::vector<uint8_t>* ObservationBuilder::get_native_delta_buffer(const String& agent_id, int64_t tick) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot || slot->tick != tick) {
+        return nullptr;
+    }
+    if (slot->delta_tick == tick) {
+        return slot->delta_is_keyframe ? &slot->buffer : &slot->delta_buffer;
+    }
+
+    const SentState& sent = slot->sent;
+    bool keyframe = !sent.valid || tick <= sent.tick ||
+                    (keyframe_interval > 0 && tick - sent.keyframe_tick >= keyframe_interval);
+    if (!keyframe) {
+        keyframe = !_encode_delta(*slot, agent_id);
+    }
+
+    PerfStats& perf = PerfStats::get();
+    if (keyframe) {
+        if (slot->dirty) {
+            _assemble(*slot, agent_id);
+        }
+        _commit_keyframe(*slot);
+        perf.add(PerfStats::COUNTER_OBSERVATION_KEYFRAMES);
+    } else {
+        perf.add(PerfStats::COUNTER_OBSERVATION_DELTAS);
+    }
+    slot->delta_tick = tick;
+    slot->delta_is_keyframe = keyframe;
+    return keyframe ? &slot->buffer : &slot->delta_buffer;
+}
+
+void ObservationBuilder::_commit_keyframe(AgentSlot& slot) {
+    SentState& sent = slot.sent;
+    sent.valid = true;
+    sent.tick = slot.tick;
+    sent.keyframe_tick = slot.tick;
+    sent.position_steps[0] = position_steps(slot.position.x);
+    sent.position_steps[1] = position_steps(slot.position.y);
+    sent.position_steps[2] = position_steps(slot.position.z);
+    sent.health = slot.health;
+    sent.max_health = slot.max_health;
+    sent.perception_radius = slot.perception_radius;
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        sent.entities[kind] = slot.entity_states[kind];
+    }
+    sent.extras.clear();
+    for (const ExtraRange& range : slot.extra_ranges) {
+        sent.extras[range.key] = std::vector<uint8_t>(slot.extras.begin() + range.begin, slot.extras.begin() + range.end);
+    }
+}
+
+bool ObservationBuilder::_encode_delta(AgentSlot& slot, const String& agent_id) {
+    // Layout (only changed parts besides the header):
+    //   {schema_version, agent_id, tick, base_tick,
+    //    position_delta: [dx, dy, dz] in 1/POSITION_STEPS_PER_UNIT steps,
+    //    health, max_health, perception_radius,
+    //    entities: {<kind key>: {upsert: [{name, type?, position?, distance?}],
+    //                            remove: [name], order: [name]}},
+    //    fields: {key: value}, removed_fields: [key]}
+    // "order" is sent only when the entity order differs from the previous
+    // order with removals dropped and new entities appended.
+    ScopedPerfTimer timer(PerfStats::PHASE_OBSERVATION_BUILD);
+    SentState& sent = slot.sent;
+    std::vector<uint8_t>& body = delta_body;
+    body.clear();
+    uint32_t field_count = 4;
+
+    const int64_t steps[3] = {position_steps(slot.position.x), position_steps(slot.position.y),
+                              position_steps(slot.position.z)};
+    if (steps[0] != sent.position_steps[0] || steps[1] != sent.position_steps[1] ||
+        steps[2] != sent.position_steps[2]) {
+        MsgPackCodec::write_str(body, "position_delta");
+        MsgPackCodec::write_array_header(body, 3);
+        for (int axis = 0; axis < 3; axis++) {
+            MsgPackCodec::write_int(body, steps[axis] - sent.position_steps[axis]);
+        }
+        field_count++;
+    }
+    if (slot.health != sent.health) {
+        MsgPackCodec::write_str(body, "health");
+        MsgPackCodec::write_double(body, slot.health);
+        field_count++;
+    }
+    if (slot.max_health != sent.max_health) {
+        MsgPackCodec::write_str(body, "max_health");
+        MsgPackCodec::write_double(body, slot.max_health);
+        field_count++;
+    }
+    if (slot.perception_radius != sent.perception_radius) {
+        MsgPackCodec::write_str(body, "perception_radius");
+        MsgPackCodec::write_double(body, slot.perception_radius);
+        field_count++;
+    }
+
+    // Entities: the body is written per kind into a nested map, counted first
+    uint32_t changed_kinds = 0;
+    std::vector<uint8_t>& kinds_out = delta_entities;
+    kinds_out.clear();
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        const std::vector<EntityState>& now = slot.entity_states[kind];
+        const std::vector<EntityState>& before = sent.entities[kind];
+
+        sent_index.clear();
+        for (int i = 0; i < (int)before.size(); i++) {
+            sent_index.insert(before[i].name, i);
+        }
+        if (sent_index.size() != (uint32_t)before.size()) {
+            return false;  // Duplicate names can't be addressed by name
+        }
+        sent_matched.assign(before.size(), 0);
+        upserts.clear();
+        for (int i = 0; i < (int)now.size(); i++) {
+            const int* match = sent_index.getptr(now[i].name);
+            if (!match) {
+                sent_index.insert(now[i].name, -1);  // New this tick
+                upserts.push_back(i);
+                continue;
+            }
+            if (*match < 0 || sent_matched[*match]) {
+                return false;
+            }
+            sent_matched[*match] = 1;
+            const EntityState& old = before[*match];
+            if (old.type != now[i].type || old.position != now[i].position ||
+                distance_changed(old.distance, now[i].distance)) {
+                upserts.push_back(i);
+            }
+        }
+        uint32_t removed = 0;
+        for (uint8_t matched : sent_matched) {
+            removed += matched ? 0 : 1;
+        }
+
+        // Would the receiver's natural order match ours?
+        bool order_changed = false;
+        int cursor = 0;
+        for (size_t i = 0; i < before.size() && !order_changed; i++) {
+            if (sent_matched[i]) {
+                order_changed = now[cursor++].name != before[i].name;
+            }
+        }
+        for (int i = 0; i < (int)now.size() && !order_changed; i++) {
+            if (*sent_index.getptr(now[i].name) < 0) {
+                order_changed = now[cursor++].name != now[i].name;
+            }
+        }
+
+        if (upserts.empty() && removed == 0 && !order_changed) {
+            continue;
+        }
+        changed_kinds++;
+        MsgPackCodec::write_str(kinds_out, KIND_KEYS[kind]);
+        MsgPackCodec::write_map_header(kinds_out, (upserts.empty() ? 0 : 1) + (removed ? 1 : 0) + (order_changed ? 1 : 0));
+
+        // The receiver's new state: distances it wasn't sent stay as they were
+        next_entities.clear();
+        for (const EntityState& entity : now) {
+            next_entities.push_back(entity);
+            const int* match = sent_index.getptr(entity.name);
+            if (*match >= 0 && !distance_changed(before[*match].distance, entity.distance)) {
+                next_entities.back().distance = before[*match].distance;
+            }
+        }
+
+        if (!upserts.empty()) {
+            MsgPackCodec::write_str(kinds_out, "upsert");
+            MsgPackCodec::write_array_header(kinds_out, (uint32_t)upserts.size());
+            for (int index : upserts) {
+                const EntityState& entity = now[index];
+                const int* match = sent_index.getptr(entity.name);
+                const EntityState* old = *match >= 0 ? &before[*match] : nullptr;
+                const bool send_type = !old || old->type != entity.type;
+                const bool send_position = !old || old->position != entity.position;
+                const bool send_distance = !old || distance_changed(old->distance, entity.distance);
+                MsgPackCodec::write_map_header(kinds_out, 1 + (send_type ? 1 : 0) + (send_position ? 1 : 0) + (send_distance ? 1 : 0));
+                MsgPackCodec::write_str(kinds_out, "name");
+                MsgPackCodec::write_str(kinds_out, entity.name);
+                if (send_type) {
+                    MsgPackCodec::write_str(kinds_out, "type");
+                    MsgPackCodec::write_str(kinds_out, entity.type);
+                }
+                if (send_position) {
+                    MsgPackCodec::write_str(kinds_out, "position");
+                    MsgPackCodec::write_vector3(kinds_out, entity.position);
+                }
+                if (send_distance) {
+                    MsgPackCodec::write_str(kinds_out, "distance");
+                    MsgPackCodec::write_double(kinds_out, entity.distance);
+                }
+            }
+        }
+        if (removed) {
+            MsgPackCodec::write_str(kinds_out, "remove");
+            MsgPackCodec::write_array_header(kinds_out, removed);
+            for (size_t i = 0; i < before.size(); i++) {
+                if (!sent_matched[i]) {
+                    MsgPackCodec::write_str(kinds_out, before[i].name);
+                }
+            }
+        }
+        if (order_changed) {
+            MsgPackCodec::write_str(kinds_out, "order");
+            MsgPackCodec::write_array_header(kinds_out, (uint32_t)now.size());
+            for (const EntityState& entity : now) {
+                MsgPackCodec::write_str(kinds_out, entity.name);
+            }
+        }
+        sent.entities[kind].swap(next_entities);
+    }
+    if (changed_kinds > 0) {
+        MsgPackCodec::write_str(body, "entities");
+        MsgPackCodec::write_map_header(body, changed_kinds);
+        body.insert(body.end(), kinds_out.begin(), kinds_out.end());
+        field_count++;
+    }
+
+    // Extra fields, compared by their encoded bytes
+    uint32_t changed_fields = 0;
+    for (const ExtraRange& range : slot.extra_ranges) {
+        const std::vector<uint8_t>* old = sent.extras.getptr(range.key);
+        if (!old || !bytes_equal(*old, slot.extras.data() + range.begin, range.end - range.begin)) {
+            changed_fields++;
+        }
+    }
+    uint32_t removed_fields = 0;
+    for (const KeyValue<String, std::vector<uint8_t>>& entry : sent.extras) {
+        bool present = false;
+        for (const ExtraRange& range : slot.extra_ranges) {
+            if (range.key == entry.key) {
+                present = true;
+                break;
+            }
+        }
+        removed_fields += present ? 0 : 1;
+    }
+    if (changed_fields > 0) {
+        MsgPackCodec::write_str(body, "fields");
+        MsgPackCodec::write_map_header(body, changed_fields);
+        for (const ExtraRange& range : slot.extra_ranges) {
+            std::vector<uint8_t>* old = sent.extras.getptr(range.key);
+            const uint8_t* value = slot.extras.data() + range.begin;
+            const size_t size = range.end - range.begin;
+            if (old && bytes_equal(*old, value, size)) {
+                continue;
+            }
+            MsgPackCodec::write_str(body, range.key);
+            body.insert(body.end(), value, value + size);
+            if (old) {
+                old->assign(value, value + size);
+            } else {
+                sent.extras.insert(range.key, std::vector<uint8_t>(value, value + size));
+            }
+        }
+        field_count++;
+    }
+    if (removed_fields > 0) {
+        MsgPackCodec::write_str(body, "removed_fields");
+        MsgPackCodec::write_array_header(body, removed_fields);
+        std::vector<String> gone;
+        for (const KeyValue<String, std::vector<uint8_t>>& entry : sent.extras) {
+            bool present = false;
+            for (const ExtraRange& range : slot.extra_ranges) {
+                if (range.key == entry.key) {
+                    present = true;
+                    break;
+                }
+            }
+            if (!present) {
+                MsgPackCodec::write_str(body, entry.key);
+                gone.push_back(entry.key);
+            }
+        }
+        for (const String& key : gone) {
+            sent.extras.erase(key);
+        }
+        field_count++;
+    }
+
+    std::vector<uint8_t>& out = slot.delta_buffer;
+    out.clear();
+    MsgPackCodec::write_map_header(out, field_count);
+    MsgPackCodec::write_str(out, "schema_version");
+    MsgPackCodec::write_int(out, SCHEMA_VERSION);
+    MsgPackCodec::write_str(out, "agent_id");
+    MsgPackCodec::write_str(out, agent_id);
+    MsgPackCodec::write_str(out, "tick");
+    MsgPackCodec::write_int(out, slot.tick);
+    MsgPackCodec::write_str(out, "base_tick");
+    MsgPackCodec::write_int(out, sent.tick);
+    out.insert(out.end(), body.begin(), body.end());
+
+    sent.tick = slot.tick;
+    for (int axis = 0; axis < 3; axis++) {
+        sent.position_steps[axis] = steps[axis];
+    }
+    sent.health = slot.health;
+    sent.max_health = slot.max_health;
+    sent.perception_radius = slot.perception_radius;
+    return true;
+}
+
+void ObservationBuilder::request_keyframe(const String& agent_id) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (slot) {
+        slot->sent.valid = false;
+        slot->delta_tick = -1;
+    }
+}
+
+void ObservationBuilder::reset_deltas() {
+    for (KeyValue<String, AgentSlot>& entry : slots) {
+        entry.value.sent.valid = false;
+        entry.value.delta_tick = -1;
+    }
+}
+
+void ObservationBuilder::set_keyframe_interval(int ticks) {
+    keyframe_interval = ticks < 0 ? 0 : ticks;
+}
+
+uint64_t ObservationBuilder::_compute_fingerprint(const AgentSlot& slot) const {
+    uint64_t hash = combine(fingerprint_cell(slot.position.x, fingerprint_cell_size),
+                            (uint64_t)fingerprint_cell(slot.position.z, fingerprint_cell_size));
+    const double health_fraction = slot.max_health > 0.0 ? slot.health / slot.max_health : 0.0;
+    hash = combine(hash, (uint64_t)(int64_t)Math::floor(health_fraction * 20.0));
+
+    // Entities and fields are summed so their order doesn't matter
+    uint64_t entities = 0;
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        for (const EntityState& entity : slot.entity_states[kind]) {
+            uint64_t entity_hash = combine((uint64_t)kind, entity.name.hash());
+            entity_hash = combine(entity_hash, entity.type.hash());
+            entity_hash = combine(entity_hash, (uint64_t)fingerprint_cell(entity.position.x, fingerprint_cell_size));
+            entity_hash = combine(entity_hash, (uint64_t)fingerprint_cell(entity.position.z, fingerprint_cell_size));
+            entities += mix64(entity_hash);
+        }
+    }
+    hash = combine(hash, entities);
+
+    uint64_t fields = 0;
+    for (const ExtraRange& range : slot.extra_ranges) {
+        if (fingerprint_ignored_fields.has(range.key)) {
+            continue;
+        }
+        fields += mix64(combine(range.key.hash(), hash_bytes(slot.extras.data() + range.begin, range.end - range.begin)));
+    }
+    return combine(hash, fields);
+}
+
+bool ObservationBuilder::get_native_fingerprint(const String& agent_id, int64_t tick, uint64_t& r_fingerprint) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot || slot->tick != tick) {
+        return false;
+    }
+    if (slot->fingerprint_dirty) {
+        slot->fingerprint = _compute_fingerprint(*slot);
+        slot->fingerprint_dirty = false;
+    }
+    r_fingerprint = slot->fingerprint;
+    return true;
+}
+
+int64_t ObservationBuilder::get_fingerprint(const String& agent_id) {
+    const AgentSlot* slot = slots.getptr(agent_id);
+    uint64_t fingerprint = 0;
+    if (slot && slot->tick >= 0) {
+        get_native_fingerprint(agent_id, slot->tick, fingerprint);
+    }
+    return (int64_t)fingerprint;
+}
+
+void ObservationBuilder::set_fingerprint_cell_size(double size) {
+    fingerprint_cell_size = Math::max(0.1, size);
+    for (KeyValue<String, AgentSlot>& entry : slots) {
+        entry.value.fingerprint_dirty = true;
+    }
+}
+
+void ObservationBuilder::set_fingerprint_ignored_fields(const PackedStringArray& fields) {
+    fingerprint_ignored_fields = fields;
+    for (KeyValue<String, AgentSlot>& entry : slots) {
+        entry.value.fingerprint_dirty = true;
+    }
+}
+
+bool ObservationBuilder::has_observation(const String& agent_id, int64_t tick) const {
+    const AgentSlot* slot = slots.getptr(agent_id);
+    return slot && slot->tick == tick;
+}
+
+PackedByteArray ObservationBuilder::get_buffer(const String& agent_id) {
+    PackedByteArray bytes;
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot || slot->tick < 0) {
+        return bytes;
+    }
+
+    const std::vector<uint8_t>* buffer = get_native_buffer(agent_id, slot->tick);
+    bytes.resize((int64_t)buffer->size());
+    if (!buffer->empty()) {
+        std::memcpy(bytes.ptrw(), buffer->data(), buffer->size());
+    }
+    return bytes;
+}
+
+Dictionary ObservationBuilder::get_observation(const String& agent_id) {
+    AgentSlot* slot = slots.getptr(agent_id);
+    if (!slot || slot->tick < 0) {
+        return Dictionary();
+    }
+
+    const std::vector<uint8_t>* buffer = get_native_buffer(agent_id, slot->tick);
+    Variant decoded;
+    if (!MsgPackCodec::decode(buffer->data(), buffer->size(), decoded) || decoded.get_type() != Variant::DICTIONARY) {
+        ARENA_LOG_WARN("ObservationBuilder: failed to decode observation for ", agent_id);
+        return Dictionary();
+    }
+    return decoded;
+}
+
+void ObservationBuilder::remove_agent(const String& agent_id) {
+    if (agent_id == current_agent) {
+        current_agent = String();
+        current = nullptr;
+    }
+    slots.erase(agent_id);
+}
+
+void ObservationBuilder::clear() {
+    slots.clear();
+    current_agent = String();
+    current = nullptr;
+}
@@ -0,0 +1,522 @@
+#include "path_planner.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/array.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// PathPlanner Implementation
+// ============================================================================
+
+namespace {
+
+const float SQRT2 = 1.41421356f;
+
+// 8-connected moves: 4 straight, then 4 diagonal
+const int32_t STEP_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int32_t STEP_Z[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+uint64_t cache_key(int32_t start, int32_t goal, bool avoid_hazards) {
+    return ((uint64_t)(uint32_t)start << 33) | ((uint64_t)(uint32_t)goal << 1) | (avoid_hazards ? 1 : 0);
+}
+
+} // namespace
+
+PathPlanner::PathPlanner()
+    : cell_size(1.0),
+      world_min(-25, -25),
+      world_max(25, 25),
+      min_cell_x(0),
+      min_cell_z(0),
+      width(0),
+      height(0),
+      epoch(0),
+      obstacle_epoch(0),
+      max_cached_paths(4096),
+      cache_enabled(true),
+      query_counter(0),
+      search_stamp(0),
+      cache_hits(0),
+      cache_misses(0),
+      nodes_expanded(0) {
+    _rebuild();
+}
+
+PathPlanner::~PathPlanner() {}
+
+void PathPlanner::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_world_bounds", "min_pos", "max_pos"), &PathPlanner::set_world_bounds);
+    ClassDB::bind_method(D_METHOD("get_world_min"), &PathPlanner::get_world_min);
+    ClassDB::bind_method(D_METHOD("get_world_max"), &PathPlanner::get_world_max);
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &PathPlanner::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &PathPlanner::get_cell_size);
+    ClassDB::bind_method(D_METHOD("get_min_cell"), &PathPlanner::get_min_cell);
+    ClassDB::bind_method(D_METHOD("get_grid_size"), &PathPlanner::get_grid_size);
+
+    ClassDB::bind_method(D_METHOD("set_cell_blocked", "x", "z", "blocked"), &PathPlanner::set_cell_blocked);
+    ClassDB::bind_method(D_METHOD("is_cell_blocked", "x", "z"), &PathPlanner::is_cell_blocked);
+    ClassDB::bind_method(D_METHOD("set_blocked_cells", "blocked"), &PathPlanner::set_blocked_cells);
+    ClassDB::bind_method(D_METHOD("clear_obstacles"), &PathPlanner::clear_obstacles);
+
+    ClassDB::bind_method(D_METHOD("set_hazard", "id", "position", "radius"), &PathPlanner::set_hazard);
+    ClassDB::bind_method(D_METHOD("remove_hazard", "id"), &PathPlanner::remove_hazard);
+    ClassDB::bind_method(D_METHOD("clear_hazards"), &PathPlanner::clear_hazards);
+    ClassDB::bind_method(D_METHOD("get_hazard_count"), &PathPlanner::get_hazard_count);
+    ClassDB::bind_method(D_METHOD("get_epoch"), &PathPlanner::get_epoch);
+
+    ClassDB::bind_method(D_METHOD("plan_path", "from", "to", "avoid_hazards"), &PathPlanner::plan_path, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("plan_paths", "from", "to", "avoid_hazards"), &PathPlanner::plan_paths, DEFVAL(true));
+
+    ClassDB::bind_method(D_METHOD("set_cache_enabled", "enabled"), &PathPlanner::set_cache_enabled);
+    ClassDB::bind_method(D_METHOD("get_cache_enabled"), &PathPlanner::get_cache_enabled);
+    ClassDB::bind_method(D_METHOD("set_max_cached_paths", "count"), &PathPlanner::set_max_cached_paths);
+    ClassDB::bind_method(D_METHOD("get_max_cached_paths"), &PathPlanner::get_max_cached_paths);
+    ClassDB::bind_method(D_METHOD("get_cache_size"), &PathPlanner::get_cache_size);
+    ClassDB::bind_method(D_METHOD("clear_cache"), &PathPlanner::clear_cache);
+    ClassDB::bind_method(D_METHOD("get_stats"), &PathPlanner::get_stats);
+    ClassDB::bind_method(D_METHOD("reset_stats"), &PathPlanner::reset_stats);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cache_enabled"), "set_cache_enabled", "get_cache_enabled");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_cached_paths"), "set_max_cached_paths", "get_max_cached_paths");
+}
+
+void PathPlanner::set_world_bounds(const Vector2& min_pos, const Vector2& max_pos) {
+    world_min = min_pos;
+    world_max = max_pos;
+    _rebuild();
+}
+
+void PathPlanner::set_cell_size(double size) {
+    cell_size = Math::max(0.1, size);
+    _rebuild();
+}
+
+void PathPlanner::_rebuild() {
+    // Same in-bounds rule as ExplorationGrid: the cell's corner lies within [min, max]
+    min_cell_x = (int32_t)std::ceil(world_min.x / cell_size);
+    min_cell_z = (int32_t)std::ceil(world_min.y / cell_size);
+    const int32_t max_cell_x = (int32_t)std::floor(world_max.x / cell_size);
+    const int32_t max_cell_z = (int32_t)std::floor(world_max.y / cell_size);
+    width = max_cell_x >= min_cell_x ? max_cell_x - min_cell_x + 1 : 0;
+    height = max_cell_z >= min_cell_z ? max_cell_z - min_cell_z + 1 : 0;
+
+    const size_t count = (size_t)width * (size_t)height;
+    obstacles.assign(count, 0);
+    hazard_cover.assign(count, 0);
+    for (const KeyValue<int64_t, Hazard>& kv : hazards) {
+        _cover_hazard(kv.value, 1);
+    }
+
+    g_cost.assign(count, 0.0f);
+    parent.assign(count, -1);
+    visit_stamp.assign(count, 0);
+    closed_stamp.assign(count, 0);
+    search_stamp = 0;
+
+    cache.clear();
+    epoch++;
+    obstacle_epoch = epoch;
+}
+
+bool PathPlanner::_to_cell(const Vector3& position, int32_t& r_x, int32_t& r_z) const {
+    r_x = (int32_t)std::floor(position.x / cell_size);
+    r_z = (int32_t)std::floor(position.z / cell_size);
+    return width > 0 && height > 0 && r_x >= min_cell_x && r_x < min_cell_x + width && r_z >= min_cell_z &&
+           r_z < min_cell_z + height;
+}
+
+Vector3 PathPlanner::_index_center(int32_t index, double y) const {
+    const int32_t x = min_cell_x + index % width;
+    const int32_t z = min_cell_z + index / width;
+    return Vector3((x + 0.5) * cell_size, y, (z + 0.5) * cell_size);
+}
+
+void PathPlanner::_cover_hazard(const Hazard& hazard, int delta) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    // Every cell whose square comes within radius of the hazard centre
+    const double r = hazard.radius;
+    const int32_t x0 = Math::max(min_cell_x, (int32_t)std::floor((hazard.position.x - r) / cell_size));
+    const int32_t x1 = Math::min(min_cell_x + width - 1, (int32_t)std::floor((hazard.position.x + r) / cell_size));
+    const int32_t z0 = Math::max(min_cell_z, (int32_t)std::floor((hazard.position.z - r) / cell_size));
+    const int32_t z1 = Math::min(min_cell_z + height - 1, (int32_t)std::floor((hazard.position.z + r) / cell_size));
+
+    for (int32_t z = z0; z <= z1; z++) {
+        for (int32_t x = x0; x <= x1; x++) {
+            const double nx = Math::clamp((double)hazard.position.x, x * cell_size, (x + 1) * cell_size);
+            const double nz = Math::clamp((double)hazard.position.z, z * cell_size, (z + 1) * cell_size);
+            const double dx = nx - hazard.position.x;
+            const double dz = nz - hazard.position.z;
+            if (dx * dx + dz * dz >= r * r) {
+                continue;
+            }
+            uint16_t& cover = hazard_cover[_index(x, z)];
+            cover = (uint16_t)(delta > 0 ? cover + 1 : (cover > 0 ? cover - 1 : 0));
+        }
+    }
+}
+
+void PathPlanner::set_cell_blocked(int x, int z, bool blocked) {
+    if (x < min_cell_x || x >= min_cell_x + width || z < min_cell_z || z >= min_cell_z + height) {
+        return;
+    }
+    uint8_t& cell = obstacles[_index(x, z)];
+    if (cell != (blocked ? 1 : 0)) {
+        cell = blocked ? 1 : 0;
+        epoch++;
+        obstacle_epoch = epoch;
+    }
+}
+
+bool PathPlanner::is_cell_blocked(int x, int z) const {
+    if (x < min_cell_x || x >= min_cell_x + width || z < min_cell_z || z >= min_cell_z + height) {
+        return true;
+    }
+    return obstacles[_index(x, z)] != 0;
+}
+
+void PathPlanner::set_blocked_cells(const PackedByteArray& blocked) {
+    const int64_t count = Math::min((int64_t)obstacles.size(), blocked.size());
+    for (int64_t i = 0; i < count; i++) {
+        obstacles[i] = blocked[i] ? 1 : 0;
+    }
+    epoch++;
+    obstacle_epoch = epoch;
+}
+
+void PathPlanner::clear_obstacles() {
+    std::fill(obstacles.begin(), obstacles.end(), 0);
+    epoch++;
+    obstacle_epoch = epoch;
+}
+
+void PathPlanner::set_hazard(int64_t id, const Vector3& position, double radius) {
+    Hazard* existing = hazards.getptr(id);
+    if (existing) {
+        if (existing->position == position && existing->radius == radius) {
+            return;
+        }
+        _cover_hazard(*existing, -1);
+        existing->position = position;
+        existing->radius = Math::max(0.0, radius);
+        _cover_hazard(*existing, 1);
+    } else {
+        const Hazard hazard{position, Math::max(0.0, radius)};
+        hazards.insert(id, hazard);
+        _cover_hazard(hazard, 1);
+    }
+    epoch++;
+}
+
+void PathPlanner::remove_hazard(int64_t id) {
+    const Hazard* existing = hazards.getptr(id);
+    if (!existing) {
+        return;
+    }
+    _cover_hazard(*existing, -1);
+    hazards.erase(id);
+    epoch++;
+}
+
+void PathPlanner::clear_hazards() {
+    if (hazards.is_empty()) {
+        return;
+    }
+    hazards.clear();
+    std::fill(hazard_cover.begin(), hazard_cover.end(), 0);
+    epoch++;
+}
+
+bool PathPlanner::_passable(int32_t index, bool avoid_hazards) const {
+    return !obstacles[index] && (!avoid_hazards || hazard_cover[index] == 0);
+}
+
+bool PathPlanner::_search(int32_t start, int32_t goal, bool avoid_hazards, std::vector<int32_t>& r_cells) {
+    r_cells.clear();
+    if (start == goal) {
+        r_cells.push_back(start);
+        return true;
+    }
+
+    if (++search_stamp == 0) {
+        std::fill(visit_stamp.begin(), visit_stamp.end(), 0);
+        std::fill(closed_stamp.begin(), closed_stamp.end(), 0);
+        search_stamp = 1;
+    }
+
+    const int32_t goal_x = goal % width;
+    const int32_t goal_z = goal / width;
+    auto heuristic = [&](int32_t index) -> float {
+        const int32_t dx = std::abs(index % width - goal_x);
+        const int32_t dz = std::abs(index / width - goal_z);
+        return (float)(dx + dz) + (SQRT2 - 2.0f) * (float)(dx < dz ? dx : dz);
+    };
+    auto heap_less = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };  // Min-heap on f
+
+    open_heap.clear();
+    g_cost[start] = 0.0f;
+    parent[start] = -1;
+    visit_stamp[start] = search_stamp;
+    open_heap.push_back(OpenNode{heuristic(start), start});
+
+    // The start and goal cells are always enterable, so agents can leave or
+    // reach a spot inside a hazard
+    auto enterable = [&](int32_t index) { return index == goal || _passable(index, avoid_hazards); };
+
+    bool found = false;
+    while (!open_heap.empty()) {
+        std::pop_heap(open_heap.begin(), open_heap.end(), heap_less);
+        const int32_t current = open_heap.back().cell;
+        open_heap.pop_back();
+        if (closed_stamp[current] == search_stamp) {
+            continue;  // Stale duplicate
+        }
+        closed_stamp[current] = search_stamp;
+        nodes_expanded++;
+
+        if (current == goal) {
+            found = true;
+            break;
+        }
+
+        const int32_t cx = current % width;
+        const int32_t cz = current / width;
+        for (int dir = 0; dir < 8; dir++) {
+            const int32_t nx = cx + STEP_X[dir];
+            const int32_t nz = cz + STEP_Z[dir];
+            if (nx < 0 || nx >= width || nz < 0 || nz >= height) {
+                continue;
+            }
+            const int32_t next = nz * width + nx;
+            if (closed_stamp[next] == search_stamp || !enterable(next)) {
+                continue;
+            }
+            // No squeezing diagonally between two blocked cells' corners
+            if (dir >= 4 && (!enterable(cz * width + nx) || !enterable(nz * width + cx))) {
+                continue;
+            }
+
+            const float g = g_cost[current] + (dir >= 4 ? SQRT2 : 1.0f);
+            if (visit_stamp[next] == search_stamp && g >= g_cost[next]) {
+                continue;
+            }
+            visit_stamp[next] = search_stamp;
+            g_cost[next] = g;
+            parent[next] = current;
+            open_heap.push_back(OpenNode{g + heuristic(next), next});
+            std::push_heap(open_heap.begin(), open_heap.end(), heap_less);
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    trace.clear();
+    for (int32_t cell = goal; cell != -1; cell = parent[cell]) {
+        trace.push_back(cell);
+    }
+    std::reverse(trace.begin(), trace.end());
+
+    // Keep only the start, the goal and the cells where the direction changes
+    r_cells.push_back(trace.front());
+    for (size_t i = 1; i + 1 < trace.size(); i++) {
+        if (trace[i] - trace[i - 1] != trace[i + 1] - trace[i]) {
+            r_cells.push_back(trace[i]);
+        }
+    }
+    r_cells.push_back(trace.back());
+    return true;
+}
+
+void PathPlanner::_prune_cache() {
+    if ((int)cache.size() <= max_cached_paths) {
+        return;
+    }
+
+    // Drop the least recently used quarter
+    std::vector<std::pair<uint64_t, uint64_t>> entries;
+    entries.reserve(cache.size());
+    for (const KeyValue<uint64_t, CachedPath>& kv : cache) {
+        entries.push_back({kv.value.last_used, kv.key});
+    }
+    const size_t drop = entries.size() - (size_t)max_cached_paths * 3 / 4;
+    std::nth_element(entries.begin(), entries.begin() + drop, entries.end());
+    for (size_t i = 0; i < drop; i++) {
+        cache.erase(entries[i].second);
+    }
+}
+
+void PathPlanner::plan_native(const Vector3& from, const Vector3& to, bool avoid_hazards, Result& r_result) {
+    r_result.success = false;
+    r_result.cached = false;
+    r_result.distance = 0.0;
+    r_result.waypoints.clear();
+    query_counter++;
+
+    int32_t goal_x, goal_z;
+    if (!_to_cell(to, goal_x, goal_z) || obstacles[_index(goal_x, goal_z)]) {
+        return;
+    }
+    // Agents can stray just outside the bounds; plan from the nearest cell
+    int32_t start_x, start_z;
+    _to_cell(from, start_x, start_z);
+    start_x = Math::clamp(start_x, min_cell_x, min_cell_x + width - 1);
+    start_z = Math::clamp(start_z, min_cell_z, min_cell_z + height - 1);
+
+    const int32_t start = _index(start_x, start_z);
+    const int32_t goal = _index(goal_x, goal_z);
+
+    const std::vector<int32_t>* cells = nullptr;
+    std::vector<int32_t> uncached;
+    if (cache_enabled) {
+        const uint64_t key = cache_key(start, goal, avoid_hazards);
+        CachedPath* entry = cache.getptr(key);
+        const bool fresh = entry && (avoid_hazards ? entry->epoch == epoch : entry->epoch >= obstacle_epoch);
+        if (fresh) {
+            cache_hits++;
+            r_result.cached = true;
+        } else {
+            cache_misses++;
+            if (!entry) {
+                entry = &cache.insert(key, CachedPath())->value;
+            }
+            entry->found = _search(start, goal, avoid_hazards, entry->cells);
+            entry->epoch = epoch;
+        }
+        entry->last_used = query_counter;
+        if (!entry->found) {
+            _prune_cache();
+            return;
+        }
+        cells = &entry->cells;
+    } else {
+        cache_misses++;
+        if (!_search(start, goal, avoid_hazards, uncached)) {
+            return;
+        }
+        cells = &uncached;
+    }
+
+    // Exact endpoints, cell centres for the turns in between
+    r_result.waypoints.push_back(from);
+    for (size_t i = 1; i + 1 < cells->size(); i++) {
+        r_result.waypoints.push_back(_index_center((*cells)[i], from.y));
+    }
+    r_result.waypoints.push_back(to);
+    for (size_t i = 1; i < r_result.waypoints.size(); i++) {
+        r_result.distance += r_result.waypoints[i - 1].distance_to(r_result.waypoints[i]);
+    }
+    r_result.success = true;
+
+    // Pruning may erase the entry cells points at, so it runs last
+    if (cache_enabled) {
+        _prune_cache();
+    }
+}
+
+Dictionary PathPlanner::plan_path(const Vector3& from, const Vector3& to, bool avoid_hazards) {
+    Result path;
+    plan_native(from, to, avoid_hazards, path);
+
+    Dictionary result;
+    result["success"] = path.success;
+    result["blocked"] = !path.success;
+    result["avoid_hazards"] = avoid_hazards;
+    result["cached"] = path.cached;
+    if (!path.success) {
+        int32_t x, z;
+        if (!_to_cell(to, x, z)) {
+            result["reason"] = "Target is outside the world bounds";
+        } else if (obstacles[_index(x, z)]) {
+            result["reason"] = "Target is inside an obstacle";
+        } else {
+            result["reason"] = avoid_hazards ? "No hazard-free path found to target" : "No path found to target";
+        }
+        return result;
+    }
+
+    Array waypoints;
+    for (const Vector3& point : path.waypoints) {
+        Array entry;
+        entry.append(point.x);
+        entry.append(point.y);
+        entry.append(point.z);
+        waypoints.append(entry);
+    }
+    result["waypoints"] = waypoints;
+    result["distance"] = path.distance;
+    return result;
+}
+
+Dictionary PathPlanner::plan_paths(const PackedVector3Array& from, const PackedVector3Array& to, bool avoid_hazards) {
+    const int64_t count = Math::min(from.size(), to.size());
+
+    PackedInt32Array offsets;
+    PackedVector3Array waypoints;
+    PackedFloat32Array distances;
+    PackedByteArray success;
+    offsets.resize(count + 1);
+    distances.resize(count);
+    success.resize(count);
+
+    // Pairs sharing a start and goal cell hit the cache after the first
+    Result path;
+    int32_t total = 0;
+    offsets.set(0, 0);
+    for (int64_t i = 0; i < count; i++) {
+        plan_native(from[i], to[i], avoid_hazards, path);
+        for (const Vector3& point : path.waypoints) {
+            waypoints.push_back(point);
+        }
+        total += (int32_t)path.waypoints.size();
+        offsets.set(i + 1, total);
+        distances.set(i, (float)path.distance);
+        success.set(i, path.success ? 1 : 0);
+    }
+
+    Dictionary result;
+    result["offsets"] = offsets;
+    result["waypoints"] = waypoints;
+    result["distances"] = distances;
+    result["success"] = success;
+    return result;
+}
+
+void PathPlanner::set_cache_enabled(bool enabled) {
+    cache_enabled = enabled;
+    if (!enabled) {
+        cache.clear();
+    }
+}
+
+void PathPlanner::set_max_cached_paths(int count) {
+    max_cached_paths = count < 16 ? 16 : count;
+    _prune_cache();
+}
+
+Dictionary PathPlanner::get_stats() const {
+    Dictionary stats;
+    stats["cache_hits"] = cache_hits;
+    stats["cache_misses"] = cache_misses;
+    stats["nodes_expanded"] = nodes_expanded;
+    stats["cache_size"] = (int64_t)cache.size();
+    stats["epoch"] = (int64_t)epoch;
+    return stats;
+}
+
+void PathPlanner::reset_stats() {
+    cache_hits = 0;
+    cache_misses = 0;
+    nodes_expanded = 0;
+}
@@ -0,0 +1,301 @@
+#include "perf_stats.h"
+
+#include "arena_log.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstdio>
+#include <string>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// PerfStats Implementation
+// ============================================================================
+
+namespace {
+
+const char* const PHASE_NAMES[PerfStats::PHASE_COUNT] = {
+    "tick",
+    "observation_build",
+    "serialize",
+    "ipc_send",
+    "backend_wait",
+    "response_parse",
+    "action_execute",
+    "tool_latency",
+};
+
+const char* const COUNTER_NAMES[PerfStats::COUNTER_COUNT] = {
+    "tick_requests",
+    "tick_responses",
+    "ticks_skipped",
+    "tool_requests",
+    "tool_timeouts",
+    "local_tool_calls",
+    "bytes_sent",
+    "observation_keyframes",
+    "observation_deltas",
+    "decision_cache_hits",
+    "reconnect_attempts",
+    "stale_responses",
+    "tool_requests_rejected",
+    "decisions_deferred",
+    "decisions_throttled",
+};
+
+double usec_to_ms(uint64_t usec) {
+    return (double)usec / 1000.0;
+}
+
+} // namespace
+
+void PerfStats::Histogram::record(uint64_t usec) {
+    if (count == 0 || usec < min_usec) min_usec = usec;
+    if (usec > max_usec) max_usec = usec;
+    count++;
+    total_usec += usec;
+    last_usec = usec;
+
+    int bucket = 0;
+    for (uint64_t v = usec; v > 1 && bucket < BUCKET_COUNT - 1; v >>= 1) {
+        bucket++;
+    }
+    buckets[bucket]++;
+}
+
+uint64_t PerfStats::Histogram::percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint64_t rank = (uint64_t)(fraction * (double)count + 0.5);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0) {
+            const uint64_t upper = (uint64_t)1 << (i + 1);
+            return upper < max_usec ? upper : max_usec;
+        }
+    }
+    return max_usec;
+}
+
+PerfStats& PerfStats::get() {
+    static PerfStats instance;
+    return instance;
+}
+
+PerfStats::PerfStats()
+    : enabled(true),
+      counters{},
+      tool_queue_depth(0),
+      peak_tool_queue_depth(0),
+      tracing(false),
+      trace_capacity(0),
+      trace_origin_usec(0) {}
+
+void PerfStats::record_span(Phase phase, uint64_t start_usec, uint64_t end_usec) {
+    if (!enabled) {
+        return;
+    }
+    const uint64_t duration = end_usec > start_usec ? end_usec - start_usec : 0;
+    histograms[phase].record(duration);
+
+    if (tracing && trace_events.size() < trace_capacity) {
+        trace_events.push_back(TraceEvent{start_usec, duration, phase});
+    }
+}
+
+void PerfStats::set_tool_queue_depth(int depth) {
+    tool_queue_depth = depth;
+    if (depth > peak_tool_queue_depth) {
+        peak_tool_queue_depth = depth;
+    }
+}
+
+void PerfStats::reset() {
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        histograms[i] = Histogram();
+    }
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counters[i] = 0;
+    }
+    peak_tool_queue_depth = tool_queue_depth;
+}
+
+Dictionary PerfStats::to_dictionary() const {
+    Dictionary phases;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        const Histogram& h = histograms[i];
+        Dictionary entry;
+        entry["count"] = (int64_t)h.count;
+        entry["mean_ms"] = h.mean_usec() / 1000.0;
+        entry["min_ms"] = usec_to_ms(h.min_usec);
+        entry["max_ms"] = usec_to_ms(h.max_usec);
+        entry["last_ms"] = usec_to_ms(h.last_usec);
+        entry["p50_ms"] = usec_to_ms(h.percentile(0.50));
+        entry["p95_ms"] = usec_to_ms(h.percentile(0.95));
+        entry["p99_ms"] = usec_to_ms(h.percentile(0.99));
+        phases[PHASE_NAMES[i]] = entry;
+    }
+
+    Dictionary counter_values;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counter_values[COUNTER_NAMES[i]] = (int64_t)counters[i];
+    }
+
+    Dictionary result;
+    result["phases"] = phases;
+    result["counters"] = counter_values;
+    result["tool_queue_depth"] = tool_queue_depth;
+    result["peak_tool_queue_depth"] = peak_tool_queue_depth;
+    return result;
+}
+
+void PerfStats::start_trace(int max_events) {
+    trace_events.clear();
+    trace_capacity = max_events < 1 ? 1 : (size_t)max_events;
+    trace_events.reserve(trace_capacity);
+    trace_origin_usec = now_usec();
+    tracing = true;
+}
+
+String PerfStats::export_trace_json() const {
+    // Chrome trace event format: complete ("X") events, timestamps in us
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char line[160];
+    for (size_t i = 0; i < trace_events.size(); i++) {
+        const TraceEvent& event = trace_events[i];
+        const uint64_t ts = event.start_usec > trace_origin_usec ? event.start_usec - trace_origin_usec : 0;
+        std::snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%llu}",
+                      i == 0 ? "" : ",", PHASE_NAMES[event.phase],
+                      (unsigned long long)ts, (unsigned long long)event.duration_usec);
+        out += line;
+    }
+    out += "]}";
+    return String::utf8(out.c_str(), (int64_t)out.size());
+}
+
+const char* PerfStats::phase_name(Phase phase) {
+    return PHASE_NAMES[phase];
+}
+
+const char* PerfStats::counter_name(Counter counter) {
+    return COUNTER_NAMES[counter];
+}
+
+// ============================================================================
+// PerfMonitor Implementation
+// ============================================================================
+
+PerfMonitor::PerfMonitor()
+    : register_monitors(true),
+      monitors_registered(false) {}
+
+PerfMonitor::~PerfMonitor() {}
+
+void PerfMonitor::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("get_perf_stats"), &PerfMonitor::get_perf_stats);
+    ClassDB::bind_method(D_METHOD("reset_perf_stats"), &PerfMonitor::reset_perf_stats);
+    ClassDB::bind_method(D_METHOD("set_stats_enabled", "enabled"), &PerfMonitor::set_stats_enabled);
+    ClassDB::bind_method(D_METHOD("get_stats_enabled"), &PerfMonitor::get_stats_enabled);
+    ClassDB::bind_method(D_METHOD("start_trace", "max_events"), &PerfMonitor::start_trace, DEFVAL(200000));
+    ClassDB::bind_method(D_METHOD("stop_trace"), &PerfMonitor::stop_trace);
+    ClassDB::bind_method(D_METHOD("is_tracing"), &PerfMonitor::is_tracing);
+    ClassDB::bind_method(D_METHOD("get_trace_event_count"), &PerfMonitor::get_trace_event_count);
+    ClassDB::bind_method(D_METHOD("export_trace", "path"), &PerfMonitor::export_trace);
+    ClassDB::bind_method(D_METHOD("set_register_monitors", "enabled"), &PerfMonitor::set_register_monitors);
+    ClassDB::bind_method(D_METHOD("get_register_monitors"), &PerfMonitor::get_register_monitors);
+
+    ClassDB::bind_method(D_METHOD("_monitor_phase", "phase"), &PerfMonitor::_monitor_phase);
+    ClassDB::bind_method(D_METHOD("_monitor_tool_queue_depth"), &PerfMonitor::_monitor_tool_queue_depth);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stats_enabled"), "set_stats_enabled", "get_stats_enabled");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "register_monitors"), "set_register_monitors", "get_register_monitors");
+}
+
+void PerfMonitor::_enter_tree() {
+    if (register_monitors) {
+        _add_monitors();
+    }
+}
+
+void PerfMonitor::_exit_tree() {
+    _remove_monitors();
+}
+
+void PerfMonitor::_add_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (monitors_registered || !performance) {
+        return;
+    }
+
+    for (int i = 0; i < PerfStats::PHASE_COUNT; i++) {
+        const String id = String("agent_arena/") + PerfStats::phase_name((PerfStats::Phase)i) + "_ms";
+        if (!performance->has_custom_monitor(id)) {
+            Array args;
+            args.append(i);
+            performance->add_custom_monitor(id, Callable(this, "_monitor_phase"), args);
+        }
+    }
+    if (!performance->has_custom_monitor("agent_arena/tool_queue_depth")) {
+        performance->add_custom_monitor("agent_arena/tool_queue_depth", Callable(this, "_monitor_tool_queue_depth"));
+    }
+    monitors_registered = true;
+}
+
+void PerfMonitor::_remove_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (!monitors_registered || !performance) {
+        return;
+    }
+
+    for (int i = 0; i < PerfStats::PHASE_COUNT; i++) {
+        const String id = String("agent_arena/") + PerfStats::phase_name((PerfStats::Phase)i) + "_ms";
+        if (performance->has_custom_monitor(id)) {
+            performance->remove_custom_monitor(id);
+        }
+    }
+    if (performance->has_custom_monitor("agent_arena/tool_queue_depth")) {
+        performance->remove_custom_monitor("agent_arena/tool_queue_depth");
+    }
+    monitors_registered = false;
+}
+
+void PerfMonitor::set_register_monitors(bool enabled) {
+    register_monitors = enabled;
+    if (!is_inside_tree()) {
+        return;
+    }
+    if (enabled) {
+        _add_monitors();
+    } else {
+        _remove_monitors();
+    }
+}
+
+double PerfMonitor::_monitor_phase(int phase) const {
+    if (phase < 0 || phase >= PerfStats::PHASE_COUNT) {
+        return 0.0;
+    }
+    return usec_to_ms(PerfStats::get().get_histogram((PerfStats::Phase)phase).last_usec);
+}
+
+Error PerfMonitor::export_trace(const String& path) const {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        Error err = FileAccess::get_open_error();
+        ARENA_LOG_ERROR("PerfMonitor: failed to open trace file ", path, " (", err, ")");
+        return err;
+    }
+    file->store_string(PerfStats::get().export_trace_json());
+    ARENA_LOG_INFO("PerfMonitor: wrote ", PerfStats::get().get_trace_event_count(), " trace events to ", path);
+    return OK;
+}
@@ -0,0 +1,103 @@
+#include "random_stream.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/char_string.hpp>
+
+#include <cmath>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// RandomStream Implementation
+// ============================================================================
+
+RandomStream::RandomStream() : stream_seed(0) {
+    set_seed(0);
+}
+
+void RandomStream::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &RandomStream::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &RandomStream::get_seed);
+    ClassDB::bind_method(D_METHOD("randi"), &RandomStream::randi);
+    ClassDB::bind_method(D_METHOD("randf"), &RandomStream::randf);
+    ClassDB::bind_method(D_METHOD("randi_range", "from", "to"), &RandomStream::randi_range);
+    ClassDB::bind_method(D_METHOD("randf_range", "from", "to"), &RandomStream::randf_range);
+    ClassDB::bind_method(D_METHOD("randfn", "mean", "deviation"), &RandomStream::randfn, DEFVAL(0.0), DEFVAL(1.0));
+    ClassDB::bind_method(D_METHOD("fork", "name"), &RandomStream::fork);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+}
+
+uint64_t RandomStream::hash_name(const String& name) {
+    CharString utf8 = name.utf8();
+    const char* data = utf8.get_data();
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (int64_t i = 0; i < utf8.length(); i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+uint64_t RandomStream::derive_seed(uint64_t master_seed, const String& name) {
+    uint64_t x = master_seed ^ hash_name(name);
+    return splitmix64(x);
+}
+
+void RandomStream::set_seed(uint64_t seed) {
+    stream_seed = seed;
+
+    // Expand the 64-bit seed into the 256-bit state; SplitMix64 never yields all zeros here
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) {
+        state[i] = splitmix64(x);
+    }
+}
+
+uint64_t RandomStream::next_bounded(uint64_t bound) {
+    if (bound == 0) {
+        return next_u64();
+    }
+
+    // Reject the low values that would make the modulo uneven
+    const uint64_t threshold = (0 - bound) % bound;
+    while (true) {
+        const uint64_t r = next_u64();
+        if (r >= threshold) {
+            return r % bound;
+        }
+    }
+}
+
+int64_t RandomStream::randi() {
+    return (int64_t)(next_u64() >> 32);
+}
+
+int64_t RandomStream::randi_range(int64_t from, int64_t to) {
+    if (from > to) {
+        int64_t tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    // Span of 0 means the full 64-bit range
+    const uint64_t span = (uint64_t)to - (uint64_t)from + 1;
+    return (int64_t)((uint64_t)from + next_bounded(span));
+}
+
+double RandomStream::randfn(double mean, double deviation) {
+    // Box-Muller; 1 - u keeps the log argument in (0, 1]
+    const double u1 = 1.0 - next_double();
+    const double u2 = next_double();
+    const double radius = std::sqrt(-2.0 * std::log(u1));
+    return mean + deviation * radius * std::cos(6.283185307179586 * u2);
+}
+
+Ref<RandomStream> RandomStream::fork(const String& name) const {
+    Ref<RandomStream> child;
+    child.instantiate();
+    child->set_seed(derive_seed(stream_seed, name));
+    return child;
+}
@@ -1,5 +1,12 @@
 #include "register_types.h"
 #include "agent_arena.h"
+#include "agent_world.h"
+#include "arena_log.h"
+#include "exploration_grid.h"
+#include "line_of_sight.h"
+#include "path_planner.h"
+#include "spatial_index.h"
+#include "world_host.h"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/class_db.hpp>
@@ -19,6 +26,18 @@ void initialize_agent_arena_module(ModuleInitializationLevel p_level) {
     ClassDB::register_class<Agent>();
     ClassDB::register_class<ToolRegistry>();
     ClassDB::register_class<IPCClient>();
+    ClassDB::register_class<ReplayReader>();
+    ClassDB::register_class<RandomStream>();
+    ClassDB::register_class<SpatialIndex>();
+    ClassDB::register_class<LineOfSight>();
+    ClassDB::register_class<ObservationBuilder>();
+    ClassDB::register_class<WorldHost>();
+    ClassDB::register_class<ToolFuture>();
+    ClassDB::register_class<PerfMonitor>();
+    ClassDB::register_class<ArenaLog>();
+    ClassDB::register_class<ExplorationGrid>();
+    ClassDB::register_class<PathPlanner>();
+    ClassDB::register_class<AgentWorld>();
 }
 
 void uninitialize_agent_arena_module(ModuleInitializationLevel p_level) {
@@ -0,0 +1,320 @@
+#include "replay_log.h"
+#include "arena_log.h"
+#include "msgpack_codec.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+using namespace agent_arena::replay_format;
+
+// ============================================================================
+// ReplayWriter Implementation
+// ============================================================================
+
+ReplayWriter::ReplayWriter()
+    : compress(true),
+      chunk_event_limit(4096),
+      pending_count(0),
+      pending_first_tick(0),
+      pending_last_tick(0),
+      chunk_count(0),
+      bytes_written(0) {
+}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+Error ReplayWriter::open(const String& path, bool p_compress) {
+    close();
+
+    file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        Error err = FileAccess::get_open_error();
+        ARENA_LOG_ERROR("ReplayWriter: Failed to open ", path, " Error code: ", err);
+        return err;
+    }
+
+    compress = p_compress;
+    chunk_count = 0;
+    file->store_32(FILE_MAGIC);
+    file->store_32(VERSION);
+    bytes_written = 8;
+
+    ARENA_LOG_INFO("ReplayWriter: Recording to ", path);
+    return OK;
+}
+
+void ReplayWriter::close() {
+    if (file.is_null()) {
+        return;
+    }
+
+    flush_chunk();
+    file->close();
+    file.unref();
+}
+
+bool ReplayWriter::append(uint64_t tick, const String& event_type, const Dictionary& data) {
+    if (file.is_null()) {
+        return false;
+    }
+
+    // Only cut chunks on tick boundaries so a tick is always in one chunk
+    bool flushed = false;
+    if (pending_count >= (uint32_t)chunk_event_limit && tick != pending_last_tick) {
+        flush_chunk();
+        flushed = true;
+    }
+
+    if (pending_count == 0) {
+        pending_first_tick = tick;
+    }
+    pending_last_tick = tick;
+
+    // [tick, type, data], written field by field rather than via a temporary Array
+    MsgPackCodec::write_array_header(pending, 3);
+    MsgPackCodec::write_int(pending, (int64_t)tick);
+    MsgPackCodec::write_str(pending, event_type);
+    MsgPackCodec::encode(data, pending);
+    pending_count++;
+
+    return flushed;
+}
+
+void ReplayWriter::flush_chunk() {
+    if (file.is_null() || pending_count == 0) {
+        return;
+    }
+
+    PackedByteArray raw;
+    raw.resize(static_cast<int64_t>(pending.size()));
+    std::memcpy(raw.ptrw(), pending.data(), pending.size());
+
+    uint32_t compression = COMPRESSION_NONE;
+    PackedByteArray stored = raw;
+    if (compress) {
+        PackedByteArray packed = raw.compress(FileAccess::COMPRESSION_ZSTD);
+        // Keep the raw payload when compression doesn't pay for itself
+        if (packed.size() > 0 && packed.size() < raw.size()) {
+            stored = packed;
+            compression = COMPRESSION_ZSTD;
+        }
+    }
+
+    file->store_32(CHUNK_MAGIC);
+    file->store_64(pending_first_tick);
+    file->store_64(pending_last_tick);
+    file->store_32(pending_count);
+    file->store_32(compression);
+    file->store_32((uint32_t)raw.size());
+    file->store_32((uint32_t)stored.size());
+    file->store_buffer(stored);
+    file->flush();
+
+    bytes_written += CHUNK_HEADER_SIZE + (uint64_t)stored.size();
+    chunk_count++;
+
+    pending.clear();
+    pending_count = 0;
+}
+
+// ============================================================================
+// ReplayReader Implementation
+// ============================================================================
+
+ReplayReader::ReplayReader()
+    : event_count(0),
+      monotonic(true),
+      min_tick(0),
+      max_tick(0),
+      cached_chunk(-1) {
+}
+
+ReplayReader::~ReplayReader() {
+    close();
+}
+
+void ReplayReader::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("open", "path"), &ReplayReader::open);
+    ClassDB::bind_method(D_METHOD("close"), &ReplayReader::close);
+    ClassDB::bind_method(D_METHOD("is_open"), &ReplayReader::is_open);
+    ClassDB::bind_method(D_METHOD("get_events_for_tick", "tick"), &ReplayReader::get_events_for_tick);
+    ClassDB::bind_method(D_METHOD("get_events_in_range", "from_tick", "to_tick"), &ReplayReader::get_events_in_range);
+    ClassDB::bind_method(D_METHOD("get_chunk_count"), &ReplayReader::get_chunk_count);
+    ClassDB::bind_method(D_METHOD("get_event_count"), &ReplayReader::get_event_count);
+    ClassDB::bind_method(D_METHOD("get_first_tick"), &ReplayReader::get_first_tick);
+    ClassDB::bind_method(D_METHOD("get_last_tick"), &ReplayReader::get_last_tick);
+    ClassDB::bind_method(D_METHOD("is_monotonic"), &ReplayReader::is_monotonic);
+}
+
+Error ReplayReader::open(const String& path) {
+    close();
+
+    file = FileAccess::open(path, FileAccess::READ);
+    if (file.is_null()) {
+        return FileAccess::get_open_error();
+    }
+
+    if (file->get_length() < 8 || file->get_32() != FILE_MAGIC || file->get_32() != VERSION) {
+        ARENA_LOG_WARN("ReplayReader: ", path, " is not a replay log");
+        close();
+        return ERR_FILE_UNRECOGNIZED;
+    }
+
+    // Index chunk headers; a truncated trailing chunk (crash mid-write) is ignored
+    const uint64_t length = file->get_length();
+    uint64_t offset = 8;
+    while (offset + CHUNK_HEADER_SIZE <= length) {
+        file->seek(offset);
+        if (file->get_32() != CHUNK_MAGIC) {
+            break;
+        }
+
+        ChunkInfo info;
+        info.first_tick = file->get_64();
+        info.last_tick = file->get_64();
+        info.event_count = file->get_32();
+        info.compression = file->get_32();
+        info.raw_size = file->get_32();
+        info.stored_size = file->get_32();
+        info.payload_offset = offset + CHUNK_HEADER_SIZE;
+
+        if (info.payload_offset + info.stored_size > length) {
+            break;
+        }
+
+        if (chunks.empty()) {
+            min_tick = info.first_tick;
+            max_tick = info.last_tick;
+        } else {
+            monotonic = monotonic && info.first_tick > chunks.back().last_tick;
+            min_tick = std::min(min_tick, info.first_tick);
+            max_tick = std::max(max_tick, info.last_tick);
+        }
+        chunks.push_back(info);
+        event_count += info.event_count;
+        offset = info.payload_offset + info.stored_size;
+    }
+
+    ARENA_LOG_INFO("ReplayReader: Indexed ", (int64_t)chunks.size(), " chunks (", event_count, " events) from ", path);
+    return OK;
+}
+
+void ReplayReader::close() {
+    if (file.is_valid()) {
+        file->close();
+        file.unref();
+    }
+    chunks.clear();
+    event_count = 0;
+    monotonic = true;
+    min_tick = 0;
+    max_tick = 0;
+    cached_chunk = -1;
+    cached_events.clear();
+}
+
+bool ReplayReader::_load_chunk(int index) {
+    if (index == cached_chunk) {
+        return true;
+    }
+
+    const ChunkInfo& info = chunks[index];
+    file->seek(info.payload_offset);
+    PackedByteArray payload = file->get_buffer(info.stored_size);
+    if (payload.size() != (int64_t)info.stored_size) {
+        return false;
+    }
+
+    if (info.compression == COMPRESSION_ZSTD) {
+        payload = payload.decompress(info.raw_size, FileAccess::COMPRESSION_ZSTD);
+        if (payload.size() != (int64_t)info.raw_size) {
+            ARENA_LOG_WARN("ReplayReader: Failed to decompress chunk ", index);
+            return false;
+        }
+    }
+
+    cached_chunk = -1;
+    cached_events.clear();
+    cached_events.reserve(info.event_count);
+
+    const uint8_t* data = payload.ptr();
+    const size_t size = (size_t)payload.size();
+    size_t pos = 0;
+    for (uint32_t i = 0; i < info.event_count && pos < size; i++) {
+        Variant value;
+        size_t consumed = 0;
+        if (!MsgPackCodec::decode(data + pos, size - pos, value, &consumed)) {
+            ARENA_LOG_WARN("ReplayReader: Corrupt event in chunk ", index);
+            return false;
+        }
+        pos += consumed;
+
+        if (value.get_type() != Variant::ARRAY) {
+            continue;
+        }
+        Array entry = value;
+        if (entry.size() < 3 || entry[0].get_type() != Variant::INT) {
+            continue;
+        }
+
+        DecodedEvent decoded;
+        decoded.tick = (uint64_t)(int64_t)entry[0];
+        decoded.event["tick"] = entry[0];
+        decoded.event["type"] = entry[1];
+        decoded.event["data"] = entry[2];
+        cached_events.push_back(decoded);
+    }
+
+    cached_chunk = index;
+    return true;
+}
+
+Array ReplayReader::get_events_for_tick(uint64_t tick) {
+    return get_events_in_range(tick, tick);
+}
+
+Array ReplayReader::get_events_in_range(uint64_t from_tick, uint64_t to_tick) {
+    Array events;
+    if (file.is_null() || chunks.empty() || from_tick > to_tick) {
+        return events;
+    }
+
+    // Start at the chunk containing from_tick, or the first one after it; a
+    // log recorded across a rewind has no such order, so check every chunk
+    int start = 0;
+    if (monotonic) {
+        auto it = std::lower_bound(chunks.begin(), chunks.end(), from_tick,
+                                   [](const ChunkInfo& chunk, uint64_t t) { return chunk.last_tick < t; });
+        start = (int)(it - chunks.begin());
+    }
+    for (int index = start; index < (int)chunks.size(); index++) {
+        if (chunks[index].first_tick > to_tick) {
+            if (monotonic) {
+                break;
+            }
+            continue;
+        }
+        if (chunks[index].last_tick < from_tick) {
+            continue;
+        }
+        if (!_load_chunk(index)) {
+            break;
+        }
+
+        auto first = std::lower_bound(cached_events.begin(), cached_events.end(), from_tick,
+                                      [](const DecodedEvent& e, uint64_t t) { return e.tick < t; });
+        for (auto e = first; e != cached_events.end() && e->tick <= to_tick; ++e) {
+            events.append(e->event);
+        }
+    }
+
+    return events;
+}
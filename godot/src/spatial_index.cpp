@@ -0,0 +1,258 @@
+#include "spatial_index.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// SpatialIndex Implementation
+// ============================================================================
+
+namespace {
+
+int64_t pack_cell(int32_t cx, int32_t cz) {
+    return ((int64_t)cx << 32) | (int64_t)(uint32_t)cz;
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex() : cell_size(5.0) {}
+
+SpatialIndex::~SpatialIndex() {}
+
+void SpatialIndex::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("insert", "id", "position", "category_mask"), &SpatialIndex::insert);
+    ClassDB::bind_method(D_METHOD("update", "id", "position"), &SpatialIndex::update);
+    ClassDB::bind_method(D_METHOD("remove", "id"), &SpatialIndex::remove);
+    ClassDB::bind_method(D_METHOD("clear"), &SpatialIndex::clear);
+    ClassDB::bind_method(D_METHOD("has", "id"), &SpatialIndex::has);
+    ClassDB::bind_method(D_METHOD("get_count"), &SpatialIndex::get_count);
+    ClassDB::bind_method(D_METHOD("get_position", "id"), &SpatialIndex::get_position);
+
+    ClassDB::bind_method(D_METHOD("query_radius", "center", "radius", "category_mask"), &SpatialIndex::query_radius);
+    ClassDB::bind_method(D_METHOD("query_radius_with_distance", "center", "radius", "category_mask"),
+                         &SpatialIndex::query_radius_with_distance);
+    ClassDB::bind_method(D_METHOD("query_radius_batch", "centers", "radius", "category_mask"),
+                         &SpatialIndex::query_radius_batch);
+
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &SpatialIndex::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &SpatialIndex::get_cell_size);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+}
+
+int64_t SpatialIndex::_cell_key_for(const Vector3& position) const {
+    const int32_t cx = (int32_t)std::floor(position.x / cell_size);
+    const int32_t cz = (int32_t)std::floor(position.z / cell_size);
+    return pack_cell(cx, cz);
+}
+
+void SpatialIndex::_cell_insert(int64_t id, Entry& entry) {
+    std::vector<int64_t>& cell = cells[entry.cell_key];
+    entry.slot = (uint32_t)cell.size();
+    cell.push_back(id);
+}
+
+void SpatialIndex::_cell_remove(const Entry& entry) {
+    std::vector<int64_t>* cell = cells.getptr(entry.cell_key);
+    if (!cell) {
+        return;
+    }
+
+    // Swap-remove, fixing up the slot of the entity that moved
+    const int64_t last_id = cell->back();
+    (*cell)[entry.slot] = last_id;
+    cell->pop_back();
+    if (entry.slot < cell->size()) {
+        entities[last_id].slot = entry.slot;
+    }
+
+    if (cell->empty()) {
+        cells.erase(entry.cell_key);
+    }
+}
+
+void SpatialIndex::_rebuild() {
+    cells.clear();
+    for (KeyValue<int64_t, Entry>& kv : entities) {
+        kv.value.cell_key = _cell_key_for(kv.value.position);
+        _cell_insert(kv.key, kv.value);
+    }
+}
+
+void SpatialIndex::insert(int64_t id, const Vector3& position, int category_mask) {
+    if (entities.has(id)) {
+        remove(id);
+    }
+
+    Entry entry;
+    entry.position = position;
+    entry.category_mask = (uint32_t)category_mask;
+    entry.cell_key = _cell_key_for(position);
+    entry.slot = 0;
+    _cell_insert(id, entry);
+    entities.insert(id, entry);
+}
+
+void SpatialIndex::update(int64_t id, const Vector3& position) {
+    Entry* entry = entities.getptr(id);
+    if (!entry) {
+        return;
+    }
+
+    entry->position = position;
+    const int64_t new_key = _cell_key_for(position);
+    if (new_key == entry->cell_key) {
+        return;
+    }
+
+    _cell_remove(*entry);
+    entry->cell_key = new_key;
+    _cell_insert(id, *entry);
+}
+
+void SpatialIndex::remove(int64_t id) {
+    const Entry* entry = entities.getptr(id);
+    if (!entry) {
+        return;
+    }
+
+    _cell_remove(*entry);
+    entities.erase(id);
+}
+
+void SpatialIndex::clear() {
+    entities.clear();
+    cells.clear();
+}
+
+Vector3 SpatialIndex::get_position(int64_t id) const {
+    const Entry* entry = entities.getptr(id);
+    return entry ? entry->position : Vector3();
+}
+
+void SpatialIndex::query_radius_native(const Vector3& center, double radius, uint32_t category_mask,
+                                       std::vector<Hit>& r_hits, int64_t exclude_id) const {
+    if (radius < 0.0) {
+        return;
+    }
+
+    const size_t first = r_hits.size();
+    const double radius_sq = radius * radius;
+    const int32_t min_cx = (int32_t)std::floor((center.x - radius) / cell_size);
+    const int32_t max_cx = (int32_t)std::floor((center.x + radius) / cell_size);
+    const int32_t min_cz = (int32_t)std::floor((center.z - radius) / cell_size);
+    const int32_t max_cz = (int32_t)std::floor((center.z + radius) / cell_size);
+
+    auto scan_cell = [&](const std::vector<int64_t>& cell) {
+        for (int64_t id : cell) {
+            if (id == exclude_id) {
+                continue;
+            }
+            const Entry* entry = entities.getptr(id);
+            if (!(entry->category_mask & category_mask)) {
+                continue;
+            }
+            const double dist_sq = center.distance_squared_to(entry->position);
+            if (dist_sq <= radius_sq) {
+                r_hits.push_back(Hit{id, (float)std::sqrt(dist_sq)});
+            }
+        }
+    };
+
+    // A radius much larger than the cell size would visit mostly empty cells
+    const int64_t span = (int64_t)(max_cx - min_cx + 1) * (int64_t)(max_cz - min_cz + 1);
+    if (span > (int64_t)cells.size()) {
+        for (const KeyValue<int64_t, std::vector<int64_t>>& kv : cells) {
+            scan_cell(kv.value);
+        }
+    } else {
+        for (int32_t cx = min_cx; cx <= max_cx; cx++) {
+            for (int32_t cz = min_cz; cz <= max_cz; cz++) {
+                const std::vector<int64_t>* cell = cells.getptr(pack_cell(cx, cz));
+                if (cell) {
+                    scan_cell(*cell);
+                }
+            }
+        }
+    }
+
+    std::sort(r_hits.begin() + first, r_hits.end(), [](const Hit& a, const Hit& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+    });
+}
+
+PackedInt64Array SpatialIndex::query_radius(const Vector3& center, double radius, int category_mask) const {
+    std::vector<Hit> hits;
+    query_radius_native(center, radius, (uint32_t)category_mask, hits);
+
+    PackedInt64Array ids;
+    ids.resize((int64_t)hits.size());
+    int64_t* ids_w = ids.ptrw();
+    for (size_t i = 0; i < hits.size(); i++) {
+        ids_w[i] = hits[i].id;
+    }
+    return ids;
+}
+
+Dictionary SpatialIndex::query_radius_with_distance(const Vector3& center, double radius, int category_mask) const {
+    std::vector<Hit> hits;
+    query_radius_native(center, radius, (uint32_t)category_mask, hits);
+
+    PackedInt64Array ids;
+    PackedFloat32Array distances;
+    ids.resize((int64_t)hits.size());
+    distances.resize((int64_t)hits.size());
+    int64_t* ids_w = ids.ptrw();
+    float* dist_w = distances.ptrw();
+    for (size_t i = 0; i < hits.size(); i++) {
+        ids_w[i] = hits[i].id;
+        dist_w[i] = hits[i].distance;
+    }
+
+    Dictionary result;
+    result["ids"] = ids;
+    result["distances"] = distances;
+    return result;
+}
+
+Dictionary SpatialIndex::query_radius_batch(const PackedVector3Array& centers, double radius, int category_mask) const {
+    std::vector<Hit> hits;
+    PackedInt32Array offsets;
+    offsets.resize(centers.size() + 1);
+    int32_t* offsets_w = offsets.ptrw();
+
+    const Vector3* centers_r = centers.ptr();
+    for (int64_t i = 0; i < centers.size(); i++) {
+        offsets_w[i] = (int32_t)hits.size();
+        query_radius_native(centers_r[i], radius, (uint32_t)category_mask, hits);
+    }
+    offsets_w[centers.size()] = (int32_t)hits.size();
+
+    PackedInt64Array ids;
+    PackedFloat32Array distances;
+    ids.resize((int64_t)hits.size());
+    distances.resize((int64_t)hits.size());
+    int64_t* ids_w = ids.ptrw();
+    float* dist_w = distances.ptrw();
+    for (size_t i = 0; i < hits.size(); i++) {
+        ids_w[i] = hits[i].id;
+        dist_w[i] = hits[i].distance;
+    }
+
+    Dictionary result;
+    result["offsets"] = offsets;
+    result["ids"] = ids;
+    result["distances"] = distances;
+    return result;
+}
+
+void SpatialIndex::set_cell_size(double size) {
+    cell_size = Math::max(0.1, size);
+    _rebuild();
+}
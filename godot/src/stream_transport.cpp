@@ -0,0 +1,305 @@
+#include "stream_transport.h"
+#include "arena_log.h"
+#include "msgpack_codec.h"
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <chrono>
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// StreamTransport Implementation
+// ============================================================================
+
+namespace {
+
+// StreamPeerTCP can't block on readiness, so the worker polls: quickly while
+// a reply is due, slowly when idle (a queued send still wakes it at once)
+const int WORKER_REPLY_POLL_USEC = 500;
+const int WORKER_IDLE_WAIT_USEC = 5000;
+const int WORKER_REPLY_WINDOW_MSEC = 250;  // Slower replies wait on the idle poll
+const size_t OUTBOUND_FRAMES = 64;
+const size_t INBOUND_MESSAGES = 256;
+
+} // namespace
+
+StreamTransport::StreamTransport()
+    : connected(false),
+      rx_offset(0),
+      bytes_sent(0),
+      bytes_received(0),
+      threaded(true),
+      use_worker(false),
+      worker_running(false),
+      worker_connecting(false),
+      stop_requested(false),
+      worker_port(0),
+      outbound(OUTBOUND_FRAMES),
+      recycled(OUTBOUND_FRAMES),
+      inbound(INBOUND_MESSAGES) {
+}
+
+StreamTransport::~StreamTransport() {
+    close();
+}
+
+bool StreamTransport::open(const String& host, int port) {
+    close();
+
+    use_worker = threaded;
+    if (!use_worker) {
+        return _connect(host, port);
+    }
+
+    worker_host = host;
+    worker_port = port;
+    stop_requested.store(false);
+    worker_connecting.store(true);
+    worker_running.store(true);
+    worker = std::thread(&StreamTransport::_run_worker, this);
+    return true;
+}
+
+void StreamTransport::close() {
+    if (use_worker) {
+        _stop_worker();
+    } else {
+        _close_socket();
+    }
+}
+
+bool StreamTransport::is_connecting() const {
+    if (use_worker) {
+        return worker_connecting.load(std::memory_order_acquire);
+    }
+    return peer.is_valid() && peer->get_status() == StreamPeerTCP::STATUS_CONNECTING;
+}
+
+bool StreamTransport::_connect(const String& host, int port) {
+    peer.instantiate();
+    Error err = peer->connect_to_host(host, port);
+    if (err != OK) {
+        ARENA_LOG_ERROR("StreamTransport: Failed to connect to ", host, ":", port, " Error code: ", err);
+        peer.unref();
+        return false;
+    }
+
+    ARENA_LOG_INFO("StreamTransport: Connecting to ", host, ":", port);
+    return true;
+}
+
+void StreamTransport::_close_socket() {
+    if (peer.is_valid()) {
+        peer->disconnect_from_host();
+        peer.unref();
+    }
+    connected.store(false, std::memory_order_release);
+    rx_buffer.clear();
+    rx_offset = 0;
+}
+
+void StreamTransport::poll(Array& r_messages) {
+    if (!use_worker) {
+        if (peer.is_valid() && !_pump(r_messages)) {
+            _close_socket();
+        }
+        return;
+    }
+
+    Variant message;
+    while (inbound.try_pop(message)) {
+        r_messages.append(message);
+    }
+    if (!worker_running.load(std::memory_order_acquire) && worker.joinable()) {
+        _stop_worker();  // Connection ended on the worker; reap it
+    }
+}
+
+bool StreamTransport::_pump(Array& r_messages) {
+    peer->poll();
+    StreamPeerTCP::Status status = peer->get_status();
+
+    if (status == StreamPeerTCP::STATUS_CONNECTING) {
+        return true;
+    }
+    if (status != StreamPeerTCP::STATUS_CONNECTED) {
+        if (connected.load()) {
+            ARENA_LOG_WARN("StreamTransport: Connection lost");
+        }
+        return false;
+    }
+
+    if (!connected.load()) {
+        peer->set_no_delay(true);  // Frames are small and latency-bound
+        connected.store(true, std::memory_order_release);
+        ARENA_LOG_INFO("StreamTransport: Connected");
+    }
+
+    int32_t available = peer->get_available_bytes();
+    if (available <= 0) {
+        return true;
+    }
+
+    Array result = peer->get_partial_data(available);
+    if ((int)result[0] != OK) {
+        return false;
+    }
+
+    PackedByteArray data = result[1];
+    rx_buffer.insert(rx_buffer.end(), data.ptr(), data.ptr() + data.size());
+    bytes_received.fetch_add((uint64_t)data.size(), std::memory_order_relaxed);
+
+    return _extract_frames(r_messages);
+}
+
+bool StreamTransport::_extract_frames(Array& r_messages) {
+    while (rx_buffer.size() - rx_offset >= 4) {
+        const uint8_t* head = rx_buffer.data() + rx_offset;
+        const uint32_t frame_size = uint32_t(head[0]) | (uint32_t(head[1]) << 8) |
+                                    (uint32_t(head[2]) << 16) | (uint32_t(head[3]) << 24);
+
+        if (frame_size > MAX_FRAME_SIZE) {
+            ARENA_LOG_WARN("StreamTransport: Oversized frame (", frame_size, " bytes), closing connection");
+            return false;
+        }
+        if (rx_buffer.size() - rx_offset - 4 < frame_size) {
+            break;  // Wait for the rest of the frame
+        }
+
+        Variant message;
+        if (MsgPackCodec::decode(head + 4, frame_size, message) && message.get_type() == Variant::DICTIONARY) {
+            r_messages.append(message);
+        } else {
+            ARENA_LOG_WARN("StreamTransport: Dropping malformed frame");
+        }
+        rx_offset += 4 + frame_size;
+    }
+
+    // Compact once everything buffered has been consumed (or the dead prefix is large)
+    if (rx_offset == rx_buffer.size()) {
+        rx_buffer.clear();
+        rx_offset = 0;
+    } else if (rx_offset > 64 * 1024) {
+        rx_buffer.erase(rx_buffer.begin(), rx_buffer.begin() + rx_offset);
+        rx_offset = 0;
+    }
+    return true;
+}
+
+bool StreamTransport::_write(const std::vector<uint8_t>& frame) {
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(frame.size()));
+    std::memcpy(bytes.ptrw(), frame.data(), frame.size());
+
+    if (peer->put_data(bytes) != OK) {
+        return false;
+    }
+    bytes_sent.fetch_add(frame.size(), std::memory_order_relaxed);
+    return true;
+}
+
+void StreamTransport::_run_worker() {
+    bool alive = _connect(worker_host, worker_port);
+    Array messages;
+    std::vector<uint8_t> frame;
+    int64_t replies_due = 0;  // Frames written since the last message arrived
+    std::chrono::steady_clock::time_point last_write;
+
+    while (alive && !stop_requested.load(std::memory_order_acquire)) {
+        alive = _pump(messages);
+        worker_connecting.store(alive && !connected.load(), std::memory_order_release);
+        replies_due = messages.size() >= replies_due ? 0 : replies_due - messages.size();
+
+        // Decoded messages wait here rather than being dropped if the main thread falls behind
+        for (int i = 0; i < messages.size() && !stop_requested.load(); i++) {
+            Variant message = messages[i];
+            while (!inbound.try_push(std::move(message)) && !stop_requested.load()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(WORKER_REPLY_POLL_USEC));
+            }
+        }
+        messages.clear();
+
+        while (alive && connected.load() && outbound.try_pop(frame)) {
+            alive = _write(frame);
+            replies_due++;
+            last_write = std::chrono::steady_clock::now();
+            frame.clear();
+            recycled.try_push(std::move(frame));  // Dropped if the main thread isn't reusing them
+            frame = std::vector<uint8_t>();
+        }
+
+        const bool reply_soon = replies_due > 0 &&
+                                std::chrono::steady_clock::now() - last_write < std::chrono::milliseconds(WORKER_REPLY_WINDOW_MSEC);
+        std::unique_lock<std::mutex> lock(wake_lock);
+        wake.wait_for(lock, std::chrono::microseconds(reply_soon ? WORKER_REPLY_POLL_USEC : WORKER_IDLE_WAIT_USEC),
+                      [this]() { return stop_requested.load() || (connected.load() && !outbound.empty()); });
+    }
+
+    _close_socket();
+    worker_connecting.store(false, std::memory_order_release);
+    worker_running.store(false, std::memory_order_release);
+}
+
+void StreamTransport::_stop_worker() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(wake_lock);
+            stop_requested.store(true, std::memory_order_release);
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    // Nothing else touches the queues now; unsent frames die with the connection
+    outbound.clear();
+    recycled.clear();
+    inbound.clear();
+    connected.store(false, std::memory_order_release);
+    worker_connecting.store(false, std::memory_order_release);
+}
+
+Error StreamTransport::send_message(const Dictionary& message) {
+    if (!connected) {
+        return ERR_CONNECTION_ERROR;
+    }
+
+    MsgPackCodec::encode(message, begin_frame());
+    return send_frame();
+}
+
+std::vector<uint8_t>& StreamTransport::begin_frame() {
+    if (use_worker && tx_buffer.capacity() == 0) {
+        recycled.try_pop(tx_buffer);  // The last frame's buffer moved to the worker
+    }
+
+    // Reserve the length prefix; send_frame() patches it once the body is written
+    tx_buffer.clear();
+    tx_buffer.resize(4);
+    return tx_buffer;
+}
+
+Error StreamTransport::send_frame() {
+    if (!connected) {
+        return ERR_CONNECTION_ERROR;
+    }
+
+    const uint32_t frame_size = static_cast<uint32_t>(tx_buffer.size() - 4);
+    tx_buffer[0] = static_cast<uint8_t>(frame_size);
+    tx_buffer[1] = static_cast<uint8_t>(frame_size >> 8);
+    tx_buffer[2] = static_cast<uint8_t>(frame_size >> 16);
+    tx_buffer[3] = static_cast<uint8_t>(frame_size >> 24);
+
+    if (use_worker) {
+        if (!outbound.try_push(std::move(tx_buffer))) {
+            return ERR_BUSY;  // Worker is behind; the caller falls back to HTTP
+        }
+        tx_buffer = std::vector<uint8_t>();
+        wake.notify_one();
+        return OK;
+    }
+
+    return _write(tx_buffer) ? OK : ERR_CONNECTION_ERROR;
+}
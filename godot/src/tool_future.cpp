@@ -0,0 +1,98 @@
+#include "tool_future.h"
+
+#include "agent_arena.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object.hpp>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// ToolFuture Implementation
+// ============================================================================
+
+ToolFuture::ToolFuture()
+    : request_id(-1),
+      status(STATUS_PENDING),
+      deadline_msec(0),
+      client_id(0) {}
+
+ToolFuture::~ToolFuture() {}
+
+void ToolFuture::_bind_methods() {
+    ClassDB::bind_static_method("ToolFuture", D_METHOD("make_resolved", "tool_name", "agent_id", "result"),
+                                &ToolFuture::make_resolved);
+    ClassDB::bind_method(D_METHOD("cancel"), &ToolFuture::cancel);
+    ClassDB::bind_method(D_METHOD("is_done"), &ToolFuture::is_done);
+    ClassDB::bind_method(D_METHOD("is_success"), &ToolFuture::is_success);
+    ClassDB::bind_method(D_METHOD("get_status"), &ToolFuture::get_status);
+    ClassDB::bind_method(D_METHOD("get_result"), &ToolFuture::get_result);
+    ClassDB::bind_method(D_METHOD("get_request_id"), &ToolFuture::get_request_id);
+    ClassDB::bind_method(D_METHOD("get_tool_name"), &ToolFuture::get_tool_name);
+    ClassDB::bind_method(D_METHOD("get_agent_id"), &ToolFuture::get_agent_id);
+
+    ADD_SIGNAL(MethodInfo("completed", PropertyInfo(Variant::DICTIONARY, "result")));
+
+    BIND_ENUM_CONSTANT(STATUS_PENDING);
+    BIND_ENUM_CONSTANT(STATUS_COMPLETED);
+    BIND_ENUM_CONSTANT(STATUS_FAILED);
+    BIND_ENUM_CONSTANT(STATUS_CANCELLED);
+    BIND_ENUM_CONSTANT(STATUS_TIMED_OUT);
+}
+
+Ref<ToolFuture> ToolFuture::make_resolved(const String& tool_name, const String& agent_id, const Dictionary& result) {
+    Ref<ToolFuture> future;
+    future.instantiate();
+    future->tool_name = tool_name;
+    future->agent_id = agent_id;
+    future->result = result;
+    future->status = result.get("success", false) ? STATUS_COMPLETED : STATUS_FAILED;
+    return future;
+}
+
+void ToolFuture::setup(IPCClient* client, int64_t p_request_id, const String& p_tool_name,
+                       const String& p_agent_id, uint64_t p_deadline_msec) {
+    client_id = client ? client->get_instance_id() : 0;
+    request_id = p_request_id;
+    tool_name = p_tool_name;
+    agent_id = p_agent_id;
+    deadline_msec = p_deadline_msec;
+}
+
+void ToolFuture::resolve(const Dictionary& response) {
+    if (status != STATUS_PENDING) {
+        return;
+    }
+    result = response;
+    status = response.get("success", false) ? STATUS_COMPLETED : STATUS_FAILED;
+    emit_signal("completed", result);
+}
+
+void ToolFuture::abandon(Status final_status, const String& error) {
+    if (status != STATUS_PENDING) {
+        return;
+    }
+    result = Dictionary();
+    result["success"] = false;
+    result["error"] = error;
+    result["request_id"] = request_id;
+    result["agent_id"] = agent_id;
+    result["tool_name"] = tool_name;
+    status = final_status;
+    emit_signal("completed", result);
+}
+
+bool ToolFuture::cancel() {
+    if (status != STATUS_PENDING) {
+        return false;
+    }
+
+    IPCClient* client = client_id ? Object::cast_to<IPCClient>(ObjectDB::get_instance(client_id)) : nullptr;
+    if (client) {
+        // Drops the queued or in-flight request and abandons this future
+        return client->cancel_tool_request(request_id);
+    }
+    abandon(STATUS_CANCELLED, "Tool request cancelled");
+    return true;
+}
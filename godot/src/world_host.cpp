@@ -0,0 +1,292 @@
+#include "world_host.h"
+
+#include "agent_arena.h"
+#include "arena_log.h"
+#include "random_stream.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// WorldHost Implementation
+// ============================================================================
+
+WorldHost::WorldHost()
+    : world_count(1),
+      master_seed(0),
+      tick_rate(10.0),
+      backend_timeout(10.0),
+      render_worlds(false),
+      ipc_client_id(0),
+      is_running(false),
+      awaiting_backend(false),
+      tick_accumulator(0.0),
+      wait_time(0.0),
+      current_tick(0) {}
+
+WorldHost::~WorldHost() {}
+
+void WorldHost::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("spawn_worlds"), &WorldHost::spawn_worlds);
+    ClassDB::bind_method(D_METHOD("clear_worlds"), &WorldHost::clear_worlds);
+    ClassDB::bind_method(D_METHOD("start"), &WorldHost::start);
+    ClassDB::bind_method(D_METHOD("stop"), &WorldHost::stop);
+    ClassDB::bind_method(D_METHOD("reset"), &WorldHost::reset);
+    ClassDB::bind_method(D_METHOD("step"), &WorldHost::step);
+
+    ClassDB::bind_method(D_METHOD("get_spawned_world_count"), &WorldHost::get_spawned_world_count);
+    ClassDB::bind_method(D_METHOD("get_world_root", "index"), &WorldHost::get_world_root);
+    ClassDB::bind_method(D_METHOD("get_world_simulation", "index"), &WorldHost::get_world_simulation);
+    ClassDB::bind_method(D_METHOD("get_world_id", "index"), &WorldHost::get_world_id);
+    ClassDB::bind_method(D_METHOD("set_ipc_client", "client"), &WorldHost::set_ipc_client);
+    ClassDB::bind_method(D_METHOD("get_ipc_client"), &WorldHost::get_ipc_client);
+    ClassDB::bind_method(D_METHOD("get_is_running"), &WorldHost::get_is_running);
+    ClassDB::bind_method(D_METHOD("is_awaiting_backend"), &WorldHost::is_awaiting_backend);
+    ClassDB::bind_method(D_METHOD("get_current_tick"), &WorldHost::get_current_tick);
+
+    ClassDB::bind_method(D_METHOD("set_world_scene", "scene"), &WorldHost::set_world_scene);
+    ClassDB::bind_method(D_METHOD("get_world_scene"), &WorldHost::get_world_scene);
+    ClassDB::bind_method(D_METHOD("set_world_count", "count"), &WorldHost::set_world_count);
+    ClassDB::bind_method(D_METHOD("get_world_count"), &WorldHost::get_world_count);
+    ClassDB::bind_method(D_METHOD("set_master_seed", "seed"), &WorldHost::set_master_seed);
+    ClassDB::bind_method(D_METHOD("get_master_seed"), &WorldHost::get_master_seed);
+    ClassDB::bind_method(D_METHOD("set_tick_rate", "rate"), &WorldHost::set_tick_rate);
+    ClassDB::bind_method(D_METHOD("get_tick_rate"), &WorldHost::get_tick_rate);
+    ClassDB::bind_method(D_METHOD("set_backend_timeout", "seconds"), &WorldHost::set_backend_timeout);
+    ClassDB::bind_method(D_METHOD("get_backend_timeout"), &WorldHost::get_backend_timeout);
+    ClassDB::bind_method(D_METHOD("set_render_worlds", "enabled"), &WorldHost::set_render_worlds);
+    ClassDB::bind_method(D_METHOD("get_render_worlds"), &WorldHost::get_render_worlds);
+
+    ClassDB::bind_method(D_METHOD("_on_tick_request_completed", "tick"), &WorldHost::_on_tick_request_completed);
+    ClassDB::bind_method(D_METHOD("_on_connection_failed", "error"), &WorldHost::_on_connection_failed);
+
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "world_scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"),
+                 "set_world_scene", "get_world_scene");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "world_count", PROPERTY_HINT_RANGE, "1,256,1"), "set_world_count", "get_world_count");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "master_seed"), "set_master_seed", "get_master_seed");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tick_rate"), "set_tick_rate", "get_tick_rate");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "backend_timeout"), "set_backend_timeout", "get_backend_timeout");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "render_worlds"), "set_render_worlds", "get_render_worlds");
+
+    ADD_SIGNAL(MethodInfo("worlds_spawned", PropertyInfo(Variant::INT, "count")));
+    ADD_SIGNAL(MethodInfo("batch_stepped", PropertyInfo(Variant::INT, "tick")));
+}
+
+void WorldHost::_process(double delta) {
+    if (!is_running || worlds.empty()) return;
+
+    if (awaiting_backend) {
+        wait_time += delta;
+        if (backend_timeout <= 0.0 || wait_time < backend_timeout) {
+            return;
+        }
+        ARENA_LOG_WARN("WorldHost: backend timed out on tick ", current_tick, ", stepping anyway");
+        awaiting_backend = false;
+    }
+
+    if (tick_rate > 0.0) {
+        const double tick_interval = 1.0 / tick_rate;
+        tick_accumulator += delta;
+        if (tick_accumulator < tick_interval) {
+            return;
+        }
+        tick_accumulator -= tick_interval;
+        // Never burst to catch up: a batched step is already N ticks of work
+        if (tick_accumulator > tick_interval) {
+            tick_accumulator = 0.0;
+        }
+    }
+
+    step();
+}
+
+void WorldHost::spawn_worlds() {
+    if (world_scene.is_null()) {
+        ARENA_LOG_WARN("WorldHost: world_scene is not set");
+        return;
+    }
+
+    clear_worlds();
+    worlds.reserve(world_count);
+
+    for (int i = 0; i < world_count; i++) {
+        Node* root = world_scene->instantiate();
+        if (!root) {
+            ARENA_LOG_WARN("WorldHost: failed to instantiate world ", i);
+            continue;
+        }
+
+        // Own World3D = own physics space; rendering is optional for headless runs
+        SubViewport* viewport = memnew(SubViewport);
+        viewport->set_name(vformat("World%d", i));
+        viewport->set_use_own_world_3d(true);
+        viewport->set_update_mode(render_worlds ? SubViewport::UPDATE_ALWAYS : SubViewport::UPDATE_DISABLED);
+        // Read by agents during _ready() to namespace their IDs
+        viewport->set_meta("world_id", world_id_for(i));
+
+        World world;
+        world.viewport = viewport;
+        world.root = root;
+        world.simulation = Object::cast_to<SimulationManager>(root->get_node_or_null("SimulationManager"));
+        if (world.simulation) {
+            // The host owns the tick loop; per-world drivers would drift apart
+            world.simulation->set_tick_mode(SimulationManager::TICK_MODE_MANUAL);
+        } else {
+            ARENA_LOG_WARN("WorldHost: world ", i, " has no SimulationManager");
+        }
+
+        viewport->add_child(root);
+        add_child(viewport);
+
+        if (world.simulation) {
+            world.simulation->set_seed(RandomStream::derive_seed(master_seed, world_id_for(i)));
+        }
+        worlds.push_back(world);
+    }
+
+    current_tick = 0;
+    ARENA_LOG_INFO("WorldHost: spawned ", (int64_t)worlds.size(), " worlds");
+    emit_signal("worlds_spawned", (int)worlds.size());
+}
+
+void WorldHost::clear_worlds() {
+    stop();
+    for (World& world : worlds) {
+        if (world.viewport) {
+            world.viewport->queue_free();
+        }
+    }
+    worlds.clear();
+}
+
+void WorldHost::start() {
+    is_running = true;
+    awaiting_backend = false;
+    tick_accumulator = 0.0;
+    wait_time = 0.0;
+    for (World& world : worlds) {
+        if (world.simulation) {
+            world.simulation->start_simulation();
+        }
+    }
+}
+
+void WorldHost::stop() {
+    if (!is_running) return;
+
+    is_running = false;
+    awaiting_backend = false;
+    for (World& world : worlds) {
+        if (world.simulation) {
+            world.simulation->stop_simulation();
+        }
+    }
+}
+
+void WorldHost::reset() {
+    stop();
+    current_tick = 0;
+    for (size_t i = 0; i < worlds.size(); i++) {
+        SimulationManager* simulation = worlds[i].simulation;
+        if (simulation) {
+            simulation->reset_simulation();
+            simulation->set_seed(RandomStream::derive_seed(master_seed, world_id_for((int)i)));
+        }
+    }
+}
+
+void WorldHost::step() {
+    // Every world's controller requests a batch tick during tick_advanced;
+    // the window merges them into one request for all agents
+    IPCClient* client = _get_ipc_client();
+    if (client) {
+        client->begin_batch();
+    }
+
+    for (World& world : worlds) {
+        if (world.simulation) {
+            world.simulation->step_simulation();
+        }
+    }
+    current_tick++;
+
+    // With a pipeline deeper than one, only a full pipeline holds the worlds
+    const bool sent = client ? client->end_batch() : false;
+    awaiting_backend = sent && !client->can_send_tick();
+    wait_time = 0.0;
+    emit_signal("batch_stepped", (int64_t)current_tick);
+}
+
+Node* WorldHost::get_world_root(int index) const {
+    if (index < 0 || index >= (int)worlds.size()) {
+        return nullptr;
+    }
+    return worlds[index].root;
+}
+
+SimulationManager* WorldHost::get_world_simulation(int index) const {
+    if (index < 0 || index >= (int)worlds.size()) {
+        return nullptr;
+    }
+    return worlds[index].simulation;
+}
+
+String WorldHost::world_id_for(int index) {
+    return vformat("w%d", index);
+}
+
+IPCClient* WorldHost::_get_ipc_client() const {
+    if (ipc_client_id == 0) {
+        return nullptr;
+    }
+    return Object::cast_to<IPCClient>(ObjectDB::get_instance(ipc_client_id));
+}
+
+void WorldHost::set_ipc_client(IPCClient* client) {
+    IPCClient* previous = _get_ipc_client();
+    if (previous) {
+        previous->disconnect("tick_request_completed", Callable(this, "_on_tick_request_completed"));
+        previous->disconnect("connection_failed", Callable(this, "_on_connection_failed"));
+    }
+
+    ipc_client_id = client ? client->get_instance_id() : 0;
+    if (client) {
+        client->connect("tick_request_completed", Callable(this, "_on_tick_request_completed"));
+        client->connect("connection_failed", Callable(this, "_on_connection_failed"));
+    }
+}
+
+void WorldHost::_on_tick_request_completed(int /*tick*/) {
+    awaiting_backend = false;
+}
+
+void WorldHost::_on_connection_failed(const String& /*error*/) {
+    // Release the step so worlds keep running without a backend
+    awaiting_backend = false;
+}
+
+void WorldHost::set_world_count(int count) {
+    world_count = count < 1 ? 1 : count;
+}
+
+void WorldHost::set_tick_rate(double rate) {
+    tick_rate = rate < 0.0 ? 0.0 : rate;
+}
+
+void WorldHost::set_backend_timeout(double seconds) {
+    backend_timeout = seconds < 0.0 ? 0.0 : seconds;
+}
+
+void WorldHost::set_render_worlds(bool enabled) {
+    render_worlds = enabled;
+    for (World& world : worlds) {
+        if (world.viewport) {
+            world.viewport->set_update_mode(enabled ? SubViewport::UPDATE_ALWAYS : SubViewport::UPDATE_DISABLED);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "world_snapshot.h"
+
+#include "msgpack_codec.h"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include <cstring>
+
+using namespace godot;
+using namespace agent_arena;
+
+// ============================================================================
+// WorldSnapshot Implementation
+// ============================================================================
+
+namespace {
+
+bool read_u64(const Variant& value, uint64_t& r_value) {
+    if (value.get_type() != Variant::INT) {
+        return false;
+    }
+    r_value = (uint64_t)(int64_t)value;
+    return true;
+}
+
+bool read_array(const Variant& value, int min_size, Array& r_array) {
+    if (value.get_type() != Variant::ARRAY) {
+        return false;
+    }
+    r_array = value;
+    return r_array.size() >= min_size;
+}
+
+} // namespace
+
+int64_t WorldSnapshot::get_owned_bytes() const {
+    int64_t bytes = 0;
+    for (const SourceState& source : sources) {
+        if (!source.shared) {
+            bytes += source.data.size();
+        }
+    }
+    return bytes;
+}
+
+int64_t WorldSnapshot::get_shared_bytes() const {
+    int64_t bytes = 0;
+    for (const SourceState& source : sources) {
+        if (source.shared) {
+            bytes += source.data.size();
+        }
+    }
+    return bytes;
+}
+
+PackedByteArray WorldSnapshot::encode() const {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(256 + (size_t)get_owned_bytes() + (size_t)get_shared_bytes());
+
+    MsgPackCodec::write_array_header(buffer, 8);
+    MsgPackCodec::write_int(buffer, snapshot_format::MAGIC);
+    MsgPackCodec::write_int(buffer, snapshot_format::VERSION);
+    MsgPackCodec::write_int(buffer, (int64_t)tick);
+    MsgPackCodec::write_int(buffer, (int64_t)seed);
+    MsgPackCodec::write_int(buffer, (int64_t)event_tick);
+    MsgPackCodec::write_int(buffer, event_offset);
+
+    MsgPackCodec::write_array_header(buffer, (uint32_t)streams.size());
+    for (const StreamState& stream : streams) {
+        MsgPackCodec::write_array_header(buffer, 6);
+        MsgPackCodec::write_str(buffer, stream.name);
+        MsgPackCodec::write_int(buffer, (int64_t)stream.seed);
+        for (int i = 0; i < 4; i++) {
+            MsgPackCodec::write_int(buffer, (int64_t)stream.state[i]);
+        }
+    }
+
+    MsgPackCodec::write_array_header(buffer, (uint32_t)sources.size());
+    for (const SourceState& source : sources) {
+        MsgPackCodec::write_array_header(buffer, 2);
+        MsgPackCodec::write_str(buffer, source.name);
+        MsgPackCodec::encode(source.data, buffer);
+    }
+
+    PackedByteArray bytes;
+    bytes.resize((int64_t)buffer.size());
+    std::memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    return bytes;
+}
+
+bool WorldSnapshot::decode(const PackedByteArray& bytes, WorldSnapshot& r_snapshot) {
+    Variant root;
+    Array fields;
+    if (!MsgPackCodec::decode(bytes, root) || !read_array(root, 8, fields)) {
+        return false;
+    }
+
+    uint64_t magic = 0;
+    uint64_t version = 0;
+    uint64_t event_offset = 0;
+    if (!read_u64(fields[0], magic) || (int64_t)magic != snapshot_format::MAGIC ||
+        !read_u64(fields[1], version) || (int64_t)version != snapshot_format::VERSION ||
+        !read_u64(fields[2], r_snapshot.tick) ||
+        !read_u64(fields[3], r_snapshot.seed) ||
+        !read_u64(fields[4], r_snapshot.event_tick) ||
+        !read_u64(fields[5], event_offset)) {
+        return false;
+    }
+    r_snapshot.event_offset = (int)event_offset;
+
+    Array streams;
+    if (!read_array(fields[6], 0, streams)) {
+        return false;
+    }
+    r_snapshot.streams.clear();
+    r_snapshot.streams.reserve((size_t)streams.size());
+    for (int64_t i = 0; i < streams.size(); i++) {
+        Array entry;
+        StreamState stream;
+        if (!read_array(streams[i], 6, entry) || entry[0].get_type() != Variant::STRING ||
+            !read_u64(entry[1], stream.seed)) {
+            return false;
+        }
+        stream.name = entry[0];
+        for (int k = 0; k < 4; k++) {
+            if (!read_u64(entry[2 + k], stream.state[k])) {
+                return false;
+            }
+        }
+        r_snapshot.streams.push_back(stream);
+    }
+
+    Array sources;
+    if (!read_array(fields[7], 0, sources)) {
+        return false;
+    }
+    r_snapshot.sources.clear();
+    r_snapshot.sources.reserve((size_t)sources.size());
+    for (int64_t i = 0; i < sources.size(); i++) {
+        Array entry;
+        if (!read_array(sources[i], 2, entry) || entry[0].get_type() != Variant::STRING ||
+            entry[1].get_type() != Variant::PACKED_BYTE_ARRAY) {
+            return false;
+        }
+        r_snapshot.sources.push_back(SourceState{entry[0], entry[1], false});
+    }
+    return true;
+}
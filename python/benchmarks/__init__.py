@@ -0,0 +1,7 @@
+"""
+Episode benchmarks for the Godot extension.
+
+``stub_backend`` is a deterministic, model-free backend; ``run_benchmarks``
+drives a headless Godot run of scenes/benchmarks/benchmark_runner.tscn
+against it and compares result files across commits.
+"""
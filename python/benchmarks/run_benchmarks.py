@@ -0,0 +1,172 @@
+"""
+Run the headless episode benchmarks, or compare two result files.
+
+``run`` starts the stub backend, waits for its /health endpoint, runs
+scenes/benchmarks/benchmark_runner.tscn headless and leaves the JSON report
+at ``--out``. ``compare`` prints per-case deltas between two reports, e.g.
+one from the main branch and one from a feature branch.
+
+Usage:
+    python -m benchmarks.run_benchmarks run --godot godot --out results.json
+    python -m benchmarks.run_benchmarks compare baseline.json results.json
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+import urllib.error
+import urllib.request
+from pathlib import Path
+from typing import Any
+
+PROJECT_ROOT = Path(__file__).resolve().parents[2]
+RUNNER_SCENE = "res://scenes/benchmarks/benchmark_runner.tscn"
+
+# Metrics deltas are reported for, and whether a larger value is better
+METRICS: dict[str, bool] = {
+    "ticks_per_sec": True,
+    "tick_ms_p50": False,
+    "tick_ms_p99": False,
+    "ipc_bytes_per_tick": False,
+    "peak_static_memory_growth_bytes": False,
+}
+
+
+def _wait_for_health(url: str, timeout: float) -> bool:
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        try:
+            with urllib.request.urlopen(f"{url}/health", timeout=1.0) as response:
+                if response.status == 200:
+                    return True
+        except (urllib.error.URLError, OSError):
+            pass
+        time.sleep(0.2)
+    return False
+
+
+def run(args: argparse.Namespace) -> int:
+    """Run every scenario / agent-count case once; returns the Godot exit code."""
+    out_path = Path(args.out).resolve()
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+
+    stub = subprocess.Popen(
+        [sys.executable, "-m", "benchmarks.stub_backend", "--port", str(args.port)],
+        cwd=Path(__file__).resolve().parents[1],
+    )
+    try:
+        if not _wait_for_health(f"http://127.0.0.1:{args.port}", args.backend_timeout):
+            print("stub backend did not come up", file=sys.stderr)
+            return 2
+
+        command = [
+            args.godot,
+            "--headless",
+            "--path",
+            str(PROJECT_ROOT),
+            RUNNER_SCENE,
+            "--",
+            f"--scenarios={args.scenarios}",
+            f"--agents={args.agents}",
+            f"--ticks={args.ticks}",
+            f"--warmup={args.warmup}",
+            f"--seed={args.seed}",
+            f"--out={out_path}",
+            f"--label={args.label}",
+        ]
+        result = subprocess.run(command, cwd=PROJECT_ROOT, timeout=args.timeout)
+        if result.returncode == 0:
+            print(f"Benchmark report written to {out_path}")
+        return result.returncode
+    finally:
+        stub.terminate()
+        try:
+            stub.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            stub.kill()
+
+
+def compare_reports(baseline: dict[str, Any], current: dict[str, Any]) -> list[dict[str, Any]]:
+    """Per-case, per-metric deltas for cases present in both reports.
+
+    Each row is {scenario, agents, metric, baseline, current, change_pct,
+    improved}; change_pct is None when the baseline value is zero.
+    """
+    base_cases = {(c["scenario"], c["agents"]): c for c in baseline.get("cases", []) if "error" not in c}
+    rows = []
+    for case in current.get("cases", []):
+        key = (case.get("scenario"), case.get("agents"))
+        if "error" in case or key not in base_cases:
+            continue
+        for metric, higher_is_better in METRICS.items():
+            if metric not in case or metric not in base_cases[key]:
+                continue
+            old = float(base_cases[key][metric])
+            new = float(case[metric])
+            change = (new - old) / old * 100.0 if old != 0.0 else None
+            rows.append(
+                {
+                    "scenario": key[0],
+                    "agents": key[1],
+                    "metric": metric,
+                    "baseline": old,
+                    "current": new,
+                    "change_pct": change,
+                    "improved": (new > old) if higher_is_better else (new < old),
+                }
+            )
+    return rows
+
+
+def compare(args: argparse.Namespace) -> int:
+    baseline = json.loads(Path(args.baseline).read_text())
+    current = json.loads(Path(args.current).read_text())
+    if baseline.get("seed") != current.get("seed") or baseline.get("ticks_per_episode") != current.get(
+        "ticks_per_episode"
+    ):
+        print("warning: reports were run with different seeds or episode lengths", file=sys.stderr)
+
+    for row in compare_reports(baseline, current):
+        change = "n/a" if row["change_pct"] is None else f"{row['change_pct']:+.1f}%"
+        marker = "" if row["change_pct"] in (None, 0.0) else ("better" if row["improved"] else "worse")
+        print(
+            f"{row['scenario']:<16} {row['agents']:>4}  {row['metric']:<26}"
+            f" {row['baseline']:>14.3f} -> {row['current']:>14.3f}  {change:>8}  {marker}"
+        )
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Agent Arena episode benchmarks")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    run_parser = sub.add_parser("run", help="Run the benchmark scenarios headless")
+    run_parser.add_argument("--godot", default=os.environ.get("GODOT", "godot"), help="Godot executable")
+    run_parser.add_argument("--out", default="benchmark_results.json")
+    run_parser.add_argument("--scenarios", default="foraging,crafting_chain,team_capture")
+    run_parser.add_argument("--agents", default="1,10,100")
+    run_parser.add_argument("--ticks", type=int, default=300)
+    run_parser.add_argument("--warmup", type=int, default=20)
+    run_parser.add_argument("--seed", type=int, default=42)
+    run_parser.add_argument("--label", default="")
+    run_parser.add_argument("--port", type=int, default=5000)
+    run_parser.add_argument("--backend-timeout", type=float, default=15.0)
+    run_parser.add_argument("--timeout", type=float, default=1800.0, help="Seconds before Godot is killed")
+    run_parser.set_defaults(func=run)
+
+    compare_parser = sub.add_parser("compare", help="Compare two benchmark reports")
+    compare_parser.add_argument("baseline")
+    compare_parser.add_argument("current")
+    compare_parser.set_defaults(func=compare)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
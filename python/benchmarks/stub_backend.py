@@ -0,0 +1,40 @@
+"""
+Deterministic stub backend for benchmark runs.
+
+Every agent walks to its nearest visible resource and idles otherwise, so a
+fixed-seed episode produces the same decisions on every run and the
+measurement is dominated by the simulation and IPC, not by a model.
+
+Usage:
+    python -m benchmarks.stub_backend --port 5000
+"""
+
+from __future__ import annotations
+
+import argparse
+import logging
+
+from agent_arena_sdk import AgentArena, Decision, Observation
+
+
+def decide(obs: Observation) -> Decision:
+    """Move to the nearest resource, or idle."""
+    if obs.nearby_resources:
+        nearest = min(obs.nearby_resources, key=lambda r: (r.distance, r.name))
+        return Decision(tool="move_to", params={"target_position": list(nearest.position)})
+    return Decision.idle()
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Deterministic benchmark backend")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=5000)
+    parser.add_argument("--binary-port", type=int, default=None)
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.WARNING)
+    AgentArena(host=args.host, port=args.port, binary_port=args.binary_port).run(decide)
+
+
+if __name__ == "__main__":
+    main()
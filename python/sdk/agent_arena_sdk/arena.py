@@ -75,6 +75,7 @@ class AgentArena:
         host: str = "127.0.0.1",
         port: int = 5000,
         enable_debug: bool = False,
+        binary_port: int | None = None,
     ):
         """
         Initialize AgentArena connection.
@@ -84,10 +85,13 @@ class AgentArena:
             port: IPC server port (default: 5000)
             enable_debug: Enable /debug/* endpoints for observation tracking,
                 trace inspection, and web-based trace viewer at /debug
+            binary_port: Also accept Godot's persistent MessagePack stream
+                transport on this port (IPCClient transport = STREAM)
         """
         self.host = host
         self.port = port
         self.enable_debug = enable_debug
+        self.binary_port = binary_port
         self.server: MinimalIPCServer | None = None
 
         logger.info(
@@ -124,6 +128,7 @@ class AgentArena:
             host=self.host,
             port=self.port,
             enable_debug=self.enable_debug,
+            binary_port=self.binary_port,
         )
 
         try:
@@ -163,6 +168,7 @@ class AgentArena:
             host=self.host,
             port=self.port,
             enable_debug=self.enable_debug,
+            binary_port=self.binary_port,
         )
 
         await self.server.run_async()
@@ -0,0 +1,115 @@
+"""
+Persistent binary transport for the Agent Arena SDK server.
+
+Godot's ``IPCClient`` can keep a single TCP connection open and exchange
+length-prefixed MessagePack frames instead of issuing an HTTP request with a
+JSON body every tick. Each frame is::
+
+    <uint32 little-endian payload length><MessagePack-encoded map>
+
+Every message carries a ``type`` key. Godot sends ``{"type": "tick", ...}``
+with the same fields as the ``/tick`` HTTP endpoint and receives
+``{"type": "tick_response", "tick": ..., "actions": [...]}``. A tick that
+fails on the server is answered with ``{"type": "error", "tick": ...,
+"error": "..."}`` so the client stops waiting on it.
+"""
+
+import asyncio
+import logging
+import struct
+from typing import Any, Callable
+
+import msgpack
+
+logger = logging.getLogger(__name__)
+
+FRAME_HEADER = struct.Struct("<I")
+MAX_FRAME_SIZE = 64 * 1024 * 1024
+
+MessageHandler = Callable[[dict[str, Any]], dict[str, Any] | None]
+
+
+def encode_frame(message: dict[str, Any]) -> bytes:
+    """Encode a message as a length-prefixed MessagePack frame."""
+    payload = msgpack.packb(message, use_bin_type=True)
+    return FRAME_HEADER.pack(len(payload)) + payload
+
+
+def decode_payload(payload: bytes) -> dict[str, Any]:
+    """Decode a frame payload (without its length prefix) into a message dict."""
+    message = msgpack.unpackb(payload, raw=False, strict_map_key=False)
+    if not isinstance(message, dict):
+        raise ValueError(f"Expected a map frame, got {type(message).__name__}")
+    return message
+
+
+async def read_frame(reader: asyncio.StreamReader) -> dict[str, Any] | None:
+    """Read one frame from the stream. Returns None on clean EOF."""
+    try:
+        header = await reader.readexactly(FRAME_HEADER.size)
+    except asyncio.IncompleteReadError:
+        return None
+
+    (size,) = FRAME_HEADER.unpack(header)
+    if size > MAX_FRAME_SIZE:
+        raise ValueError(f"Frame of {size} bytes exceeds limit of {MAX_FRAME_SIZE}")
+
+    payload = await reader.readexactly(size)
+    return decode_payload(payload)
+
+
+class BinaryTransportServer:
+    """
+    Asyncio TCP server speaking the length-prefixed MessagePack protocol.
+
+    Frames are handled in order per connection; the handler returns the
+    response message (or None for no reply).
+    """
+
+    def __init__(self, handler: MessageHandler, host: str = "127.0.0.1", port: int = 5001):
+        self.handler = handler
+        self.host = host
+        self.port = port
+        self._server: asyncio.AbstractServer | None = None
+
+    async def start(self) -> None:
+        """Start listening for Godot connections."""
+        self._server = await asyncio.start_server(self._handle_connection, self.host, self.port)
+        logger.info(f"Binary transport listening on {self.host}:{self.port}")
+
+    async def stop(self) -> None:
+        """Stop the server and close the listening socket."""
+        if self._server is not None:
+            self._server.close()
+            await self._server.wait_closed()
+            self._server = None
+
+    async def _handle_connection(
+        self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter
+    ) -> None:
+        peer = writer.get_extra_info("peername")
+        logger.info(f"Binary transport client connected: {peer}")
+        try:
+            while True:
+                message = await read_frame(reader)
+                if message is None:
+                    break
+
+                try:
+                    response = self.handler(message)
+                except Exception as e:
+                    logger.error(f"Error handling binary message: {e}", exc_info=True)
+                    response = {"type": "error", "error": str(e)}
+                    # Echo the tick so the client can fail that request
+                    # instead of waiting on it until it times out.
+                    if "tick" in message:
+                        response["tick"] = message["tick"]
+
+                if response is not None:
+                    writer.write(encode_frame(response))
+                    await writer.drain()
+        except (ConnectionError, ValueError) as e:
+            logger.warning(f"Binary transport connection {peer} closed: {e}")
+        finally:
+            writer.close()
+            logger.info(f"Binary transport client disconnected: {peer}")
@@ -14,6 +14,7 @@ from fastapi import FastAPI, HTTPException, Query
 from fastapi.responses import HTMLResponse
 
 from ..schemas import Decision, Observation
+from .observation_delta import ObservationDeltaDecoder
 
 logger = logging.getLogger(__name__)
 
@@ -39,6 +40,7 @@ class MinimalIPCServer:
         host: str = "127.0.0.1",
         port: int = 5000,
         enable_debug: bool = False,
+        binary_port: int | None = None,
     ):
         """
         Initialize the minimal IPC server.
@@ -49,16 +51,22 @@ class MinimalIPCServer:
             port: Port to listen on
             enable_debug: Enable /debug/* endpoints for observation tracking,
                 trace inspection, and web-based trace viewer
+            binary_port: If set, also accept Godot's persistent binary
+                (length-prefixed MessagePack) transport on this port
         """
         self.decide_callback = decide_callback
         self.host = host
         self.port = port
         self.enable_debug = enable_debug
+        self.binary_port = binary_port
+        self.binary_transport: Any = None
         self.app: FastAPI | None = None
         self.metrics = {
             "total_ticks": 0,
             "total_observations": 0,
         }
+        # Rebuilds observations that arrive as deltas over the binary transport
+        self.observation_decoder = ObservationDeltaDecoder()
 
         # Debug subsystems (created lazily in create_app when enabled)
         self.observation_tracker: Any = None
@@ -238,11 +246,15 @@ class MinimalIPCServer:
             logger.debug(
                 f"[/tools/execute] Acknowledging tool '{tool_name}' " f"for agent '{agent_id}'"
             )
-            return {
+            response: dict[str, Any] = {
                 "success": True,
                 "result": None,
                 "error": "",
             }
+            # Echo the correlation ID so Godot can match concurrent responses
+            if "request_id" in request_data:
+                response["request_id"] = request_data["request_id"]
+            return response
 
         @app.post("/experience")
         async def receive_experience(request_data: dict[str, Any]) -> dict[str, Any]:
@@ -266,68 +278,14 @@ class MinimalIPCServer:
             Receives observation(s), calls decide callback, returns action(s).
             """
             try:
-                tick = request_data.get("tick", 0)
-                agents_data = request_data.get("agents", [])
-
-                logger.debug(f"Processing tick {tick} with {len(agents_data)} agents")
-
-                actions = []
-                for agent_data in agents_data:
-                    agent_id = agent_data.get("agent_id")
-                    obs_data = agent_data.get("observations", {})
-
-                    # Add agent_id and tick to observation data if not present
-                    if "agent_id" not in obs_data:
-                        obs_data["agent_id"] = agent_id
-                    if "tick" not in obs_data:
-                        obs_data["tick"] = tick
-
-                    # Track observation for debug (no-op when disabled)
-                    self._track_observation(obs_data)
-
-                    try:
-                        # Parse observation
-                        observation = Observation.from_dict(obs_data)
-
-                        # Call user's decide callback
-                        decision = self.decide_callback(observation)
-
-                        # Convert decision to action format
-                        action_data = {
-                            "agent_id": agent_id,
-                            "action": decision.to_dict(),
-                        }
-                        actions.append(action_data)
-
-                        logger.debug(f"Agent {agent_id} decided: {decision.tool}")
-
-                    except Exception as e:
-                        logger.error(
-                            f"Error processing agent {agent_id}: {e}",
-                            exc_info=True,
-                        )
-                        # Fallback to idle
-                        action_data = {
-                            "agent_id": agent_id,
-                            "action": Decision.idle(reasoning=f"Error: {str(e)}").to_dict(),
-                        }
-                        actions.append(action_data)
-
-                # Update metrics
-                self.metrics["total_ticks"] += 1
-                self.metrics["total_observations"] += len(agents_data)
-
-                response = {
-                    "tick": tick,
-                    "actions": actions,
-                }
-
-                return response
-
+                return self.process_tick(request_data)
             except Exception as e:
                 logger.error(f"Error processing tick: {e}", exc_info=True)
                 raise HTTPException(status_code=500, detail=str(e))
 
+        if self.binary_port is not None:
+            self._register_binary_transport(app)
+
         # ---------------------------------------------------------------
         # Debug endpoints (only registered when enable_debug=True)
         # ---------------------------------------------------------------
@@ -337,6 +295,111 @@ class MinimalIPCServer:
         self.app = app
         return app
 
+    def process_tick(self, request_data: dict[str, Any]) -> dict[str, Any]:
+        """
+        Decide actions for every agent in a tick request.
+
+        Shared by the ``/tick`` HTTP endpoint and the binary transport.
+        """
+        tick = request_data.get("tick", 0)
+        agents_data = request_data.get("agents", [])
+
+        logger.debug(f"Processing tick {tick} with {len(agents_data)} agents")
+
+        actions = []
+        resync = []
+        for agent_data in agents_data:
+            agent_id = agent_data.get("agent_id")
+            obs_data = agent_data.get("observations", {})
+
+            # Add agent_id and tick to observation data if not present
+            if "agent_id" not in obs_data:
+                obs_data["agent_id"] = agent_id
+            if "tick" not in obs_data:
+                obs_data["tick"] = tick
+
+            rebuilt = self.observation_decoder.apply(obs_data)
+            if rebuilt is None:
+                # Delta against an observation we don't have: no decision
+                # this tick, and Godot sends a keyframe next
+                resync.append(agent_id)
+                continue
+            obs_data = rebuilt
+
+            # Track observation for debug (no-op when disabled)
+            self._track_observation(obs_data)
+
+            try:
+                # Parse observation
+                observation = Observation.from_dict(obs_data)
+
+                # Call user's decide callback
+                decision = self.decide_callback(observation)
+
+                # Convert decision to action format
+                action_data = {
+                    "agent_id": agent_id,
+                    "action": decision.to_dict(),
+                }
+                actions.append(action_data)
+
+                logger.debug(f"Agent {agent_id} decided: {decision.tool}")
+
+            except Exception as e:
+                logger.error(
+                    f"Error processing agent {agent_id}: {e}",
+                    exc_info=True,
+                )
+                # Fallback to idle
+                action_data = {
+                    "agent_id": agent_id,
+                    "action": Decision.idle(reasoning=f"Error: {str(e)}").to_dict(),
+                }
+                actions.append(action_data)
+
+        # Update metrics
+        self.metrics["total_ticks"] += 1
+        self.metrics["total_observations"] += len(agents_data)
+
+        response: dict[str, Any] = {
+            "tick": tick,
+            "actions": actions,
+        }
+        if resync:
+            response["resync"] = resync
+        return response
+
+    def handle_binary_message(self, message: dict[str, Any]) -> dict[str, Any] | None:
+        """Dispatch a message received over the binary transport."""
+        message_type = message.get("type")
+        if message_type == "tick":
+            response = self.process_tick(message)
+            response["type"] = "tick_response"
+            return response
+
+        logger.warning(f"Unknown binary message type: {message_type}")
+        response = {"type": "error", "error": f"Unknown message type: {message_type}"}
+        if "tick" in message:
+            response["tick"] = message["tick"]
+        return response
+
+    def _register_binary_transport(self, app: FastAPI) -> None:
+        """Run the binary transport alongside the HTTP server's event loop."""
+        from .binary_transport import BinaryTransportServer
+
+        assert self.binary_port is not None
+        self.binary_transport = BinaryTransportServer(
+            self.handle_binary_message, host=self.host, port=self.binary_port
+        )
+
+        @app.on_event("startup")
+        async def start_binary_transport() -> None:
+            await self.binary_transport.start()
+
+        @app.on_event("shutdown")
+        async def stop_binary_transport() -> None:
+            await self.binary_transport.stop()
+
     def _register_debug_endpoints(self, app: FastAPI) -> None:
         """Register all /debug/* endpoints on the FastAPI app."""
 
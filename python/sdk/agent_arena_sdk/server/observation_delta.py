@@ -0,0 +1,154 @@
+"""
+Rebuild full observations from Godot's keyframe + delta stream.
+
+Over the stream transport, Godot's ``ObservationBuilder`` sends each agent's
+observation either in full (a keyframe, the same map the HTTP endpoint gets)
+or as a delta against the observation it sent for that agent last. A delta
+carries ``base_tick`` plus only what changed::
+
+    {
+        "schema_version": 1, "agent_id": "a1", "tick": 42, "base_tick": 41,
+        "position_delta": [dx, dy, dz],          # in 1/1024 units
+        "health": 90.0,                           # changed self fields
+        "entities": {
+            "nearby_resources": {
+                "upsert": [{"name": "berry_3", "distance": 4.5}],  # changed fields only
+                "remove": ["berry_1"],
+                "order": ["berry_3", "berry_2"],  # only if the order changed
+            },
+        },
+        "fields": {"tool_result": {...}},         # changed extra fields
+        "removed_fields": ["exploration"],
+    }
+
+Entities are keyed by name. Without "order", surviving entities keep their
+previous order and new ones are appended. Positions are tracked in the same
+integer steps Godot uses, so rebuilt positions never drift.
+"""
+
+from __future__ import annotations
+
+import math
+from typing import Any
+
+POSITION_STEPS_PER_UNIT = 1024
+
+# Entity lists ObservationBuilder writes; the first two are always present
+ENTITY_KEYS = ("nearby_resources", "nearby_hazards", "nearby_stations", "nearby_agents")
+ALWAYS_WRITTEN = ("nearby_resources", "nearby_hazards")
+
+_DELTA_KEYS = {"base_tick", "position_delta", "entities", "fields", "removed_fields"}
+
+
+def _steps(value: float) -> int:
+    # Must match ObservationBuilder's position_steps()
+    return math.floor(value * POSITION_STEPS_PER_UNIT + 0.5)
+
+
+class _AgentState:
+    """What the decoder holds for one agent: its last rebuilt observation."""
+
+    __slots__ = ("tick", "keyframe", "fields", "steps", "entities")
+
+    def __init__(self, tick: int, keyframe: dict[str, Any]):
+        self.tick = tick
+        self.keyframe: dict[str, Any] | None = keyframe  # Indexed on the first delta
+        self.fields: dict[str, Any] = {}
+        self.steps: list[int] = [0, 0, 0]
+        self.entities: dict[str, dict[str, dict[str, Any]]] = {}
+
+    def index(self) -> None:
+        """Split the stored keyframe into fields, position steps and entities by name."""
+        keyframe = self.keyframe
+        if keyframe is None:
+            return
+        self.keyframe = None
+        self.fields = {k: v for k, v in keyframe.items() if k not in ENTITY_KEYS}
+        position = keyframe.get("position") or [0.0, 0.0, 0.0]
+        self.steps = [_steps(float(v)) for v in position]
+        self.entities = {}
+        for key in ENTITY_KEYS:
+            if key in keyframe:
+                self.entities[key] = {e.get("name", ""): e for e in keyframe[key]}
+
+    def snapshot(self) -> dict[str, Any]:
+        observation = dict(self.fields)
+        observation["position"] = [s / POSITION_STEPS_PER_UNIT for s in self.steps]
+        for key in ENTITY_KEYS:
+            entities = self.entities.get(key)
+            if entities is not None:
+                observation[key] = list(entities.values())
+            elif key in ALWAYS_WRITTEN:
+                observation[key] = []
+        return observation
+
+
+class ObservationDeltaDecoder:
+    """
+    Per-agent state for turning keyframes and deltas into full observation dicts.
+
+    Frames must be applied in the order Godot sent them, as the stream
+    transport delivers them.
+    """
+
+    def __init__(self) -> None:
+        self._agents: dict[str, _AgentState] = {}
+        self.keyframes = 0
+        self.deltas = 0
+        self.resyncs = 0
+
+    def apply(self, obs_data: dict[str, Any]) -> dict[str, Any] | None:
+        """
+        Return the full observation for a keyframe or delta.
+
+        Returns None when a delta's base isn't the observation held for that
+        agent (e.g. after a server restart); the caller should ask Godot for a
+        keyframe (the tick response's ``resync`` list).
+        """
+        agent_id = obs_data.get("agent_id", "")
+        if "base_tick" not in obs_data:
+            self._agents[agent_id] = _AgentState(obs_data.get("tick", 0), obs_data)
+            self.keyframes += 1
+            return obs_data
+
+        state = self._agents.get(agent_id)
+        if state is None or state.tick != obs_data["base_tick"]:
+            self._agents.pop(agent_id, None)
+            self.resyncs += 1
+            return None
+
+        state.index()
+        for key, value in obs_data.items():
+            if key not in _DELTA_KEYS:
+                state.fields[key] = value  # agent_id, tick, schema_version and changed self fields
+
+        delta = obs_data.get("position_delta")
+        if delta:
+            state.steps = [s + int(d) for s, d in zip(state.steps, delta)]
+
+        for key, change in (obs_data.get("entities") or {}).items():
+            entities = state.entities.setdefault(key, {})
+            for name in change.get("remove", ()):
+                entities.pop(name, None)
+            for update in change.get("upsert", ()):
+                name = update.get("name", "")
+                previous = entities.get(name)
+                # New dicts, so observations handed out earlier stay unchanged
+                entities[name] = {**previous, **update} if previous is not None else dict(update)
+            order = change.get("order")
+            if order is not None:
+                state.entities[key] = {name: entities[name] for name in order if name in entities}
+
+        state.fields.update(obs_data.get("fields") or {})
+        for key in obs_data.get("removed_fields", ()):
+            state.fields.pop(key, None)
+
+        state.tick = obs_data.get("tick", state.tick)
+        self.deltas += 1
+        return state.snapshot()
+
+    def forget(self, agent_id: str) -> None:
+        self._agents.pop(agent_id, None)
+
+    def clear(self) -> None:
+        self._agents.clear()
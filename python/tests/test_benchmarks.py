@@ -0,0 +1,68 @@
+"""
+Tests for the benchmark stub backend and report comparison.
+"""
+
+from agent_arena_sdk.testing import mock_observation, mock_resource
+from benchmarks.run_benchmarks import compare_reports
+from benchmarks.stub_backend import decide
+
+
+class TestStubBackend:
+    """The stub must be deterministic so benchmark episodes repeat."""
+
+    def test_moves_to_nearest_resource(self):
+        obs = mock_observation(
+            nearby_resources=[
+                mock_resource("stone", name="far", position=(9.0, 0.0, 9.0), distance=12.0),
+                mock_resource("berry", name="near", position=(1.0, 0.0, 2.0), distance=2.2),
+            ]
+        )
+        decision = decide(obs)
+        assert decision.tool == "move_to"
+        assert decision.params["target_position"] == [1.0, 0.0, 2.0]
+
+    def test_ties_break_by_name(self):
+        obs = mock_observation(
+            nearby_resources=[
+                mock_resource("berry", name="b", position=(2.0, 0.0, 0.0), distance=2.0),
+                mock_resource("berry", name="a", position=(-2.0, 0.0, 0.0), distance=2.0),
+            ]
+        )
+        assert decide(obs).params["target_position"] == [-2.0, 0.0, 0.0]
+
+    def test_idles_without_resources(self):
+        assert decide(mock_observation()).tool == "idle"
+
+
+class TestCompareReports:
+    """Per-case metric deltas between two reports."""
+
+    def _report(self, **metrics):
+        case = {"scenario": "foraging", "agents": 10}
+        case.update(metrics)
+        return {"seed": 42, "cases": [case]}
+
+    def test_reports_change_and_direction(self):
+        rows = compare_reports(
+            self._report(ticks_per_sec=100.0, tick_ms_p99=8.0),
+            self._report(ticks_per_sec=125.0, tick_ms_p99=10.0),
+        )
+        by_metric = {row["metric"]: row for row in rows}
+        assert by_metric["ticks_per_sec"]["change_pct"] == 25.0
+        assert by_metric["ticks_per_sec"]["improved"]
+        assert by_metric["tick_ms_p99"]["change_pct"] == 25.0
+        assert not by_metric["tick_ms_p99"]["improved"]
+
+    def test_skips_unmatched_and_failed_cases(self):
+        baseline = {"cases": [{"scenario": "foraging", "agents": 1, "ticks_per_sec": 50.0}]}
+        current = {
+            "cases": [
+                {"scenario": "foraging", "agents": 100, "ticks_per_sec": 10.0},
+                {"scenario": "foraging", "agents": 1, "error": "unknown scenario"},
+            ]
+        }
+        assert compare_reports(baseline, current) == []
+
+    def test_zero_baseline_has_no_percentage(self):
+        rows = compare_reports(self._report(ipc_bytes_per_tick=0.0), self._report(ipc_bytes_per_tick=64.0))
+        assert rows[0]["change_pct"] is None
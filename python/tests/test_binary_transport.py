@@ -0,0 +1,126 @@
+"""Tests for the length-prefixed MessagePack stream transport."""
+
+from __future__ import annotations
+
+import asyncio
+
+from agent_arena_sdk import Decision, Observation
+from agent_arena_sdk.server.binary_transport import (
+    FRAME_HEADER,
+    BinaryTransportServer,
+    decode_payload,
+    encode_frame,
+    read_frame,
+)
+from agent_arena_sdk.server.ipc_server import MinimalIPCServer
+
+
+def _decide(obs: Observation) -> Decision:
+    return Decision(tool="move_to", params={"target_position": obs.position})
+
+
+def _tick_message(tick: int = 7) -> dict:
+    return {
+        "type": "tick",
+        "tick": tick,
+        "agents": [
+            {"agent_id": "agent_1", "observations": {"position": [1.0, 0.0, 2.0]}},
+            {"agent_id": "agent_2", "observations": {"position": [3.0, 0.0, 4.0]}},
+        ],
+    }
+
+
+class TestFraming:
+    def test_frame_round_trip(self) -> None:
+        message = {"type": "tick", "tick": 3, "blob": b"\x00\x01", "nested": {"a": [1, 2.5]}}
+        frame = encode_frame(message)
+        (size,) = FRAME_HEADER.unpack(frame[: FRAME_HEADER.size])
+        assert size == len(frame) - FRAME_HEADER.size
+        assert decode_payload(frame[FRAME_HEADER.size :]) == message
+
+    def test_read_frame_handles_eof(self) -> None:
+        async def run() -> list:
+            reader = asyncio.StreamReader()
+            reader.feed_data(encode_frame({"type": "a"}) + encode_frame({"type": "b"}))
+            reader.feed_eof()
+            return [await read_frame(reader), await read_frame(reader), await read_frame(reader)]
+
+        assert asyncio.run(run()) == [{"type": "a"}, {"type": "b"}, None]
+
+
+class TestBinaryTickHandling:
+    def test_tick_message_matches_http_shape(self) -> None:
+        server = MinimalIPCServer(decide_callback=_decide)
+        response = server.handle_binary_message(_tick_message())
+
+        assert response is not None
+        assert response["type"] == "tick_response"
+        assert response["tick"] == 7
+        assert [a["agent_id"] for a in response["actions"]] == ["agent_1", "agent_2"]
+        assert response["actions"][0]["action"]["tool"] == "move_to"
+
+    def test_unknown_message_type(self) -> None:
+        server = MinimalIPCServer(decide_callback=_decide)
+        response = server.handle_binary_message({"type": "bogus"})
+        assert response is not None
+        assert response["type"] == "error"
+
+    def test_unknown_message_type_echoes_tick(self) -> None:
+        server = MinimalIPCServer(decide_callback=_decide)
+        response = server.handle_binary_message({"type": "bogus", "tick": 4})
+        assert response is not None
+        assert response["tick"] == 4
+
+    def test_handler_error_echoes_tick(self) -> None:
+        def _handler(message: dict) -> dict | None:
+            raise RuntimeError("handler failed")
+
+        async def run() -> dict | None:
+            server = BinaryTransportServer(_handler, port=0)
+            await server.start()
+            assert server._server is not None
+            port = server._server.sockets[0].getsockname()[1]
+
+            reader, writer = await asyncio.open_connection("127.0.0.1", port)
+            writer.write(encode_frame(_tick_message(11)))
+            await writer.drain()
+            frame = await read_frame(reader)
+
+            writer.close()
+            await writer.wait_closed()
+            await server.stop()
+            return frame
+
+        frame = asyncio.run(run())
+        assert frame is not None
+        assert frame["type"] == "error"
+        assert frame["tick"] == 11
+
+    def test_server_round_trip(self) -> None:
+        ipc = MinimalIPCServer(decide_callback=_decide)
+
+        async def run() -> list[dict]:
+            server = BinaryTransportServer(ipc.handle_binary_message, port=0)
+            await server.start()
+            assert server._server is not None
+            port = server._server.sockets[0].getsockname()[1]
+
+            reader, writer = await asyncio.open_connection("127.0.0.1", port)
+            responses = []
+            # Several ticks over one persistent connection
+            for tick in range(3):
+                writer.write(encode_frame(_tick_message(tick)))
+                await writer.drain()
+                frame = await read_frame(reader)
+                assert frame is not None
+                responses.append(frame)
+
+            writer.close()
+            await writer.wait_closed()
+            await server.stop()
+            return responses
+
+        responses = asyncio.run(run())
+        assert [r["tick"] for r in responses] == [0, 1, 2]
+        assert all(len(r["actions"]) == 2 for r in responses)
+        assert ipc.metrics["total_ticks"] == 3
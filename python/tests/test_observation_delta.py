@@ -0,0 +1,135 @@
+"""Tests for rebuilding observations from keyframes and deltas."""
+
+from __future__ import annotations
+
+from agent_arena_sdk import Decision, Observation
+from agent_arena_sdk.server.ipc_server import MinimalIPCServer
+from agent_arena_sdk.server.observation_delta import ObservationDeltaDecoder
+
+
+def _keyframe(tick: int = 1) -> dict:
+    return {
+        "schema_version": 1,
+        "agent_id": "agent_1",
+        "tick": tick,
+        "position": [1.0, 0.0, 2.0],
+        "health": 100.0,
+        "max_health": 100.0,
+        "perception_radius": 10.0,
+        "nearby_resources": [
+            {"name": "berry_1", "type": "berry", "position": [3.0, 0.0, 2.0], "distance": 2.0},
+            {"name": "berry_2", "type": "berry", "position": [1.0, 0.0, 6.0], "distance": 4.0},
+        ],
+        "nearby_hazards": [],
+        "exploration": {"exploration_percentage": 5.0},
+    }
+
+
+class TestObservationDeltaDecoder:
+    def test_keyframe_passes_through(self) -> None:
+        decoder = ObservationDeltaDecoder()
+        keyframe = _keyframe()
+        assert decoder.apply(keyframe) is keyframe
+
+    def test_delta_rebuilds_full_observation(self) -> None:
+        decoder = ObservationDeltaDecoder()
+        decoder.apply(_keyframe())
+        rebuilt = decoder.apply(
+            {
+                "schema_version": 1,
+                "agent_id": "agent_1",
+                "tick": 2,
+                "base_tick": 1,
+                "position_delta": [512, 0, -1024],
+                "health": 95.0,
+                "entities": {
+                    "nearby_resources": {
+                        "upsert": [
+                            {"name": "berry_2", "distance": 3.5},
+                            {"name": "stone_1", "type": "stone", "position": [0.0, 0.0, 0.0], "distance": 1.8},
+                        ],
+                        "remove": ["berry_1"],
+                    }
+                },
+                "fields": {"tool_result": {"tool": "collect", "success": True}},
+                "removed_fields": ["exploration"],
+            }
+        )
+
+        assert rebuilt is not None
+        assert rebuilt["tick"] == 2
+        assert rebuilt["position"] == [1.5, 0.0, 1.0]
+        assert rebuilt["health"] == 95.0
+        assert rebuilt["max_health"] == 100.0
+        assert [r["name"] for r in rebuilt["nearby_resources"]] == ["berry_2", "stone_1"]
+        assert rebuilt["nearby_resources"][0] == {
+            "name": "berry_2",
+            "type": "berry",
+            "position": [1.0, 0.0, 6.0],
+            "distance": 3.5,
+        }
+        assert rebuilt["nearby_hazards"] == []
+        assert rebuilt["tool_result"] == {"tool": "collect", "success": True}
+        assert "exploration" not in rebuilt
+        assert "base_tick" not in rebuilt
+
+        obs = Observation.from_dict(rebuilt)
+        assert obs.nearby_resources[1].type == "stone"
+
+    def test_order_is_applied(self) -> None:
+        decoder = ObservationDeltaDecoder()
+        decoder.apply(_keyframe())
+        rebuilt = decoder.apply(
+            {
+                "agent_id": "agent_1",
+                "tick": 2,
+                "base_tick": 1,
+                "entities": {"nearby_resources": {"order": ["berry_2", "berry_1"]}},
+            }
+        )
+        assert [r["name"] for r in rebuilt["nearby_resources"]] == ["berry_2", "berry_1"]
+
+    def test_earlier_observations_are_not_mutated(self) -> None:
+        decoder = ObservationDeltaDecoder()
+        decoder.apply(_keyframe())
+        first = decoder.apply({"agent_id": "agent_1", "tick": 2, "base_tick": 1})
+        decoder.apply(
+            {
+                "agent_id": "agent_1",
+                "tick": 3,
+                "base_tick": 2,
+                "entities": {"nearby_resources": {"upsert": [{"name": "berry_1", "distance": 9.0}]}},
+            }
+        )
+        assert first["nearby_resources"][0]["distance"] == 2.0
+
+    def test_unknown_base_needs_resync(self) -> None:
+        decoder = ObservationDeltaDecoder()
+        assert decoder.apply({"agent_id": "agent_1", "tick": 5, "base_tick": 4}) is None
+
+        decoder.apply(_keyframe(tick=1))
+        assert decoder.apply({"agent_id": "agent_1", "tick": 3, "base_tick": 2}) is None
+        # The stale state is dropped, so later deltas fail too until a keyframe
+        assert decoder.apply({"agent_id": "agent_1", "tick": 4, "base_tick": 3}) is None
+        assert decoder.resyncs == 3
+
+
+class TestTickResync:
+    def test_response_lists_agents_needing_keyframes(self) -> None:
+        server = MinimalIPCServer(decide_callback=lambda obs: Decision.idle())
+        response = server.process_tick(
+            {
+                "tick": 9,
+                "agents": [
+                    {"agent_id": "agent_1", "observations": _keyframe(tick=9)},
+                    {"agent_id": "agent_2", "observations": {"agent_id": "agent_2", "tick": 9, "base_tick": 8}},
+                ],
+            }
+        )
+        assert [a["agent_id"] for a in response["actions"]] == ["agent_1"]
+        assert response["resync"] == ["agent_2"]
+
+    def test_no_resync_key_when_in_sync(self) -> None:
+        server = MinimalIPCServer(decide_callback=lambda obs: Decision.idle())
+        response = server.process_tick({"tick": 1, "agents": [{"agent_id": "agent_1", "observations": _keyframe()}]})
+        assert "resync" not in response
@@ -199,6 +199,26 @@ class TestObservation:
         assert reconstructed.objective is not None
         assert reconstructed.current_progress == original.current_progress
 
+    def test_observation_memory_snapshot(self):
+        """Test the agent memory snapshot round-trips through from_dict."""
+        data = {
+            "agent_id": "agent_001",
+            "tick": 3,
+            "position": [0.0, 0.0, 0.0],
+            "memory": {
+                "entries": {"goal": "berries"},
+                "recent_actions": [{"tool": "move_to", "params": {}}],
+                "total_actions": 12,
+            },
+        }
+
+        obs = Observation.from_dict(data)
+
+        assert obs.memory["entries"]["goal"] == "berries"
+        assert obs.memory["total_actions"] == 12
+        assert obs.to_dict()["memory"] == data["memory"]
+        assert Observation.from_dict({"agent_id": "a", "tick": 0, "position": [0, 0, 0]}).memory == {}
+
 
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
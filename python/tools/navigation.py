@@ -13,7 +13,7 @@ logger = logging.getLogger(__name__)
 
 def plan_path(target_position: list[float], avoid_hazards: bool = True) -> dict[str, Any]:
     """
-    Plan a path from current position to target using Godot's navigation system.
+    Plan a path from current position to target using Godot's path planner.
 
     This is a query tool - it returns path information but doesn't move the agent.
     Use move_to to actually move along the path.
@@ -32,7 +32,7 @@ def plan_path(target_position: list[float], avoid_hazards: bool = True) -> dict[
     """
     logger.debug(f"Planning path to {target_position}, avoid_hazards={avoid_hazards}")
 
-    # This is handled by Godot's NavigationServer3D
+    # This is handled by Godot's native PathPlanner (grid A* with a shared path cache)
     # The actual implementation is in SceneController/SimpleAgent
     return {
         "success": True,
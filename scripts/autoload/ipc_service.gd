@@ -12,12 +12,41 @@ signal connected_to_server
 signal connection_failed(error: String)
 signal tool_response(agent_id: String, tool_name: String, response: Dictionary)
 signal tick_response(agent_id: String, response: Dictionary)
+signal batch_tick_completed(tick: int, action_count: int)
+signal tick_request_completed(tick: int)  # Response arrived; its pipeline slot is free
+signal tick_request_failed(tick: int, error: String)  # HTTP error or bad JSON; tick_request_completed follows
+signal backpressure_changed(level: float)  # 0 = backend keeping up, 1 = latency at twice the budget
 
 var ipc_client: IPCClient
+var observation_builder: ObservationBuilder  # Shared by every scene (and world) in the process
 var server_url := "http://127.0.0.1:5000"
 var is_ready := false
 var connection_active := false  # Track connection status
 
+# Decision pipelining (override with -- --pipeline-depth=K --fixed-action-latency)
+var pipeline_depth := 1  # Tick requests allowed in flight while the simulation keeps stepping
+var fixed_action_latency := false  # Apply actions at tick + pipeline_depth instead of on arrival
+
+# Reuse decisions for agents whose observation fingerprint hasn't changed
+# (override with -- --decision-cache=replay|skip|off --decision-cache-ttl=N)
+var decision_cache := IPCClient.DECISION_CACHE_OFF
+var decision_cache_ttl := 30  # Ticks a cached decision stays usable
+
+# Slow the tick loop down when the backend falls behind
+# (override with -- --adaptive-tick-rate --latency-budget-ms=N)
+var adaptive_tick_rate := false  # Scenes apply backpressure_changed to their SimulationManager
+var latency_budget_ms := 250.0  # Backend latency above this raises backpressure
+
+# Decision scheduling (override with -- --max-agents-per-tick=N --idle-decision-interval=N
+# --backpressure-shedding)
+var max_agents_per_tick := 0  # 0 = ask about every due agent each tick
+var idle_decision_interval := 1  # Agents whose last action was idle are asked at most every Nth tick
+var backpressure_shedding := false  # Ask about fewer (lowest priority dropped first) agents as backpressure rises
+
+# Per-phase tick timings; -- --perf-trace=<path> also writes a Chrome trace on exit
+var perf_monitor: PerfMonitor
+var perf_trace_path := ""
+
 func _ready():
 	print("=== IPCService Initializing ===")
 
@@ -25,28 +54,105 @@ func _ready():
 	ipc_client = IPCClient.new()
 	ipc_client.name = "IPCClient"
 	ipc_client.server_url = server_url
+	_apply_pipeline_args()
+	ipc_client.pipeline_depth = pipeline_depth
+	ipc_client.action_latency = IPCClient.ACTION_LATENCY_FIXED if fixed_action_latency else IPCClient.ACTION_LATENCY_ON_ARRIVAL
+	ipc_client.decision_cache = decision_cache
+	ipc_client.decision_cache_ttl = decision_cache_ttl
+	ipc_client.latency_budget_ms = latency_budget_ms
+	ipc_client.max_agents_per_tick = max_agents_per_tick
+	ipc_client.idle_decision_interval = idle_decision_interval
+	ipc_client.backpressure_shedding = backpressure_shedding
 	add_child(ipc_client)
 
+	observation_builder = ObservationBuilder.new()
+	ipc_client.observation_builder = observation_builder
+
+	perf_monitor = PerfMonitor.new()
+	perf_monitor.name = "PerfMonitor"
+	add_child(perf_monitor)
+	if not perf_trace_path.is_empty():
+		perf_monitor.start_trace()
+
 	# Connect signals from IPCClient
 	ipc_client.response_received.connect(_on_ipc_response_received)
 	ipc_client.connection_failed.connect(_on_ipc_connection_failed)
+	ipc_client.tick_actions_routed.connect(_on_ipc_tick_actions_routed)
+	ipc_client.tick_request_completed.connect(_on_ipc_tick_request_completed)
+	ipc_client.tick_request_failed.connect(_on_ipc_tick_request_failed)
+	ipc_client.backpressure_changed.connect(_on_ipc_backpressure_changed)
 
 	print("IPCService: IPCClient created")
 
 	is_ready = true
 	print("=== IPCService Ready ===")
 
-	# Auto-connect to backend using a short timer to ensure everything is fully initialized
-	print("IPCService: Will auto-connect to backend in 0.5 seconds...")
-	var connect_timer = Timer.new()
-	connect_timer.wait_time = 0.5
-	connect_timer.one_shot = true
-	connect_timer.timeout.connect(_connect_to_backend)
-	add_child(connect_timer)
-	connect_timer.start()
+	# Start the health check right away: it runs on HTTPRequest's thread while
+	# the main scene loads, so the backend is usually connected by the first tick
+	_connect_to_backend()
+
+func _apply_pipeline_args():
+	"""Read pipeline, cache, scheduling, backpressure, perf and log settings from user command-line args (after --)"""
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--pipeline-depth="):
+			pipeline_depth = int(arg.trim_prefix("--pipeline-depth="))
+		elif arg == "--fixed-action-latency":
+			fixed_action_latency = true
+		elif arg.begins_with("--perf-trace="):
+			perf_trace_path = arg.trim_prefix("--perf-trace=")
+		elif arg.begins_with("--decision-cache="):
+			var modes := {
+				"off": IPCClient.DECISION_CACHE_OFF,
+				"replay": IPCClient.DECISION_CACHE_REPLAY,
+				"skip": IPCClient.DECISION_CACHE_SKIP,
+			}
+			var mode_name := arg.trim_prefix("--decision-cache=").to_lower()
+			if modes.has(mode_name):
+				decision_cache = modes[mode_name]
+			else:
+				push_warning("IPCService: unknown decision cache mode '%s'" % mode_name)
+		elif arg.begins_with("--decision-cache-ttl="):
+			decision_cache_ttl = int(arg.trim_prefix("--decision-cache-ttl="))
+		elif arg == "--adaptive-tick-rate":
+			adaptive_tick_rate = true
+		elif arg.begins_with("--latency-budget-ms="):
+			latency_budget_ms = float(arg.trim_prefix("--latency-budget-ms="))
+		elif arg.begins_with("--max-agents-per-tick="):
+			max_agents_per_tick = int(arg.trim_prefix("--max-agents-per-tick="))
+		elif arg.begins_with("--idle-decision-interval="):
+			idle_decision_interval = int(arg.trim_prefix("--idle-decision-interval="))
+		elif arg == "--backpressure-shedding":
+			backpressure_shedding = true
+		elif arg.begins_with("--log-level="):
+			_apply_log_level(arg.trim_prefix("--log-level="))
+
+func _apply_log_level(level_name: String):
+	"""Set the C++ runtime log level (trace, debug, info, warn, error, none)"""
+	var levels := {
+		"trace": ArenaLog.LEVEL_TRACE,
+		"debug": ArenaLog.LEVEL_DEBUG,
+		"info": ArenaLog.LEVEL_INFO,
+		"warn": ArenaLog.LEVEL_WARN,
+		"error": ArenaLog.LEVEL_ERROR,
+		"none": ArenaLog.LEVEL_NONE,
+	}
+	var key := level_name.to_lower()
+	if levels.has(key):
+		ArenaLog.set_level(levels[key])
+	else:
+		push_warning("IPCService: unknown log level '%s'" % level_name)
+
+func _exit_tree():
+	if perf_monitor and perf_monitor.is_tracing():
+		perf_monitor.stop_trace()
+		perf_monitor.export_trace(perf_trace_path)
+
+func get_perf_stats() -> Dictionary:
+	"""Per-phase tick timings (ms histograms) and IPC counters"""
+	return perf_monitor.get_perf_stats() if perf_monitor else {}
 
 func _connect_to_backend():
-	"""Internal function to connect to backend (called after short delay)"""
+	"""Internal function to connect to backend (called from _ready)"""
 	if not ipc_client:
 		push_error("IPCClient not initialized!")
 		return
@@ -83,6 +189,56 @@ func send_tick(_agent_id: String, tick: int, perceptions: Array) -> void:
 
 	ipc_client.send_tick_request(tick, perceptions)
 
+func register_agent(agent: Agent) -> void:
+	"""Register a C++ Agent so it is included in batched ticks and receives its actions"""
+	if not ipc_client:
+		push_error("IPCClient not initialized!")
+		return
+
+	ipc_client.register_agent(agent)
+
+func unregister_agent(agent_id: String) -> void:
+	"""Remove an agent from batched ticks"""
+	if ipc_client:
+		ipc_client.unregister_agent(agent_id)
+
+func set_agent_priority(agent_id: String, priority: float) -> void:
+	"""Weight an agent's claim on the per-tick decision budget and the tool queue (default 1.0)"""
+	if ipc_client:
+		ipc_client.set_agent_priority(agent_id, priority)
+
+func set_observation_builder(builder: ObservationBuilder) -> void:
+	"""Use a native ObservationBuilder as the observation source for batched ticks"""
+	if not ipc_client:
+		push_error("IPCClient not initialized!")
+		return
+
+	observation_builder = builder
+	ipc_client.observation_builder = builder
+
+func send_batch_tick(tick: int) -> void:
+	"""Send one /tick request covering every registered agent's last observation"""
+	if not is_ready:
+		push_error("IPCService not ready yet!")
+		return
+
+	if not ipc_client:
+		push_error("IPCClient not initialized!")
+		return
+
+	ipc_client.send_batch_tick_request(tick)
+
+func can_send_tick() -> bool:
+	"""True while the decision pipeline has room for another tick request"""
+	if not ipc_client:
+		return false
+	return ipc_client.can_send_tick()
+
+func advance_to_tick(tick: int) -> void:
+	"""Apply held-back actions that are due by tick (fixed action latency)"""
+	if ipc_client:
+		ipc_client.advance_to_tick(tick)
+
 func is_backend_connected() -> bool:
 	"""Check if connected to Python backend"""
 	if not ipc_client:
@@ -114,6 +270,23 @@ func _on_ipc_response_received(response: Dictionary):
 		# Generic response
 		print("[IPCService] Unknown response type: ", response)
 
+func _on_ipc_tick_actions_routed(tick: int, action_count: int):
+	"""Batched tick response has been routed to the individual agents"""
+	batch_tick_completed.emit(tick, action_count)
+
+func _on_ipc_tick_request_completed(tick: int):
+	"""A tick request finished; actions may still be pending under fixed latency"""
+	tick_request_completed.emit(tick)
+
+func _on_ipc_tick_request_failed(tick: int, error: String):
+	"""A tick request got no usable response; its agents keep their current actions"""
+	push_warning("[IPCService] Tick %d request failed: %s" % [tick, error])
+	tick_request_failed.emit(tick, error)
+
+func _on_ipc_backpressure_changed(level: float):
+	"""Backend latency moved relative to latency_budget_ms"""
+	backpressure_changed.emit(level)
+
 func _on_ipc_connection_failed(error: String):
 	"""Handle connection failure"""
 	push_error("[IPCService] Connection failed: " + error)
@@ -6,20 +6,40 @@ extends Node
 ##
 ## Usage:
 ##   ToolRegistryService.register_tool("move_to", schema)
-##   ToolRegistryService.execute_tool(agent_id, "move_to", params)
+##   ToolRegistryService.register_tools([schema_a, schema_b])
+##   ToolRegistryService.execute_tool(agent_id, "move_to", params, agent)
+##   var future = ToolRegistryService.call_tool(agent_id, "pickup_item", params, agent)
+##   if not future.is_done(): await future.completed
 ##   ToolRegistryService.get_available_tools()
 
 signal tool_registered(tool_name: String)
 signal tool_executed(agent_id: String, tool_name: String)
 
+## Default tool schemas, decoded natively in one pass at boot (the same
+## shape as register_tools() takes); keep *.json in export include filters
+const DEFAULT_TOOL_MANIFEST := "res://scripts/autoload/default_tools.json"
+
+## Tools the agent body executes in-engine. Each runs the agent's
+## _tool_<name>(params) method straight from the ToolRegistry dispatch
+## table, so these never cost an IPC round-trip.
+const LOCAL_AGENT_TOOLS := [
+	"move_to",
+	"stop_movement",
+	"plan_path",
+	"explore_direction",
+	"get_exploration_status",
+	"craft_item",
+	"get_recipes",
+]
+
 var tool_registry: ToolRegistry
 var is_ready := false
 
 func _ready():
 	print("=== ToolRegistryService Initializing ===")
 
-	# Wait for IPCService to be ready first
-	await get_tree().process_frame
+	# IPCService is listed first in [autoload], so its IPCClient already exists:
+	# no frame wait, tools are ready before the main scene's _ready runs
 
 	# Create the C++ ToolRegistry node
 	tool_registry = ToolRegistry.new()
@@ -36,118 +56,33 @@ func _ready():
 
 	# Register default tools
 	_register_default_tools()
+	_bind_local_tools()
 
 	is_ready = true
 	print("=== ToolRegistryService Ready ===")
 
 func _register_default_tools():
-	"""Register the standard set of tools available to all agents"""
-	print("Registering default tools...")
-
-	# Movement tools
-	register_tool("move_to", {
-		"name": "move_to",
-		"description": "Move to a target position in the world",
-		"parameters": {
-			"target_position": {"type": "array", "description": "3D position [x, y, z]"},
-			"speed": {"type": "number", "description": "Movement speed multiplier", "default": 1.0}
-		}
-	})
-
-	register_tool("navigate_to", {
-		"name": "navigate_to",
-		"description": "Navigate to target using pathfinding (avoids obstacles)",
-		"parameters": {
-			"target_position": {"type": "array", "description": "3D position [x, y, z]"}
-		}
-	})
-
-	register_tool("stop_movement", {
-		"name": "stop_movement",
-		"description": "Stop all movement immediately",
-		"parameters": {}
-	})
-
-	# Interaction tools
-	register_tool("pickup_item", {
-		"name": "pickup_item",
-		"description": "Pick up an item from the world",
-		"parameters": {
-			"item_id": {"type": "string", "description": "Unique identifier of the item"}
-		}
-	})
-
-	register_tool("drop_item", {
-		"name": "drop_item",
-		"description": "Drop an item from inventory",
-		"parameters": {
-			"item_id": {"type": "string", "description": "Unique identifier of the item"}
-		}
-	})
-
-	register_tool("use_item", {
-		"name": "use_item",
-		"description": "Use an item from inventory",
-		"parameters": {
-			"item_id": {"type": "string", "description": "Unique identifier of the item"}
-		}
-	})
-
-	# Query tools
-	register_tool("get_inventory", {
-		"name": "get_inventory",
-		"description": "Get current inventory contents",
-		"parameters": {}
-	})
-
-	register_tool("look_at", {
-		"name": "look_at",
-		"description": "Get detailed information about an object or entity",
-		"parameters": {
-			"target_id": {"type": "string", "description": "ID of the object to examine"}
-		}
-	})
-
-	# Navigation/Exploration tools
-	register_tool("plan_path", {
-		"name": "plan_path",
-		"description": "Plan a path to a target position. Returns waypoints and distance.",
-		"parameters": {
-			"target_position": {"type": "array", "description": "Target [x, y, z] position"},
-			"avoid_hazards": {"type": "boolean", "description": "Route around hazards", "default": true}
-		}
-	})
-
-	register_tool("explore_direction", {
-		"name": "explore_direction",
-		"description": "Get a position to explore in a direction (north, south, east, west, etc.)",
-		"parameters": {
-			"direction": {"type": "string", "description": "Direction to explore"}
-		}
-	})
-
-	register_tool("get_exploration_status", {
-		"name": "get_exploration_status",
-		"description": "Get exploration percentage and frontier locations",
-		"parameters": {}
-	})
-
-	# Crafting tools
-	register_tool("craft_item", {
-		"name": "craft_item",
-		"description": "Craft an item at a nearby crafting station using collected resources",
-		"parameters": {
-			"recipe": {"type": "string", "description": "Name of the recipe to craft (e.g., 'torch', 'shelter', 'meal')"}
-		}
-	})
-
-	register_tool("get_recipes", {
-		"name": "get_recipes",
-		"description": "Get available crafting recipes and their requirements",
-		"parameters": {}
-	})
-
-	print("Registered ", get_tool_count(), " default tools")
+	"""Register the standard set of tools available to all agents, in one native call"""
+	var count = tool_registry.load_tool_manifest(DEFAULT_TOOL_MANIFEST)
+	if count < 0:
+		push_error("ToolRegistryService: Could not load tool manifest %s" % DEFAULT_TOOL_MANIFEST)
+		return
+	for tool_name in tool_registry.get_all_tool_names():
+		tool_registered.emit(tool_name)
+	print("Registered ", count, " default tools")
+
+func register_tools(manifest: Variant) -> int:
+	"""Register many tools at once: an Array of schemas (each with "name"), {"tools": [...]} or {name: schema}"""
+	if not tool_registry:
+		push_error("ToolRegistry not initialized!")
+		return 0
+
+	var before = tool_registry.get_all_tool_names()
+	var count = tool_registry.register_tools(manifest)
+	for tool_name in tool_registry.get_all_tool_names():
+		if not before.has(tool_name):
+			tool_registered.emit(tool_name)
+	return count
 
 func register_tool(tool_name: String, schema: Dictionary) -> bool:
 	"""Register a new tool with the given schema"""
@@ -157,11 +92,27 @@ func register_tool(tool_name: String, schema: Dictionary) -> bool:
 
 	tool_registry.register_tool(tool_name, schema)
 	tool_registered.emit(tool_name)
-	print("Tool registered: ", tool_name)
 	return true
 
-func execute_tool(agent_id: String, tool_name: String, parameters: Dictionary) -> Dictionary:
-	"""Execute a tool for a specific agent"""
+func _bind_local_tools():
+	"""Route LOCAL_AGENT_TOOLS to the calling agent instead of the backend"""
+	for tool_name in LOCAL_AGENT_TOOLS:
+		if tool_registry.has_tool(tool_name):
+			tool_registry.set_local_handler(tool_name, _run_agent_tool.bind(StringName("_tool_" + tool_name)))
+
+func _run_agent_tool(agent: Object, parameters: Dictionary, method: StringName) -> Dictionary:
+	if agent == null or not agent.has_method(method):
+		return {"success": false, "error": "Agent cannot execute local tool '%s'" % String(method).trim_prefix("_tool_")}
+	return agent.call(method, parameters)
+
+func execute_tool(agent_id: String, tool_name: String, parameters: Dictionary, agent: Object = null) -> Dictionary:
+	"""
+	Execute a tool for a specific agent.
+	Local tools run immediately on `agent`; the rest are sent to the backend
+	with agent_id at the top level of the request (not inside params) and
+	return {success: false, pending: true, request_id}; use call_tool() for
+	their actual result.
+	"""
 	if not is_ready:
 		push_error("ToolRegistryService not ready yet!")
 		return {"success": false, "error": "Service not ready"}
@@ -170,19 +121,54 @@ func execute_tool(agent_id: String, tool_name: String, parameters: Dictionary) -
 		push_error("ToolRegistry not initialized!")
 		return {"success": false, "error": "Registry not initialized"}
 
-	# Get IPC client to call execute_tool_sync with agent_id at top level
-	var ipc_client = tool_registry.get_ipc_client()
-	if not ipc_client:
-		push_error("No IPC client available!")
-		return {"success": false, "error": "No IPC client"}
-
-	# Call IPCClient directly with agent_id as separate parameter
-	# This ensures agent_id is at top level of request, not inside params
-	var result = ipc_client.execute_tool_sync(tool_name, parameters, agent_id, 0)
+	var result: Dictionary
+	if tool_registry.has_tool(tool_name):
+		result = tool_registry.execute_tool(tool_name, parameters, agent_id, agent)
+	else:
+		# Unregistered tools are still forwarded, the backend may know them
+		var ipc_client = tool_registry.get_ipc_client()
+		if not ipc_client:
+			push_error("No IPC client available!")
+			return {"success": false, "error": "No IPC client"}
+		result = ipc_client.execute_tool_sync(tool_name, parameters, agent_id, 0)
 
 	tool_executed.emit(agent_id, tool_name)
 	return result
 
+func call_tool(agent_id: String, tool_name: String, parameters: Dictionary, agent: Object = null) -> ToolFuture:
+	"""
+	Execute a tool and return a ToolFuture for its real result.
+	Local tools come back already resolved; remote ones resolve when the
+	backend answers, times out (IPCClient.tool_timeout) or is cancelled.
+	"""
+	if not is_ready or not tool_registry:
+		push_error("ToolRegistryService not ready yet!")
+		return _failed_future(tool_name, "Service not ready")
+
+	var future: ToolFuture
+	if tool_registry.has_tool(tool_name):
+		future = tool_registry.call_tool(tool_name, parameters, agent_id, agent)
+	else:
+		# Unregistered tools are still forwarded, the backend may know them
+		var ipc_client = tool_registry.get_ipc_client()
+		if not ipc_client:
+			push_error("No IPC client available!")
+			return _failed_future(tool_name, "No IPC client")
+		future = ipc_client.execute_tool_async(tool_name, parameters, agent_id)
+
+	tool_executed.emit(agent_id, tool_name)
+	return future
+
+func _failed_future(tool_name: String, error: String) -> ToolFuture:
+	return ToolFuture.make_resolved(tool_name, "", {"success": false, "error": error})
+
+func is_local_tool(tool_name: String) -> bool:
+	"""Check if a tool runs in-engine rather than on the backend"""
+	if not tool_registry:
+		return false
+
+	return tool_registry.is_local_tool(tool_name)
+
 func get_available_tools() -> Array:
 	"""Get list of all registered tool names"""
 	if not tool_registry:
@@ -206,4 +192,7 @@ func has_tool(tool_name: String) -> bool:
 
 func get_tool_count() -> int:
 	"""Get the total number of registered tools"""
-	return get_available_tools().size()
+	if not tool_registry:
+		return 0
+
+	return tool_registry.get_tool_count()
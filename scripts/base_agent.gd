@@ -35,6 +35,14 @@ func _ready():
 		agent_id = "agent_" + str(Time.get_ticks_msec())
 		print("BaseAgent: Auto-generated ID: ", agent_id)
 
+	# Worlds hosted by a WorldHost share one backend connection, so IDs are
+	# namespaced by world ("w0/forager_001") to stay unique across worlds
+	var viewport = get_viewport()
+	if viewport and viewport.has_meta("world_id"):
+		var prefix = "%s/" % viewport.get_meta("world_id")
+		if not agent_id.begins_with(prefix):
+			agent_id = prefix + agent_id
+
 func take_damage(amount: float, source: Node = null, source_type: String = "unknown") -> void:
 	"""Apply damage to this agent and emit signal."""
 	current_health -= amount
@@ -81,3 +89,17 @@ func call_tool(_tool_name: String, _parameters: Dictionary = {}) -> Dictionary:
 	"""
 	push_error("BaseAgent.call_tool() called but not overridden in subclass")
 	return {"success": false, "error": "Not implemented"}
+
+func get_snapshot_state() -> Dictionary:
+	"""
+	Agent-specific state for SimulationManager snapshots.
+
+	Position and health are captured natively by the scene's AgentWorld;
+	override to add anything else needed to resume from this point
+	(movement targets, cooldowns, ...).
+	"""
+	return {}
+
+func apply_snapshot_state(_state: Dictionary) -> void:
+	"""Restore what get_snapshot_state() captured (called after position and health)."""
+	velocity = Vector3.ZERO
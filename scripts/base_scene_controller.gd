@@ -18,6 +18,7 @@ class_name SceneController
 ## - _on_scene_stopped()
 ## - _on_scene_tick(tick)
 ## - _on_agent_tool_completed(agent_data, tool_name, response)
+## - _capture_scene_state() / _restore_scene_state(state) (snapshot/rollback)
 
 # Scene references (automatically discovered)
 @onready var simulation_manager: Node = $SimulationManager
@@ -25,13 +26,31 @@ class_name SceneController
 @onready var metrics_label: Label = $UI/MetricsLabel
 
 # Agent tracking
-var agents: Array[Dictionary] = []  # Array of {agent: Node, id: String, team: String, position: Vector3}
+var agents: Array[Dictionary] = []  # Array of {agent: Node, id: String, team: String, position: Vector3, slot: int}
+var agent_world: AgentWorld = null  # Native SoA columns for agent hot state; agent_data.slot indexes it
 
 # Perception configuration (override in subclasses)
 @export var perception_radius: float = 10.0  ## Max distance agent can perceive objects
 var line_of_sight_enabled: bool = true  # Set to false to disable LOS checks (x-ray vision)
 var los_collision_mask: int = 2  # Collision layer for obstacles that block vision
 
+# Spatial index for perception queries (category bitmasks, combine with |)
+const SPATIAL_RESOURCE := 1
+const SPATIAL_HAZARD := 2
+const SPATIAL_STATION := 4
+const SPATIAL_AGENT := 8
+var spatial_index: SpatialIndex = null
+var line_of_sight: LineOfSight = null  # Batched, cached LOS raycasts (see filter_line_of_sight)
+var _spatial_entities: Array = []  # spatial id -> entity Dictionary (null once removed)
+var _spatial_categories: PackedInt32Array = PackedInt32Array()
+
+# Path planning: native grid A* with a shared path cache; hazards registered
+# with the spatial index are mirrored into it
+var path_planner: PathPlanner = null
+var path_cell_size: float = 1.0
+var hazard_avoidance_radius: float = 1.5  # Default clearance for hazards without a "radius" key
+var _path_obstacles_ready := false  # Obstacles are rasterised on the first query (physics is live by then)
+
 # Exploration tracking
 var visibility_tracker: VisibilityTracker = null
 var exploration_enabled: bool = true  # Set to false to disable exploration tracking
@@ -50,14 +69,26 @@ var scene_completed: bool = false
 
 # Backend decision tracking
 var backend_decisions: Array[Dictionary] = []  # Track all decisions for analysis
-var waiting_for_decision := false  # Prevent concurrent requests
-var http_request: HTTPRequest = null  # HTTP node for backend communication
+var waiting_for_decision := false  # Decision pipeline is full (see IPCService.pipeline_depth)
 var decisions_executed := 0  # Count of executed decisions
 var decisions_skipped := 0  # Count of skipped decisions (idle)
 
 # Tool result tracking (Issue #71) - stores last tool result per agent
 var pending_tool_results: Dictionary = {}  # agent_id -> Dictionary
 
+# Agent memory in observations: the C++ Agent's memory store and its most
+# recent actions are encoded natively into the "memory" field
+var send_agent_memory: bool = false
+var memory_actions_in_observation: int = 8
+
+# Native per-agent observation buffers shipped to the backend as-is
+# (shared via IPCService when available)
+var observation_builder: ObservationBuilder = null
+
+# Snapshots: agents and scene state are registered as SimulationManager
+# snapshot sources; initial_snapshot is the episode start (see reset_to_initial_state)
+var initial_snapshot: int = -1
+
 func _ready():
 	"""Initialize scene controller and discover agents"""
 	print("SceneController initializing...")
@@ -77,6 +108,10 @@ func _ready():
 
 	print("✓ SceneController discovered %d agent(s)" % agents.size())
 
+	# Index agents for proximity queries (scenes register their own objects)
+	_setup_path_planner()
+	_setup_spatial_index()
+
 	# Setup exploration tracking
 	if exploration_enabled:
 		_setup_visibility_tracker()
@@ -87,9 +122,14 @@ func _ready():
 	# Call scene-specific initialization
 	_on_scene_ready()
 
+	_setup_snapshots()
+
 func _discover_agents():
 	"""Auto-discover SimpleAgent nodes in scene"""
 	agents.clear()
+	if agent_world == null:
+		agent_world = AgentWorld.new()
+	agent_world.clear()
 
 	# Look for Agents node in scene tree
 	var agents_node = get_node_or_null("Agents")
@@ -121,7 +161,10 @@ func _discover_agents_in_node(parent_node: Node, team: String):
 				"agent": child,
 				"id": agent_id_value,
 				"team": team,
-				"position": child.global_position
+				"position": child.global_position,
+				"last_observation": {},
+				"spatial_id": -1,
+				"slot": agent_world.add_agent(child, str(agent_id_value), team)
 			}
 			agents.append(agent_data)
 
@@ -131,6 +174,14 @@ func _discover_agents_in_node(parent_node: Node, team: String):
 					_on_agent_tool_completed(agent_data, tool_name, response)
 			)
 
+			# Batched tick actions routed by IPCClient are parked in the
+			# AgentWorld and executed by _execute_pending_actions()
+			if child.has_signal("action_received"):
+				child.action_received.connect(
+					func(action: Dictionary):
+						agent_world.set_pending_action(agent_data.slot, action)
+				)
+
 			# Create visual if available
 			_create_agent_visual(child, agent_data)
 
@@ -198,17 +249,28 @@ func _on_simulation_stopped():
 
 func _on_tick_advanced(tick: int):
 	"""Send observations to all agents each tick"""
-	# Update agent positions
-	for agent_data in agents:
-		agent_data.position = agent_data.agent.global_position
+	# Actions held back for this tick (fixed action latency) land before observing
+	if IPCService:
+		IPCService.advance_to_tick(tick)
+	_execute_pending_actions()
 
-	# Update exploration tracking for each agent
+	# Read every agent's position and health in one native pass (this also
+	# moves agents in the spatial index), so perception sees all of this tick's positions
+	agent_world.sync_from_nodes(spatial_index)
+	var positions := agent_world.get_positions()
+	if line_of_sight:
+		line_of_sight.begin_tick()  # Pairs cached by every agent last tick stay cached
+
+	# Exploration and perception in a single pass over the agents
 	for agent_data in agents:
+		var slot: int = agent_data.slot
+		if not agent_world.is_agent_active(slot):
+			continue  # Node freed or removed from the tree
+		agent_data.position = positions[slot]
 		_update_exploration(agent_data)
 
-	# Send perception to each agent
-	for agent_data in agents:
 		var observations = _build_observations_for_agent(agent_data)
+		agent_data.last_observation = observations
 
 		# Debug logging if enabled
 		if debug_observations:
@@ -355,6 +417,95 @@ func is_within_perception(agent_pos: Vector3, target_pos: Vector3) -> bool:
 	"""Check if a target is within the agent's perception radius"""
 	return agent_pos.distance_to(target_pos) <= perception_radius
 
+## Spatial Index
+
+func _setup_spatial_index():
+	"""Create the native spatial index and register discovered agents"""
+	spatial_index = SpatialIndex.new()
+	spatial_index.name = "SpatialIndex"
+	spatial_index.cell_size = max(perception_radius * 0.5, 1.0)
+	add_child(spatial_index)
+
+	line_of_sight = LineOfSight.new()
+	line_of_sight.name = "LineOfSight"
+	line_of_sight.collision_mask = los_collision_mask
+	add_child(line_of_sight)
+
+	for agent_data in agents:
+		agent_data.spatial_id = register_spatial_entity(agent_data, SPATIAL_AGENT)
+		agent_world.set_spatial_id(agent_data.slot, agent_data.spatial_id)
+
+func register_spatial_entity(entity: Dictionary, category: int) -> int:
+	"""Add an entity with a 'position' key to the spatial index. Returns its spatial id."""
+	var id = _spatial_entities.size()
+	entity.spatial_id = id
+	_spatial_entities.append(entity)
+	_spatial_categories.append(category)
+	spatial_index.insert(id, entity.position, category)
+	if path_planner and (category & SPATIAL_HAZARD) != 0:
+		path_planner.set_hazard(id, entity.position, entity.get("radius", hazard_avoidance_radius))
+	return id
+
+func clear_spatial_entities(category_mask: int):
+	"""Remove every indexed entity in the given categories"""
+	for id in _spatial_entities.size():
+		if _spatial_entities[id] != null and (_spatial_categories[id] & category_mask) != 0:
+			spatial_index.remove(id)
+			if path_planner and (_spatial_categories[id] & SPATIAL_HAZARD) != 0:
+				path_planner.remove_hazard(id)
+			_spatial_entities[id] = null
+
+func query_nearby(center: Vector3, category_mask: int, radius: float = -1.0) -> Array:
+	"""Entities within radius (default: perception_radius), nearest first.
+
+	Returns an Array of {"entity": Dictionary, "distance": float, "category": int}.
+	"""
+	if radius < 0.0:
+		radius = perception_radius
+	var hits: Dictionary = spatial_index.query_radius_with_distance(center, radius, category_mask)
+	var ids: PackedInt64Array = hits.ids
+	var distances: PackedFloat32Array = hits.distances
+	var result := []
+	for i in ids.size():
+		var id = ids[i]
+		result.append({"entity": _spatial_entities[id], "distance": distances[i], "category": _spatial_categories[id]})
+	return result
+
+func filter_line_of_sight(agent_data: Dictionary, hits: Array) -> Array:
+	"""Keep the query_nearby() hits visible from the agent.
+
+	All targets go to LineOfSight in one call; pairs whose endpoints haven't
+	moved reuse last tick's result instead of raycasting again (the cache
+	ages per tick, see begin_tick() in _on_tick_advanced).
+	"""
+	if not line_of_sight_enabled or hits.is_empty():
+		return hits
+
+	var to_ids := PackedInt64Array()
+	var to_positions := PackedVector3Array()
+	var target_instance_ids := PackedInt64Array()
+	for hit in hits:
+		var entity: Dictionary = hit.entity
+		var node = entity.get("node")
+		to_ids.append(entity.spatial_id)
+		to_positions.append(entity.position)
+		target_instance_ids.append(node.get_instance_id() if node != null else 0)
+
+	var agent_node = agent_data.agent
+	var exclude_rid := RID()
+	if agent_node is CollisionObject3D:
+		exclude_rid = agent_node.get_rid()
+
+	var visible: PackedByteArray = line_of_sight.check_targets(
+		agent_data.spatial_id, agent_data.position, exclude_rid, to_ids, to_positions, target_instance_ids
+	)
+
+	var result := []
+	for i in hits.size():
+		if visible[i] == 1:
+			result.append(hits[i])
+	return result
+
 ## Observation Debug Logging
 
 func _unhandled_input(event):
@@ -513,43 +664,57 @@ func set_exploration_overlay(enabled: bool):
 
 ## Navigation query methods
 
-func query_plan_path(from_pos: Vector3, to_pos: Vector3, avoid_hazards: bool = true) -> Dictionary:
-	"""Query path planning using Godot's NavigationServer3D."""
-	var nav_map = NavigationServer3D.get_maps()[0] if NavigationServer3D.get_maps().size() > 0 else RID()
-	if not nav_map.is_valid():
-		return {
-			"success": false,
-			"blocked": true,
-			"reason": "No navigation map available"
-		}
-
-	# Get path from NavigationServer3D
-	var path = NavigationServer3D.map_get_path(nav_map, from_pos, to_pos, true)
+func _setup_path_planner():
+	"""Create the native path planner over the world bounds"""
+	path_planner = PathPlanner.new()
+	path_planner.cell_size = path_cell_size
+	path_planner.set_world_bounds(world_bounds_min, world_bounds_max)
+
+func _rasterize_path_obstacles():
+	"""Block planner cells whose centre lies inside a vision-blocking obstacle"""
+	_path_obstacles_ready = true
+	var world_3d = get_viewport().find_world_3d() if get_viewport() else null
+	if not world_3d:
+		return
+	var space_state = world_3d.direct_space_state
+	var query = PhysicsPointQueryParameters3D.new()
+	query.collision_mask = los_collision_mask
+	query.collide_with_areas = false
+
+	var min_cell: Vector2i = path_planner.get_min_cell()
+	var grid_size: Vector2i = path_planner.get_grid_size()
+	var cell_size: float = path_planner.cell_size
+	var blocked := PackedByteArray()
+	blocked.resize(grid_size.x * grid_size.y)
+	for z in grid_size.y:
+		for x in grid_size.x:
+			query.position = Vector3((min_cell.x + x + 0.5) * cell_size, 0.5, (min_cell.y + z + 0.5) * cell_size)
+			blocked[z * grid_size.x + x] = 1 if not space_state.intersect_point(query, 1).is_empty() else 0
+	path_planner.set_blocked_cells(blocked)
 
-	if path.size() == 0:
+func query_plan_path(from_pos: Vector3, to_pos: Vector3, avoid_hazards: bool = true) -> Dictionary:
+	"""Plan a path with the native grid planner (cached per start/goal cell)."""
+	if not path_planner:
 		return {
 			"success": false,
 			"blocked": true,
-			"reason": "No path found to target"
+			"reason": "No path planner available"
 		}
+	if not _path_obstacles_ready:
+		_rasterize_path_obstacles()
+	return path_planner.plan_path(from_pos, to_pos, avoid_hazards)
 
-	# Calculate total distance
-	var total_distance = 0.0
-	for i in range(path.size() - 1):
-		total_distance += path[i].distance_to(path[i + 1])
-
-	# Convert path to array of arrays for JSON serialization
-	var waypoints = []
-	for point in path:
-		waypoints.append([point.x, point.y, point.z])
+func query_plan_paths(from_positions: PackedVector3Array, to_positions: PackedVector3Array, avoid_hazards: bool = true) -> Dictionary:
+	"""Plan one path per (from, to) pair in a single native call.
 
-	return {
-		"success": true,
-		"waypoints": waypoints,
-		"distance": total_distance,
-		"blocked": false,
-		"avoid_hazards": avoid_hazards
-	}
+	Returns {offsets, waypoints, distances, success}; pair i's waypoints are
+	waypoints[offsets[i] .. offsets[i + 1]).
+	"""
+	if not path_planner:
+		return {}
+	if not _path_obstacles_ready:
+		_rasterize_path_obstacles()
+	return path_planner.plan_paths(from_positions, to_positions, avoid_hazards)
 
 func query_explore_direction(agent_pos: Vector3, direction: String) -> Dictionary:
 	"""Get exploration target in a specific direction."""
@@ -583,147 +748,125 @@ func query_exploration_status(agent_pos: Vector3) -> Dictionary:
 ## Backend decision communication
 
 func _setup_backend_communication():
-	"""Initialize HTTP request node for backend communication"""
-	http_request = HTTPRequest.new()
-	http_request.name = "HTTPRequest"
-	http_request.timeout = 30.0
-	add_child(http_request)
-
-func _request_backend_decision():
-	"""Request decision from backend for the first agent (single-agent scenes)"""
-	print("[SceneController] _request_backend_decision called")
-	print("  agents.size() = ", agents.size())
-	print("  waiting_for_decision = ", waiting_for_decision)
-	print("  IPCService exists = ", IPCService != null)
+	"""Connect to IPCService for batched backend decisions"""
 	if IPCService:
-		print("  IPCService.is_connected = ", IPCService.is_connected)
+		# One builder per process so multi-world batches see every agent
+		observation_builder = IPCService.observation_builder
+		IPCService.tick_request_completed.connect(_on_tick_request_completed)
+		IPCService.connection_failed.connect(_on_backend_connection_failed)
+		if IPCService.adaptive_tick_rate:
+			simulation_manager.adaptive_tick_rate = true
+		IPCService.backpressure_changed.connect(simulation_manager.set_backend_pressure)
+	else:
+		observation_builder = ObservationBuilder.new()
 
-	# Only request if we have an agent and not already waiting
+func _request_backend_decision():
+	"""Request decisions for all agents from the backend in one batched /tick call"""
 	if agents.size() == 0:
-		print("  ✗ No agents found, skipping backend request")
+		simulation_manager.notify_backend_ready()
 		return
 
 	if waiting_for_decision:
-		print("  ✗ Already waiting for decision, skipping")
 		return
 
 	# Check if backend is connected
-	if not IPCService or not IPCService.is_connected:
-		print("  ✗ Backend not connected, skipping")
+	if not IPCService or not IPCService.is_backend_connected():
+		simulation_manager.notify_backend_ready()
 		return
 
-	print("  ✓ Sending observation to backend...")
-	waiting_for_decision = true
+	# Write each agent's observation into its native buffer; IPCClient
+	# gathers the buffers into a single request and routes actions back by agent_id
+	var tick: int = simulation_manager.current_tick
+	var agent_count := 0
+	for agent_data in agents:
+		if not agent_data.agent.has_method("get_core_agent"):
+			continue  # e.g. PlayerControlledAgent - not backend driven
+		observation_builder.begin_agent(agent_data.id, tick)
+		_write_backend_observation(observation_builder, agent_data, agent_data.last_observation)
+		var priority := _get_decision_priority(agent_data)
+		if priority != agent_data.get("decision_priority", 1.0):
+			agent_data["decision_priority"] = priority
+			IPCService.set_agent_priority(agent_data.id, priority)
+		agent_count += 1
+
+	if agent_count == 0:
+		simulation_manager.notify_backend_ready()
+		return
 
-	# Build observation for first agent (single-agent scene)
-	var agent_data = agents[0]
-	var observation = _build_observations_for_agent(agent_data)
+	IPCService.send_batch_tick(tick)
+	_execute_pending_actions()  # Decision cache replays are routed synchronously
 
-	# Convert observation to backend format
-	var full_observation = _convert_observation_to_backend_format(agent_data, observation)
+	if IPCService.can_send_tick():
+		# Pipeline has room: keep stepping while the backend works on this tick
+		simulation_manager.notify_backend_ready()
+	else:
+		waiting_for_decision = true
 
-	# Send to backend
-	var json = JSON.stringify(full_observation)
-	var headers = ["Content-Type: application/json"]
-	var url = "http://127.0.0.1:5000/observe"
+func _get_decision_priority(_agent_data: Dictionary) -> float:
+	"""How urgently an agent needs a backend decision this tick (default 1.0)
 
-	var err = http_request.request(url, headers, HTTPClient.METHOD_POST, json)
+	Only matters when IPCService.max_agents_per_tick (or backpressure) caps
+	the request: higher priorities are asked first, and every agent is still
+	asked within max_decision_wait ticks. Override in subclasses, e.g. to
+	favour agents in danger or at contested objectives.
+	"""
+	return 1.0
 
-	if err != OK:
-		push_error("Failed to send observation to backend: %d" % err)
+func _on_tick_request_completed(_tick: int):
+	"""A tick response arrived (its actions are routed by IPCClient) - free the pipeline"""
+	_execute_pending_actions()
+	if waiting_for_decision:
 		waiting_for_decision = false
-		return
+		simulation_manager.notify_backend_ready()
 
-	# Wait for response
-	var response = await http_request.request_completed
-	_on_decision_received(response)
+func _on_backend_connection_failed(_error: String):
+	"""Release the decision slot so the simulation doesn't wait forever"""
+	waiting_for_decision = false
+	simulation_manager.notify_backend_ready()
 
-func _convert_observation_to_backend_format(agent_data: Dictionary, observation: Dictionary) -> Dictionary:
-	"""Convert observation dictionary to backend-compatible format
+func _write_backend_observation(builder: ObservationBuilder, agent_data: Dictionary, observation: Dictionary) -> void:
+	"""Write one agent's backend observation into the builder (begin_agent already called)
 
-	Override this method in subclasses if you need custom observation formatting.
-	Default implementation handles common Vector3 -> [x,y,z] conversions.
+	Override this method in subclasses to add scene-specific entities or fields;
+	call super first, then use builder.add_entity() / builder.set_field().
 	"""
-	var backend_obs = {
-		"agent_id": agent_data.id,
-		"tick": observation.get("tick", simulation_manager.current_tick),
-		"position": [observation.position.x, observation.position.y, observation.position.z] if observation.has("position") and observation.position is Vector3 else observation.get("position", [0, 0, 0]),
-		"health": observation.get("health", 100.0),
-		"max_health": observation.get("max_health", 100.0),
-		"perception_radius": perception_radius,
-		"nearby_resources": [],
-		"nearby_hazards": []
-	}
-
-	# Convert resources if present
-	if observation.has("nearby_resources"):
-		for resource in observation.nearby_resources:
-			var res_dict = {
-				"name": resource.name,
-				"type": resource.type,
-				"distance": resource.distance
-			}
-			# Handle Vector3 position conversion
-			if resource.position is Vector3:
-				res_dict["position"] = [resource.position.x, resource.position.y, resource.position.z]
-			else:
-				res_dict["position"] = resource.position
-			backend_obs.nearby_resources.append(res_dict)
-
-	# Convert hazards if present
-	if observation.has("nearby_hazards"):
-		for hazard in observation.nearby_hazards:
-			var haz_dict = {
-				"name": hazard.name,
-				"type": hazard.type,
-				"distance": hazard.distance
-			}
-			# Handle Vector3 position conversion
-			if hazard.position is Vector3:
-				haz_dict["position"] = [hazard.position.x, hazard.position.y, hazard.position.z]
-			else:
-				haz_dict["position"] = hazard.position
-			backend_obs.nearby_hazards.append(haz_dict)
+	var position = observation.get("position", agent_data.position)
+	builder.set_self(
+		position if position is Vector3 else Vector3.ZERO,
+		observation.get("health", 100.0),
+		observation.get("max_health", 100.0),
+		perception_radius
+	)
+
+	for resource in observation.get("nearby_resources", []):
+		builder.add_entity(ObservationBuilder.KIND_RESOURCE, resource.name, resource.type, resource.position, resource.distance)
+	for hazard in observation.get("nearby_hazards", []):
+		builder.add_entity(ObservationBuilder.KIND_HAZARD, hazard.name, hazard.type, hazard.position, hazard.distance)
 
 	# Add exploration data if tracking is enabled
 	if exploration_enabled and visibility_tracker:
-		var agent_pos = agent_data.position
-		var exploration = get_exploration_summary(agent_pos)
-		backend_obs["exploration"] = exploration
+		builder.set_field("exploration", get_exploration_summary(agent_data.position))
 
 	# Attach pending tool result if available (Issue #71)
 	if pending_tool_results.has(agent_data.id):
-		backend_obs["tool_result"] = pending_tool_results[agent_data.id]
+		builder.set_field("tool_result", pending_tool_results[agent_data.id])
 		pending_tool_results.erase(agent_data.id)
 
-	return backend_obs
-
-func _on_decision_received(response: Array):
-	"""Handle decision response from backend"""
-	waiting_for_decision = false
-
-	var _result_code = response[0]
-	var response_code = response[1]
-	var _response_headers = response[2]
-	var body = response[3]
-
-	# Parse response
-	if response_code == 200:
-		var body_string = body.get_string_from_utf8()
-		var json_parser = JSON.new()
-		var parse_err = json_parser.parse(body_string)
+	if send_agent_memory and agent_data.agent.has_method("get_core_agent"):
+		builder.set_memory(agent_data.agent.get_core_agent(), memory_actions_in_observation)
 
-		if parse_err == OK:
-			var decision = json_parser.get_data()
-			_log_backend_decision(decision)
-		else:
-			push_error("JSON parse error: %s" % json_parser.get_error_message())
-	else:
-		push_error("Backend returned error code: %d" % response_code)
+func _execute_pending_actions():
+	"""Log and execute the actions routed since the last call, in agent order"""
+	if agent_world == null or agent_world.get_pending_action_count() == 0:
+		return
+	for agent_data in agents:
+		if agent_world.has_pending_action(agent_data.slot):
+			_log_backend_decision(agent_data, agent_world.take_pending_action(agent_data.slot))
 
-func _log_backend_decision(decision: Dictionary):
-	"""Log, store, and execute backend decision"""
+func _log_backend_decision(agent_data: Dictionary, decision: Dictionary):
+	"""Log, store, and execute backend decision for one agent"""
 	# Add timestamp and tick
+	decision["agent_id"] = agent_data.id
 	decision["tick"] = simulation_manager.current_tick
 	decision["timestamp"] = Time.get_ticks_msec()
 
@@ -731,10 +874,11 @@ func _log_backend_decision(decision: Dictionary):
 	backend_decisions.append(decision)
 
 	# Log to console
-	print("[Backend Decision] Tick %d: %s - %s" % [
+	print("[Backend Decision] Tick %d: %s: %s - %s" % [
 		decision.tick,
-		decision.tool,
-		decision.reasoning
+		agent_data.id,
+		decision.get("tool", "idle"),
+		decision.get("reasoning", "")
 	])
 
 	# Log params if present
@@ -742,19 +886,14 @@ func _log_backend_decision(decision: Dictionary):
 		print("  Params: %s" % decision.params)
 
 	# Execute decision
-	_execute_backend_decision(decision)
+	_execute_backend_decision(agent_data, decision)
 
-func _execute_backend_decision(decision: Dictionary):
-	"""Execute backend decision by calling agent tool
+func _execute_backend_decision(agent_data: Dictionary, decision: Dictionary):
+	"""Execute backend decision by calling the agent's tool
 
 	Override this in subclass to add custom execution logic or filtering.
-	Return false to skip execution (e.g., if scene handles movement differently).
 	"""
-	if agents.size() == 0:
-		return
-
-	var agent_data = agents[0]
-	var tool_name = decision.tool
+	var tool_name = decision.get("tool", "idle")
 	var params = decision.get("params", {})
 
 	# Skip idle tool (no action needed)
@@ -773,19 +912,36 @@ func _execute_backend_decision(decision: Dictionary):
 
 	# Execute tool via SimpleAgent
 	print("  → Executing tool: %s" % tool_name)
-	var result = agent_data.agent.call_tool(tool_name, params)
 	decisions_executed += 1
 
-	# For synchronous tools (not move_to/explore_direction which complete async),
-	# store the result immediately (Issue #71)
-	if tool_name != "move_to" and tool_name != "explore_direction":
-		pending_tool_results[agent_data.id] = {
-			"tool": tool_name,
-			"success": result.get("success", false),
-			"result": result,
-			"error": result.get("error", ""),
-			"duration_ticks": 0
-		}
+	# move_to/explore_direction report completion via tool_completed (Issue #71)
+	var completes_on_arrival = tool_name == "move_to" or tool_name == "explore_direction"
+	if completes_on_arrival or not agent_data.agent.has_method("call_tool_async"):
+		var result = agent_data.agent.call_tool(tool_name, params)
+		if not completes_on_arrival:
+			_store_tool_result(agent_data.id, tool_name, result, 0)
+		return
+
+	# Remote tools resolve later; record the real result, not a placeholder
+	var future: ToolFuture = agent_data.agent.call_tool_async(tool_name, params)
+	if future.is_done():
+		_store_tool_result(agent_data.id, tool_name, future.get_result(), 0)
+		return
+
+	var start_tick = simulation_manager.current_tick
+	future.completed.connect(func(response: Dictionary):
+		_store_tool_result(agent_data.id, tool_name, response, simulation_manager.current_tick - start_tick)
+	, CONNECT_ONE_SHOT)
+
+func _store_tool_result(agent_id: String, tool_name: String, result: Dictionary, duration_ticks: int):
+	"""Queue a tool result for the agent's next observation (Issue #71)"""
+	pending_tool_results[agent_id] = {
+		"tool": tool_name,
+		"success": result.get("success", false),
+		"result": result,
+		"error": result.get("error", ""),
+		"duration_ticks": duration_ticks
+	}
 
 func reset_backend_decisions():
 	"""Reset backend decision tracking - call this in scene reset handlers"""
@@ -794,3 +950,68 @@ func reset_backend_decisions():
 	decisions_executed = 0
 	decisions_skipped = 0
 	pending_tool_results.clear()
+
+## Snapshots and rollback
+
+func _setup_snapshots():
+	"""Register agent and scene state with SimulationManager snapshots"""
+	simulation_manager.add_snapshot_source("agents", _capture_agent_state, _restore_agent_state)
+	simulation_manager.add_snapshot_source("scene", _capture_scene_state, _restore_scene_state)
+	if visibility_tracker:
+		simulation_manager.add_snapshot_source("exploration", _capture_exploration_state, _restore_exploration_state)
+	simulation_manager.snapshot_restored.connect(_on_snapshot_restored)
+	initial_snapshot = simulation_manager.snapshot()
+
+func reset_to_initial_state() -> bool:
+	"""Fast episode reset: roll back to the state captured after scene setup"""
+	return simulation_manager.restore(initial_snapshot)
+
+func _capture_agent_state() -> Dictionary:
+	agent_world.sync_from_nodes(spatial_index)
+	var per_agent := {}
+	for agent_data in agents:
+		var state: Dictionary = agent_data.agent.get_snapshot_state() if agent_data.agent.has_method("get_snapshot_state") else {}
+		if not state.is_empty():
+			per_agent[agent_data.id] = state
+	return {"world": agent_world.capture_state(), "agents": per_agent}
+
+func _restore_agent_state(state: Dictionary):
+	agent_world.restore_state(state.get("world", PackedByteArray()), spatial_index)
+	var positions := agent_world.get_positions()
+	var per_agent: Dictionary = state.get("agents", {})
+	for agent_data in agents:
+		agent_data.position = positions[agent_data.slot]
+		if agent_data.agent.has_method("apply_snapshot_state"):
+			agent_data.agent.apply_snapshot_state(per_agent.get(agent_data.id, {}))
+
+func _capture_exploration_state() -> PackedByteArray:
+	return visibility_tracker.get_snapshot_state()
+
+func _restore_exploration_state(state: PackedByteArray):
+	visibility_tracker.apply_snapshot_state(state)
+
+func _capture_scene_state() -> Dictionary:
+	"""Override: add scene state (resources, hazards, scores) and call super
+
+	Values are serialized with var_to_bytes, so keep node references out;
+	store names or indices and resolve them again in _restore_scene_state().
+	"""
+	return {
+		"scene_completed": scene_completed,
+		"decisions_executed": decisions_executed,
+		"decisions_skipped": decisions_skipped
+	}
+
+func _restore_scene_state(state: Dictionary):
+	"""Override: restore what _capture_scene_state() added and call super"""
+	scene_completed = state.get("scene_completed", false)
+	decisions_executed = state.get("decisions_executed", 0)
+	decisions_skipped = state.get("decisions_skipped", 0)
+
+func _on_snapshot_restored(tick: int):
+	# Decisions and tool results in flight belong to the abandoned branch
+	waiting_for_decision = false
+	pending_tool_results.clear()
+	_last_observation_cache.clear()
+	if IPCService:
+		IPCService.advance_to_tick(tick)
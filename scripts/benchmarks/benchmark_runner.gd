@@ -0,0 +1,201 @@
+extends Node
+## Headless episode benchmarks for the GDExtension
+##
+## Runs each scenario with each agent count for a fixed number of ticks from a
+## fixed seed, against whatever backend IPCService is connected to (normally
+## python/benchmarks/stub_backend.py), then writes one JSON report.
+## Agents are cloned from (or trimmed to) the scene's own agents before the
+## scene enters the tree, so every case runs the real scene controller.
+##
+## Usage:
+##   godot --headless --path . res://scenes/benchmarks/benchmark_runner.tscn -- \
+##       --scenarios=foraging,crafting_chain,team_capture --agents=1,10,100 \
+##       --ticks=300 --seed=42 --out=user://benchmark_results.json
+## or, with the stub backend started for you: cmake --build <dir> --target benchmark
+
+const SCENARIOS := {
+	"foraging": "res://scenes/foraging.tscn",
+	"crafting_chain": "res://scenes/crafting_chain.tscn",
+	"team_capture": "res://scenes/team_capture.tscn",
+}
+const AGENT_PARENTS := ["Agents", "TeamBlue", "TeamRed", "TeamGreen", "TeamYellow"]
+const SCHEMA_VERSION := 2  # 2: peak memory is sampled per case, not process-wide
+
+var scenarios: PackedStringArray = PackedStringArray(["foraging", "crafting_chain", "team_capture"])
+var agent_counts: PackedInt32Array = PackedInt32Array([1, 10, 100])
+var ticks_per_episode := 300
+var warmup_ticks := 20  # Stepped before measuring, so connection setup and first-tick allocations don't count
+var master_seed := 42
+var output_path := "user://benchmark_results.json"
+var label := ""  # Free-form tag for the report, e.g. a commit hash
+var backend_timeout := 10.0  # Seconds to wait for IPCService to connect
+
+func _ready():
+	_apply_command_line()
+	Engine.max_fps = 0
+	ArenaLog.set_level(ArenaLog.LEVEL_WARN)
+
+	if not await _wait_for_backend():
+		push_error("BenchmarkRunner: backend not reachable at %s" % IPCService.server_url)
+		get_tree().quit(2)
+		return
+
+	var cases := []
+	for scenario in scenarios:
+		for agent_count in agent_counts:
+			cases.append(await _run_case(scenario, agent_count))
+
+	var report := {
+		"schema_version": SCHEMA_VERSION,
+		"label": label,
+		"engine": Engine.get_version_info().get("string", ""),
+		"seed": master_seed,
+		"ticks_per_episode": ticks_per_episode,
+		"warmup_ticks": warmup_ticks,
+		"pipeline_depth": IPCService.pipeline_depth,
+		"cases": cases,
+	}
+	var json := JSON.stringify(report, "  ")
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file:
+		file.store_string(json)
+		file.close()
+	else:
+		push_error("BenchmarkRunner: cannot write %s" % output_path)
+	print("BENCHMARK_REPORT " + JSON.stringify(report))
+	get_tree().quit(0)
+
+func _apply_command_line():
+	"""Read benchmark settings from user command-line args (after --)"""
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--scenarios="):
+			scenarios = arg.trim_prefix("--scenarios=").split(",", false)
+		elif arg.begins_with("--agents="):
+			agent_counts = PackedInt32Array()
+			for count in arg.trim_prefix("--agents=").split(",", false):
+				agent_counts.append(int(count))
+		elif arg.begins_with("--ticks="):
+			ticks_per_episode = int(arg.trim_prefix("--ticks="))
+		elif arg.begins_with("--warmup="):
+			warmup_ticks = int(arg.trim_prefix("--warmup="))
+		elif arg.begins_with("--seed="):
+			master_seed = int(arg.trim_prefix("--seed="))
+		elif arg.begins_with("--out="):
+			output_path = arg.trim_prefix("--out=")
+		elif arg.begins_with("--label="):
+			label = arg.trim_prefix("--label=")
+		elif arg.begins_with("--backend-timeout="):
+			backend_timeout = float(arg.trim_prefix("--backend-timeout="))
+
+func _wait_for_backend() -> bool:
+	var deadline := Time.get_ticks_msec() + int(backend_timeout * 1000.0)
+	while not IPCService.is_backend_connected():
+		if Time.get_ticks_msec() > deadline:
+			return false
+		await get_tree().process_frame
+	return true
+
+func _run_case(scenario: String, agent_count: int) -> Dictionary:
+	"""One fixed-seed episode; returns its measurements"""
+	var result := {"scenario": scenario, "agents": agent_count}
+	if not SCENARIOS.has(scenario):
+		result["error"] = "unknown scenario"
+		return result
+
+	var scene: Node = load(SCENARIOS[scenario]).instantiate()
+	_scale_agents(scene, agent_count)
+	add_child(scene)
+	await get_tree().process_frame  # Let the controller finish _ready
+
+	var simulation: SimulationManager = scene.simulation_manager
+	simulation.tick_mode = SimulationManager.TICK_MODE_MANUAL
+	simulation.set_seed(master_seed)
+	simulation.start_simulation()
+
+	for i in warmup_ticks:
+		await _step(scene)
+
+	IPCService.perf_monitor.reset_perf_stats()
+	# OS.get_static_memory_peak_usage() is process-wide and never resets, so
+	# it would carry earlier cases' peaks; sample this case's high-water mark
+	var memory_before := OS.get_static_memory_usage()
+	var memory_peak := memory_before
+	var tick_usec := PackedInt64Array()
+	tick_usec.resize(ticks_per_episode)
+	var started := Time.get_ticks_usec()
+	for i in ticks_per_episode:
+		tick_usec[i] = await _step(scene)
+		memory_peak = maxi(memory_peak, OS.get_static_memory_usage())
+	var elapsed := float(Time.get_ticks_usec() - started) / 1000000.0
+
+	simulation.stop_simulation()
+	var stats: Dictionary = IPCService.get_perf_stats()
+	var counters: Dictionary = stats.get("counters", {})
+	tick_usec.sort()
+
+	result["ticks"] = ticks_per_episode
+	result["seconds"] = elapsed
+	result["ticks_per_sec"] = ticks_per_episode / elapsed if elapsed > 0.0 else 0.0
+	result["tick_ms_p50"] = _percentile(tick_usec, 0.50) / 1000.0
+	result["tick_ms_p99"] = _percentile(tick_usec, 0.99) / 1000.0
+	result["ipc_bytes_per_tick"] = float(counters.get("bytes_sent", 0)) / ticks_per_episode
+	result["tick_requests"] = counters.get("tick_requests", 0)
+	result["ticks_skipped"] = counters.get("ticks_skipped", 0)
+	result["static_memory_bytes"] = OS.get_static_memory_usage()
+	result["static_memory_growth_bytes"] = OS.get_static_memory_usage() - memory_before
+	result["peak_static_memory_bytes"] = memory_peak  # Sampled after each measured tick
+	result["peak_static_memory_growth_bytes"] = memory_peak - memory_before
+	result["phases"] = stats.get("phases", {})
+
+	scene.queue_free()
+	await get_tree().process_frame
+	return result
+
+func _step(scene: Node) -> int:
+	"""Advance one tick once the decision pipeline has room; returns the step's duration in usec"""
+	while scene.waiting_for_decision:
+		await get_tree().process_frame
+	var start := Time.get_ticks_usec()
+	scene.simulation_manager.step_simulation()
+	var duration := Time.get_ticks_usec() - start
+	await get_tree().process_frame  # Physics, movement and IPC polling run between ticks
+	return duration
+
+func _percentile(sorted_values: PackedInt64Array, fraction: float) -> float:
+	if sorted_values.is_empty():
+		return 0.0
+	var index := clampi(int(ceil(fraction * sorted_values.size())) - 1, 0, sorted_values.size() - 1)
+	return float(sorted_values[index])
+
+func _scale_agents(scene: Node, agent_count: int):
+	"""Clone or remove agents (round-robin over the scene's agent groups) until agent_count remain"""
+	var templates: Array[Node] = []
+	for parent_name in AGENT_PARENTS:
+		var parent := scene.get_node_or_null(parent_name)
+		if parent:
+			for child in parent.get_children():
+				if child.has_method("perceive") and child.has_method("call_tool"):
+					templates.append(child)
+	if templates.is_empty():
+		return
+
+	# Trim from the back so team scenes keep one agent per team as long as possible
+	while templates.size() > agent_count:
+		var extra: Node = templates.pop_back()
+		extra.get_parent().remove_child(extra)
+		extra.free()
+
+	# Clones spread out on a seeded ring around their template
+	var rng := RandomStream.new()
+	rng.set_seed(master_seed)
+	var originals := templates.size()
+	for i in range(originals, agent_count):
+		var template: Node = templates[i % originals]
+		var clone: Node = template.duplicate()
+		clone.name = "%s_bench%03d" % [template.name, i]
+		clone.agent_id = "%s_bench%03d" % [template.agent_id if template.agent_id != "" else str(template.name), i]
+		if clone is Node3D:
+			var angle := rng.randf() * TAU
+			var radius := 2.0 + rng.randf() * 6.0
+			clone.position = template.position + Vector3(cos(angle) * radius, 0.0, sin(angle) * radius)
+		template.get_parent().add_child(clone)
@@ -467,3 +467,43 @@ func _reset_scene():
 			resource.node.visible = true
 
 	print("✓ Scene reset!")
+
+func _capture_scene_state() -> Dictionary:
+	"""Snapshot source: crafting metrics, inventory and collected resources"""
+	var state = super._capture_scene_state()
+	var collected = PackedByteArray()
+	collected.resize(base_resources.size())
+	for i in range(base_resources.size()):
+		collected[i] = 1 if base_resources[i].collected else 0
+	state["resources"] = collected
+	state["items_crafted"] = items_crafted
+	state["total_items_crafted"] = total_items_crafted
+	state["resources_collected"] = resources_collected
+	state["resources_used"] = resources_used
+	state["resources_wasted"] = resources_wasted
+	state["crafting_attempts"] = crafting_attempts
+	state["successful_crafts"] = successful_crafts
+	state["total_crafting_time"] = total_crafting_time
+	state["agent_inventory"] = agent_inventory
+	state["current_craft"] = current_craft
+	return state
+
+func _restore_scene_state(state: Dictionary):
+	super._restore_scene_state(state)
+	var collected: PackedByteArray = state.get("resources", PackedByteArray())
+	for i in range(min(collected.size(), base_resources.size())):
+		var resource = base_resources[i]
+		resource.collected = collected[i] != 0
+		if resource.node != null:
+			resource.node.visible = not resource.collected
+	items_crafted = state.get("items_crafted", {})
+	total_items_crafted = state.get("total_items_crafted", 0)
+	resources_collected = state.get("resources_collected", 0)
+	resources_used = state.get("resources_used", 0)
+	resources_wasted = state.get("resources_wasted", 0)
+	crafting_attempts = state.get("crafting_attempts", 0)
+	successful_crafts = state.get("successful_crafts", 0)
+	total_crafting_time = state.get("total_crafting_time", 0.0)
+	agent_inventory = state.get("agent_inventory", {})
+	current_craft = state.get("current_craft", null)
+
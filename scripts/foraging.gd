@@ -62,6 +62,7 @@ func _initialize_scene():
 	active_resources.clear()
 	active_hazards.clear()
 	active_stations.clear()
+	clear_spatial_entities(SPATIAL_RESOURCE | SPATIAL_HAZARD | SPATIAL_STATION)
 
 	# Collect all resources
 	var resources_node = $Resources
@@ -99,6 +100,14 @@ func _initialize_scene():
 					"node": child
 				})
 
+	# Register everything perceivable with the spatial index
+	for resource in active_resources:
+		register_spatial_entity(resource, SPATIAL_RESOURCE)
+	for hazard in active_hazards:
+		register_spatial_entity(hazard, SPATIAL_HAZARD)
+	for station in active_stations:
+		register_spatial_entity(station, SPATIAL_STATION)
+
 func _get_resource_type(resource_name: String) -> String:
 	"""Extract resource type from name"""
 	if "Berry" in resource_name or "Apple" in resource_name:
@@ -176,55 +185,31 @@ func _build_observations_for_agent(agent_data: Dictionary) -> Dictionary:
 	var agent_pos = agent_data.position
 	var agent_node = agent_data.agent
 
-	# Find nearby resources (with line-of-sight check)
-	var nearby_resources = []
-	for resource in active_resources:
-		if not resource.collected:
-			var dist = agent_pos.distance_to(resource.position)
-			# Skip if beyond perception radius
-			if dist > perception_radius:
-				continue
-			# Check line of sight (uses base class method)
-			if not has_line_of_sight(agent_node, agent_pos, resource.position, resource.node):
-				continue
-			nearby_resources.append({
-				"name": resource.name,
-				"type": resource.type,
-				"position": resource.position,
-				"distance": dist
-			})
+	# Gather everything in perception range, then batch the line-of-sight checks
+	var candidates = query_nearby(agent_pos, SPATIAL_RESOURCE | SPATIAL_HAZARD | SPATIAL_STATION)
+	candidates = candidates.filter(
+		func(hit): return hit.category != SPATIAL_RESOURCE or not hit.entity.collected
+	)
 
-	# Find nearby hazards (with line-of-sight check)
+	# Split visible objects by kind (each list is nearest first)
+	var nearby_resources = []
 	var nearby_hazards = []
-	for hazard in active_hazards:
-		var dist = agent_pos.distance_to(hazard.position)
-		# Skip if beyond perception radius
-		if dist > perception_radius:
-			continue
-		# Check line of sight (uses base class method)
-		if not has_line_of_sight(agent_node, agent_pos, hazard.position, hazard.node):
-			continue
-		nearby_hazards.append({
-			"name": hazard.name,
-			"type": hazard.type,
-			"position": hazard.position,
-			"distance": dist
-		})
-
-	# Find nearby stations (with line-of-sight check)
 	var nearby_stations = []
-	for station in active_stations:
-		var dist = agent_pos.distance_to(station.position)
-		if dist > perception_radius:
-			continue
-		if not has_line_of_sight(agent_node, agent_pos, station.position, station.node):
-			continue
-		nearby_stations.append({
-			"name": station.name,
-			"type": station.type,
-			"position": station.position,
-			"distance": dist
-		})
+	for hit in filter_line_of_sight(agent_data, candidates):
+		var entity = hit.entity
+		var entry = {
+			"name": entity.name,
+			"type": entity.type,
+			"position": entity.position,
+			"distance": hit.distance
+		}
+		match hit.category:
+			SPATIAL_RESOURCE:
+				nearby_resources.append(entry)
+			SPATIAL_HAZARD:
+				nearby_hazards.append(entry)
+			SPATIAL_STATION:
+				nearby_stations.append(entry)
 
 	# Build observation dictionary
 	return {
@@ -242,35 +227,20 @@ func _build_observations_for_agent(agent_data: Dictionary) -> Dictionary:
 		"tick": simulation_manager.current_tick
 	}
 
+func _get_decision_priority(agent_data: Dictionary) -> float:
+	"""Agents with a hazard in view decide first"""
+	return 2.0 if not agent_data.last_observation.get("nearby_hazards", []).is_empty() else 1.0
+
 func _on_agent_tool_completed(agent_data: Dictionary, tool_name: String, response: Dictionary):
 	"""Handle tool execution completion from agent"""
 	print("Foraging: Agent '%s' completed tool '%s': %s" % [agent_data.id, tool_name, response])
 
-func _convert_observation_to_backend_format(agent_data: Dictionary, observation: Dictionary) -> Dictionary:
+func _write_backend_observation(builder: ObservationBuilder, agent_data: Dictionary, observation: Dictionary) -> void:
 	"""Override to include crafting data in backend observations"""
-	var backend_obs = super._convert_observation_to_backend_format(agent_data, observation)
-
-	# Add stations
-	if observation.has("nearby_stations"):
-		var stations_list = []
-		for station in observation.nearby_stations:
-			var st_dict = {
-				"name": station.name,
-				"type": station.type,
-				"distance": station.distance
-			}
-			if station.position is Vector3:
-				st_dict["position"] = [station.position.x, station.position.y, station.position.z]
-			else:
-				st_dict["position"] = station.position
-			stations_list.append(st_dict)
-		backend_obs["nearby_stations"] = stations_list
+	super._write_backend_observation(builder, agent_data, observation)
 
-	# Add inventory and recipes under "custom" (not top-level "inventory"
-	# which Observation.from_dict expects as list[ItemInfo], not a dict)
-	if not backend_obs.has("custom"):
-		backend_obs["custom"] = {}
-	backend_obs["custom"]["inventory"] = observation.get("inventory", {})
+	for station in observation.get("nearby_stations", []):
+		builder.add_entity(ObservationBuilder.KIND_STATION, station.name, station.type, station.position, station.distance)
 
 	# Add recipes (static data, always sent so agent has complete info)
 	var recipes_for_backend = {}
@@ -280,30 +250,33 @@ func _convert_observation_to_backend_format(agent_data: Dictionary, observation:
 			"inputs": recipe.inputs,
 			"station": recipe.station
 		}
-	backend_obs["custom"]["recipes"] = recipes_for_backend
 
-	return backend_obs
+	# Inventory and recipes go under "custom" (not top-level "inventory"
+	# which Observation.from_dict expects as list[ItemInfo], not a dict)
+	builder.set_field("custom", {
+		"inventory": observation.get("inventory", {}),
+		"recipes": recipes_for_backend
+	})
 
-func _execute_backend_decision(decision: Dictionary):
+func _execute_backend_decision(agent_data: Dictionary, decision: Dictionary):
 	"""Override to handle craft_item tool locally"""
-	if decision.tool == "craft_item":
+	if decision.get("tool", "") == "craft_item":
 		var recipe_name = decision.get("params", {}).get("recipe", "")
 		var result = craft_item(recipe_name)
 		print("  Craft result: %s" % str(result))
 		decisions_executed += 1
 		# Store craft result for next observation (Issue #71)
-		if agents.size() > 0:
-			pending_tool_results[agents[0].id] = {
-				"tool": "craft_item",
-				"success": result.get("success", false),
-				"result": result,
-				"error": result.get("error", ""),
-				"duration_ticks": 0
-			}
+		pending_tool_results[agent_data.id] = {
+			"tool": "craft_item",
+			"success": result.get("success", false),
+			"result": result,
+			"error": result.get("error", ""),
+			"duration_ticks": 0
+		}
 		return
 
 	# All other tools: use default behavior
-	super._execute_backend_decision(decision)
+	super._execute_backend_decision(agent_data, decision)
 
 func _connect_agent_damage_signals():
 	"""Connect to agent damage_taken signals for metrics tracking"""
@@ -596,3 +569,37 @@ func _reset_scene():
 			resource.node.visible = true
 
 	print("✓ Scene reset!")
+
+func _capture_scene_state() -> Dictionary:
+	"""Snapshot source: metrics, inventory and which resources are collected"""
+	var state = super._capture_scene_state()
+	var collected = PackedByteArray()
+	collected.resize(active_resources.size())
+	for i in range(active_resources.size()):
+		collected[i] = 1 if active_resources[i].collected else 0
+	state["resources"] = collected
+	state["resources_collected"] = resources_collected
+	state["damage_taken"] = damage_taken
+	state["distance_traveled"] = distance_traveled
+	state["last_position"] = last_position
+	state["agent_inventory"] = agent_inventory
+	state["items_crafted"] = items_crafted
+	state["total_items_crafted"] = total_items_crafted
+	return state
+
+func _restore_scene_state(state: Dictionary):
+	super._restore_scene_state(state)
+	var collected: PackedByteArray = state.get("resources", PackedByteArray())
+	for i in range(min(collected.size(), active_resources.size())):
+		var resource = active_resources[i]
+		resource.collected = collected[i] != 0
+		if resource.node != null:
+			resource.node.visible = not resource.collected
+	resources_collected = state.get("resources_collected", 0)
+	damage_taken = state.get("damage_taken", 0.0)
+	distance_traveled = state.get("distance_traveled", 0.0)
+	last_position = state.get("last_position", Vector3.ZERO)
+	agent_inventory = state.get("agent_inventory", {})
+	items_crafted = state.get("items_crafted", {})
+	total_items_crafted = state.get("total_items_crafted", 0)
+
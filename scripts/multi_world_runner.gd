@@ -0,0 +1,33 @@
+extends WorldHost
+## Runs N isolated copies of a scene in one process, sharing one backend connection
+##
+## Every world gets its own physics space, SimulationManager and EventBus; the
+## host steps them in lockstep and sends one batched /tick for all agents.
+## Agent IDs are prefixed with the world ID ("w0/", "w1/", ...).
+##
+## Usage (headless evals):
+##   godot --headless res://scenes/multi_world.tscn -- --worlds=16 --seed=42
+
+@export var auto_start: bool = true
+
+func _ready():
+	_apply_command_line()
+
+	if IPCService:
+		set_ipc_client(IPCService.ipc_client)
+
+	worlds_spawned.connect(func(count: int): print("MultiWorldRunner: %d world(s) ready" % count))
+	spawn_worlds()
+
+	if auto_start:
+		start()
+
+func _apply_command_line():
+	"""Override world_count / master_seed / tick_rate from user args (after --)"""
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--worlds="):
+			world_count = int(arg.trim_prefix("--worlds="))
+		elif arg.begins_with("--seed="):
+			master_seed = int(arg.trim_prefix("--seed="))
+		elif arg.begins_with("--tick-rate="):
+			tick_rate = float(arg.trim_prefix("--tick-rate="))
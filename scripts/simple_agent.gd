@@ -14,8 +14,10 @@ extends BaseAgent
 ##   agent.agent_id = "foraging_agent_001"  # Must match Python registration
 ##   add_child(agent)
 ##   agent.call_tool("move_to", {"target_position": [10, 0, 5]})
+##   var future = agent.call_tool_async("get_inventory")
 
 signal tick_completed(response: Dictionary)
+signal action_received(action: Dictionary)
 
 @export var auto_connect: bool = true
 @export var move_speed: float = 5.0  # Units per second
@@ -48,6 +50,7 @@ func _ready():
 	_cpp_agent.name = "AgentCore"
 	_cpp_agent.set_agent_id(agent_id)
 	add_child(_cpp_agent)
+	_cpp_agent.action_received.connect(_on_core_action_received)
 
 	if auto_connect:
 		_connect_to_services()
@@ -63,6 +66,7 @@ func _connect_to_services():
 	if IPCService:
 		IPCService.tool_response.connect(_on_tool_response)
 		IPCService.tick_response.connect(_on_tick_response)
+		IPCService.register_agent(_cpp_agent)
 		print("SimpleAgent '", agent_id, "': Connected to IPCService")
 	else:
 		push_error("SimpleAgent: IPCService not found!")
@@ -74,108 +78,134 @@ func _connect_to_services():
 func call_tool(tool_name: String, parameters: Dictionary = {}) -> Dictionary:
 	"""
 	Execute a tool for this agent using the global ToolRegistryService.
-	Returns immediately with a pending status - actual response comes via signal.
+	Engine-side tools (movement, navigation queries, crafting) run locally
+	through the _tool_* methods below and return their result immediately;
+	runtime tools return {success: false, pending: true, request_id} and
+	respond via signal; use call_tool_async() to wait for their result.
 	"""
-	print("[SimpleAgent] ==== call_tool START ====")
-	print("[SimpleAgent] Agent ID: ", agent_id)
-	print("[SimpleAgent] Tool: ", tool_name)
-	print("[SimpleAgent] Parameters: ", parameters)
-	print("[SimpleAgent] Current position: ", global_position)
-	print("[SimpleAgent] Current _is_moving: ", _is_moving)
-
 	if not ToolRegistryService:
 		push_error("SimpleAgent: ToolRegistryService not found!")
 		return {"success": false, "error": "ToolRegistryService not available"}
 
-	# Handle movement locally
-	if tool_name == "move_to" and parameters.has("target_position"):
-		var target = parameters.target_position
-		print("[SimpleAgent] move_to detected! Target value: ", target, " type: ", typeof(target))
-		# Convert array to Vector3 if needed
-		if target is Array and target.size() >= 3:
-			_target_position = Vector3(target[0], target[1], target[2])
-			print("[SimpleAgent] ✓ Converted array to Vector3: ", _target_position)
-		elif target is Vector3:
-			_target_position = target
-			print("[SimpleAgent] ✓ Using Vector3 directly: ", _target_position)
-		else:
-			print("[SimpleAgent] ✗ Invalid target_position format!")
-			return {"success": false, "error": "Invalid target_position"}
-
-		_movement_speed = parameters.get("speed", 1.0)
-		_is_moving = true
-		_movement_start_tick = _get_current_tick()
-		_position_samples.clear()
-		_stuck_check_timer = 0
-		_current_move_tool = "move_to"
-		print("[SimpleAgent] ✓ Movement configured:")
-		print("[SimpleAgent]   - _target_position: ", _target_position)
-		print("[SimpleAgent]   - _movement_speed: ", _movement_speed)
-		print("[SimpleAgent]   - _is_moving: ", _is_moving)
-		print("[SimpleAgent]   - Distance to target: ", global_position.distance_to(_target_position))
-
-	# Handle navigation query tools locally (they need Godot data)
-	if tool_name == "plan_path":
-		var scene_controller = _get_scene_controller()
-		if scene_controller:
-			var target = parameters.get("target_position", [0, 0, 0])
-			var target_vec = Vector3(target[0], target[1], target[2]) if target is Array else target
-			var avoid = parameters.get("avoid_hazards", true)
-			var path_result = scene_controller.query_plan_path(global_position, target_vec, avoid)
-			print("[SimpleAgent] plan_path result: ", path_result)
-			return path_result
-		return {"success": false, "error": "No scene controller"}
+	return ToolRegistryService.execute_tool(agent_id, tool_name, parameters, self)
 
-	if tool_name == "explore_direction":
-		var scene_controller = _get_scene_controller()
-		if scene_controller:
-			var direction = parameters.get("direction", "north")
-			var explore_result = scene_controller.query_explore_direction(global_position, direction)
-			print("[SimpleAgent] explore_direction result: ", explore_result)
-			# Actually move toward the exploration target
-			if explore_result.get("success", false) and explore_result.has("target_position"):
-				var target = explore_result.target_position
-				if target is Vector3:
-					_target_position = target
-				elif target is Array and target.size() >= 3:
-					_target_position = Vector3(target[0], target[1], target[2])
-				_is_moving = true
-				_movement_start_tick = _get_current_tick()
-				_position_samples.clear()
-				_stuck_check_timer = 0
-				_current_move_tool = "explore_direction"
-				print("[SimpleAgent] ✓ Exploring %s, moving to: %s" % [direction, _target_position])
-			return explore_result
-		return {"success": false, "error": "No scene controller"}
+func call_tool_async(tool_name: String, parameters: Dictionary = {}) -> ToolFuture:
+	"""
+	Execute a tool and return a ToolFuture carrying its actual result.
+	Usage: if not future.is_done(): await future.completed
+	"""
+	if not ToolRegistryService:
+		push_error("SimpleAgent: ToolRegistryService not found!")
+		return ToolFuture.make_resolved(tool_name, agent_id, {"success": false, "error": "ToolRegistryService not available"})
 
-	if tool_name == "get_exploration_status":
-		var scene_controller = _get_scene_controller()
-		if scene_controller:
-			var status_result = scene_controller.query_exploration_status(global_position)
-			print("[SimpleAgent] get_exploration_status result: ", status_result)
-			return status_result
-		return {"success": false, "error": "No scene controller"}
+	return ToolRegistryService.call_tool(agent_id, tool_name, parameters, self)
 
-	# Handle crafting tools via scene controller
-	if tool_name == "craft_item":
-		var scene_controller = _get_scene_controller()
-		if scene_controller and scene_controller.has_method("craft_item"):
-			var recipe = parameters.get("recipe", "")
-			var craft_result = scene_controller.craft_item(recipe)
-			print("[SimpleAgent] craft_item result: ", craft_result)
-			return craft_result
-		return {"success": false, "error": "Scene does not support crafting"}
+# Local tool handlers, dispatched by ToolRegistryService without an IPC round-trip
+
+func _tool_move_to(parameters: Dictionary) -> Dictionary:
+	var target = parameters.get("target_position")
+	if target is Array and target.size() >= 3:
+		_start_movement(Vector3(target[0], target[1], target[2]), "move_to")
+	elif target is Vector3:
+		_start_movement(target, "move_to")
+	else:
+		return {"success": false, "error": "Invalid target_position"}
+
+	_movement_speed = parameters.get("speed", 1.0)
+	return {
+		"success": true,
+		"target_position": [_target_position.x, _target_position.y, _target_position.z],
+		"distance": global_position.distance_to(_target_position)
+	}
+
+func _tool_stop_movement(_parameters: Dictionary) -> Dictionary:
+	if _is_moving:
+		_is_moving = false
+		velocity = Vector3.ZERO
+		tool_completed.emit(_current_move_tool, {
+			"success": false,
+			"error": "stopped",
+			"final_position": [global_position.x, global_position.y, global_position.z],
+			"target_position": [_target_position.x, _target_position.y, _target_position.z],
+			"duration_ticks": _get_current_tick() - _movement_start_tick
+		})
+	return {"success": true, "position": [global_position.x, global_position.y, global_position.z]}
 
-	if tool_name == "get_recipes":
-		var scene_controller = _get_scene_controller()
-		if scene_controller and "RECIPES" in scene_controller:
-			return {"success": true, "recipes": scene_controller.RECIPES}
-		return {"success": false, "error": "No recipes available"}
+func _tool_plan_path(parameters: Dictionary) -> Dictionary:
+	var scene_controller = _get_scene_controller()
+	if not scene_controller:
+		return {"success": false, "error": "No scene controller"}
+	var target = parameters.get("target_position", [0, 0, 0])
+	var target_vec = Vector3(target[0], target[1], target[2]) if target is Array else target
+	var avoid = parameters.get("avoid_hazards", true)
+	return scene_controller.query_plan_path(global_position, target_vec, avoid)
+
+func _tool_explore_direction(parameters: Dictionary) -> Dictionary:
+	var scene_controller = _get_scene_controller()
+	if not scene_controller:
+		return {"success": false, "error": "No scene controller"}
+	var direction = parameters.get("direction", "north")
+	var explore_result = scene_controller.query_explore_direction(global_position, direction)
+	# Actually move toward the exploration target
+	if explore_result.get("success", false) and explore_result.has("target_position"):
+		var target = explore_result.target_position
+		if target is Vector3:
+			_start_movement(target, "explore_direction")
+		elif target is Array and target.size() >= 3:
+			_start_movement(Vector3(target[0], target[1], target[2]), "explore_direction")
+		print("[SimpleAgent] Exploring %s, moving to: %s" % [direction, _target_position])
+	return explore_result
+
+func _tool_get_exploration_status(_parameters: Dictionary) -> Dictionary:
+	var scene_controller = _get_scene_controller()
+	if not scene_controller:
+		return {"success": false, "error": "No scene controller"}
+	return scene_controller.query_exploration_status(global_position)
 
-	var result = ToolRegistryService.execute_tool(agent_id, tool_name, parameters)
-	print("[SimpleAgent] ToolRegistryService.execute_tool returned: ", result)
-	print("[SimpleAgent] ==== call_tool END ====")
-	return result
+func _tool_craft_item(parameters: Dictionary) -> Dictionary:
+	var scene_controller = _get_scene_controller()
+	if not scene_controller or not scene_controller.has_method("craft_item"):
+		return {"success": false, "error": "Scene does not support crafting"}
+	return scene_controller.craft_item(parameters.get("recipe", ""))
+
+func _tool_get_recipes(_parameters: Dictionary) -> Dictionary:
+	var scene_controller = _get_scene_controller()
+	if scene_controller and "RECIPES" in scene_controller:
+		return {"success": true, "recipes": scene_controller.RECIPES}
+	return {"success": false, "error": "No recipes available"}
+
+func _start_movement(target: Vector3, move_tool: String) -> void:
+	_target_position = target
+	_is_moving = true
+	_movement_start_tick = _get_current_tick()
+	_position_samples.clear()
+	_stuck_check_timer = 0
+	_current_move_tool = move_tool
+
+func get_snapshot_state() -> Dictionary:
+	"""Movement in progress and native memory, so a restored agent carries on where it was."""
+	return {
+		"target_position": _target_position,
+		"is_moving": _is_moving,
+		"movement_speed": _movement_speed,
+		"movement_start_tick": _movement_start_tick,
+		"move_tool": _current_move_tool,
+		"memory": _cpp_agent.get_memory_snapshot() if _cpp_agent else {}
+	}
+
+func apply_snapshot_state(state: Dictionary) -> void:
+	super.apply_snapshot_state(state)
+	_target_position = state.get("target_position", global_position)
+	_is_moving = state.get("is_moving", false)
+	_movement_speed = state.get("movement_speed", 1.0)
+	_movement_start_tick = state.get("movement_start_tick", 0)
+	_current_move_tool = state.get("move_tool", "")
+	if _cpp_agent:
+		_cpp_agent.restore_memory_snapshot(state.get("memory", {}))
+	_position_samples.clear()
+	_stuck_check_timer = 0
+	_reported_collisions_this_tick.clear()
+	_last_collision_report_tick = -1
 
 func perceive(_observations: Dictionary) -> void:
 	"""
@@ -187,6 +217,10 @@ func perceive(_observations: Dictionary) -> void:
 	# Observations are handled by SceneController and sent to backend
 	pass
 
+func get_core_agent() -> Agent:
+	"""Get the C++ Agent node that holds this agent's backend observation"""
+	return _cpp_agent
+
 func send_tick(tick: int, perceptions: Array) -> void:
 	"""
 	Send a tick update for this agent using the global IPCService.
@@ -361,6 +395,14 @@ func _get_scene_controller() -> Node:
 	return null
 
 # Signal handlers
+func _on_core_action_received(action: Dictionary):
+	"""Forward a batched tick action routed to our C++ Agent by IPCClient"""
+	action_received.emit(action)
+
+func _exit_tree():
+	if IPCService:
+		IPCService.unregister_agent(agent_id)
+
 func _on_tool_response(response_agent_id: String, tool_name: String, response: Dictionary):
 	"""Handle tool response from IPCService"""
 	# Only process responses for this agent
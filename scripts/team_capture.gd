@@ -161,6 +161,15 @@ func _build_observations_for_agent(agent_data: Dictionary) -> Dictionary:
 		"tick": simulation_manager.current_tick
 	}
 
+func _get_decision_priority(agent_data: Dictionary) -> float:
+	"""Agents facing enemies or standing on a point their team doesn't hold decide first"""
+	if not agent_data.last_observation.get("nearby_enemies", []).is_empty():
+		return 2.0
+	for point in capture_points:
+		if point.owner != agent_data.team and agent_data.position.distance_to(point.position) <= CAPTURE_RADIUS:
+			return 2.0
+	return 1.0
+
 func _on_agent_tool_completed(agent_data: Dictionary, tool_name: String, response: Dictionary):
 	"""Handle tool execution completion from agent"""
 	print("TeamCapture: Agent '%s' (%s) completed tool '%s': %s" %
@@ -463,3 +472,43 @@ func _reset_scene():
 			red_agents[i].agent.global_position = red_spawn_positions[i]
 
 	print("✓ Scene reset!")
+
+func _capture_scene_state() -> Dictionary:
+	"""Snapshot source: scores, contributions and capture point ownership"""
+	var state = super._capture_scene_state()
+	var points = []
+	for point in capture_points:
+		points.append([point.owner, point.capture_progress, point.capturing_team])
+	state["capture_points"] = points
+	state["blue_score"] = blue_score
+	state["red_score"] = red_score
+	state["objectives_captured"] = objectives_captured
+	state["total_captures"] = total_captures
+	state["team_blue_contributions"] = team_blue_contributions
+	state["team_red_contributions"] = team_red_contributions
+	state["winning_team"] = winning_team
+	return state
+
+func _restore_scene_state(state: Dictionary):
+	super._restore_scene_state(state)
+	var points: Array = state.get("capture_points", [])
+	for i in range(min(points.size(), capture_points.size())):
+		var point = capture_points[i]
+		point.owner = points[i][0]
+		point.capture_progress = points[i][1]
+		point.capturing_team = points[i][2]
+		point.agents_present.clear()  # Recomputed on the next tick
+		if point.node:
+			point.node.set_owner_team(point.owner)
+			if point.capturing_team == null or point.capture_progress <= 0.0:
+				point.node.reset_capture()
+			else:
+				point.node.set_capture_progress(point.capture_progress, point.capturing_team)
+	blue_score = state.get("blue_score", 0)
+	red_score = state.get("red_score", 0)
+	objectives_captured = state.get("objectives_captured", {"blue": 0, "red": 0})
+	total_captures = state.get("total_captures", 0)
+	team_blue_contributions = state.get("team_blue_contributions", {})
+	team_red_contributions = state.get("team_red_contributions", {})
+	winning_team = state.get("winning_team", "")
+
@@ -3,7 +3,8 @@ class_name VisibilityTracker
 
 ## Tracks which areas of the world the agent has seen.
 ##
-## Uses a 2D grid (ignoring Y) to track visibility. Each cell can be:
+## Uses a 2D grid (ignoring Y) to track visibility, stored natively in an
+## ExplorationGrid bitset. Each cell can be:
 ## - unseen: Never in agent's line of sight
 ## - seen: Agent has had line of sight to this cell
 ##
@@ -24,6 +25,7 @@ signal exploration_updated(percentage: float)
 ## Configuration
 @export var cell_size: float = 2.0  ## Size of each grid cell in world units
 @export var use_raycasting: bool = false  ## If true, use raycasts to check for walls blocking vision
+@export var layer: int = 0  ## ExplorationGrid layer; agents sharing one pool what they have seen
 
 ## Debug visualization
 var _debug_enabled: bool = false
@@ -34,8 +36,8 @@ var _debug_needs_update: bool = false
 var world_min: Vector2 = Vector2(-25, -25)
 var world_max: Vector2 = Vector2(25, 25)
 
-## Grid storage: Vector2i -> bool (true = seen)
-var _seen_cells: Dictionary = {}
+## Grid storage: one bit per cell, plus cached frontier bits
+var _grid := ExplorationGrid.new()
 
 ## Cached metrics
 var _total_navigable_cells: int = 0
@@ -47,9 +49,9 @@ var _space_state: PhysicsDirectSpaceState3D = null
 var _los_collision_mask: int = 2  ## Collision layer for obstacles that block vision
 
 func _ready():
-	# Try to get physics space state
-	if get_tree() and get_tree().root:
-		var world_3d = get_tree().root.get_world_3d()
+	# Try to get physics space state (our own viewport's, so hosted worlds stay isolated)
+	if get_viewport():
+		var world_3d = get_viewport().find_world_3d()
 		if world_3d:
 			_space_state = world_3d.direct_space_state
 
@@ -57,6 +59,8 @@ func set_world_bounds(min_pos: Vector2, max_pos: Vector2) -> void:
 	"""Set the world bounds for exploration tracking."""
 	world_min = min_pos
 	world_max = max_pos
+	_grid.cell_size = cell_size
+	_grid.set_world_bounds(world_min, world_max)
 	_calculate_total_cells()
 	print("[VisibilityTracker] World bounds set: %s to %s (%d total cells)" % [
 		world_min, world_max, _total_navigable_cells
@@ -68,9 +72,9 @@ func set_los_collision_mask(mask: int) -> void:
 
 func _calculate_total_cells() -> void:
 	"""Calculate total number of cells in the world bounds."""
-	var width = int((world_max.x - world_min.x) / cell_size) + 1
-	var height = int((world_max.y - world_min.y) / cell_size) + 1
-	_total_navigable_cells = width * height
+	_total_navigable_cells = _grid.get_total_cells()
+	_seen_cell_count = 0
+	_exploration_percentage = 0.0
 
 func world_to_cell(world_pos: Vector3) -> Vector2i:
 	"""Convert world position to grid cell coordinates."""
@@ -89,10 +93,7 @@ func cell_to_world(cell: Vector2i) -> Vector3:
 
 func is_cell_in_bounds(cell: Vector2i) -> bool:
 	"""Check if a cell is within world bounds."""
-	var world_x = cell.x * cell_size
-	var world_z = cell.y * cell_size
-	return (world_x >= world_min.x and world_x <= world_max.x and
-			world_z >= world_min.y and world_z <= world_max.y)
+	return _grid.is_cell_in_bounds(cell.x, cell.y)
 
 func update_visibility(agent_pos: Vector3, perception_radius: float, agent_node: Node3D = null) -> void:
 	"""Update visibility grid based on agent's current position and perception radius.
@@ -102,45 +103,29 @@ func update_visibility(agent_pos: Vector3, perception_radius: float, agent_node:
 		perception_radius: How far the agent can see
 		agent_node: Optional agent node for raycast exclusion
 	"""
-	var center_cell = world_to_cell(agent_pos)
-	var cells_radius = int(ceil(perception_radius / cell_size))
-
 	var new_cells_seen = 0
 
-	# Mark cells within perception radius as seen
-	for dx in range(-cells_radius, cells_radius + 1):
-		for dz in range(-cells_radius, cells_radius + 1):
-			var cell = Vector2i(center_cell.x + dx, center_cell.y + dz)
-
-			# Skip if outside world bounds
-			if not is_cell_in_bounds(cell):
-				continue
-
-			# Skip if already seen
-			if _seen_cells.has(cell):
-				continue
-
-			# Get cell world position
-			var cell_world = cell_to_world(cell)
-			var distance = agent_pos.distance_to(cell_world)
-
-			# Skip if beyond perception radius
-			if distance > perception_radius:
-				continue
-
-			# Optional: Check line of sight (if enabled and we have physics)
-			if use_raycasting and _space_state and agent_node:
-				if not _has_line_of_sight(agent_pos, cell_world, agent_node):
-					continue
-
-			# Mark as seen
-			_seen_cells[cell] = true
-			new_cells_seen += 1
+	if use_raycasting and _space_state and agent_node:
+		# Blocked cells stay unseen and are retried, so every unseen cell in
+		# range is a candidate
+		var candidates: PackedInt32Array = _grid.collect_unseen(layer, agent_pos, perception_radius)
+		var visible := PackedInt32Array()
+		for i in range(0, candidates.size(), 2):
+			var cell = Vector2i(candidates[i], candidates[i + 1])
+			if _has_line_of_sight(agent_pos, cell_to_world(cell), agent_node):
+				visible.append(cell.x)
+				visible.append(cell.y)
+		if not visible.is_empty():
+			new_cells_seen = _grid.mark_cells(layer, visible)
+	else:
+		# Only the cells this agent has newly come within range of are touched
+		var viewer_id = agent_node.get_instance_id() if agent_node else -1
+		new_cells_seen = _grid.reveal(layer, viewer_id, agent_pos, perception_radius)
 
 	# Update metrics
 	if new_cells_seen > 0:
-		_seen_cell_count = _seen_cells.size()
-		_exploration_percentage = (float(_seen_cell_count) / float(_total_navigable_cells)) * 100.0 if _total_navigable_cells > 0 else 0.0
+		_seen_cell_count = _grid.get_seen_count(layer)
+		_exploration_percentage = _grid.get_exploration_percentage(layer)
 		exploration_updated.emit(_exploration_percentage)
 		# Request debug visualization update
 		if _debug_enabled:
@@ -168,22 +153,9 @@ func _has_line_of_sight(from_pos: Vector3, to_pos: Vector3, agent_node: Node3D)
 func get_frontier_cells() -> Array[Vector2i]:
 	"""Get cells that are seen and adjacent to unseen cells (frontiers)."""
 	var frontiers: Array[Vector2i] = []
-
-	for cell in _seen_cells.keys():
-		# Check 4-connected neighbors
-		var neighbors = [
-			Vector2i(cell.x - 1, cell.y),
-			Vector2i(cell.x + 1, cell.y),
-			Vector2i(cell.x, cell.y - 1),
-			Vector2i(cell.x, cell.y + 1)
-		]
-
-		for neighbor in neighbors:
-			# If neighbor is in bounds but not seen, this is a frontier
-			if is_cell_in_bounds(neighbor) and not _seen_cells.has(neighbor):
-				frontiers.append(cell)
-				break  # Only add cell once
-
+	var cells: PackedInt32Array = _grid.get_frontier_cells(layer)
+	for i in range(0, cells.size(), 2):
+		frontiers.append(Vector2i(cells[i], cells[i + 1]))
 	return frontiers
 
 func get_cardinal_direction(from_pos: Vector3, to_pos: Vector3) -> String:
@@ -227,47 +199,7 @@ func get_exploration_summary(agent_pos: Vector3) -> Dictionary:
 		- frontiers_by_direction: Dictionary mapping direction -> nearest distance
 		- suggested_explore_targets: Array of {direction, position, distance}
 	"""
-	var frontiers = get_frontier_cells()
-
-	# Group frontiers by direction and find nearest in each
-	var frontiers_by_direction: Dictionary = {}
-	var direction_positions: Dictionary = {}  # Store best position for each direction
-
-	for cell in frontiers:
-		var cell_world = cell_to_world(cell)
-		var direction = get_cardinal_direction(agent_pos, cell_world)
-		var distance = agent_pos.distance_to(cell_world)
-
-		if not frontiers_by_direction.has(direction):
-			frontiers_by_direction[direction] = distance
-			direction_positions[direction] = cell_world
-		elif distance < frontiers_by_direction[direction]:
-			frontiers_by_direction[direction] = distance
-			direction_positions[direction] = cell_world
-
-	# Build suggested explore targets (sorted by distance)
-	var explore_targets: Array[Dictionary] = []
-	for direction in frontiers_by_direction.keys():
-		explore_targets.append({
-			"direction": direction,
-			"distance": frontiers_by_direction[direction],
-			"position": [
-				direction_positions[direction].x,
-				direction_positions[direction].y,
-				direction_positions[direction].z
-			]
-		})
-
-	# Sort by distance
-	explore_targets.sort_custom(func(a, b): return a.distance < b.distance)
-
-	return {
-		"exploration_percentage": _exploration_percentage,
-		"total_cells": _total_navigable_cells,
-		"seen_cells": _seen_cell_count,
-		"frontiers_by_direction": frontiers_by_direction,
-		"explore_targets": explore_targets.slice(0, 5)  # Top 5 targets
-	}
+	return _grid.get_summary(layer, agent_pos, 5)
 
 func get_unexplored_position_in_direction(agent_pos: Vector3, direction: String) -> Dictionary:
 	"""Get a navigable unexplored position in the given direction.
@@ -283,50 +215,33 @@ func get_unexplored_position_in_direction(agent_pos: Vector3, direction: String)
 		- distance: float if success
 		- has_unexplored: bool
 	"""
-	var frontiers = get_frontier_cells()
-
-	# Filter frontiers by direction
-	var best_distance = INF
-	var best_position: Vector3 = Vector3.ZERO
-	var found = false
-
-	for cell in frontiers:
-		var cell_world = cell_to_world(cell)
-		var cell_direction = get_cardinal_direction(agent_pos, cell_world)
-
-		if cell_direction == direction:
-			var distance = agent_pos.distance_to(cell_world)
-			if distance < best_distance:
-				best_distance = distance
-				best_position = cell_world
-				found = true
-
-	if found:
-		return {
-			"success": true,
-			"position": [best_position.x, best_position.y, best_position.z],
-			"distance": best_distance,
-			"has_unexplored": true
-		}
-	else:
-		return {
-			"success": false,
-			"has_unexplored": false,
-			"reason": "No unexplored areas in direction: " + direction
-		}
+	return _grid.find_frontier(layer, agent_pos, direction)
 
 func is_position_explored(world_pos: Vector3) -> bool:
 	"""Check if a specific position has been explored."""
-	var cell = world_to_cell(world_pos)
-	return _seen_cells.has(cell)
+	return _grid.is_position_seen(layer, world_pos)
 
 func clear() -> void:
 	"""Clear all exploration data (call on episode reset)."""
-	_seen_cells.clear()
+	_grid.clear()
 	_seen_cell_count = 0
 	_exploration_percentage = 0.0
 	print("[VisibilityTracker] Exploration data cleared")
 
+func get_snapshot_state() -> PackedByteArray:
+	"""Seen cells and each agent's last perception disk, for SimulationManager snapshots."""
+	return _grid.capture_state()
+
+func apply_snapshot_state(state: PackedByteArray) -> void:
+	"""Restore what get_snapshot_state() captured; clears if it doesn't fit this grid."""
+	if not _grid.restore_state(state):
+		_grid.clear()
+	_seen_cell_count = _grid.get_seen_count(layer)
+	_exploration_percentage = _grid.get_exploration_percentage(layer)
+	exploration_updated.emit(_exploration_percentage)
+	if _debug_enabled:
+		request_debug_update()
+
 func get_debug_info() -> Dictionary:
 	"""Get debug information about the tracker state."""
 	return {
@@ -335,7 +250,7 @@ func get_debug_info() -> Dictionary:
 		"total_cells": _total_navigable_cells,
 		"seen_cells": _seen_cell_count,
 		"exploration_percentage": _exploration_percentage,
-		"frontier_count": get_frontier_cells().size()
+		"frontier_count": _grid.get_frontier_count(layer)
 	}
 
 ## Debug Visualization
@@ -387,11 +302,6 @@ func _update_debug_mesh() -> void:
 	if not _debug_enabled or _debug_mesh_instance == null:
 		return
 
-	var frontiers = get_frontier_cells()
-	var frontier_set: Dictionary = {}
-	for cell in frontiers:
-		frontier_set[cell] = true
-
 	# Create immediate mesh
 	var mesh = ImmediateMesh.new()
 	mesh.surface_begin(Mesh.PRIMITIVE_TRIANGLES)
@@ -401,23 +311,21 @@ func _update_debug_mesh() -> void:
 	var y_offset = 0.05  # Slightly above ground
 
 	# Calculate grid bounds in cells
-	var min_cell_x = int(floor(world_min.x / cell_size))
-	var max_cell_x = int(floor(world_max.x / cell_size))
-	var min_cell_z = int(floor(world_min.y / cell_size))
-	var max_cell_z = int(floor(world_max.y / cell_size))
+	var min_cell: Vector2i = _grid.get_min_cell()
+	var grid_size: Vector2i = _grid.get_grid_size()
 
 	# Draw each cell
-	for cx in range(min_cell_x, max_cell_x + 1):
-		for cz in range(min_cell_z, max_cell_z + 1):
+	for cx in range(min_cell.x, min_cell.x + grid_size.x):
+		for cz in range(min_cell.y, min_cell.y + grid_size.y):
 			var cell = Vector2i(cx, cz)
 			var center = cell_to_world(cell)
 			center.y = y_offset
 
 			var color: Color
-			if frontier_set.has(cell):
+			if _grid.is_frontier_cell(layer, cx, cz):
 				# Frontier cell - yellow/orange
 				color = Color(1.0, 0.7, 0.0, 0.5)
-			elif _seen_cells.has(cell):
+			elif _grid.is_cell_seen(layer, cx, cz):
 				# Seen cell - light green transparent
 				color = Color(0.2, 0.8, 0.2, 0.15)
 			else: